@@ -9,6 +9,7 @@
 #include "edits/insert_node.hpp"
 #include "edits/insert_point.hpp"
 #include "edits/set_value.hpp"
+#include "io/read_file.hpp"
 #include "math/vector_funcs.hpp"
 #include "resource.h"
 #include "utility/file_pickers.hpp"
@@ -119,6 +120,9 @@ void world_edit::update()
    update_ui();
 
    // Logic!
+   _edit_stack_world.set_memory_budget(static_cast<std::size_t>(
+      _settings.preferences.edit_history_budget_mb * 1024.0f * 1024.0f));
+
    update_object_classes();
 
    _asset_libraries.update_loaded();
@@ -131,7 +135,8 @@ void world_edit::update()
    try {
       _renderer->draw_frame(_camera, _world, _interaction_targets, _world_draw_mask,
                             _world_layers_draw_mask, _tool_visualizers,
-                            _object_classes, _settings.graphics);
+                            _object_classes, _object_bboxes, _object_store,
+                            _settings.graphics);
    }
    catch (graphics::gpu::exception& e) {
       handle_gpu_error(e);
@@ -201,9 +206,12 @@ void world_edit::update_hovered_entity() noexcept
    }
 
    if (raycast_mask.objects) {
+      // Input handling may have edited objects since the store was last updated.
+      _object_store.update(_world);
+
       if (std::optional<world::raycast_result<world::object>> hit =
              world::raycast(ray.origin, ray.direction, _world_layers_hit_mask,
-                            _world.objects, _object_classes);
+                            _object_store, _object_classes, _object_bboxes);
           hit) {
          if (hit->distance < hovered_entity_distance) {
             _interaction_targets.hovered_entity = hit->id;
@@ -312,7 +320,7 @@ void world_edit::update_hovered_entity() noexcept
    if (raycast_mask.planning_connections) {
       if (std::optional<world::raycast_result<world::planning_connection>> hit =
              world::raycast(ray.origin, ray.direction, _world.planning_connections,
-                            _world.planning_hubs, _world.planning_hub_index,
+                            _world.planning_hubs, _world.id_index.planning_hubs,
                             _settings.graphics.planning_connection_height);
           hit) {
          if (hit->distance < hovered_entity_distance) {
@@ -381,15 +389,16 @@ void world_edit::update_hovered_entity() noexcept
 
 void world_edit::update_object_classes() noexcept
 {
-   std::array<std::span<const world::object>, 2> object_spans{_world.objects};
+   const world::object* creation_object =
+      _interaction_targets.creation_entity
+         ? std::get_if<world::object>(&(*_interaction_targets.creation_entity))
+         : nullptr;
 
-   if (_interaction_targets.creation_entity and
-       std::holds_alternative<world::object>(*_interaction_targets.creation_entity)) {
-      object_spans[1] =
-         std::span{&std::get<world::object>(*_interaction_targets.creation_entity), 1};
-   }
+   _object_classes.update(_world, creation_object);
 
-   _object_classes.update(object_spans);
+   _snapping_index.update(_world, _object_classes);
+   _object_bboxes.update(_world, _object_classes);
+   _object_store.update(_world);
 }
 
 void world_edit::update_camera(const float delta_time)
@@ -513,7 +522,7 @@ void world_edit::place_creation_entity() noexcept
             world::object new_object = object;
 
             new_object.name =
-               world::create_unique_name(_world.objects, new_object.name);
+               world::create_unique_name<world::object>(_world, new_object.name);
             new_object.instance_properties = world::make_object_instance_properties(
                *_object_classes[object.class_name].definition,
                new_object.instance_properties);
@@ -528,8 +537,8 @@ void world_edit::place_creation_entity() noexcept
             if (not object.name.empty()) {
                _edit_stack_world.apply(edits::make_set_creation_value(
                                           &world::object::name,
-                                          world::create_unique_name(_world.objects,
-                                                                    object.name),
+                                          world::create_unique_name<world::object>(
+                                             _world, object.name),
                                           object.name),
                                        _edit_context, {.transparent = true});
             }
@@ -546,12 +555,13 @@ void world_edit::place_creation_entity() noexcept
          [&](const world::light& light) {
             world::light new_light = light;
 
-            new_light.name = world::create_unique_name(_world.lights, new_light.name);
+            new_light.name = world::create_unique_name<world::light>(_world,
+                                                                     new_light.name);
             new_light.id = _world.next_id.lights.aquire();
 
             if (world::is_region_light(light)) {
                new_light.region_name =
-                  world::create_unique_light_region_name(_world.lights, _world.regions,
+                  world::create_unique_light_region_name(_world,
                                                          light.region_name.empty()
                                                             ? light.name
                                                             : light.region_name);
@@ -564,8 +574,8 @@ void world_edit::place_creation_entity() noexcept
 
             _edit_stack_world.apply(edits::make_set_creation_value(
                                        &world::light::name,
-                                       world::create_unique_name(_world.lights,
-                                                                 light.name),
+                                       world::create_unique_name<world::light>(
+                                          _world, light.name),
                                        light.name),
                                     _edit_context, {.transparent = true});
 
@@ -573,7 +583,7 @@ void world_edit::place_creation_entity() noexcept
                _edit_stack_world.apply(edits::make_set_creation_value(
                                           &world::light::region_name,
                                           world::create_unique_light_region_name(
-                                             _world.lights, _world.regions,
+                                             _world,
                                              light.region_name.empty() ? light.name
                                                                        : light.region_name),
                                           light.region_name),
@@ -584,7 +594,7 @@ void world_edit::place_creation_entity() noexcept
          },
          [&](const world::path& path) {
             if (const world::path* existing_path =
-                   world::find_entity(_world.paths, path.name);
+                   world::find_entity<world::path>(_world, path.name);
                 existing_path) {
                if (path.nodes.empty()) std::terminate();
 
@@ -627,7 +637,7 @@ void world_edit::place_creation_entity() noexcept
             world::region new_region = region;
 
             new_region.name =
-               world::create_unique_name(_world.regions, new_region.name);
+               world::create_unique_name<world::region>(_world, new_region.name);
             new_region.id = _world.next_id.regions.aquire();
 
             _last_created_entities.last_region = new_region.id;
@@ -637,8 +647,8 @@ void world_edit::place_creation_entity() noexcept
 
             _edit_stack_world.apply(edits::make_set_creation_value(
                                        &world::region::name,
-                                       world::create_unique_name(_world.regions,
-                                                                 region.name),
+                                       world::create_unique_name<world::region>(
+                                          _world, region.name),
                                        region.name),
                                     _edit_context, {.transparent = true});
 
@@ -648,7 +658,7 @@ void world_edit::place_creation_entity() noexcept
             if (sector.points.empty()) std::terminate();
 
             if (const world::sector* existing_sector =
-                   world::find_entity(_world.sectors, sector.name);
+                   world::find_entity<world::sector>(_world, sector.name);
                 existing_sector) {
                _edit_stack_world
                   .apply(edits::make_insert_point(existing_sector->id,
@@ -680,7 +690,7 @@ void world_edit::place_creation_entity() noexcept
             world::portal new_portal = portal;
 
             new_portal.name =
-               world::create_unique_name(_world.portals, new_portal.name);
+               world::create_unique_name<world::portal>(_world, new_portal.name);
             new_portal.id = _world.next_id.portals.aquire();
 
             _last_created_entities.last_portal = new_portal.id;
@@ -690,8 +700,8 @@ void world_edit::place_creation_entity() noexcept
 
             _edit_stack_world.apply(edits::make_set_creation_value(
                                        &world::portal::name,
-                                       world::create_unique_name(_world.portals,
-                                                                 portal.name),
+                                       world::create_unique_name<world::portal>(
+                                          _world, portal.name),
                                        portal.name),
                                     _edit_context, {.transparent = true});
          },
@@ -699,7 +709,7 @@ void world_edit::place_creation_entity() noexcept
             world::hintnode new_hintnode = hintnode;
 
             new_hintnode.name =
-               world::create_unique_name(_world.hintnodes, new_hintnode.name);
+               world::create_unique_name<world::hintnode>(_world, new_hintnode.name);
             new_hintnode.id = _world.next_id.hintnodes.aquire();
 
             _last_created_entities.last_hintnode = new_hintnode.id;
@@ -709,8 +719,8 @@ void world_edit::place_creation_entity() noexcept
 
             _edit_stack_world.apply(edits::make_set_creation_value(
                                        &world::hintnode::name,
-                                       world::create_unique_name(_world.hintnodes,
-                                                                 hintnode.name),
+                                       world::create_unique_name<world::hintnode>(
+                                          _world, hintnode.name),
                                        hintnode.name),
                                     _edit_context, {.transparent = true});
 
@@ -720,7 +730,7 @@ void world_edit::place_creation_entity() noexcept
             world::barrier new_barrier = barrier;
 
             new_barrier.name =
-               world::create_unique_name(_world.barriers, new_barrier.name);
+               world::create_unique_name<world::barrier>(_world, new_barrier.name);
             new_barrier.id = _world.next_id.barriers.aquire();
 
             _last_created_entities.last_barrier = new_barrier.id;
@@ -730,8 +740,8 @@ void world_edit::place_creation_entity() noexcept
 
             _edit_stack_world.apply(edits::make_set_creation_value(
                                        &world::barrier::name,
-                                       world::create_unique_name(_world.barriers,
-                                                                 barrier.name),
+                                       world::create_unique_name<world::barrier>(
+                                          _world, barrier.name),
                                        barrier.name),
                                     _edit_context, {.transparent = true});
          },
@@ -740,20 +750,18 @@ void world_edit::place_creation_entity() noexcept
                world::planning_hub new_hub = hub;
 
                new_hub.name =
-                  world::create_unique_name(_world.planning_hubs, new_hub.name);
+                  world::create_unique_name<world::planning_hub>(_world, new_hub.name);
                new_hub.id = _world.next_id.planning_hubs.aquire();
 
                _last_created_entities.last_planning_hub = new_hub.id;
 
-               _edit_stack_world
-                  .apply(edits::make_insert_entity(std::move(new_hub),
-                                                   _world.planning_hubs.size()),
-                         _edit_context);
+               _edit_stack_world.apply(edits::make_insert_entity(std::move(new_hub)),
+                                       _edit_context);
 
                _edit_stack_world.apply(edits::make_set_creation_value(
                                           &world::planning_hub::name,
-                                          world::create_unique_name(_world.planning_hubs,
-                                                                    hub.name),
+                                          world::create_unique_name<world::planning_hub>(
+                                             _world, hub.name),
                                           hub.name),
                                        _edit_context, {.transparent = true});
 
@@ -774,8 +782,8 @@ void world_edit::place_creation_entity() noexcept
                world::planning_connection new_connection = connection;
 
                new_connection.name =
-                  world::create_unique_name(_world.planning_connections,
-                                            new_connection.name);
+                  world::create_unique_name<world::planning_connection>(
+                     _world, new_connection.name);
                new_connection.id = _world.next_id.planning_connections.aquire();
 
                _last_created_entities.last_planning_connection = new_connection.id;
@@ -785,8 +793,9 @@ void world_edit::place_creation_entity() noexcept
 
                _edit_stack_world.apply(edits::make_set_creation_value(
                                           &world::planning_connection::name,
-                                          world::create_unique_name(_world.planning_connections,
-                                                                    connection.name),
+                                          world::create_unique_name<
+                                             world::planning_connection>(_world,
+                                                                         connection.name),
                                           connection.name),
                                        _edit_context, {.transparent = true});
 
@@ -807,7 +816,7 @@ void world_edit::place_creation_entity() noexcept
             world::boundary new_boundary = boundary;
 
             new_boundary.name =
-               world::create_unique_name(_world.boundaries, new_boundary.name);
+               world::create_unique_name<world::boundary>(_world, new_boundary.name);
             new_boundary.id = _world.next_id.boundaries.aquire();
 
             _last_created_entities.last_boundary = new_boundary.id;
@@ -817,8 +826,8 @@ void world_edit::place_creation_entity() noexcept
 
             _edit_stack_world.apply(edits::make_set_creation_value(
                                        &world::boundary::name,
-                                       world::create_unique_name(_world.boundaries,
-                                                                 boundary.name),
+                                       world::create_unique_name<world::boundary>(
+                                          _world, boundary.name),
                                        boundary.name),
                                     _edit_context, {.transparent = true});
          },
@@ -955,6 +964,10 @@ void world_edit::align_selection() noexcept
 
    edits::bundle_vector bundle;
 
+   std::vector<world::object_id> object_ids;
+   std::vector<float3> new_object_positions;
+   std::vector<float3> object_positions;
+
    const float alignment = _world.terrain.grid_scale;
 
    const auto align_position = [=](const float3 position) {
@@ -965,18 +978,19 @@ void world_edit::align_selection() noexcept
    for (const auto& selected : _interaction_targets.selection) {
       if (std::holds_alternative<world::object_id>(selected)) {
          const world::object* object =
-            world::find_entity(_world.objects, std::get<world::object_id>(selected));
+            world::find_entity<world::object>(_world,
+                                              std::get<world::object_id>(selected));
 
          if (object) {
-            bundle.push_back(edits::make_set_value(object->id, &world::object::position,
-                                                   align_position(object->position),
-                                                   object->position));
+            object_ids.push_back(object->id);
+            new_object_positions.push_back(align_position(object->position));
+            object_positions.push_back(object->position);
          }
       }
       else if (std::holds_alternative<world::path_id_node_pair>(selected)) {
          const auto [id, node_index] = std::get<world::path_id_node_pair>(selected);
 
-         const world::path* path = world::find_entity(_world.paths, id);
+         const world::path* path = world::find_entity<world::path>(_world, id);
 
          if (path) {
             const world::path::node& node = path->nodes[node_index];
@@ -990,7 +1004,7 @@ void world_edit::align_selection() noexcept
       }
       else if (std::holds_alternative<world::light_id>(selected)) {
          const world::light* light =
-            world::find_entity(_world.lights, std::get<world::light_id>(selected));
+            world::find_entity<world::light>(_world, std::get<world::light_id>(selected));
 
          if (light) {
             bundle.push_back(edits::make_set_value(light->id, &world::light::position,
@@ -1000,7 +1014,8 @@ void world_edit::align_selection() noexcept
       }
       else if (std::holds_alternative<world::region_id>(selected)) {
          const world::region* region =
-            world::find_entity(_world.regions, std::get<world::region_id>(selected));
+            world::find_entity<world::region>(_world,
+                                              std::get<world::region_id>(selected));
 
          if (region) {
             bundle.push_back(edits::make_set_value(region->id, &world::region::position,
@@ -1010,7 +1025,8 @@ void world_edit::align_selection() noexcept
       }
       else if (std::holds_alternative<world::sector_id>(selected)) {
          const world::sector* sector =
-            world::find_entity(_world.sectors, std::get<world::sector_id>(selected));
+            world::find_entity<world::sector>(_world,
+                                              std::get<world::sector_id>(selected));
 
          if (sector) {
             std::vector<float2> new_points = sector->points;
@@ -1026,7 +1042,8 @@ void world_edit::align_selection() noexcept
       }
       else if (std::holds_alternative<world::portal_id>(selected)) {
          const world::portal* portal =
-            world::find_entity(_world.portals, std::get<world::portal_id>(selected));
+            world::find_entity<world::portal>(_world,
+                                              std::get<world::portal_id>(selected));
 
          if (portal) {
             bundle.push_back(edits::make_set_value(portal->id, &world::portal::position,
@@ -1036,8 +1053,8 @@ void world_edit::align_selection() noexcept
       }
       else if (std::holds_alternative<world::hintnode_id>(selected)) {
          const world::hintnode* hintnode =
-            world::find_entity(_world.hintnodes,
-                               std::get<world::hintnode_id>(selected));
+            world::find_entity<world::hintnode>(_world,
+                                                std::get<world::hintnode_id>(selected));
 
          if (hintnode) {
             bundle.push_back(
@@ -1048,7 +1065,8 @@ void world_edit::align_selection() noexcept
       }
       else if (std::holds_alternative<world::barrier_id>(selected)) {
          const world::barrier* barrier =
-            world::find_entity(_world.barriers, std::get<world::barrier_id>(selected));
+            world::find_entity<world::barrier>(_world,
+                                               std::get<world::barrier_id>(selected));
 
          if (barrier) {
             bundle.push_back(edits::make_set_value(barrier->id, &world::barrier::position,
@@ -1058,8 +1076,8 @@ void world_edit::align_selection() noexcept
       }
       else if (std::holds_alternative<world::planning_hub_id>(selected)) {
          const world::planning_hub* planning_hub =
-            world::find_entity(_world.planning_hubs,
-                               std::get<world::planning_hub_id>(selected));
+            world::find_entity<world::planning_hub>(
+               _world, std::get<world::planning_hub_id>(selected));
 
          if (planning_hub) {
             bundle.push_back(
@@ -1070,8 +1088,8 @@ void world_edit::align_selection() noexcept
       }
       else if (std::holds_alternative<world::boundary_id>(selected)) {
          const world::boundary* boundary =
-            world::find_entity(_world.boundaries,
-                               std::get<world::boundary_id>(selected));
+            world::find_entity<world::boundary>(_world,
+                                                std::get<world::boundary_id>(selected));
 
          if (boundary) {
             bundle.push_back(
@@ -1082,6 +1100,13 @@ void world_edit::align_selection() noexcept
       }
    }
 
+   if (not object_ids.empty()) {
+      bundle.push_back(edits::make_set_values(std::move(object_ids),
+                                              &world::object::position,
+                                              std::move(new_object_positions),
+                                              std::move(object_positions)));
+   }
+
    if (bundle.size() == 1) {
       _edit_stack_world.apply(std::move(bundle.back()), _edit_context,
                               {.closed = true});
@@ -1092,6 +1117,37 @@ void world_edit::align_selection() noexcept
    }
 }
 
+void world_edit::fill_all_sectors() noexcept
+{
+   _object_bboxes.update(_world, _object_classes);
+
+   const std::vector<std::vector<std::string>> sectors_objects =
+      world::sector_fill_all(_world.sectors, _world.objects, _object_bboxes,
+                             *_thread_pool);
+
+   std::vector<world::sector_id> sector_ids;
+   std::vector<std::vector<std::string>> new_sector_objects;
+   std::vector<std::vector<std::string>> original_sector_objects;
+
+   for (std::size_t i = 0; i < _world.sectors.size(); ++i) {
+      const world::sector& sector = _world.sectors[i];
+
+      if (sector.objects == sectors_objects[i]) continue;
+
+      sector_ids.push_back(sector.id);
+      new_sector_objects.push_back(sectors_objects[i]);
+      original_sector_objects.push_back(sector.objects);
+   }
+
+   if (sector_ids.empty()) return;
+
+   _edit_stack_world.apply(edits::make_set_values(std::move(sector_ids),
+                                                  &world::sector::objects,
+                                                  std::move(new_sector_objects),
+                                                  std::move(original_sector_objects)),
+                           _edit_context, {.closed = true});
+}
+
 void world_edit::new_entity_from_selection() noexcept
 {
    if (_interaction_targets.selection.empty()) return;
@@ -1100,13 +1156,13 @@ void world_edit::new_entity_from_selection() noexcept
 
    if (std::holds_alternative<world::object_id>(selected)) {
       world::object* object =
-         world::find_entity(_world.objects, std::get<world::object_id>(selected));
+         world::find_entity<world::object>(_world, std::get<world::object_id>(selected));
 
       if (not object) return;
 
       world::object new_object = *object;
 
-      new_object.name = world::create_unique_name(_world.objects, new_object.name);
+      new_object.name = world::create_unique_name<world::object>(_world, new_object.name);
       new_object.id = world::max_id;
 
       _edit_stack_world
@@ -1117,13 +1173,13 @@ void world_edit::new_entity_from_selection() noexcept
    }
    else if (std::holds_alternative<world::light_id>(selected)) {
       world::light* light =
-         world::find_entity(_world.lights, std::get<world::light_id>(selected));
+         world::find_entity<world::light>(_world, std::get<world::light_id>(selected));
 
       if (not light) return;
 
       world::light new_light = *light;
 
-      new_light.name = world::create_unique_name(_world.lights, new_light.name);
+      new_light.name = world::create_unique_name<world::light>(_world, new_light.name);
       new_light.id = world::max_id;
 
       _edit_stack_world
@@ -1135,13 +1191,13 @@ void world_edit::new_entity_from_selection() noexcept
    else if (std::holds_alternative<world::path_id_node_pair>(selected)) {
       auto [id, node_index] = std::get<world::path_id_node_pair>(selected);
 
-      world::path* path = world::find_entity(_world.paths, id);
+      world::path* path = world::find_entity<world::path>(_world, id);
 
       if (not path) return;
 
       world::path new_path = *path;
 
-      new_path.name = world::create_unique_name(_world.paths, new_path.name);
+      new_path.name = world::create_unique_name<world::path>(_world, new_path.name);
       new_path.nodes = {world::path::node{}};
       new_path.id = world::max_id;
 
@@ -1153,13 +1209,13 @@ void world_edit::new_entity_from_selection() noexcept
    }
    else if (std::holds_alternative<world::region_id>(selected)) {
       world::region* region =
-         world::find_entity(_world.regions, std::get<world::region_id>(selected));
+         world::find_entity<world::region>(_world, std::get<world::region_id>(selected));
 
       if (not region) return;
 
       world::region new_region = *region;
 
-      new_region.name = world::create_unique_name(_world.regions, new_region.name);
+      new_region.name = world::create_unique_name<world::region>(_world, new_region.name);
       new_region.id = world::max_id;
 
       _edit_stack_world
@@ -1170,13 +1226,13 @@ void world_edit::new_entity_from_selection() noexcept
    }
    else if (std::holds_alternative<world::sector_id>(selected)) {
       world::sector* sector =
-         world::find_entity(_world.sectors, std::get<world::sector_id>(selected));
+         world::find_entity<world::sector>(_world, std::get<world::sector_id>(selected));
 
       if (not sector) return;
 
       world::sector new_sector = *sector;
 
-      new_sector.name = world::create_unique_name(_world.sectors, new_sector.name);
+      new_sector.name = world::create_unique_name<world::sector>(_world, new_sector.name);
       new_sector.points = {{0.0f, 0.0f}};
       new_sector.id = world::max_id;
 
@@ -1188,13 +1244,13 @@ void world_edit::new_entity_from_selection() noexcept
    }
    else if (std::holds_alternative<world::portal_id>(selected)) {
       world::portal* portal =
-         world::find_entity(_world.portals, std::get<world::portal_id>(selected));
+         world::find_entity<world::portal>(_world, std::get<world::portal_id>(selected));
 
       if (not portal) return;
 
       world::portal new_portal = *portal;
 
-      new_portal.name = world::create_unique_name(_world.portals, new_portal.name);
+      new_portal.name = world::create_unique_name<world::portal>(_world, new_portal.name);
       new_portal.id = world::max_id;
 
       _edit_stack_world
@@ -1205,14 +1261,15 @@ void world_edit::new_entity_from_selection() noexcept
    }
    else if (std::holds_alternative<world::hintnode_id>(selected)) {
       world::hintnode* hintnode =
-         world::find_entity(_world.hintnodes, std::get<world::hintnode_id>(selected));
+         world::find_entity<world::hintnode>(_world,
+                                             std::get<world::hintnode_id>(selected));
 
       if (not hintnode) return;
 
       world::hintnode new_hintnode = *hintnode;
 
       new_hintnode.name =
-         world::create_unique_name(_world.hintnodes, new_hintnode.name);
+         world::create_unique_name<world::hintnode>(_world, new_hintnode.name);
       new_hintnode.id = world::max_id;
 
       _edit_stack_world
@@ -1223,13 +1280,15 @@ void world_edit::new_entity_from_selection() noexcept
    }
    else if (std::holds_alternative<world::barrier_id>(selected)) {
       world::barrier* barrier =
-         world::find_entity(_world.barriers, std::get<world::barrier_id>(selected));
+         world::find_entity<world::barrier>(_world,
+                                            std::get<world::barrier_id>(selected));
 
       if (not barrier) return;
 
       world::barrier new_barrier = *barrier;
 
-      new_barrier.name = world::create_unique_name(_world.barriers, new_barrier.name);
+      new_barrier.name = world::create_unique_name<world::barrier>(_world,
+                                                                   new_barrier.name);
       new_barrier.id = world::max_id;
 
       _edit_stack_world
@@ -1240,14 +1299,14 @@ void world_edit::new_entity_from_selection() noexcept
    }
    else if (std::holds_alternative<world::planning_hub_id>(selected)) {
       world::planning_hub* hub =
-         world::find_entity(_world.planning_hubs,
-                            std::get<world::planning_hub_id>(selected));
+         world::find_entity<world::planning_hub>(
+            _world, std::get<world::planning_hub_id>(selected));
 
       if (not hub) return;
 
       world::planning_hub new_hub = *hub;
 
-      new_hub.name = world::create_unique_name(_world.planning_hubs, new_hub.name);
+      new_hub.name = world::create_unique_name<world::planning_hub>(_world, new_hub.name);
       new_hub.id = world::max_id;
 
       _edit_stack_world
@@ -1259,15 +1318,16 @@ void world_edit::new_entity_from_selection() noexcept
    }
    else if (std::holds_alternative<world::planning_connection_id>(selected)) {
       world::planning_connection* connection =
-         world::find_entity(_world.planning_connections,
-                            std::get<world::planning_connection_id>(selected));
+         world::find_entity<world::planning_connection>(
+            _world, std::get<world::planning_connection_id>(selected));
 
       if (not connection) return;
 
       world::planning_connection new_connection = *connection;
 
       new_connection.name =
-         world::create_unique_name(_world.planning_connections, new_connection.name);
+         world::create_unique_name<world::planning_connection>(_world,
+                                                               new_connection.name);
       new_connection.id = world::max_id;
 
       _edit_stack_world
@@ -1279,14 +1339,15 @@ void world_edit::new_entity_from_selection() noexcept
    }
    else if (std::holds_alternative<world::boundary_id>(selected)) {
       world::boundary* boundary =
-         world::find_entity(_world.boundaries, std::get<world::boundary_id>(selected));
+         world::find_entity<world::boundary>(_world,
+                                             std::get<world::boundary_id>(selected));
 
       if (not boundary) return;
 
       world::boundary new_boundary = *boundary;
 
       new_boundary.name =
-         world::create_unique_name(_world.boundaries, new_boundary.name);
+         world::create_unique_name<world::boundary>(_world, new_boundary.name);
       new_boundary.id = world::max_id;
 
       _edit_stack_world
@@ -1369,7 +1430,11 @@ void world_edit::load_world(std::filesystem::path path) noexcept
    catch (std::exception& e) {
       _stream.write(fmt::format("Failed to load world '{}'! Reason: {}",
                                 path.filename().string(), e.what()));
+
+      return;
    }
+
+   recover_edit_journal();
 }
 
 void world_edit::load_world_with_picker() noexcept
@@ -1404,6 +1469,9 @@ void world_edit::save_world(std::filesystem::path path) noexcept
       world::save_world(path, _world);
 
       _edit_stack_world.clear_modified_flag();
+
+      // The journal is replayed onto the saved world so it restarts with each save.
+      if (path == _world_path) start_edit_journal();
    }
    catch (std::exception& e) {
       auto message =
@@ -1443,6 +1511,8 @@ void world_edit::close_world() noexcept
 {
    ask_to_save_world();
 
+   stop_edit_journal();
+
    _object_classes.clear();
    _world = {};
    _interaction_targets = {};
@@ -1454,6 +1524,9 @@ void world_edit::close_world() noexcept
    _world_path.clear();
 
    _terrain_collision = {};
+   _snapping_index.clear();
+   _object_bboxes.clear();
+   _object_store.clear();
 
    _edit_stack_world.clear();
    _edit_stack_world.clear_modified_flag();
@@ -1464,6 +1537,92 @@ void world_edit::close_world() noexcept
    _window_unsaved_star = false;
 }
 
+void world_edit::start_edit_journal() noexcept
+{
+   stop_edit_journal();
+
+   if (_world_path.empty()) return;
+
+   std::filesystem::path journal_path = _world_path;
+   journal_path += L".journal"sv;
+
+   try {
+      _edit_journal = std::make_unique<edits::journal>(journal_path);
+
+      // Edits made before the journal was started aren't in it, so they can't be
+      // coalesced into.
+      _edit_stack_world.close_last();
+      _edit_stack_world.set_listener(_edit_journal.get());
+   }
+   catch (std::exception& e) {
+      _stream.write(fmt::format("Failed to start edit journal '{}'! Unsaved edits "
+                                "will not be recoverable after a crash. Reason: {}",
+                                journal_path.filename().string(), e.what()));
+   }
+}
+
+void world_edit::stop_edit_journal() noexcept
+{
+   if (not _edit_journal) return;
+
+   _edit_stack_world.set_listener(nullptr);
+   _edit_journal = nullptr;
+
+   std::filesystem::path journal_path = _world_path;
+   journal_path += L".journal"sv;
+
+   std::error_code error;
+
+   std::filesystem::remove(journal_path, error);
+}
+
+void world_edit::recover_edit_journal() noexcept
+{
+   std::filesystem::path journal_path = _world_path;
+   journal_path += L".journal"sv;
+
+   std::vector<std::byte> journal_bytes;
+
+   try {
+      if (std::filesystem::exists(journal_path)) {
+         journal_bytes = io::read_file_to_bytes(journal_path);
+      }
+   }
+   catch (std::exception& e) {
+      _stream.write(fmt::format("Failed to read edit journal '{}'! Reason: {}",
+                                journal_path.filename().string(), e.what()));
+   }
+
+   // Only the header is written until the first edit.
+   const bool has_edits = journal_bytes.size() > sizeof(uint32) * 2;
+
+   const bool recover =
+      has_edits and
+      MessageBoxW(_window, L"The world has unsaved edits from a previous session that did not close cleanly.\n\nRecover them?",
+                  L"Recover Unsaved Edits", MB_YESNO) == IDYES;
+
+   // Start the new journal before replaying so recovered edits are journaled again.
+   start_edit_journal();
+
+   if (not recover) return;
+
+   const edits::journal_replay_result result =
+      edits::replay_journal(journal_bytes, _edit_stack_world, _edit_context);
+
+   _stream.write(fmt::format("Recovered {} edit journal records for '{}'.\n",
+                             result.records, _world_path.filename().string()));
+
+   if (not result.complete) {
+      const std::string message =
+         fmt::format("Only some unsaved edits could be recovered.\n   Reason: {}\n",
+                     result.error);
+
+      _stream.write(message);
+
+      MessageBoxA(_window, message.data(), "Edit Recovery Incomplete", MB_OK);
+   }
+}
+
 void world_edit::enumerate_project_worlds() noexcept
 {
    try {
@@ -1494,7 +1653,7 @@ void world_edit::open_odfs_for_selected() noexcept
       if (not std::holds_alternative<world::object_id>(selected)) continue;
 
       const world::object* object =
-         world::find_entity(_world.objects, std::get<world::object_id>(selected));
+         world::find_entity<world::object>(_world, std::get<world::object_id>(selected));
 
       if (not object) continue;
 
@@ -4,6 +4,7 @@
 #include "async/thread_pool.hpp"
 #include "commands.hpp"
 #include "container/ring_set.hpp"
+#include "edits/journal.hpp"
 #include "edits/stack.hpp"
 #include "gizmo.hpp"
 #include "graphics/camera.hpp"
@@ -14,9 +15,12 @@
 #include "settings/io.hpp"
 #include "settings/settings.hpp"
 #include "utility/command_line.hpp"
+#include "world/object_bbox_cache.hpp"
 #include "world/object_class.hpp"
 #include "world/object_class_library.hpp"
+#include "world/object_store.hpp"
 #include "world/tool_visualizers.hpp"
+#include "world/utility/snapping.hpp"
 #include "world/world.hpp"
 
 #include <chrono>
@@ -109,6 +113,8 @@ private:
 
    void align_selection() noexcept;
 
+   void fill_all_sectors() noexcept;
+
    void new_entity_from_selection() noexcept;
 
    void ask_to_save_world() noexcept;
@@ -127,6 +133,12 @@ private:
 
    void close_world() noexcept;
 
+   void start_edit_journal() noexcept;
+
+   void stop_edit_journal() noexcept;
+
+   void recover_edit_journal() noexcept;
+
    void enumerate_project_worlds() noexcept;
 
    void open_odfs_for_selected() noexcept;
@@ -175,12 +187,16 @@ private:
    world::active_layers _world_layers_draw_mask{true};
    world::active_layers _world_layers_hit_mask{true};
    world::terrain_collision _terrain_collision;
+   world::snapping_index _snapping_index;
+   world::object_bbox_cache _object_bboxes;
+   world::object_store _object_store;
    world::tool_visualizers _tool_visualizers;
 
    edits::stack<world::edit_context> _edit_stack_world;
    world::edit_context _edit_context{.world = _world,
                                      .creation_entity =
                                         _interaction_targets.creation_entity};
+   std::unique_ptr<edits::journal> _edit_journal;
 
    std::unique_ptr<graphics::renderer> _renderer;
    graphics::camera _camera;
@@ -174,6 +174,14 @@ void world_edit::update_ui() noexcept
 
          ImGui::Separator();
 
+         if (ImGui::MenuItem("Auto-Fill All Sectors")) fill_all_sectors();
+
+         if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Refill the objects of every sector in the world.");
+         }
+
+         ImGui::Separator();
+
          if (ImGui::MenuItem("Clear Undo/Redo Stacks")) {
             _clear_edit_stack_confirm_open = true;
          }
@@ -253,7 +261,8 @@ void world_edit::update_ui() noexcept
 
          if (ImGui::MenuItem("Object")) {
             const world::object* base_object =
-               world::find_entity(_world.objects, _last_created_entities.last_object);
+               world::find_entity<world::object>(_world,
+                                                 _last_created_entities.last_object);
 
             world::object new_object;
 
@@ -261,7 +270,7 @@ void world_edit::update_ui() noexcept
                new_object = *base_object;
 
                new_object.name =
-                  world::create_unique_name(_world.objects, base_object->name);
+                  world::create_unique_name<world::object>(_world, base_object->name);
                new_object.layer = creation_layer;
                new_object.id = world::max_id;
             }
@@ -282,7 +291,8 @@ void world_edit::update_ui() noexcept
 
          if (ImGui::MenuItem("Light")) {
             const world::light* base_light =
-               world::find_entity(_world.lights, _last_created_entities.last_light);
+               world::find_entity<world::light>(_world,
+                                                _last_created_entities.last_light);
 
             world::light new_light;
 
@@ -290,7 +300,7 @@ void world_edit::update_ui() noexcept
                new_light = *base_light;
 
                new_light.name =
-                  world::create_unique_name(_world.lights, base_light->name);
+                  world::create_unique_name<world::light>(_world, base_light->name);
                new_light.layer = creation_layer;
                new_light.id = world::max_id;
             }
@@ -309,14 +319,12 @@ void world_edit::update_ui() noexcept
 
          if (ImGui::MenuItem("Path")) {
             const world::path* base_path =
-               world::find_entity(_world.paths, _last_created_entities.last_path);
+               world::find_entity<world::path>(_world, _last_created_entities.last_path);
 
             _edit_stack_world.apply(
                edits::make_creation_entity_set(
-                  world::path{.name = world::create_unique_name(_world.paths,
-                                                                base_path
-                                                                   ? base_path->name
-                                                                   : "Path 0"),
+                  world::path{.name = world::create_unique_name<world::path>(
+                                 _world, base_path ? base_path->name : "Path 0"),
                               .layer = base_path ? base_path->layer : creation_layer,
                               .nodes = {world::path::node{}},
                               .id = world::max_id},
@@ -328,7 +336,8 @@ void world_edit::update_ui() noexcept
 
          if (ImGui::MenuItem("Region")) {
             const world::region* base_region =
-               world::find_entity(_world.regions, _last_created_entities.last_region);
+               world::find_entity<world::region>(_world,
+                                                 _last_created_entities.last_region);
 
             world::region new_region;
 
@@ -336,13 +345,14 @@ void world_edit::update_ui() noexcept
                new_region = *base_region;
 
                new_region.name =
-                  world::create_unique_name(_world.regions, base_region->name);
+                  world::create_unique_name<world::region>(_world, base_region->name);
                new_region.layer = creation_layer;
                new_region.id = world::max_id;
             }
             else {
                new_region =
-                  world::region{.name = world::create_unique_name(_world.lights, "Region0"),
+                  world::region{.name = world::create_unique_name<world::light>(
+                                   _world, "Region0"),
                                 .layer = creation_layer,
                                 .id = world::max_id};
             }
@@ -357,12 +367,13 @@ void world_edit::update_ui() noexcept
 
          if (ImGui::MenuItem("Sector")) {
             const world::sector* base_sector =
-               world::find_entity(_world.sectors, _last_created_entities.last_sector);
+               world::find_entity<world::sector>(_world,
+                                                 _last_created_entities.last_sector);
 
             _edit_stack_world
                .apply(edits::make_creation_entity_set(
-                         world::sector{.name = world::create_unique_name(
-                                          _world.sectors,
+                         world::sector{.name = world::create_unique_name<world::sector>(
+                                          _world,
                                           base_sector ? base_sector->name : "Sector0"),
                                        .base = 0.0f,
                                        .height = 10.0f,
@@ -376,7 +387,8 @@ void world_edit::update_ui() noexcept
 
          if (ImGui::MenuItem("Portal")) {
             const world::portal* base_portal =
-               world::find_entity(_world.portals, _last_created_entities.last_portal);
+               world::find_entity<world::portal>(_world,
+                                                 _last_created_entities.last_portal);
 
             world::portal new_portal;
 
@@ -384,7 +396,7 @@ void world_edit::update_ui() noexcept
                new_portal = *base_portal;
 
                new_portal.name =
-                  world::create_unique_name(_world.portals, base_portal->name);
+                  world::create_unique_name<world::portal>(_world, base_portal->name);
                new_portal.id = world::max_id;
             }
             else {
@@ -401,7 +413,8 @@ void world_edit::update_ui() noexcept
 
          if (ImGui::MenuItem("Hintnode")) {
             const world::hintnode* base_hintnode =
-               world::find_entity(_world.hintnodes, _last_created_entities.last_hintnode);
+               world::find_entity<world::hintnode>(_world,
+                                                   _last_created_entities.last_hintnode);
 
             world::hintnode new_hintnode;
 
@@ -409,7 +422,7 @@ void world_edit::update_ui() noexcept
                new_hintnode = *base_hintnode;
 
                new_hintnode.name =
-                  world::create_unique_name(_world.hintnodes, base_hintnode->name);
+                  world::create_unique_name<world::hintnode>(_world, base_hintnode->name);
                new_hintnode.layer = creation_layer;
                new_hintnode.id = world::max_id;
             }
@@ -429,7 +442,8 @@ void world_edit::update_ui() noexcept
 
          if (ImGui::MenuItem("Barrier")) {
             const world::barrier* base_barrier =
-               world::find_entity(_world.barriers, _last_created_entities.last_barrier);
+               world::find_entity<world::barrier>(_world,
+                                                  _last_created_entities.last_barrier);
 
             world::barrier new_barrier;
 
@@ -437,7 +451,7 @@ void world_edit::update_ui() noexcept
                new_barrier = *base_barrier;
 
                new_barrier.name =
-                  world::create_unique_name(_world.barriers, base_barrier->name);
+                  world::create_unique_name<world::barrier>(_world, base_barrier->name);
                new_barrier.id = world::max_id;
             }
             else {
@@ -454,8 +468,8 @@ void world_edit::update_ui() noexcept
 
          if (ImGui::MenuItem("AI Planning Hub")) {
             const world::planning_hub* base_hub =
-               world::find_entity(_world.planning_hubs,
-                                  _last_created_entities.last_planning_hub);
+               world::find_entity<world::planning_hub>(
+                  _world, _last_created_entities.last_planning_hub);
 
             world::planning_hub new_hub;
 
@@ -463,7 +477,7 @@ void world_edit::update_ui() noexcept
                new_hub = *base_hub;
 
                new_hub.name =
-                  world::create_unique_name(_world.planning_hubs, base_hub->name);
+                  world::create_unique_name<world::planning_hub>(_world, base_hub->name);
                new_hub.id = world::max_id;
             }
             else {
@@ -482,8 +496,8 @@ void world_edit::update_ui() noexcept
          if (ImGui::MenuItem("AI Planning Connection") and
              not _world.planning_hubs.empty()) {
             const world::planning_connection* base_connection =
-               world::find_entity(_world.planning_connections,
-                                  _last_created_entities.last_planning_connection);
+               world::find_entity<world::planning_connection>(
+                  _world, _last_created_entities.last_planning_connection);
 
             world::planning_connection new_connection;
 
@@ -491,8 +505,8 @@ void world_edit::update_ui() noexcept
                new_connection = *base_connection;
 
                new_connection.name =
-                  world::create_unique_name(_world.planning_connections,
-                                            base_connection->name);
+                  world::create_unique_name<world::planning_connection>(
+                     _world, base_connection->name);
                new_connection.id = world::max_id;
             }
             else {
@@ -514,8 +528,8 @@ void world_edit::update_ui() noexcept
 
          if (ImGui::MenuItem("Boundary")) {
             const world::boundary* base_boundary =
-               world::find_entity(_world.boundaries,
-                                  _last_created_entities.last_boundary);
+               world::find_entity<world::boundary>(_world,
+                                                   _last_created_entities.last_boundary);
 
             world::boundary new_boundary;
 
@@ -523,7 +537,7 @@ void world_edit::update_ui() noexcept
                new_boundary = *base_boundary;
 
                new_boundary.name =
-                  world::create_unique_name(_world.boundaries, base_boundary->name);
+                  world::create_unique_name<world::boundary>(_world, base_boundary->name);
                new_boundary.id = world::max_id;
             }
             else {
@@ -928,8 +942,8 @@ void world_edit::update_ui() noexcept
 
             if (std::holds_alternative<world::object_id>(selected)) {
                world::object* object =
-                  world::find_entity(_world.objects,
-                                     std::get<world::object_id>(selected));
+                  world::find_entity<world::object>(_world,
+                                                    std::get<world::object_id>(selected));
 
                if (not object) {
                   ImGui::PopID();
@@ -966,8 +980,8 @@ void world_edit::update_ui() noexcept
                ImGui::InputText("Name", object, &world::object::name, &_edit_stack_world,
                                 &_edit_context, [&](std::string* edited_value) {
                                    *edited_value =
-                                      world::create_unique_name(_world.objects,
-                                                                *edited_value);
+                                      world::create_unique_name<world::object>(
+                                         _world, *edited_value);
                                 });
                ImGui::InputTextAutoComplete(
                   "Class Name", object, &world::object::class_name,
@@ -1167,8 +1181,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::light_id>(selected)) {
                world::light* light =
-                  world::find_entity(_world.lights,
-                                     std::get<world::light_id>(selected));
+                  world::find_entity<world::light>(_world,
+                                                   std::get<world::light_id>(selected));
 
                if (not light) {
                   ImGui::PopID();
@@ -1205,8 +1219,8 @@ void world_edit::update_ui() noexcept
                ImGui::InputText("Name", light, &world::light::name, &_edit_stack_world,
                                 &_edit_context, [&](std::string* edited_value) {
                                    *edited_value =
-                                      world::create_unique_name(_world.lights,
-                                                                *edited_value);
+                                      world::create_unique_name<world::light>(
+                                         _world, *edited_value);
                                 });
                ImGui::LayerPick("Layer", light, &_edit_stack_world, &_edit_context);
 
@@ -1308,9 +1322,9 @@ void world_edit::update_ui() noexcept
                                    &_edit_context, [&](std::string* edited_value) {
                                       *edited_value =
                                          world::create_unique_light_region_name(
-                                            _world.lights, _world.regions,
-                                            edited_value->empty() ? light->name
-                                                                  : *edited_value);
+                                            _world, edited_value->empty()
+                                                       ? light->name
+                                                       : *edited_value);
                                    });
                   ImGui::DragQuat("Region Rotation", light,
                                   &world::light::region_rotation,
@@ -1322,7 +1336,7 @@ void world_edit::update_ui() noexcept
             else if (std::holds_alternative<world::path_id_node_pair>(selected)) {
                auto [id, node_index] = std::get<world::path_id_node_pair>(selected);
 
-               world::path* path = world::find_entity(_world.paths, id);
+               world::path* path = world::find_entity<world::path>(_world, id);
 
                if (not path or node_index >= path->nodes.size()) {
                   ImGui::PopID();
@@ -1359,11 +1373,10 @@ void world_edit::update_ui() noexcept
                ImGui::InputText("Name", path, &world::path::name, &_edit_stack_world,
                                 &_edit_context, [&](std::string* edited_value) {
                                    *edited_value =
-                                      world::create_unique_name(_world.paths,
-                                                                edited_value->empty()
-                                                                   ? "Path 0"sv
-                                                                   : std::string_view{
-                                                                        *edited_value});
+                                      world::create_unique_name<world::path>(
+                                         _world, edited_value->empty()
+                                                    ? "Path 0"sv
+                                                    : std::string_view{*edited_value});
                                 });
                ImGui::LayerPick("Layer", path, &_edit_stack_world, &_edit_context);
 
@@ -1451,8 +1464,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::region_id>(selected)) {
                world::region* region =
-                  world::find_entity(_world.regions,
-                                     std::get<world::region_id>(selected));
+                  world::find_entity<world::region>(_world,
+                                                    std::get<world::region_id>(selected));
 
                if (not region) {
                   ImGui::PopID();
@@ -1489,8 +1502,8 @@ void world_edit::update_ui() noexcept
                ImGui::InputText("Name", region, &world::region::name, &_edit_stack_world,
                                 &_edit_context, [&](std::string* edited_value) {
                                    *edited_value =
-                                      world::create_unique_name(_world.regions,
-                                                                *edited_value);
+                                      world::create_unique_name<world::region>(
+                                         _world, *edited_value);
                                 });
                ImGui::LayerPick("Layer", region, &_edit_stack_world, &_edit_context);
 
@@ -1915,8 +1928,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::sector_id>(selected)) {
                world::sector* sector =
-                  world::find_entity(_world.sectors,
-                                     std::get<world::sector_id>(selected));
+                  world::find_entity<world::sector>(_world,
+                                                    std::get<world::sector_id>(selected));
 
                if (not sector) {
                   ImGui::PopID();
@@ -1953,8 +1966,8 @@ void world_edit::update_ui() noexcept
                ImGui::InputText("Name", sector, &world::sector::name, &_edit_stack_world,
                                 &_edit_context, [&](std::string* edited_value) {
                                    *edited_value =
-                                      world::create_unique_name(_world.sectors,
-                                                                *edited_value);
+                                      world::create_unique_name<world::sector>(
+                                         _world, *edited_value);
                                 });
 
                ImGui::DragFloat("Base", sector, &world::sector::base, &_edit_stack_world,
@@ -1989,8 +2002,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::portal_id>(selected)) {
                world::portal* portal =
-                  world::find_entity(_world.portals,
-                                     std::get<world::portal_id>(selected));
+                  world::find_entity<world::portal>(_world,
+                                                    std::get<world::portal_id>(selected));
 
                if (not portal) {
                   ImGui::PopID();
@@ -2027,8 +2040,8 @@ void world_edit::update_ui() noexcept
                ImGui::InputText("Name", portal, &world::portal::name, &_edit_stack_world,
                                 &_edit_context, [&](std::string* edited_value) {
                                    *edited_value =
-                                      world::create_unique_name(_world.portals,
-                                                                *edited_value);
+                                      world::create_unique_name<world::portal>(
+                                         _world, *edited_value);
                                 });
 
                ImGui::DragFloat("Width", portal, &world::portal::width,
@@ -2083,8 +2096,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::hintnode_id>(selected)) {
                world::hintnode* hintnode =
-                  world::find_entity(_world.hintnodes,
-                                     std::get<world::hintnode_id>(selected));
+                  world::find_entity<world::hintnode>(
+                     _world, std::get<world::hintnode_id>(selected));
 
                if (not hintnode) {
                   ImGui::PopID();
@@ -2122,8 +2135,8 @@ void world_edit::update_ui() noexcept
                                 &_edit_stack_world, &_edit_context,
                                 [&](std::string* edited_value) {
                                    *edited_value =
-                                      world::create_unique_name(_world.hintnodes,
-                                                                *edited_value);
+                                      world::create_unique_name<world::hintnode>(
+                                         _world, *edited_value);
                                 });
                ImGui::LayerPick("Layer", hintnode, &_edit_stack_world, &_edit_context);
 
@@ -2214,8 +2227,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::barrier_id>(selected)) {
                world::barrier* barrier =
-                  world::find_entity(_world.barriers,
-                                     std::get<world::barrier_id>(selected));
+                  world::find_entity<world::barrier>(
+                     _world, std::get<world::barrier_id>(selected));
 
                if (not barrier) {
                   ImGui::PopID();
@@ -2253,8 +2266,8 @@ void world_edit::update_ui() noexcept
                                 &_edit_stack_world, &_edit_context,
                                 [&](std::string* edited_value) {
                                    *edited_value =
-                                      world::create_unique_name(_world.barriers,
-                                                                *edited_value);
+                                      world::create_unique_name<world::barrier>(
+                                         _world, *edited_value);
                                 });
 
                ImGui::DragBarrierRotation("Rotation", barrier,
@@ -2278,8 +2291,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::planning_hub_id>(selected)) {
                world::planning_hub* hub =
-                  world::find_entity(_world.planning_hubs,
-                                     std::get<world::planning_hub_id>(selected));
+                  world::find_entity<world::planning_hub>(
+                     _world, std::get<world::planning_hub_id>(selected));
 
                if (not hub) {
                   ImGui::PopID();
@@ -2317,8 +2330,8 @@ void world_edit::update_ui() noexcept
                                 &_edit_stack_world, &_edit_context,
                                 [&](std::string* edited_value) {
                                    *edited_value =
-                                      world::create_unique_name(_world.planning_hubs,
-                                                                *edited_value);
+                                      world::create_unique_name<world::planning_hub>(
+                                         _world, *edited_value);
                                 });
 
                ImGui::DragFloat3("Position", hub, &world::planning_hub::position,
@@ -2329,8 +2342,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::planning_connection_id>(selected)) {
                world::planning_connection* connection =
-                  world::find_entity(_world.planning_connections,
-                                     std::get<world::planning_connection_id>(selected));
+                  world::find_entity<world::planning_connection>(
+                     _world, std::get<world::planning_connection_id>(selected));
 
                if (not connection) {
                   ImGui::PopID();
@@ -2368,20 +2381,19 @@ void world_edit::update_ui() noexcept
                                 &world::planning_connection::name, &_edit_stack_world,
                                 &_edit_context, [&](std::string* edited_value) {
                                    *edited_value =
-                                      world::create_unique_name(_world.planning_connections,
-                                                                *edited_value);
+                                      world::create_unique_name<
+                                         world::planning_connection>(_world,
+                                                                     *edited_value);
                                 });
 
-               ImGui::Text(
-                  "Start: %s",
-                  _world
-                     .planning_hubs[_world.planning_hub_index.at(connection->start)]
-                     .name.c_str());
-               ImGui::Text(
-                  "End: %s",
-                  _world
-                     .planning_hubs[_world.planning_hub_index.at(connection->end)]
-                     .name.c_str());
+               ImGui::Text("Start: %s",
+                           world::find_entity<world::planning_hub>(_world,
+                                                                   connection->start)
+                              ->name.c_str());
+               ImGui::Text("End: %s",
+                           world::find_entity<world::planning_hub>(_world,
+                                                                   connection->end)
+                              ->name.c_str());
 
                ImGui::EditFlags("Flags", connection, &world::planning_connection::flags,
                                 &_edit_stack_world, &_edit_context,
@@ -2479,8 +2491,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::boundary_id>(selected)) {
                world::boundary* boundary =
-                  world::find_entity(_world.boundaries,
-                                     std::get<world::boundary_id>(selected));
+                  world::find_entity<world::boundary>(
+                     _world, std::get<world::boundary_id>(selected));
 
                if (not boundary) {
                   ImGui::PopID();
@@ -2518,8 +2530,8 @@ void world_edit::update_ui() noexcept
                                 &_edit_stack_world, &_edit_context,
                                 [&](std::string* edited_value) {
                                    *edited_value =
-                                      world::create_unique_name(_world.boundaries,
-                                                                *edited_value);
+                                      world::create_unique_name<world::boundary>(
+                                         _world, *edited_value);
                                 });
 
                ImGui::DragFloat2XZ("Position", boundary, &world::boundary::position,
@@ -2671,7 +2683,8 @@ void world_edit::update_ui() noexcept
                           &_edit_stack_world, &_edit_context,
                           [&](std::string* edited_value) {
                              *edited_value =
-                                world::create_unique_name(_world.objects, *edited_value);
+                                world::create_unique_name<world::object>(_world,
+                                                                         *edited_value);
                           });
 
          ImGui::InputTextAutoComplete(
@@ -2796,7 +2809,7 @@ void world_edit::update_ui() noexcept
                else if (_entity_creation_config.placement_alignment ==
                         placement_alignment::snapping) {
                   const std::optional<float3> snapped_position =
-                     world::get_snapped_position(object, new_position, _world.objects,
+                     world::get_snapped_position(object, new_position, _snapping_index,
                                                  _entity_creation_config.snap_distance,
                                                  _object_classes);
 
@@ -2852,7 +2865,8 @@ void world_edit::update_ui() noexcept
                           &_edit_stack_world, &_edit_context,
                           [&](std::string* edited_value) {
                              *edited_value =
-                                world::create_unique_name(_world.lights, *edited_value);
+                                world::create_unique_name<world::light>(_world,
+                                                                        *edited_value);
                           });
 
          ImGui::LayerPick<world::light>("Layer", &creation_entity,
@@ -2907,9 +2921,8 @@ void world_edit::update_ui() noexcept
                else if (_entity_creation_config.placement_alignment ==
                         placement_alignment::snapping) {
                   const std::optional<float3> snapped_position =
-                     world::get_snapped_position(new_position, _world.objects,
-                                                 _entity_creation_config.snap_distance,
-                                                 _object_classes);
+                     world::get_snapped_position(new_position, _snapping_index,
+                                                 _entity_creation_config.snap_distance);
 
                   if (snapped_position) new_position = *snapped_position;
                }
@@ -3047,8 +3060,7 @@ void world_edit::update_ui() noexcept
                              &world::light::region_name, &_edit_stack_world,
                              &_edit_context, [&](std::string* edited_value) {
                                 *edited_value = world::create_unique_light_region_name(
-                                   _world.lights, _world.regions,
-                                   edited_value->empty() ? light.name : *edited_value);
+                                   _world, edited_value->empty() ? light.name : *edited_value);
                              });
 
             if (_entity_creation_config.placement_rotation !=
@@ -3074,7 +3086,7 @@ void world_edit::update_ui() noexcept
          const world::path& path = std::get<world::path>(creation_entity);
 
          const world::path* existing_path =
-            world::find_entity(_world.paths, path.name);
+            world::find_entity<world::path>(_world, path.name);
 
          if (existing_path) {
             ImGui::LabelText("Name", existing_path->name.c_str());
@@ -3120,11 +3132,10 @@ void world_edit::update_ui() noexcept
                              &_edit_stack_world, &_edit_context,
                              [&](std::string* edited_value) {
                                 *edited_value =
-                                   world::create_unique_name(_world.paths,
-                                                             edited_value->empty()
-                                                                ? "Path 0"sv
-                                                                : std::string_view{
-                                                                     *edited_value});
+                                   world::create_unique_name<world::path>(
+                                      _world, edited_value->empty()
+                                                 ? "Path 0"sv
+                                                 : std::string_view{*edited_value});
                              });
 
             ImGui::LayerPick<world::path>("Layer", &creation_entity,
@@ -3199,9 +3210,8 @@ void world_edit::update_ui() noexcept
                else if (_entity_creation_config.placement_alignment ==
                         placement_alignment::snapping) {
                   const std::optional<float3> snapped_position =
-                     world::get_snapped_position(new_position, _world.objects,
-                                                 _entity_creation_config.snap_distance,
-                                                 _object_classes);
+                     world::get_snapped_position(new_position, _snapping_index,
+                                                 _entity_creation_config.snap_distance);
 
                   if (snapped_position) new_position = *snapped_position;
                }
@@ -3291,8 +3301,8 @@ void world_edit::update_ui() noexcept
 
             _edit_stack_world.apply(edits::make_set_creation_value(
                                        &world::path::name,
-                                       world::create_unique_name(_world.paths,
-                                                                 path.name),
+                                       world::create_unique_name<world::path>(_world,
+                                                                              path.name),
                                        path.name),
                                     _edit_context);
          }
@@ -3310,7 +3320,8 @@ void world_edit::update_ui() noexcept
                           &_edit_stack_world, &_edit_context,
                           [&](std::string* edited_value) {
                              *edited_value =
-                                world::create_unique_name(_world.regions, *edited_value);
+                                world::create_unique_name<world::region>(_world,
+                                                                         *edited_value);
                           });
 
          ImGui::LayerPick<world::region>("Layer", &creation_entity,
@@ -3787,9 +3798,8 @@ void world_edit::update_ui() noexcept
                else if (_entity_creation_config.placement_alignment ==
                         placement_alignment::snapping) {
                   const std::optional<float3> snapped_position =
-                     world::get_snapped_position(new_position, _world.objects,
-                                                 _entity_creation_config.snap_distance,
-                                                 _object_classes);
+                     world::get_snapped_position(new_position, _snapping_index,
+                                                 _entity_creation_config.snap_distance);
 
                   if (snapped_position) new_position = *snapped_position;
                }
@@ -3987,9 +3997,8 @@ void world_edit::update_ui() noexcept
             _entity_creation_config.placement_mode = placement_mode::manual;
 
             const world::object* object =
-               world::find_entity(_world.objects,
-                                  std::get<world::object_id>(
-                                     *_interaction_targets.hovered_entity));
+               world::find_entity<world::object>(
+                  _world, std::get<world::object_id>(*_interaction_targets.hovered_entity));
 
             if (object) {
                math::bounding_box bbox =
@@ -4016,7 +4025,8 @@ void world_edit::update_ui() noexcept
                           &_edit_stack_world, &_edit_context,
                           [&](std::string* edited_value) {
                              *edited_value =
-                                world::create_unique_name(_world.sectors, *edited_value);
+                                world::create_unique_name<world::sector>(_world,
+                                                                         *edited_value);
                           });
 
          ImGui::DragFloat("Base", &creation_entity, &world::sector::base,
@@ -4067,8 +4077,8 @@ void world_edit::update_ui() noexcept
 
             _edit_stack_world.apply(edits::make_set_creation_value(
                                        &world::sector::name,
-                                       world::create_unique_name(_world.sectors,
-                                                                 sector.name),
+                                       world::create_unique_name<world::sector>(
+                                          _world, sector.name),
                                        sector.name),
                                     _edit_context);
          }
@@ -4091,7 +4101,7 @@ void world_edit::update_ui() noexcept
          }
 
          if (const world::sector* existing_sector =
-                world::find_entity(_world.sectors, sector.name);
+                world::find_entity<world::sector>(_world, sector.name);
              existing_sector and not existing_sector->points.empty()) {
             const float2 start_point = existing_sector->points.back();
             const float2 mid_point = sector.points[0];
@@ -4133,7 +4143,8 @@ void world_edit::update_ui() noexcept
                           &_edit_stack_world, &_edit_context,
                           [&](std::string* edited_value) {
                              *edited_value =
-                                world::create_unique_name(_world.portals, *edited_value);
+                                world::create_unique_name<world::portal>(_world,
+                                                                         *edited_value);
                           });
 
          ImGui::DragFloat("Width", &creation_entity, &world::portal::width,
@@ -4195,8 +4206,8 @@ void world_edit::update_ui() noexcept
              _interaction_targets.hovered_entity and
              std::holds_alternative<world::sector_id>(*_interaction_targets.hovered_entity)) {
             const world::sector* sector =
-               find_entity(_world.sectors, std::get<world::sector_id>(
-                                              *_interaction_targets.hovered_entity));
+               find_entity<world::sector>(
+                  _world, std::get<world::sector_id>(*_interaction_targets.hovered_entity));
 
             if (sector) {
                std::string world::portal::*sector_member = nullptr;
@@ -4364,8 +4375,8 @@ void world_edit::update_ui() noexcept
                           &_edit_stack_world, &_edit_context,
                           [&](std::string* edited_value) {
                              *edited_value =
-                                world::create_unique_name(_world.hintnodes,
-                                                          *edited_value);
+                                world::create_unique_name<world::hintnode>(_world,
+                                                                           *edited_value);
                           });
 
          ImGui::LayerPick<world::hintnode>("Layer", &creation_entity,
@@ -4421,9 +4432,8 @@ void world_edit::update_ui() noexcept
                else if (_entity_creation_config.placement_alignment ==
                         placement_alignment::snapping) {
                   const std::optional<float3> snapped_position =
-                     world::get_snapped_position(new_position, _world.objects,
-                                                 _entity_creation_config.snap_distance,
-                                                 _object_classes);
+                     world::get_snapped_position(new_position, _snapping_index,
+                                                 _entity_creation_config.snap_distance);
 
                   if (snapped_position) new_position = *snapped_position;
                }
@@ -4554,7 +4564,8 @@ void world_edit::update_ui() noexcept
                           &_edit_stack_world, &_edit_context,
                           [&](std::string* edited_value) {
                              *edited_value =
-                                world::create_unique_name(_world.barriers, *edited_value);
+                                world::create_unique_name<world::barrier>(_world,
+                                                                          *edited_value);
                           });
 
          ImGui::DragBarrierRotation("Rotation", &creation_entity,
@@ -4583,9 +4594,8 @@ void world_edit::update_ui() noexcept
                else if (_entity_creation_config.placement_alignment ==
                         placement_alignment::snapping) {
                   const std::optional<float3> snapped_position =
-                     world::get_snapped_position(new_position, _world.objects,
-                                                 _entity_creation_config.snap_distance,
-                                                 _object_classes);
+                     world::get_snapped_position(new_position, _snapping_index,
+                                                 _entity_creation_config.snap_distance);
 
                   if (snapped_position) {
                      new_position = *snapped_position;
@@ -4753,9 +4763,8 @@ void world_edit::update_ui() noexcept
             _entity_creation_config.placement_mode = placement_mode::manual;
 
             const world::object* object =
-               world::find_entity(_world.objects,
-                                  std::get<world::object_id>(
-                                     *_interaction_targets.hovered_entity));
+               world::find_entity<world::object>(
+                  _world, std::get<world::object_id>(*_interaction_targets.hovered_entity));
 
             if (object) {
                math::bounding_box bbox =
@@ -4952,8 +4961,8 @@ void world_edit::update_ui() noexcept
                           &_edit_stack_world, &_edit_context,
                           [&](std::string* edited_value) {
                              *edited_value =
-                                world::create_unique_name(_world.planning_hubs,
-                                                          *edited_value);
+                                world::create_unique_name<world::planning_hub>(
+                                   _world, *edited_value);
                           });
 
          if (ImGui::DragFloat3("Position", &creation_entity, &world::planning_hub::position,
@@ -4980,9 +4989,8 @@ void world_edit::update_ui() noexcept
                      world::get_snapped_position({new_position.x,
                                                   _cursor_positionWS.y,
                                                   new_position.y},
-                                                 _world.objects,
-                                                 _entity_creation_config.snap_distance,
-                                                 _object_classes);
+                                                 _snapping_index,
+                                                 _entity_creation_config.snap_distance);
 
                   if (snapped_position) {
                      new_position = *snapped_position;
@@ -5039,18 +5047,16 @@ void world_edit::update_ui() noexcept
                           &world::planning_connection::name, &_edit_stack_world,
                           &_edit_context, [&](std::string* edited_value) {
                              *edited_value =
-                                world::create_unique_name(_world.planning_connections,
-                                                          *edited_value);
+                                world::create_unique_name<world::planning_connection>(
+                                   _world, *edited_value);
                           });
 
          ImGui::Text("Start: %s",
-                     _world
-                        .planning_hubs[_world.planning_hub_index.at(connection.start)]
-                        .name.c_str());
+                     world::find_entity<world::planning_hub>(_world, connection.start)
+                        ->name.c_str());
          ImGui::Text("End: %s",
-                     _world
-                        .planning_hubs[_world.planning_hub_index.at(connection.end)]
-                        .name.c_str());
+                     world::find_entity<world::planning_hub>(_world, connection.end)
+                        ->name.c_str());
 
          if (_entity_creation_context.connection_link_started and
              _interaction_targets.hovered_entity and
@@ -5170,8 +5176,8 @@ void world_edit::update_ui() noexcept
                           &_edit_stack_world, &_edit_context,
                           [&](std::string* edited_value) {
                              *edited_value =
-                                world::create_unique_name(_world.boundaries,
-                                                          *edited_value);
+                                world::create_unique_name<world::boundary>(_world,
+                                                                           *edited_value);
                           });
 
          if (ImGui::DragFloat2XZ("Position", &creation_entity, &world::boundary::position,
@@ -5198,9 +5204,8 @@ void world_edit::update_ui() noexcept
                      world::get_snapped_position({new_position.x,
                                                   _cursor_positionWS.y,
                                                   new_position.y},
-                                                 _world.objects,
-                                                 _entity_creation_config.snap_distance,
-                                                 _object_classes);
+                                                 _snapping_index,
+                                                 _entity_creation_config.snap_distance);
 
                   if (snapped_position) {
                      new_position = {snapped_position->x, snapped_position->z};
@@ -6617,14 +6622,12 @@ void world_edit::update_ui() noexcept
                   const bool hover_entity = ImGui::IsItemHovered();
                   ImGui::TableNextColumn();
                   ImGui::Text(
-                     _world
-                        .planning_hubs[_world.planning_hub_index.at(connection.start)]
-                        .name.c_str());
+                     world::find_entity<world::planning_hub>(_world, connection.start)
+                        ->name.c_str());
                   ImGui::TableNextColumn();
                   ImGui::Text(
-                     _world
-                        .planning_hubs[_world.planning_hub_index.at(connection.end)]
-                        .name.c_str());
+                     world::find_entity<world::planning_hub>(_world, connection.end)
+                        ->name.c_str());
                   ImGui::TableNextColumn();
                   ImGui::Text(soldier ? "X" : "-");
                   ImGui::TableNextColumn();
@@ -6816,7 +6819,8 @@ void world_edit::update_ui() noexcept
    }
 
    if (_settings_editor_open) {
-      settings::show_imgui_editor(_settings, _settings_editor_open, _display_scale);
+      settings::show_imgui_editor(_settings, _settings_editor_open, _display_scale,
+                                  _edit_stack_world.memory_use());
 
       if (not _settings_editor_open) {
          settings::save(".settings", _settings);
@@ -6840,8 +6844,8 @@ void world_edit::update_ui() noexcept
          for (const auto& selected : _interaction_targets.selection) {
             if (std::holds_alternative<world::object_id>(selected)) {
                const world::object* object =
-                  world::find_entity(_world.objects,
-                                     std::get<world::object_id>(selected));
+                  world::find_entity<world::object>(_world,
+                                                    std::get<world::object_id>(selected));
 
                if (object) {
                   if (_gizmo_object_placement == gizmo_object_placement::position) {
@@ -6863,7 +6867,7 @@ void world_edit::update_ui() noexcept
                const auto [id, node_index] =
                   std::get<world::path_id_node_pair>(selected);
 
-               const world::path* path = world::find_entity(_world.paths, id);
+               const world::path* path = world::find_entity<world::path>(_world, id);
 
                if (path) {
                   const world::path::node& node = path->nodes[node_index];
@@ -6874,8 +6878,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::light_id>(selected)) {
                const world::light* light =
-                  world::find_entity(_world.lights,
-                                     std::get<world::light_id>(selected));
+                  world::find_entity<world::light>(_world,
+                                                   std::get<world::light_id>(selected));
 
                if (light) {
                   selection_centre += light->position;
@@ -6884,8 +6888,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::region_id>(selected)) {
                const world::region* region =
-                  world::find_entity(_world.regions,
-                                     std::get<world::region_id>(selected));
+                  world::find_entity<world::region>(_world,
+                                                    std::get<world::region_id>(selected));
 
                if (region) {
                   selection_centre += region->position;
@@ -6894,8 +6898,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::sector_id>(selected)) {
                const world::sector* sector =
-                  world::find_entity(_world.sectors,
-                                     std::get<world::sector_id>(selected));
+                  world::find_entity<world::sector>(_world,
+                                                    std::get<world::sector_id>(selected));
 
                if (sector) {
                   for (auto& point : sector->points) {
@@ -6906,8 +6910,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::portal_id>(selected)) {
                const world::portal* portal =
-                  world::find_entity(_world.portals,
-                                     std::get<world::portal_id>(selected));
+                  world::find_entity<world::portal>(_world,
+                                                    std::get<world::portal_id>(selected));
 
                if (portal) {
                   selection_centre += portal->position;
@@ -6916,8 +6920,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::hintnode_id>(selected)) {
                const world::hintnode* hintnode =
-                  world::find_entity(_world.hintnodes,
-                                     std::get<world::hintnode_id>(selected));
+                  world::find_entity<world::hintnode>(
+                     _world, std::get<world::hintnode_id>(selected));
 
                if (hintnode) {
                   selection_centre += hintnode->position;
@@ -6926,8 +6930,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::barrier_id>(selected)) {
                const world::barrier* barrier =
-                  world::find_entity(_world.barriers,
-                                     std::get<world::barrier_id>(selected));
+                  world::find_entity<world::barrier>(
+                     _world, std::get<world::barrier_id>(selected));
 
                if (barrier) {
                   selection_centre += barrier->position;
@@ -6936,8 +6940,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::planning_hub_id>(selected)) {
                const world::planning_hub* planning_hub =
-                  world::find_entity(_world.planning_hubs,
-                                     std::get<world::planning_hub_id>(selected));
+                  world::find_entity<world::planning_hub>(
+                     _world, std::get<world::planning_hub_id>(selected));
 
                if (planning_hub) {
                   selection_centre += planning_hub->position;
@@ -6946,8 +6950,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::boundary_id>(selected)) {
                const world::boundary* boundary =
-                  world::find_entity(_world.boundaries,
-                                     std::get<world::boundary_id>(selected));
+                  world::find_entity<world::boundary>(
+                     _world, std::get<world::boundary_id>(selected));
 
                if (boundary) {
                   selection_centre +=
@@ -6973,24 +6977,27 @@ void world_edit::update_ui() noexcept
 
             edits::bundle_vector bundled_edits;
 
+            std::vector<world::object_id> object_ids;
+            std::vector<float3> new_object_positions;
+            std::vector<float3> object_positions;
+
             for (const auto& selected : _interaction_targets.selection) {
                if (std::holds_alternative<world::object_id>(selected)) {
                   const world::object* object =
-                     world::find_entity(_world.objects,
-                                        std::get<world::object_id>(selected));
+                     world::find_entity<world::object>(
+                        _world, std::get<world::object_id>(selected));
 
                   if (object) {
-                     bundled_edits.push_back(
-                        edits::make_set_value(object->id, &world::object::position,
-                                              object->position + move_delta,
-                                              object->position));
+                     object_ids.push_back(object->id);
+                     new_object_positions.push_back(object->position + move_delta);
+                     object_positions.push_back(object->position);
                   }
                }
                else if (std::holds_alternative<world::path_id_node_pair>(selected)) {
                   const auto [id, node_index] =
                      std::get<world::path_id_node_pair>(selected);
 
-                  const world::path* path = world::find_entity(_world.paths, id);
+                  const world::path* path = world::find_entity<world::path>(_world, id);
 
                   if (path) {
                      const world::path::node& node = path->nodes[node_index];
@@ -7004,8 +7011,8 @@ void world_edit::update_ui() noexcept
                }
                else if (std::holds_alternative<world::light_id>(selected)) {
                   const world::light* light =
-                     world::find_entity(_world.lights,
-                                        std::get<world::light_id>(selected));
+                     world::find_entity<world::light>(
+                        _world, std::get<world::light_id>(selected));
 
                   if (light) {
                      bundled_edits.push_back(
@@ -7016,8 +7023,8 @@ void world_edit::update_ui() noexcept
                }
                else if (std::holds_alternative<world::region_id>(selected)) {
                   const world::region* region =
-                     world::find_entity(_world.regions,
-                                        std::get<world::region_id>(selected));
+                     world::find_entity<world::region>(
+                        _world, std::get<world::region_id>(selected));
 
                   if (region) {
                      bundled_edits.push_back(
@@ -7028,8 +7035,8 @@ void world_edit::update_ui() noexcept
                }
                else if (std::holds_alternative<world::sector_id>(selected)) {
                   const world::sector* sector =
-                     world::find_entity(_world.sectors,
-                                        std::get<world::sector_id>(selected));
+                     world::find_entity<world::sector>(
+                        _world, std::get<world::sector_id>(selected));
 
                   if (sector) {
                      std::vector<float2> new_points = sector->points;
@@ -7045,8 +7052,8 @@ void world_edit::update_ui() noexcept
                }
                else if (std::holds_alternative<world::portal_id>(selected)) {
                   const world::portal* portal =
-                     world::find_entity(_world.portals,
-                                        std::get<world::portal_id>(selected));
+                     world::find_entity<world::portal>(
+                        _world, std::get<world::portal_id>(selected));
 
                   if (portal) {
                      bundled_edits.push_back(
@@ -7057,8 +7064,8 @@ void world_edit::update_ui() noexcept
                }
                else if (std::holds_alternative<world::hintnode_id>(selected)) {
                   const world::hintnode* hintnode =
-                     world::find_entity(_world.hintnodes,
-                                        std::get<world::hintnode_id>(selected));
+                     world::find_entity<world::hintnode>(
+                        _world, std::get<world::hintnode_id>(selected));
 
                   if (hintnode) {
                      bundled_edits.push_back(
@@ -7069,8 +7076,8 @@ void world_edit::update_ui() noexcept
                }
                else if (std::holds_alternative<world::barrier_id>(selected)) {
                   const world::barrier* barrier =
-                     world::find_entity(_world.barriers,
-                                        std::get<world::barrier_id>(selected));
+                     world::find_entity<world::barrier>(
+                        _world, std::get<world::barrier_id>(selected));
 
                   if (barrier) {
                      bundled_edits.push_back(
@@ -7081,8 +7088,8 @@ void world_edit::update_ui() noexcept
                }
                else if (std::holds_alternative<world::planning_hub_id>(selected)) {
                   const world::planning_hub* planning_hub =
-                     world::find_entity(_world.planning_hubs,
-                                        std::get<world::planning_hub_id>(selected));
+                     world::find_entity<world::planning_hub>(
+                        _world, std::get<world::planning_hub_id>(selected));
 
                   if (planning_hub) {
                      bundled_edits.push_back(
@@ -7094,8 +7101,8 @@ void world_edit::update_ui() noexcept
                }
                else if (std::holds_alternative<world::boundary_id>(selected)) {
                   const world::boundary* boundary =
-                     world::find_entity(_world.boundaries,
-                                        std::get<world::boundary_id>(selected));
+                     world::find_entity<world::boundary>(
+                        _world, std::get<world::boundary_id>(selected));
 
                   if (boundary) {
                      bundled_edits.push_back(
@@ -7107,6 +7114,13 @@ void world_edit::update_ui() noexcept
                }
             }
 
+            if (not object_ids.empty()) {
+               bundled_edits.push_back(
+                  edits::make_set_values(std::move(object_ids), &world::object::position,
+                                         std::move(new_object_positions),
+                                         std::move(object_positions)));
+            }
+
             if (bundled_edits.size() == 1) {
                _edit_stack_world.apply(std::move(bundled_edits.back()), _edit_context);
             }
@@ -7163,7 +7177,7 @@ void world_edit::update_ui() noexcept
          float3 path_centre = {0.0f, 0.0f, 0.0f};
 
          if (const world::path* path =
-                world::find_entity(_world.paths, _move_entire_path_id);
+                world::find_entity<world::path>(_world, _move_entire_path_id);
              path) {
             for (std::size_t i = 0; i < path->nodes.size(); ++i) {
                const world::path::node& node = path->nodes[i];
@@ -7188,7 +7202,7 @@ void world_edit::update_ui() noexcept
             const float3 move_delta = (_move_selection_amount - last_move_amount);
 
             const world::path* path =
-               world::find_entity(_world.paths, _move_entire_path_id);
+               world::find_entity<world::path>(_world, _move_entire_path_id);
 
             if (path) {
                edits::bundle_vector bundled_edits;
@@ -7243,8 +7257,8 @@ void world_edit::update_ui() noexcept
          for (const auto& selected : _interaction_targets.selection) {
             if (std::holds_alternative<world::object_id>(selected)) {
                const world::object* object =
-                  world::find_entity(_world.objects,
-                                     std::get<world::object_id>(selected));
+                  world::find_entity<world::object>(_world,
+                                                    std::get<world::object_id>(selected));
 
                if (object) {
                   selection_centre += object->position;
@@ -7255,7 +7269,7 @@ void world_edit::update_ui() noexcept
                const auto [id, node_index] =
                   std::get<world::path_id_node_pair>(selected);
 
-               const world::path* path = world::find_entity(_world.paths, id);
+               const world::path* path = world::find_entity<world::path>(_world, id);
 
                if (path) {
                   const world::path::node& node = path->nodes[node_index];
@@ -7266,8 +7280,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::light_id>(selected)) {
                const world::light* light =
-                  world::find_entity(_world.lights,
-                                     std::get<world::light_id>(selected));
+                  world::find_entity<world::light>(_world,
+                                                   std::get<world::light_id>(selected));
 
                if (light) {
                   selection_centre += light->position;
@@ -7276,8 +7290,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::region_id>(selected)) {
                const world::region* region =
-                  world::find_entity(_world.regions,
-                                     std::get<world::region_id>(selected));
+                  world::find_entity<world::region>(_world,
+                                                    std::get<world::region_id>(selected));
 
                if (region) {
                   selection_centre += region->position;
@@ -7286,8 +7300,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::sector_id>(selected)) {
                const world::sector* sector =
-                  world::find_entity(_world.sectors,
-                                     std::get<world::sector_id>(selected));
+                  world::find_entity<world::sector>(_world,
+                                                    std::get<world::sector_id>(selected));
 
                if (sector) {
                   for (auto& point : sector->points) {
@@ -7298,8 +7312,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::portal_id>(selected)) {
                const world::portal* portal =
-                  world::find_entity(_world.portals,
-                                     std::get<world::portal_id>(selected));
+                  world::find_entity<world::portal>(_world,
+                                                    std::get<world::portal_id>(selected));
 
                if (portal) {
                   selection_centre += portal->position;
@@ -7308,8 +7322,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::hintnode_id>(selected)) {
                const world::hintnode* hintnode =
-                  world::find_entity(_world.hintnodes,
-                                     std::get<world::hintnode_id>(selected));
+                  world::find_entity<world::hintnode>(
+                     _world, std::get<world::hintnode_id>(selected));
 
                if (hintnode) {
                   selection_centre += hintnode->position;
@@ -7318,8 +7332,8 @@ void world_edit::update_ui() noexcept
             }
             else if (std::holds_alternative<world::barrier_id>(selected)) {
                const world::barrier* barrier =
-                  world::find_entity(_world.barriers,
-                                     std::get<world::barrier_id>(selected));
+                  world::find_entity<world::barrier>(
+                     _world, std::get<world::barrier_id>(selected));
 
                if (barrier) {
                   selection_centre += barrier->position;
@@ -7355,23 +7369,26 @@ void world_edit::update_ui() noexcept
 
             edits::bundle_vector bundled_edits;
 
+            std::vector<world::object_id> object_ids;
+            std::vector<quaternion> new_object_rotations;
+            std::vector<quaternion> object_rotations;
+
             for (const auto& selected : _interaction_targets.selection) {
                if (std::holds_alternative<world::object_id>(selected)) {
                   const world::object* object =
-                     world::find_entity(_world.objects,
-                                        std::get<world::object_id>(selected));
+                     world::find_entity<world::object>(
+                        _world, std::get<world::object_id>(selected));
 
                   if (object) {
-                     bundled_edits.push_back(
-                        edits::make_set_value(object->id, &world::object::rotation,
-                                              object->rotation * rotation,
-                                              object->rotation));
+                     object_ids.push_back(object->id);
+                     new_object_rotations.push_back(object->rotation * rotation);
+                     object_rotations.push_back(object->rotation);
                   }
                }
                else if (std::holds_alternative<world::light_id>(selected)) {
                   const world::light* light =
-                     world::find_entity(_world.lights,
-                                        std::get<world::light_id>(selected));
+                     world::find_entity<world::light>(
+                        _world, std::get<world::light_id>(selected));
 
                   if (light) {
                      bundled_edits.push_back(
@@ -7384,7 +7401,7 @@ void world_edit::update_ui() noexcept
                   const auto [id, node_index] =
                      std::get<world::path_id_node_pair>(selected);
 
-                  const world::path* path = world::find_entity(_world.paths, id);
+                  const world::path* path = world::find_entity<world::path>(_world, id);
 
                   if (path) {
                      const world::path::node& node = path->nodes[node_index];
@@ -7398,8 +7415,8 @@ void world_edit::update_ui() noexcept
                }
                else if (std::holds_alternative<world::region_id>(selected)) {
                   const world::region* region =
-                     world::find_entity(_world.regions,
-                                        std::get<world::region_id>(selected));
+                     world::find_entity<world::region>(
+                        _world, std::get<world::region_id>(selected));
 
                   if (region) {
                      bundled_edits.push_back(
@@ -7410,8 +7427,8 @@ void world_edit::update_ui() noexcept
                }
                else if (std::holds_alternative<world::sector_id>(selected)) {
                   const world::sector* sector =
-                     world::find_entity(_world.sectors,
-                                        std::get<world::sector_id>(selected));
+                     world::find_entity<world::sector>(
+                        _world, std::get<world::sector_id>(selected));
 
                   if (sector) {
                      const quaternion sector_rotation =
@@ -7442,8 +7459,8 @@ void world_edit::update_ui() noexcept
                }
                else if (std::holds_alternative<world::portal_id>(selected)) {
                   const world::portal* portal =
-                     world::find_entity(_world.portals,
-                                        std::get<world::portal_id>(selected));
+                     world::find_entity<world::portal>(
+                        _world, std::get<world::portal_id>(selected));
 
                   if (portal) {
                      bundled_edits.push_back(
@@ -7454,8 +7471,8 @@ void world_edit::update_ui() noexcept
                }
                else if (std::holds_alternative<world::hintnode_id>(selected)) {
                   const world::hintnode* hintnode =
-                     world::find_entity(_world.hintnodes,
-                                        std::get<world::hintnode_id>(selected));
+                     world::find_entity<world::hintnode>(
+                        _world, std::get<world::hintnode_id>(selected));
 
                   if (hintnode) {
                      bundled_edits.push_back(
@@ -7466,8 +7483,8 @@ void world_edit::update_ui() noexcept
                }
                else if (std::holds_alternative<world::barrier_id>(selected)) {
                   const world::barrier* barrier =
-                     world::find_entity(_world.barriers,
-                                        std::get<world::barrier_id>(selected));
+                     world::find_entity<world::barrier>(
+                        _world, std::get<world::barrier_id>(selected));
 
                   if (barrier) {
                      bundled_edits.push_back(
@@ -7479,6 +7496,13 @@ void world_edit::update_ui() noexcept
                }
             }
 
+            if (not object_ids.empty()) {
+               bundled_edits.push_back(
+                  edits::make_set_values(std::move(object_ids), &world::object::rotation,
+                                         std::move(new_object_rotations),
+                                         std::move(object_rotations)));
+            }
+
             if (bundled_edits.size() == 1) {
                _edit_stack_world.apply(std::move(bundled_edits.back()), _edit_context);
             }
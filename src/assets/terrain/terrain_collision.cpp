@@ -1,18 +1,40 @@
 
-
 #include "terrain_collision.hpp"
 #include "math/intersectors.hpp"
 #include "terrain.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 #include <utility>
 #include <vector>
 
-#include <FastBVH.h>
-
 namespace we::assets::terrain {
 
 namespace detail {
 
+namespace {
+
+/// @brief Min and max height of a cell, unscaled.
+struct height_range {
+   int16 min = std::numeric_limits<int16>::max();
+   int16 max = std::numeric_limits<int16>::lowest();
+};
+
+auto combine(const height_range l, const height_range r) noexcept -> height_range
+{
+   return {.min = std::min(l.min, r.min), .max = std::max(l.max, r.max)};
+}
+
+}
+
+/// @brief Ray casting against the terrain using a quadtree of min/max heights.
+///
+/// Level 0 has one cell for each terrain quad, each level above it has half the
+/// resolution of the one below. Because the X and Z bounds of each cell are implied by
+/// its position only the height ranges need storing. This also lets height map edits
+/// be applied by recomputing just the cells over the edited points and their parents.
 class terrain_collision_impl {
 public:
    terrain_collision_impl(const terrain& terrain) noexcept
@@ -20,67 +42,164 @@ public:
       _half_world_length = terrain.length * terrain.grid_scale / 2.0f;
       _grid_scale = terrain.grid_scale;
       _height_scale = terrain.height_scale;
+      _length = static_cast<uint16>(terrain.length);
       _max_length = static_cast<uint16>(terrain.length - 1);
       _terrain = &terrain;
 
-      _indices.clear();
-      _indices.reserve(terrain.length * terrain.length);
+      if (terrain.length <= 0) return;
 
-      for (uint16 z = 0; z < terrain.length; ++z) {
-         for (uint16 x = 0; x < terrain.length; ++x) {
-            _indices.push_back({x, z});
-         }
-      }
+      int32 level_length = terrain.length;
 
-      FastBVH::BuildStrategy<float, 1> build_strategy;
+      while (true) {
+         _levels.emplace_back(level_length, level_length);
 
-      _bvh = build_strategy(_indices, [&](const std::array<uint16, 2>& point) {
-         float3 min{std::numeric_limits<float>::max(),
-                    std::numeric_limits<float>::max(),
-                    std::numeric_limits<float>::max()};
-         float3 max{std::numeric_limits<float>::lowest(),
-                    std::numeric_limits<float>::lowest(),
-                    std::numeric_limits<float>::lowest()};
+         if (level_length == 1) break;
 
-         for (auto& v : get_quad(point[0], point[1])) {
-            min = we::min(v, min);
-            max = we::max(v, max);
-         }
+         level_length = (level_length + 1) / 2;
+      }
 
-         return FastBVH::BBox{FastBVH::Vector3{min.x, min.y, min.z},
-                              FastBVH::Vector3{max.x, max.y, max.z}};
-      });
+      update_region({.left = 0,
+                     .top = 0,
+                     .right = static_cast<uint32>(terrain.length),
+                     .bottom = static_cast<uint32>(terrain.length)});
    }
 
    auto raycast(const float3 ray_origin, const float3 ray_direction) const noexcept
       -> std::optional<ray_hit>
    {
-      if (not _bvh) return std::nullopt;
+      if (_levels.empty()) return std::nullopt;
 
-      FastBVH::Traverser traverser{
-         *_bvh, [&](const std::array<uint16, 2>& point, const FastBVH::Ray<float>& ray) {
-            const std::array<float3, 4> quad = get_quad(point[0], point[1]);
+      const float3 inv_ray_direction = 1.0f / ray_direction;
 
-            float3 intersect = quadIntersect({ray.o.x, ray.o.y, ray.o.z},
-                                             {ray.d.x, ray.d.y, ray.d.z},
-                                             quad[0], quad[1], quad[2], quad[3]);
+      struct traversal {
+         uint8 level;
+         uint16 x;
+         uint16 z;
+         float near;
+      };
 
-            if (intersect.x < 0.0f) {
-               return FastBVH::Intersection<float, std::array<uint16, 2>>{};
+      // Each step pops one cell and pushes at most four, so three slots per level is enough.
+      std::array<traversal, 64> stack;
+      std::size_t stack_size = 0;
+
+      float closest = std::numeric_limits<float>::max();
+
+      {
+         const uint8 top_level = static_cast<uint8>(_levels.size() - 1);
+
+         if (const float near = intersect_cell(ray_origin, inv_ray_direction,
+                                               top_level, 0, 0, closest);
+             near >= 0.0f) {
+            stack[stack_size++] = {.level = top_level, .x = 0, .z = 0, .near = near};
+         }
+      }
+
+      while (stack_size > 0) {
+         const traversal cell = stack[--stack_size];
+
+         if (cell.near >= closest) continue;
+
+         if (cell.level == 0) {
+            const std::array<float3, 4> quad = get_quad(cell.x, cell.z);
+
+            const float3 intersect = quadIntersect(ray_origin, ray_direction, quad[0],
+                                                   quad[1], quad[2], quad[3]);
+
+            if (intersect.x >= 0.0f and intersect.x < closest) {
+               closest = intersect.x;
+            }
+
+            continue;
+         }
+
+         const uint8 child_level = static_cast<uint8>(cell.level - 1);
+         const uint32 child_length = static_cast<uint32>(_levels[child_level].shape()[0]);
+
+         std::array<traversal, 4> children;
+         std::size_t child_count = 0;
+
+         for (uint32 z = cell.z * 2u; z < std::min(cell.z * 2u + 2u, child_length); ++z) {
+            for (uint32 x = cell.x * 2u; x < std::min(cell.x * 2u + 2u, child_length);
+                 ++x) {
+               if (const float near =
+                      intersect_cell(ray_origin, inv_ray_direction, child_level,
+                                     static_cast<uint16>(x), static_cast<uint16>(z), closest);
+                   near >= 0.0f) {
+                  children[child_count++] = {.level = child_level,
+                                             .x = static_cast<uint16>(x),
+                                             .z = static_cast<uint16>(z),
+                                             .near = near};
+               }
             }
+         }
 
-            return FastBVH::Intersection<float, std::array<uint16, 2>>{
-               .t = intersect.x, .object = &point};
-         }};
+         // Push the furthest children first so the nearest are visited first.
+         std::sort(children.begin(), children.begin() + child_count,
+                   [](const traversal& l, const traversal& r) {
+                      return l.near > r.near;
+                   });
 
-      FastBVH::Intersection intersection = traverser.traverse(
-         FastBVH::Ray{FastBVH::Vector3{ray_origin.x, ray_origin.y, ray_origin.z},
-                      FastBVH::Vector3{ray_direction.x, ray_direction.y,
-                                       ray_direction.z}});
+         for (std::size_t i = 0; i < child_count; ++i) {
+            stack[stack_size++] = children[i];
+         }
+      }
 
-      if (not intersection) return std::nullopt;
+      if (closest == std::numeric_limits<float>::max()) return std::nullopt;
 
-      return ray_hit{.distance = intersection.t};
+      return ray_hit{.distance = closest};
+   }
+
+   void update_region(const rect region) noexcept
+   {
+      if (_levels.empty()) return;
+
+      // Quads touch the points at x + 1 and z + 1, so edits to a point also affect the quads before it.
+      uint32 left = std::min(region.left, uint32{_length});
+      uint32 top = std::min(region.top, uint32{_length});
+      uint32 right = std::min(region.right, uint32{_length});
+      uint32 bottom = std::min(region.bottom, uint32{_length});
+
+      if (left >= right or top >= bottom) return;
+
+      left = left > 0 ? left - 1 : 0;
+      top = top > 0 ? top - 1 : 0;
+
+      container::dynamic_array_2d<height_range>& quads = _levels[0];
+
+      for (uint32 z = top; z < bottom; ++z) {
+         for (uint32 x = left; x < right; ++x) {
+            quads[{x, z}] = get_quad_height_range(static_cast<uint16>(x),
+                                                  static_cast<uint16>(z));
+         }
+      }
+
+      for (std::size_t level = 1; level < _levels.size(); ++level) {
+         const container::dynamic_array_2d<height_range>& children = _levels[level - 1];
+         container::dynamic_array_2d<height_range>& cells = _levels[level];
+
+         const uint32 child_length = static_cast<uint32>(children.shape()[0]);
+
+         left /= 2;
+         top /= 2;
+         right = (right + 1) / 2;
+         bottom = (bottom + 1) / 2;
+
+         for (uint32 z = top; z < bottom; ++z) {
+            for (uint32 x = left; x < right; ++x) {
+               height_range range;
+
+               for (uint32 child_z = z * 2; child_z < std::min(z * 2 + 2, child_length);
+                    ++child_z) {
+                  for (uint32 child_x = x * 2;
+                       child_x < std::min(x * 2 + 2, child_length); ++child_x) {
+                     range = combine(range, children[{child_x, child_z}]);
+                  }
+               }
+
+               cells[{x, z}] = range;
+            }
+         }
+      }
    }
 
    auto get_quad(uint16 x, uint16 z) const noexcept -> std::array<float3, 4>
@@ -100,13 +219,88 @@ public:
    }
 
 private:
-   std::optional<FastBVH::BVH<float, std::array<uint16, 2>>> _bvh;
-   std::vector<std::array<uint16, 2>> _indices;
+   auto get_quad_height_range(uint16 x, uint16 z) const noexcept -> height_range
+   {
+      const auto get_height = [&](const uint16 x, const uint16 z) {
+         return _terrain->height_map[{std::clamp(x, uint16{0}, _max_length),
+                                      std::clamp(z, uint16{0}, _max_length)}];
+      };
+
+      const std::array<int16, 4> heights{get_height(x, z), get_height(x + 1, z),
+                                         get_height(x + 1, z + 1),
+                                         get_height(x, z + 1)};
+
+      return {.min = std::ranges::min(heights), .max = std::ranges::max(heights)};
+   }
+
+   /// @brief Intersect a ray with the bounds of a cell.
+   /// @return The distance to the cell along the ray or -1.0f if the ray misses the cell.
+   auto intersect_cell(const float3 ray_origin, const float3 inv_ray_direction,
+                       const uint8 level, const uint16 x, const uint16 z,
+                       const float max_distance) const noexcept -> float
+   {
+      const height_range range = _levels[level][{x, z}];
+
+      const float quad_x_begin = static_cast<float>(x << level);
+      const float quad_x_end =
+         static_cast<float>(std::min((x + 1) << level, static_cast<int>(_length)));
+      const float quad_z_begin = static_cast<float>(z << level);
+      const float quad_z_end =
+         static_cast<float>(std::min((z + 1) << level, static_cast<int>(_length)));
+
+      const float height_min = range.min * _height_scale;
+      const float height_max = range.max * _height_scale;
+
+      const float3 bbox_min = {quad_x_begin * _grid_scale - _half_world_length,
+                               std::min(height_min, height_max),
+                               quad_z_begin * _grid_scale - _half_world_length + _grid_scale};
+      const float3 bbox_max = {quad_x_end * _grid_scale - _half_world_length,
+                               std::max(height_min, height_max),
+                               quad_z_end * _grid_scale - _half_world_length + _grid_scale};
+
+      const auto [near_x, far_x] =
+         intersect_slab(ray_origin.x, inv_ray_direction.x, bbox_min.x, bbox_max.x);
+      const auto [near_y, far_y] =
+         intersect_slab(ray_origin.y, inv_ray_direction.y, bbox_min.y, bbox_max.y);
+      const auto [near_z, far_z] =
+         intersect_slab(ray_origin.z, inv_ray_direction.z, bbox_min.z, bbox_max.z);
+
+      const float near = std::max(std::max(near_x, near_y), std::max(near_z, 0.0f));
+      const float far = std::min(std::min(far_x, far_y), std::min(far_z, max_distance));
+
+      if (near > far) return -1.0f;
+
+      return near;
+   }
+
+   /// @brief Get the range along a ray that is between two planes on an axis.
+   static auto intersect_slab(const float origin, const float inv_direction,
+                              const float min, const float max) noexcept
+      -> std::pair<float, float>
+   {
+      constexpr float inf = std::numeric_limits<float>::infinity();
+
+      // Rays parallel to the slab are either always in it or never in it. Handling
+      // this explicitly also avoids 0 * inf when the origin is on one of the planes.
+      if (std::isinf(inv_direction)) {
+         if (origin < min or origin > max) return {inf, -inf};
+
+         return {-inf, inf};
+      }
+
+      const float t0 = (min - origin) * inv_direction;
+      const float t1 = (max - origin) * inv_direction;
+
+      return {std::min(t0, t1), std::max(t0, t1)};
+   }
+
+   std::vector<container::dynamic_array_2d<height_range>> _levels;
 
    float _half_world_length = 0.0f;
    float _grid_scale = 0.0f;
    float _height_scale = 0.0f;
 
+   uint16 _length = 0;
    uint16 _max_length = 0;
 
    const terrain* _terrain = nullptr;
@@ -137,4 +331,11 @@ auto terrain_collision::raycast(const float3 ray_origin,
    return _impl->raycast(ray_origin, ray_direction);
 }
 
-}
\ No newline at end of file
+void terrain_collision::update_region(const rect region) noexcept
+{
+   if (not _impl) return;
+
+   _impl->update_region(region);
+}
+
+}
@@ -18,6 +18,14 @@ struct ray_hit {
    float distance;
 };
 
+/// @brief A rectangle of height map points, right and bottom are exclusive.
+struct rect {
+   uint32 left = 0;
+   uint32 top = 0;
+   uint32 right = 0;
+   uint32 bottom = 0;
+};
+
 class terrain_collision {
 public:
    terrain_collision();
@@ -35,6 +43,11 @@ public:
    [[nodiscard]] auto raycast(const float3 ray_origin, const float3 ray_direction) const noexcept
       -> std::optional<ray_hit>;
 
+   /// @brief Refresh the collision data for a region of the height map after it has been edited.
+   /// The terrain's length must not have changed, if it has the terrain_collision must be recreated.
+   /// @param region The height map points that were edited. Clamped to the terrain.
+   void update_region(const rect region) noexcept;
+
 private:
    std::unique_ptr<detail::terrain_collision_impl> _impl;
 };
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace we::container {
+
+/// @brief An array stored as fixed size chunks that are shared between copies. Copying
+/// the array only copies the chunk pointers, a chunk is cloned the first time it is
+/// written to while shared.
+///
+/// Shared chunks are never written to so a copy can be read on another thread while the
+/// array it was copied from keeps changing.
+template<typename T, std::size_t chunk_size = 256>
+class cow_chunked_array {
+   using chunk = std::vector<T>;
+
+public:
+   using value_type = T;
+   using size_type = std::size_t;
+   using reference = T&;
+   using const_reference = const T&;
+
+   class const_iterator {
+   public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const T*;
+      using reference = const T&;
+
+      const_iterator() = default;
+
+      const_iterator(const cow_chunked_array* array, const std::size_t index) noexcept
+         : _array{array}, _index{index}
+      {
+      }
+
+      [[nodiscard]] auto operator*() const noexcept -> const T&
+      {
+         return (*_array)[_index];
+      }
+
+      [[nodiscard]] auto operator->() const noexcept -> const T*
+      {
+         return &(*_array)[_index];
+      }
+
+      auto operator++() noexcept -> const_iterator&
+      {
+         _index += 1;
+
+         return *this;
+      }
+
+      auto operator++(int) noexcept -> const_iterator
+      {
+         const_iterator old = *this;
+
+         _index += 1;
+
+         return old;
+      }
+
+      [[nodiscard]] bool operator==(const const_iterator&) const noexcept = default;
+
+   private:
+      const cow_chunked_array* _array = nullptr;
+      std::size_t _index = 0;
+   };
+
+   cow_chunked_array() = default;
+
+   /// @brief Create an array from values.
+   /// @param values The values to copy into the array.
+   explicit cow_chunked_array(std::span<const T> values)
+   {
+      assign(values);
+   }
+
+   [[nodiscard]] auto operator[](const std::size_t i) const noexcept -> const T&
+   {
+      assert(i < _size);
+
+      return (*_chunks[i / chunk_size])[i % chunk_size];
+   }
+
+   /// @brief Get a value for writing. Clones the chunk holding it if it is shared.
+   /// @param i The index of the value.
+   [[nodiscard]] auto mutate(const std::size_t i) -> T&
+   {
+      assert(i < _size);
+
+      return unshare_chunk(i / chunk_size)[i % chunk_size];
+   }
+
+   [[nodiscard]] auto begin() const noexcept -> const_iterator
+   {
+      return {this, 0};
+   }
+
+   [[nodiscard]] auto end() const noexcept -> const_iterator
+   {
+      return {this, _size};
+   }
+
+   [[nodiscard]] bool empty() const noexcept
+   {
+      return _size == 0;
+   }
+
+   [[nodiscard]] auto size() const noexcept -> std::size_t
+   {
+      return _size;
+   }
+
+   /// @brief The number of chunks in the array.
+   [[nodiscard]] auto chunk_count() const noexcept -> std::size_t
+   {
+      return _chunks.size();
+   }
+
+   /// @brief Get the values in a chunk.
+   /// @param chunk_index The index of the chunk.
+   [[nodiscard]] auto chunk_values(const std::size_t chunk_index) const noexcept
+      -> std::span<const T>
+   {
+      assert(chunk_index < _chunks.size());
+
+      return *_chunks[chunk_index];
+   }
+
+   /// @brief Check if two arrays share a chunk. Mostly useful for testing.
+   /// @param other The other array.
+   /// @param chunk_index The index of the chunk.
+   [[nodiscard]] bool shares_chunk(const cow_chunked_array& other,
+                                   const std::size_t chunk_index) const noexcept
+   {
+      if (chunk_index >= _chunks.size() or chunk_index >= other._chunks.size()) {
+         return false;
+      }
+
+      return _chunks[chunk_index] == other._chunks[chunk_index];
+   }
+
+   /// @brief Add a value to the end of the array.
+   /// @param value The value.
+   void push_back(T value)
+   {
+      if (_size % chunk_size == 0) {
+         auto new_chunk = std::make_shared<chunk>();
+
+         new_chunk->reserve(chunk_size);
+
+         _chunks.push_back(std::move(new_chunk));
+      }
+
+      unshare_chunk(_chunks.size() - 1).push_back(std::move(value));
+
+      _size += 1;
+   }
+
+   /// @brief Make the array hold values. Chunks that already hold the same values are
+   /// kept, so after a small change to the values only the chunks that changed are
+   /// reallocated and the others stay shared with copies of the array. Values are
+   /// compared from first on, so this is linear in the number of values after first.
+   /// @param values The values.
+   /// @param first The index of the first value that may differ from the array. Chunks
+   /// before the one holding it are kept without being compared.
+   void assign(std::span<const T> values, const std::size_t first = 0)
+   {
+      const std::size_t new_chunk_count = (values.size() + chunk_size - 1) / chunk_size;
+      const std::size_t first_chunk = std::min(first, _size) / chunk_size;
+
+      _chunks.resize(new_chunk_count);
+
+      for (std::size_t chunk_index = first_chunk; chunk_index < new_chunk_count;
+           ++chunk_index) {
+         const std::span<const T> chunk_values =
+            values.subspan(chunk_index * chunk_size,
+                           std::min(chunk_size, values.size() - chunk_index * chunk_size));
+
+         std::shared_ptr<chunk>& existing = _chunks[chunk_index];
+
+         if (existing and std::ranges::equal(*existing, chunk_values)) continue;
+
+         auto new_chunk = std::make_shared<chunk>();
+
+         new_chunk->reserve(chunk_size);
+         new_chunk->assign(chunk_values.begin(), chunk_values.end());
+
+         existing = std::move(new_chunk);
+      }
+
+      _size = values.size();
+   }
+
+   /// @brief Remove every value from the array.
+   void clear() noexcept
+   {
+      _chunks.clear();
+      _size = 0;
+   }
+
+private:
+   auto unshare_chunk(const std::size_t chunk_index) -> chunk&
+   {
+      std::shared_ptr<chunk>& shared_chunk = _chunks[chunk_index];
+
+      // A use count of 1 can't be raced as only this array can hand out new references.
+      if (shared_chunk.use_count() != 1) {
+         auto new_chunk = std::make_shared<chunk>();
+
+         new_chunk->reserve(chunk_size);
+         new_chunk->assign(shared_chunk->begin(), shared_chunk->end());
+
+         shared_chunk = std::move(new_chunk);
+      }
+
+      return *shared_chunk;
+   }
+
+   std::vector<std::shared_ptr<chunk>> _chunks;
+   std::size_t _size = 0;
+};
+
+}
@@ -50,6 +50,24 @@ struct paged_stack {
       return get_page(_size - 1).back();
    }
 
+   [[nodiscard]] auto operator[](const std::size_t i) noexcept -> T&
+   {
+      assert(i < _size);
+
+      const std::size_t slot = _offset + i;
+
+      return _pages[slot / page_size][slot % page_size];
+   }
+
+   [[nodiscard]] auto operator[](const std::size_t i) const noexcept -> const T&
+   {
+      assert(i < _size);
+
+      const std::size_t slot = _offset + i;
+
+      return _pages[slot / page_size][slot % page_size];
+   }
+
    [[nodiscard]] bool empty() const noexcept
    {
       return _size == 0;
@@ -63,6 +81,7 @@ struct paged_stack {
    void clear() noexcept
    {
       _size = 0;
+      _offset = 0;
 
       for (auto& page : _pages) page.clear();
    }
@@ -116,18 +135,51 @@ struct paged_stack {
       return value;
    }
 
+   /// @brief Remove items from the bottom of the stack. Pages emptied by this are freed
+   /// and the rest of the items stay where they are, so the cost depends on the number of
+   /// items removed and not the size of the stack.
+   /// @param count The number of items to remove.
+   void erase_bottom(const std::size_t count) noexcept
+   {
+      assert(count <= _size);
+
+      if (count == 0) return;
+
+      if (count == _size) {
+         clear();
+
+         return;
+      }
+
+      const std::size_t new_offset = _offset + count;
+      const std::size_t freed_pages = new_offset / page_size;
+      const std::size_t first_erased = freed_pages == 0 ? _offset : 0;
+
+      _pages.erase(_pages.begin(), _pages.begin() + freed_pages);
+
+      // Items on the new bottom page below the new offset are left in place moved-from
+      // until the page is freed. Moving out of them releases anything they own now.
+      for (std::size_t i = first_erased; i < new_offset % page_size; ++i) {
+         [[maybe_unused]] T discard = std::move(_pages[0][i]);
+      }
+
+      _offset = new_offset % page_size;
+      _size -= count;
+   }
+
    void swap(paged_stack& other) noexcept
    {
       using std::swap;
 
       swap(this->_size, other._size);
+      swap(this->_offset, other._offset);
       swap(this->_pages, other._pages);
    }
 
 private:
    auto get_page(const std::size_t item_index) noexcept -> std::vector<T>&
    {
-      const std::size_t page_index = item_index / page_size;
+      const std::size_t page_index = (_offset + item_index) / page_size;
 
       assert(page_index <= _pages.size());
 
@@ -141,7 +193,7 @@ private:
    auto get_page(const std::size_t item_index) const noexcept
       -> const std::vector<T>&
    {
-      const std::size_t page_index = item_index / page_size;
+      const std::size_t page_index = (_offset + item_index) / page_size;
 
       assert(page_index < _pages.size());
 
@@ -149,6 +201,9 @@ private:
    }
 
    std::size_t _size = 0;
+   /// @brief The number of slots on the first page before the bottom item. Set by
+   /// erase_bottom, always less than page_size.
+   std::size_t _offset = 0;
    std::vector<std::vector<T>> _pages;
 };
 
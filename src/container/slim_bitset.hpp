@@ -83,6 +83,8 @@ public:
       _bits |= (true << i);
    }
 
+   [[nodiscard]] constexpr bool operator==(const slim_bitset&) const noexcept = default;
+
 private:
    storage_type _bits = {};
 };
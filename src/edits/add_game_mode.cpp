@@ -1,4 +1,5 @@
 #include "add_game_mode.hpp"
+#include "journal_io.hpp"
 #include "utility/string_icompare.hpp"
 
 #include <optional>
@@ -115,6 +116,14 @@ struct add_game_mode final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::add_game_mode);
+      writer.write(_name);
+
+      return true;
+   }
+
 private:
    const std::string _name;
    const req_edit_type _req_edit_type;
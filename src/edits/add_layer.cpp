@@ -1,4 +1,5 @@
 #include "add_layer.hpp"
+#include "journal_io.hpp"
 #include "utility/string_icompare.hpp"
 
 #include <fmt/core.h>
@@ -82,6 +83,14 @@ struct add_layer final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::add_layer);
+      writer.write(_name);
+
+      return true;
+   }
+
 private:
    const std::string _name;
    const std::optional<previously_deleted_entry> _previously_deleted;
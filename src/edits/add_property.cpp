@@ -1,4 +1,5 @@
 #include "add_property.hpp"
+#include "journal_io.hpp"
 #include "world/utility/world_utilities.hpp"
 
 namespace we::edits {
@@ -13,12 +14,17 @@ struct add_property_path final : edit<world::edit_context> {
 
    void apply(world::edit_context& context) const noexcept override
    {
-      world::find_entity(context.world.paths, _id)->properties.emplace_back(_property, "");
+      world::find_entity<world::path>(context.world, _id)
+         ->properties.emplace_back(_property, "");
+
+      world::record_change<world::path>(context.world, _id, world::change_type::modify);
    }
 
    void revert(world::edit_context& context) const noexcept override
    {
-      world::find_entity(context.world.paths, _id)->properties.pop_back();
+      world::find_entity<world::path>(context.world, _id)->properties.pop_back();
+
+      world::record_change<world::path>(context.world, _id, world::change_type::modify);
    }
 
    bool is_coalescable([[maybe_unused]] const edit& other) const noexcept override
@@ -28,6 +34,15 @@ struct add_property_path final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::add_property_path);
+      writer.write(_id);
+      writer.write(_property);
+
+      return true;
+   }
+
 private:
    const world::path_id _id;
    const std::string _property;
@@ -42,17 +57,21 @@ struct add_property_path_node final : edit<world::edit_context> {
    void apply(world::edit_context& context) const noexcept override
    {
       world::path::node& node =
-         world::find_entity(context.world.paths, _id)->nodes[_node];
+         world::find_entity<world::path>(context.world, _id)->nodes[_node];
 
       node.properties.emplace_back(_property, "");
+
+      world::record_change<world::path>(context.world, _id, world::change_type::modify);
    }
 
    void revert(world::edit_context& context) const noexcept override
    {
       world::path::node& node =
-         world::find_entity(context.world.paths, _id)->nodes[_node];
+         world::find_entity<world::path>(context.world, _id)->nodes[_node];
 
       node.properties.pop_back();
+
+      world::record_change<world::path>(context.world, _id, world::change_type::modify);
    }
 
    bool is_coalescable([[maybe_unused]] const edit& other) const noexcept override
@@ -62,6 +81,16 @@ struct add_property_path_node final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::add_property_path_node);
+      writer.write(_id);
+      writer.write(_node);
+      writer.write(_property);
+
+      return true;
+   }
+
 private:
    const world::path_id _id;
    const std::size_t _node;
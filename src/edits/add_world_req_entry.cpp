@@ -1,4 +1,5 @@
 #include "add_world_req_entry.hpp"
+#include "journal_io.hpp"
 
 namespace we::edits {
 
@@ -27,6 +28,15 @@ struct add_world_req_entry final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::add_world_req_entry);
+      writer.write(_list_index);
+      writer.write(_name);
+
+      return true;
+   }
+
 private:
    const int _list_index;
    const std::string _name;
@@ -1,4 +1,5 @@
 #include "add_world_req_list.hpp"
+#include "journal_io.hpp"
 
 namespace we::edits {
 
@@ -26,6 +27,14 @@ struct add_world_req_list final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::add_world_req_list);
+      writer.write(_file_type);
+
+      return true;
+   }
+
 private:
    const std::string _file_type;
 };
@@ -1,9 +1,13 @@
 #include "bundle.hpp"
+#include "journal_io.hpp"
 
 namespace we::edits {
 
 struct bundle : edit<world::edit_context> {
-   bundle(bundle_vector edits) : edits{std::move(edits)} {}
+   bundle(bundle_vector edits)
+      : edit{edit_kind_of<bundle>}, edits{std::move(edits)}
+   {
+   }
 
    void apply(world::edit_context& target) const noexcept
    {
@@ -21,13 +25,13 @@ struct bundle : edit<world::edit_context> {
 
    bool is_coalescable(const edit<world::edit_context>& other_unknown) const noexcept
    {
-      const bundle* other = dynamic_cast<const bundle*>(&other_unknown);
+      const bundle* other = edit_cast<bundle>(&other_unknown);
 
       if (not other) return false;
       if (this->edits.size() != other->edits.size()) return false;
 
       for (std::size_t i = 0; i < this->edits.size(); ++i) {
-         if (not this->edits[i]->is_coalescable(*other->edits[i])) {
+         if (not can_coalesce(*this->edits[i], *other->edits[i])) {
             return false;
          }
       }
@@ -37,13 +41,35 @@ struct bundle : edit<world::edit_context> {
 
    void coalesce(edit<world::edit_context>& other_unknown) noexcept
    {
-      bundle& other = dynamic_cast<bundle&>(other_unknown);
+      bundle& other = edit_cast<bundle>(other_unknown);
 
       for (std::size_t i = 0; i < this->edits.size(); ++i) {
          this->edits[i]->coalesce(*other.edits[i]);
       }
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::bundle);
+      writer.write(static_cast<uint32>(edits.size()));
+
+      for (auto& edit : edits) {
+         if (not edit->write_journal(writer)) return false;
+      }
+
+      return true;
+   }
+
+   auto memory_use() const noexcept -> std::size_t override
+   {
+      std::size_t memory_use =
+         sizeof(bundle) + edits.capacity() * sizeof(bundle_vector::value_type);
+
+      for (auto& edit : edits) memory_use += edit->memory_use();
+
+      return memory_use;
+   }
+
    bundle_vector edits;
 };
 
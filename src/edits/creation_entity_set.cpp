@@ -1,5 +1,6 @@
 
 #include "creation_entity_set.hpp"
+#include "journal_io.hpp"
 
 namespace we::edits {
 
@@ -30,6 +31,15 @@ struct creation_entity_set final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::creation_entity_set);
+      writer.write(new_creation_entity);
+      writer.write(old_creation_entity);
+
+      return true;
+   }
+
    const std::optional<world::creation_entity> new_creation_entity;
    const std::optional<world::creation_entity> old_creation_entity;
 };
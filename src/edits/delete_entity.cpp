@@ -1,8 +1,12 @@
 #include "delete_entity.hpp"
+#include "journal_io.hpp"
+#include "memory_use.hpp"
 #include "types.hpp"
 #include "utility/string_icompare.hpp"
 #include "world/utility/world_utilities.hpp"
 
+#include <optional>
+#include <ranges>
 #include <vector>
 
 namespace we::edits {
@@ -10,11 +14,13 @@ namespace we::edits {
 namespace {
 
 template<typename Type>
-auto get_entity_index(const std::vector<Type>& entities, const world::id<Type> id) noexcept
+auto get_entity_index(const world::world& world,
+                      const world::id<std::type_identity_t<Type>> id) noexcept
    -> uint32
 {
-   for (uint32 i = 0; i < entities.size(); ++i) {
-      if (entities[i].id == id) return i;
+   if (const std::optional<std::size_t> index = world::find_entity_index<Type>(world, id);
+       index) {
+      return static_cast<uint32>(*index);
    }
 
    std::terminate();
@@ -56,22 +62,36 @@ struct delete_object final : edit<world::edit_context> {
    void apply(world::edit_context& context) const noexcept override
    {
       context.world.objects.erase(context.world.objects.begin() + _object_index);
+      world::record_change<world::object>(context.world, _object.id,
+                                          world::change_type::remove, _object_index);
+      world::unindex_entity_id<world::object>(context.world, _object.id, _object_index);
+      world::unindex_entity_name(context.world, _object);
 
       for (const auto& [path_index, property_index] : _path_property_refs) {
-         std::vector<world::path::property>& properties =
-            context.world.paths[path_index].properties;
+         world::path& path = context.world.paths[path_index];
 
-         properties.erase(properties.begin() + property_index);
+         path.properties.erase(path.properties.begin() + property_index);
+
+         world::record_change<world::path>(context.world, path.id,
+                                           world::change_type::modify);
       }
 
       for (const auto& [sector_index, entry_index] : _sector_entry_refs) {
-         std::vector<std::string>& objects = context.world.sectors[sector_index].objects;
+         world::sector& sector = context.world.sectors[sector_index];
+
+         sector.objects.erase(sector.objects.begin() + entry_index);
 
-         objects.erase(objects.begin() + entry_index);
+         world::record_change<world::sector>(context.world, sector.id,
+                                             world::change_type::modify);
       }
 
       for (const auto& [hintnode_index] : _hintnode_refs) {
-         context.world.hintnodes[hintnode_index].command_post = "";
+         world::hintnode& hintnode = context.world.hintnodes[hintnode_index];
+
+         hintnode.command_post = "";
+
+         world::record_change<world::hintnode>(context.world, hintnode.id,
+                                               world::change_type::modify);
       }
    }
 
@@ -79,24 +99,38 @@ struct delete_object final : edit<world::edit_context> {
    {
       context.world.objects.insert(context.world.objects.begin() + _object_index,
                                    _object);
+      world::record_change<world::object>(context.world, _object.id,
+                                          world::change_type::insert, _object_index);
+      world::update_id_index<world::object>(context.world, _object_index);
+      world::index_entity_name(context.world, _object);
 
       for (const auto& [path_index, property_index] : _path_property_refs) {
-         std::vector<world::path::property>& properties =
-            context.world.paths[path_index].properties;
+         world::path& path = context.world.paths[path_index];
+
+         path.properties.emplace(path.properties.begin() + property_index,
+                                 std::string{path_property_ref::property_name},
+                                 _object.name);
 
-         properties.emplace(properties.begin() + property_index,
-                            std::string{path_property_ref::property_name},
-                            _object.name);
+         world::record_change<world::path>(context.world, path.id,
+                                           world::change_type::modify);
       }
 
       for (const auto& [sector_index, entry_index] : _sector_entry_refs) {
-         std::vector<std::string>& objects = context.world.sectors[sector_index].objects;
+         world::sector& sector = context.world.sectors[sector_index];
+
+         sector.objects.insert(sector.objects.begin() + entry_index, _object.name);
 
-         objects.insert(objects.begin() + entry_index, _object.name);
+         world::record_change<world::sector>(context.world, sector.id,
+                                             world::change_type::modify);
       }
 
       for (const auto& [hintnode_index] : _hintnode_refs) {
-         context.world.hintnodes[hintnode_index].command_post = _object.name;
+         world::hintnode& hintnode = context.world.hintnodes[hintnode_index];
+
+         hintnode.command_post = _object.name;
+
+         world::record_change<world::hintnode>(context.world, hintnode.id,
+                                               world::change_type::modify);
       }
    }
 
@@ -107,6 +141,22 @@ struct delete_object final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::delete_entity);
+      writer.write_entity_type<world::object>();
+      writer.write(_object.id);
+
+      return true;
+   }
+
+   auto memory_use() const noexcept -> std::size_t override
+   {
+      return sizeof(delete_object) + heap_memory_use(_object) +
+             heap_memory_use(_path_property_refs) + heap_memory_use(_sector_entry_refs) +
+             heap_memory_use(_hintnode_refs);
+   }
+
 private:
    const world::object _object;
    const uint32 _object_index;
@@ -127,6 +177,11 @@ struct delete_entity final : edit<world::edit_context> {
       std::vector<T>& entities = world::select_entities<T>(context.world);
 
       entities.erase(entities.begin() + _entity_index);
+
+      world::unindex_entity_id<T>(context.world, _entity.id, _entity_index);
+      world::unindex_entity_name(context.world, _entity);
+      world::record_change<T>(context.world, _entity.id, world::change_type::remove,
+                              _entity_index);
    }
 
    void revert(world::edit_context& context) const noexcept override
@@ -134,6 +189,11 @@ struct delete_entity final : edit<world::edit_context> {
       std::vector<T>& entities = world::select_entities<T>(context.world);
 
       entities.insert(entities.begin() + _entity_index, _entity);
+
+      world::update_id_index<T>(context.world, _entity_index);
+      world::index_entity_name(context.world, _entity);
+      world::record_change<T>(context.world, _entity.id, world::change_type::insert,
+                              _entity_index);
    }
 
    bool is_coalescable([[maybe_unused]] const edit& other) const noexcept override
@@ -143,6 +203,20 @@ struct delete_entity final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::delete_entity);
+      writer.write_entity_type<T>();
+      writer.write(_entity.id);
+
+      return true;
+   }
+
+   auto memory_use() const noexcept -> std::size_t override
+   {
+      return sizeof(delete_entity) + heap_memory_use(_entity);
+   }
+
 private:
    const T _entity;
    const uint32 _entity_index;
@@ -156,16 +230,22 @@ struct delete_path_node final : edit<world::edit_context> {
 
    void apply(world::edit_context& context) const noexcept override
    {
-      std::vector<world::path::node>& nodes = context.world.paths[_path_index].nodes;
+      world::path& path = context.world.paths[_path_index];
+
+      path.nodes.erase(path.nodes.begin() + _node_index);
 
-      nodes.erase(nodes.begin() + _node_index);
+      world::record_change<world::path>(context.world, path.id,
+                                        world::change_type::modify);
    }
 
    void revert(world::edit_context& context) const noexcept override
    {
-      std::vector<world::path::node>& nodes = context.world.paths[_path_index].nodes;
+      world::path& path = context.world.paths[_path_index];
 
-      nodes.insert(nodes.begin() + _node_index, _node);
+      path.nodes.insert(path.nodes.begin() + _node_index, _node);
+
+      world::record_change<world::path>(context.world, path.id,
+                                        world::change_type::modify);
    }
 
    bool is_coalescable([[maybe_unused]] const edit& other) const noexcept override
@@ -175,6 +255,20 @@ struct delete_path_node final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::delete_path_node);
+      writer.write(_path_index);
+      writer.write(_node_index);
+
+      return true;
+   }
+
+   auto memory_use() const noexcept -> std::size_t override
+   {
+      return sizeof(delete_path_node) + heap_memory_use(_node);
+   }
+
 private:
    const world::path::node _node;
    const uint32 _path_index;
@@ -193,22 +287,36 @@ struct delete_path final : edit<world::edit_context> {
    void apply(world::edit_context& context) const noexcept override
    {
       context.world.paths.erase(context.world.paths.begin() + _path_index);
+      world::unindex_entity_id<world::path>(context.world, _path.id, _path_index);
+      world::unindex_entity_name(context.world, _path);
+      world::record_change<world::path>(context.world, _path.id,
+                                        world::change_type::remove, _path_index);
 
       for (const auto& unlinked : _unlinked_object_properties) {
-         context.world.objects[unlinked.object_index]
-            .instance_properties[unlinked.property_index]
-            .value = "";
+         world::object& object = context.world.objects[unlinked.object_index];
+
+         object.instance_properties[unlinked.property_index].value = "";
+
+         world::record_change<world::object>(context.world, object.id,
+                                             world::change_type::modify);
       }
    }
 
    void revert(world::edit_context& context) const noexcept override
    {
       context.world.paths.insert(context.world.paths.begin() + _path_index, _path);
+      world::update_id_index<world::path>(context.world, _path_index);
+      world::index_entity_name(context.world, _path);
+      world::record_change<world::path>(context.world, _path.id,
+                                        world::change_type::insert, _path_index);
 
       for (const auto& unlinked : _unlinked_object_properties) {
-         context.world.objects[unlinked.object_index]
-            .instance_properties[unlinked.property_index]
-            .value = _path.name;
+         world::object& object = context.world.objects[unlinked.object_index];
+
+         object.instance_properties[unlinked.property_index].value = _path.name;
+
+         world::record_change<world::object>(context.world, object.id,
+                                             world::change_type::modify);
       }
    }
 
@@ -219,6 +327,21 @@ struct delete_path final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::delete_path_node);
+      writer.write(_path_index);
+      writer.write(uint32{0});
+
+      return true;
+   }
+
+   auto memory_use() const noexcept -> std::size_t override
+   {
+      return sizeof(delete_path) + heap_memory_use(_path) +
+             heap_memory_use(_unlinked_object_properties);
+   }
+
 private:
    const world::path _path;
    const uint32 _path_index;
@@ -237,11 +360,18 @@ struct delete_region final : edit<world::edit_context> {
    void apply(world::edit_context& context) const noexcept override
    {
       context.world.regions.erase(context.world.regions.begin() + _region_index);
+      world::unindex_entity_id<world::region>(context.world, _region.id, _region_index);
+      world::unindex_entity_name(context.world, _region);
+      world::record_change<world::region>(context.world, _region.id,
+                                          world::change_type::remove, _region_index);
 
       for (const auto& unlinked : _unlinked_object_properties) {
-         context.world.objects[unlinked.object_index]
-            .instance_properties[unlinked.property_index]
-            .value = "";
+         world::object& object = context.world.objects[unlinked.object_index];
+
+         object.instance_properties[unlinked.property_index].value = "";
+
+         world::record_change<world::object>(context.world, object.id,
+                                             world::change_type::modify);
       }
    }
 
@@ -249,11 +379,18 @@ struct delete_region final : edit<world::edit_context> {
    {
       context.world.regions.insert(context.world.regions.begin() + _region_index,
                                    _region);
+      world::update_id_index<world::region>(context.world, _region_index);
+      world::index_entity_name(context.world, _region);
+      world::record_change<world::region>(context.world, _region.id,
+                                          world::change_type::insert, _region_index);
 
       for (const auto& unlinked : _unlinked_object_properties) {
-         context.world.objects[unlinked.object_index]
-            .instance_properties[unlinked.property_index]
-            .value = _region.description;
+         world::object& object = context.world.objects[unlinked.object_index];
+
+         object.instance_properties[unlinked.property_index].value = _region.description;
+
+         world::record_change<world::object>(context.world, object.id,
+                                             world::change_type::modify);
       }
    }
 
@@ -264,6 +401,21 @@ struct delete_region final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::delete_entity);
+      writer.write_entity_type<world::region>();
+      writer.write(_region.id);
+
+      return true;
+   }
+
+   auto memory_use() const noexcept -> std::size_t override
+   {
+      return sizeof(delete_region) + heap_memory_use(_region) +
+             heap_memory_use(_unlinked_object_properties);
+   }
+
 private:
    const world::region _region;
    const uint32 _region_index;
@@ -286,12 +438,19 @@ struct delete_sector final : edit<world::edit_context> {
    void apply(world::edit_context& context) const noexcept override
    {
       context.world.sectors.erase(context.world.sectors.begin() + _sector_index);
+      world::unindex_entity_id<world::sector>(context.world, _sector.id, _sector_index);
+      world::unindex_entity_name(context.world, _sector);
+      world::record_change<world::sector>(context.world, _sector.id,
+                                          world::change_type::remove, _sector_index);
 
       for (const auto& unlinked : _unlinked_portals) {
          world::portal& portal = context.world.portals[unlinked.portal_index];
 
          if (unlinked.sector1) portal.sector1 = "";
          if (unlinked.sector2) portal.sector2 = "";
+
+         world::record_change<world::portal>(context.world, portal.id,
+                                             world::change_type::modify);
       }
    }
 
@@ -299,12 +458,19 @@ struct delete_sector final : edit<world::edit_context> {
    {
       context.world.sectors.insert(context.world.sectors.begin() + _sector_index,
                                    _sector);
+      world::update_id_index<world::sector>(context.world, _sector_index);
+      world::index_entity_name(context.world, _sector);
+      world::record_change<world::sector>(context.world, _sector.id,
+                                          world::change_type::insert, _sector_index);
 
       for (const auto& unlinked : _unlinked_portals) {
          world::portal& portal = context.world.portals[unlinked.portal_index];
 
          if (unlinked.sector1) portal.sector1 = _sector.name;
          if (unlinked.sector2) portal.sector2 = _sector.name;
+
+         world::record_change<world::portal>(context.world, portal.id,
+                                             world::change_type::modify);
       }
    }
 
@@ -315,6 +481,21 @@ struct delete_sector final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::delete_entity);
+      writer.write_entity_type<world::sector>();
+      writer.write(_sector.id);
+
+      return true;
+   }
+
+   auto memory_use() const noexcept -> std::size_t override
+   {
+      return sizeof(delete_sector) + heap_memory_use(_sector) +
+             heap_memory_use(_unlinked_portals);
+   }
+
 private:
    const world::sector _sector;
    const uint32 _sector_index;
@@ -336,15 +517,28 @@ struct delete_planning_hub final : edit<world::edit_context> {
    void apply(world::edit_context& context) const noexcept override
    {
       context.world.planning_hubs.erase(context.world.planning_hubs.begin() + _hub_index);
-      context.world.planning_hub_index.erase(_hub.id);
-
-      for (auto& [id, index] : context.world.planning_hub_index) {
-         if (index > _hub_index) index -= 1;
-      }
-
-      for (const auto& broken : _broken_connections) {
+      world::unindex_entity_id<world::planning_hub>(context.world, _hub.id, _hub_index);
+      world::unindex_entity_name(context.world, _hub);
+      world::record_change<world::planning_hub>(context.world, _hub.id,
+                                                world::change_type::remove, _hub_index);
+
+      // Erase from the back so the stored indices stay valid and update the ID index
+      // once for the whole batch instead of once per connection.
+      for (const auto& broken : _broken_connections | std::views::reverse) {
          context.world.planning_connections.erase(
             context.world.planning_connections.begin() + broken.index);
+         world::select_id_index<world::planning_connection>(context.world)
+            .erase(broken.connection.id);
+         world::unindex_entity_name(context.world, broken.connection);
+         world::record_change<world::planning_connection>(context.world,
+                                                          broken.connection.id,
+                                                          world::change_type::remove,
+                                                          broken.index);
+      }
+
+      if (not _broken_connections.empty()) {
+         world::update_id_index<world::planning_connection>(
+            context.world, _broken_connections.front().index);
       }
    }
 
@@ -352,17 +546,25 @@ struct delete_planning_hub final : edit<world::edit_context> {
    {
       context.world.planning_hubs.insert(context.world.planning_hubs.begin() + _hub_index,
                                          _hub);
-
-      for (auto& [id, index] : context.world.planning_hub_index) {
-         if (index >= _hub_index) index += 1;
-      }
-
-      context.world.planning_hub_index.emplace(_hub.id, _hub_index);
+      world::update_id_index<world::planning_hub>(context.world, _hub_index);
+      world::index_entity_name(context.world, _hub);
+      world::record_change<world::planning_hub>(context.world, _hub.id,
+                                                world::change_type::insert, _hub_index);
 
       for (const auto& broken : _broken_connections) {
          context.world.planning_connections
             .insert(context.world.planning_connections.begin() + broken.index,
                     broken.connection);
+         world::index_entity_name(context.world, broken.connection);
+         world::record_change<world::planning_connection>(context.world,
+                                                          broken.connection.id,
+                                                          world::change_type::insert,
+                                                          broken.index);
+      }
+
+      if (not _broken_connections.empty()) {
+         world::update_id_index<world::planning_connection>(
+            context.world, _broken_connections.front().index);
       }
    }
 
@@ -373,6 +575,27 @@ struct delete_planning_hub final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::delete_entity);
+      writer.write_entity_type<world::planning_hub>();
+      writer.write(_hub.id);
+
+      return true;
+   }
+
+   auto memory_use() const noexcept -> std::size_t override
+   {
+      std::size_t memory_use = sizeof(delete_planning_hub) + heap_memory_use(_hub) +
+                               heap_memory_use(_broken_connections);
+
+      for (const auto& broken : _broken_connections) {
+         memory_use += heap_memory_use(broken.connection);
+      }
+
+      return memory_use;
+   }
+
 private:
    const world::planning_hub _hub;
    const uint32 _hub_index;
@@ -384,7 +607,7 @@ private:
 auto make_delete_entity(world::object_id object_id, const world::world& world)
    -> std::unique_ptr<edit<world::edit_context>>
 {
-   const uint32 object_index = get_entity_index(world.objects, object_id);
+   const uint32 object_index = get_entity_index<world::object>(world, object_id);
    const world::object& object = world.objects[object_index];
 
    uint32 path_property_count = 0;
@@ -458,7 +681,7 @@ auto make_delete_entity(world::object_id object_id, const world::world& world)
 auto make_delete_entity(world::light_id light_id, const world::world& world)
    -> std::unique_ptr<edit<world::edit_context>>
 {
-   const uint32 light_index = get_entity_index(world.lights, light_id);
+   const uint32 light_index = get_entity_index<world::light>(world, light_id);
    const world::light& light = world.lights[light_index];
 
    return std::make_unique<delete_entity<world::light>>(light, light_index);
@@ -467,7 +690,7 @@ auto make_delete_entity(world::light_id light_id, const world::world& world)
 auto make_delete_entity(world::path_id_node_pair path_id_node, const world::world& world)
    -> std::unique_ptr<edit<world::edit_context>>
 {
-   const uint32 path_index = get_entity_index(world.paths, path_id_node.id);
+   const uint32 path_index = get_entity_index<world::path>(world, path_id_node.id);
    const world::path& path = world.paths[path_index];
 
    if (path.nodes.size() > 1) {
@@ -517,7 +740,7 @@ auto make_delete_entity(world::path_id_node_pair path_id_node, const world::worl
 auto make_delete_entity(world::region_id region_id, const world::world& world)
    -> std::unique_ptr<edit<world::edit_context>>
 {
-   const uint32 region_index = get_entity_index(world.regions, region_id);
+   const uint32 region_index = get_entity_index<world::region>(world, region_id);
    const world::region& region = world.regions[region_index];
 
    uint32 unlinked_object_property_count = 0;
@@ -566,7 +789,7 @@ auto make_delete_entity(world::region_id region_id, const world::world& world)
 auto make_delete_entity(world::sector_id sector_id, const world::world& world)
    -> std::unique_ptr<edit<world::edit_context>>
 {
-   const uint32 sector_index = get_entity_index(world.sectors, sector_id);
+   const uint32 sector_index = get_entity_index<world::sector>(world, sector_id);
    const world::sector& sector = world.sectors[sector_index];
 
    uint32 unlinked_portal_count = 0;
@@ -597,7 +820,7 @@ auto make_delete_entity(world::sector_id sector_id, const world::world& world)
 auto make_delete_entity(world::portal_id portal_id, const world::world& world)
    -> std::unique_ptr<edit<world::edit_context>>
 {
-   const uint32 portal_index = get_entity_index(world.portals, portal_id);
+   const uint32 portal_index = get_entity_index<world::portal>(world, portal_id);
    const world::portal& portal = world.portals[portal_index];
 
    return std::make_unique<delete_entity<world::portal>>(portal, portal_index);
@@ -606,7 +829,7 @@ auto make_delete_entity(world::portal_id portal_id, const world::world& world)
 auto make_delete_entity(world::hintnode_id hintnode_id, const world::world& world)
    -> std::unique_ptr<edit<world::edit_context>>
 {
-   const uint32 hintnode_index = get_entity_index(world.hintnodes, hintnode_id);
+   const uint32 hintnode_index = get_entity_index<world::hintnode>(world, hintnode_id);
    const world::hintnode& hintnode = world.hintnodes[hintnode_index];
 
    return std::make_unique<delete_entity<world::hintnode>>(hintnode, hintnode_index);
@@ -615,7 +838,7 @@ auto make_delete_entity(world::hintnode_id hintnode_id, const world::world& worl
 auto make_delete_entity(world::barrier_id barrier_id, const world::world& world)
    -> std::unique_ptr<edit<world::edit_context>>
 {
-   const uint32 barrier_index = get_entity_index(world.barriers, barrier_id);
+   const uint32 barrier_index = get_entity_index<world::barrier>(world, barrier_id);
    const world::barrier& barrier = world.barriers[barrier_index];
 
    return std::make_unique<delete_entity<world::barrier>>(barrier, barrier_index);
@@ -625,7 +848,7 @@ auto make_delete_entity(world::planning_hub_id planning_hub_id, const world::wor
    -> std::unique_ptr<edit<world::edit_context>>
 {
    const uint32 planning_hub_index =
-      get_entity_index(world.planning_hubs, planning_hub_id);
+      get_entity_index<world::planning_hub>(world, planning_hub_id);
    const world::planning_hub& planning_hub = world.planning_hubs[planning_hub_index];
 
    uint32 broken_connection_count = 0;
@@ -657,7 +880,7 @@ auto make_delete_entity(world::planning_connection_id planning_connection_id,
    -> std::unique_ptr<edit<world::edit_context>>
 {
    const uint32 planning_connection_index =
-      get_entity_index(world.planning_connections, planning_connection_id);
+      get_entity_index<world::planning_connection>(world, planning_connection_id);
    const world::planning_connection& planning_connection =
       world.planning_connections[planning_connection_index];
 
@@ -668,7 +891,7 @@ auto make_delete_entity(world::planning_connection_id planning_connection_id,
 auto make_delete_entity(world::boundary_id boundary_id, const world::world& world)
    -> std::unique_ptr<edit<world::edit_context>>
 {
-   const uint32 boundary_index = get_entity_index(world.boundaries, boundary_id);
+   const uint32 boundary_index = get_entity_index<world::boundary>(world, boundary_id);
    const world::boundary& boundary = world.boundaries[boundary_index];
 
    return std::make_unique<delete_entity<world::boundary>>(boundary, boundary_index);
@@ -1,4 +1,5 @@
 #include "delete_game_mode.hpp"
+#include "journal_io.hpp"
 
 #include "utility/string_icompare.hpp"
 
@@ -92,6 +93,14 @@ struct delete_game_mode final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::delete_game_mode);
+      writer.write(_index);
+
+      return true;
+   }
+
 private:
    const int _index;
    const world::game_mode_description _game_mode;
@@ -1,6 +1,10 @@
 #include "delete_layer.hpp"
+#include "journal_io.hpp"
+#include "memory_use.hpp"
 #include "utility/string_icompare.hpp"
+#include "world/utility/world_utilities.hpp"
 
+#include <algorithm>
 #include <vector>
 
 #include <fmt/core.h>
@@ -277,23 +281,40 @@ auto makee_game_mode_requirements_delete_entries(
 }
 
 template<typename T>
-void apply_delete_entries(std::vector<T>& entities,
+void apply_delete_entries(world::world& world, std::vector<T>& entities,
                           std::span<const delete_entry<std::type_identity_t<T>>> entries)
 {
+   std::size_t first_moved = entities.size();
+
    for (const auto& [index, entity] : entries) {
       entities.erase(entities.begin() + index);
+
+      select_id_index<T>(world).erase(entity.id);
+      unindex_entity_name(world, entity);
+
+      first_moved = std::min(first_moved, static_cast<std::size_t>(index));
    }
+
+   update_id_index<T>(world, first_moved);
 }
 
 template<typename T>
-void revert_delete_entries(std::vector<T>& entities,
+void revert_delete_entries(world::world& world, std::vector<T>& entities,
                            std::span<const delete_entry<std::type_identity_t<T>>> entries)
 {
+   std::size_t first_moved = entities.size();
+
    for (std::ptrdiff_t i = (std::ssize(entries) - 1); i >= 0; --i) {
       const auto& [index, entity] = entries[i];
 
       entities.insert(entities.begin() + index, entity);
+
+      index_entity_name(world, entity);
+
+      first_moved = std::min(first_moved, static_cast<std::size_t>(index));
    }
+
+   update_id_index<T>(world, first_moved);
 }
 
 void apply_delete_entries(std::vector<world::requirement_list>& requirements,
@@ -360,6 +381,24 @@ void revert_delete_entries(std::vector<world::game_mode_description>& game_modes
    }
 }
 
+template<typename T>
+auto entries_memory_use(const std::vector<T>& entries) noexcept -> std::size_t
+{
+   std::size_t memory_use = entries.capacity() * sizeof(T);
+
+   for (const T& entry : entries) {
+      if constexpr (requires { entry.entity; }) {
+         memory_use += heap_memory_use(entry.entity);
+      }
+
+      if constexpr (requires { entry.entry; }) {
+         memory_use += heap_memory_use(entry.entry);
+      }
+   }
+
+   return memory_use;
+}
+
 struct delete_layer final : edit<world::edit_context> {
    delete_layer(delete_layer_data data) : _data{std::move(data)} {}
 
@@ -377,14 +416,16 @@ struct delete_layer final : edit<world::edit_context> {
       apply_remap_entries(world.hintnodes, _data.remap_hintnodes);
       apply_remap_entries(world.game_modes, _data.remap_game_modes);
 
-      apply_delete_entries(world.objects, _data.delete_objects);
-      apply_delete_entries(world.lights, _data.delete_lights);
-      apply_delete_entries(world.paths, _data.delete_paths);
-      apply_delete_entries(world.regions, _data.delete_regions);
-      apply_delete_entries(world.hintnodes, _data.delete_hintnodes);
+      apply_delete_entries(world, world.objects, _data.delete_objects);
+      apply_delete_entries(world, world.lights, _data.delete_lights);
+      apply_delete_entries(world, world.paths, _data.delete_paths);
+      apply_delete_entries(world, world.regions, _data.delete_regions);
+      apply_delete_entries(world, world.hintnodes, _data.delete_hintnodes);
       apply_delete_entries(world.requirements, _data.delete_requirements);
       apply_delete_entries(world.game_modes, _data.delete_game_mode_entries);
       apply_delete_entries(world.game_modes, _data.delete_game_mode_requirements);
+
+      world::reset_change_logs(world);
    }
 
    void revert(world::edit_context& context) const noexcept override
@@ -395,11 +436,11 @@ struct delete_layer final : edit<world::edit_context> {
                                       _data.layer);
       world.deleted_layers.pop_back();
 
-      revert_delete_entries(world.objects, _data.delete_objects);
-      revert_delete_entries(world.lights, _data.delete_lights);
-      revert_delete_entries(world.paths, _data.delete_paths);
-      revert_delete_entries(world.regions, _data.delete_regions);
-      revert_delete_entries(world.hintnodes, _data.delete_hintnodes);
+      revert_delete_entries(world, world.objects, _data.delete_objects);
+      revert_delete_entries(world, world.lights, _data.delete_lights);
+      revert_delete_entries(world, world.paths, _data.delete_paths);
+      revert_delete_entries(world, world.regions, _data.delete_regions);
+      revert_delete_entries(world, world.hintnodes, _data.delete_hintnodes);
       revert_delete_entries(world.requirements, _data.delete_requirements);
       revert_delete_entries(world.game_modes, _data.delete_game_mode_entries,
                             _data.index);
@@ -411,6 +452,8 @@ struct delete_layer final : edit<world::edit_context> {
       revert_remap_entries(world.regions, _data.remap_regions);
       revert_remap_entries(world.hintnodes, _data.remap_hintnodes);
       revert_remap_entries(world.game_modes, _data.remap_game_modes);
+
+      world::reset_change_logs(world);
    }
 
    bool is_coalescable([[maybe_unused]] const edit& other) const noexcept override
@@ -420,6 +463,33 @@ struct delete_layer final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::delete_layer);
+      writer.write(_data.index);
+
+      return true;
+   }
+
+   auto memory_use() const noexcept -> std::size_t override
+   {
+      return sizeof(delete_layer) + heap_memory_use(_data.layer) +
+             entries_memory_use(_data.remap_objects) +
+             entries_memory_use(_data.remap_lights) +
+             entries_memory_use(_data.remap_paths) +
+             entries_memory_use(_data.remap_regions) +
+             entries_memory_use(_data.remap_hintnodes) +
+             entries_memory_use(_data.remap_game_modes) +
+             entries_memory_use(_data.delete_objects) +
+             entries_memory_use(_data.delete_lights) +
+             entries_memory_use(_data.delete_paths) +
+             entries_memory_use(_data.delete_regions) +
+             entries_memory_use(_data.delete_hintnodes) +
+             entries_memory_use(_data.delete_requirements) +
+             entries_memory_use(_data.delete_game_mode_entries) +
+             entries_memory_use(_data.delete_game_mode_requirements);
+   }
+
 private:
    const delete_layer_data _data;
 };
@@ -1,4 +1,5 @@
 #include "delete_world_req_entry.hpp"
+#include "journal_io.hpp"
 
 namespace we::edits {
 
@@ -31,6 +32,14 @@ struct delete_world_req_list final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::delete_world_req_list);
+      writer.write(_list_index);
+
+      return true;
+   }
+
 private:
    const int _list_index;
    const world::requirement_list _list;
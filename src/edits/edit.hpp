@@ -1,7 +1,29 @@
 #pragma once
 
+#include <cassert>
+#include <cstddef>
+
 namespace we::edits {
 
+class journal_writer;
+
+/// @brief Identifies the concrete type of an edit without RTTI. See edit_kind_of.
+using edit_kind = const void*;
+
+namespace detail {
+
+// Not const, identical read-only constants can be merged by the linker (/OPT:ICF) which
+// would give different edit types the same kind.
+template<typename Edit>
+inline char edit_kind_tag;
+
+}
+
+/// @brief The edit_kind of an edit type. Each type gets a unique value, the address of
+/// a variable template instantiated for it.
+template<typename Edit>
+inline constexpr edit_kind edit_kind_of = &detail::edit_kind_tag<Edit>;
+
 /// @brief Represents an edit.
 /// @tparam T The type that the edit targets.
 template<typename T>
@@ -10,6 +32,15 @@ struct edit {
 
    virtual ~edit() = default;
 
+   /// @brief Get the kind of the edit, set by the edit when it's constructed. Used by
+   /// edit_cast and to let the edit stack skip is_coalescable for edits of different
+   /// kinds.
+   /// @return The kind of the edit or nullptr if the edit doesn't have one.
+   auto kind() const noexcept -> edit_kind
+   {
+      return _kind;
+   }
+
    /// @brief Apply the edit to the target.
    /// @param target The target of the edit.
    virtual void apply(edit_target& target) const noexcept = 0;
@@ -28,6 +59,23 @@ struct edit {
    /// @param other The edit to coalesce into this. Maybe left in an invalid state after call.
    virtual void coalesce(edit& other) noexcept = 0;
 
+   /// @brief Get an estimate of the memory used by the edit, including memory it owns.
+   /// Used by the edit stack to keep its history within a memory budget. Edits that
+   /// hold copies of entities or arrays of values should override this.
+   /// @return The estimated memory use in bytes.
+   virtual auto memory_use() const noexcept -> std::size_t
+   {
+      return sizeof(edit);
+   }
+
+   /// @brief Write the edit to an edit journal so it can be replayed later.
+   /// @param writer The journal writer.
+   /// @return False if the edit can not be written to a journal.
+   virtual bool write_journal([[maybe_unused]] journal_writer& writer) const noexcept
+   {
+      return false;
+   }
+
    /// @brief Checks if the edit is marked as being closed and shouldn't be coalesced by the edit stack.
    /// @return If the edit is closed.
    bool is_closed() const noexcept
@@ -55,9 +103,55 @@ struct edit {
       _transparent = true;
    }
 
+protected:
+   /// @brief Construct the edit.
+   /// @param kind The kind of the edit, edit_kind_of<Type> for edits that implement
+   /// coalescing. Edits of different kinds will never be coalesced.
+   explicit edit(const edit_kind kind = nullptr) noexcept : _kind{kind} {}
+
 private:
+   edit_kind _kind = nullptr;
    bool _closed = false;
    bool _transparent = false;
 };
 
+/// @brief Cast an edit to a derived type using its kind.
+/// @tparam Edit The type of edit to cast to. Must pass edit_kind_of<Edit> to edit's
+/// constructor.
+/// @param unknown The edit to cast.
+/// @return The edit or nullptr if the edit isn't an Edit.
+template<typename Edit, typename T>
+inline auto edit_cast(const edit<T>* unknown) noexcept -> const Edit*
+{
+   if (unknown->kind() != edit_kind_of<Edit>) return nullptr;
+
+   return static_cast<const Edit*>(unknown);
+}
+
+/// @brief Cast an edit to a derived type using its kind. The edit must be an Edit.
+/// @tparam Edit The type of edit to cast to. Must pass edit_kind_of<Edit> to edit's
+/// constructor.
+/// @param unknown The edit to cast.
+/// @return The edit.
+template<typename Edit, typename T>
+inline auto edit_cast(edit<T>& unknown) noexcept -> Edit&
+{
+   assert(unknown.kind() == edit_kind_of<Edit>);
+
+   return static_cast<Edit&>(unknown);
+}
+
+/// @brief Check if an edit can be coalesced with another. Edits of different kinds are
+/// rejected without calling is_coalescable.
+/// @param current The edit to coalesce into.
+/// @param other The new edit to check.
+/// @return True if the edit can be coalesced, false if it can not.
+template<typename T>
+inline bool can_coalesce(const edit<T>& current, const edit<T>& other) noexcept
+{
+   if (current.kind() != other.kind()) return false;
+
+   return current.is_coalescable(other);
+}
+
 }
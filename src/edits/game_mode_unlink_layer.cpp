@@ -1,6 +1,7 @@
 #pragma once
 
 #include "game_mode_unlink_layer.hpp"
+#include "journal_io.hpp"
 #include "utility/string_icompare.hpp"
 
 #include <cassert>
@@ -101,6 +102,15 @@ struct unlink_layer final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::game_mode_unlink_layer);
+      writer.write(_game_mode_index);
+      writer.write(_game_mode_layers_index);
+
+      return true;
+   }
+
 private:
    const int _game_mode_index;
    const int _game_mode_layers_index;
@@ -1,4 +1,6 @@
 #include "insert_entity.hpp"
+#include "journal_io.hpp"
+#include "memory_use.hpp"
 #include "world/utility/world_utilities.hpp"
 
 #include <algorithm>
@@ -18,6 +20,14 @@ struct insert_entity final : edit<world::edit_context> {
       auto& entities = world::select_entities<T>(context.world);
 
       entities.push_back(_entity);
+
+      // The entity's ID may not have come from this world's generator, such as when the
+      // edit is replayed from a journal. Keep later IDs from the generator unique.
+      world::select_id_generator<T>(context.world).skip_past(_id);
+      world::update_id_index<T>(context.world, entities.size() - 1);
+      world::index_entity_name(context.world, _entity);
+      world::record_change<T>(context.world, _id, world::change_type::insert,
+                              entities.size() - 1);
    }
 
    void revert(world::edit_context& context) const noexcept override
@@ -25,6 +35,11 @@ struct insert_entity final : edit<world::edit_context> {
       auto& entities = world::select_entities<T>(context.world);
 
       entities.pop_back();
+
+      world::unindex_entity_id<T>(context.world, _id, entities.size());
+      world::unindex_entity_name(context.world, _entity);
+      world::record_change<T>(context.world, _id, world::change_type::remove,
+                              entities.size());
    }
 
    bool is_coalescable([[maybe_unused]] const edit& other) const noexcept override
@@ -34,41 +49,23 @@ struct insert_entity final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
-private:
-   const world::id<T> _id;
-   const T _entity;
-};
-
-template<>
-struct insert_entity<world::planning_hub> final : edit<world::edit_context> {
-   insert_entity(world::planning_hub hub, const std::size_t hub_index)
-      : _id{hub.id}, _hub{std::move(hub)}, _index{hub_index}
-   {
-   }
-
-   void apply(world::edit_context& context) const noexcept override
+   bool write_journal(journal_writer& writer) const noexcept override
    {
-      context.world.planning_hubs.push_back(_hub);
-      context.world.planning_hub_index.emplace(_hub.id, _index);
-   }
+      writer.write(journal_edit_type::insert_entity);
+      writer.write_entity_type<T>();
+      writer.write(_entity);
 
-   void revert(world::edit_context& context) const noexcept override
-   {
-      context.world.planning_hubs.pop_back();
-      context.world.planning_hub_index.erase(_hub.id);
+      return true;
    }
 
-   bool is_coalescable([[maybe_unused]] const edit& other) const noexcept override
+   auto memory_use() const noexcept -> std::size_t override
    {
-      return false;
+      return sizeof(insert_entity) + heap_memory_use(_entity);
    }
 
-   void coalesce([[maybe_unused]] edit& other) noexcept override {}
-
 private:
-   const world::planning_hub_id _id;
-   const world::planning_hub _hub;
-   const std::size_t _index;
+   const world::id<T> _id;
+   const T _entity;
 };
 
 }
@@ -120,11 +117,10 @@ auto make_insert_entity(world::barrier barrier)
    return std::make_unique<insert_entity<world::barrier>>(std::move(barrier));
 }
 
-auto make_insert_entity(world::planning_hub planning_hub, std::size_t hub_index)
+auto make_insert_entity(world::planning_hub planning_hub)
    -> std::unique_ptr<edit<world::edit_context>>
 {
-   return std::make_unique<insert_entity<world::planning_hub>>(std::move(planning_hub),
-                                                               hub_index);
+   return std::make_unique<insert_entity<world::planning_hub>>(std::move(planning_hub));
 }
 
 auto make_insert_entity(world::planning_connection planning_connection)
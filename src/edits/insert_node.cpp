@@ -1,4 +1,5 @@
 #include "insert_node.hpp"
+#include "journal_io.hpp"
 #include "world/utility/world_utilities.hpp"
 
 namespace we::edits {
@@ -14,16 +15,20 @@ struct insert_path_node final : edit<world::edit_context> {
 
    void apply(world::edit_context& context) const noexcept override
    {
-      auto& nodes = world::find_entity(context.world.paths, _id)->nodes;
+      auto& nodes = world::find_entity<world::path>(context.world, _id)->nodes;
 
       nodes.insert(nodes.begin() + _insert_before_index, _node);
+
+      world::record_change<world::path>(context.world, _id, world::change_type::modify);
    }
 
    void revert(world::edit_context& context) const noexcept override
    {
-      auto& nodes = world::find_entity(context.world.paths, _id)->nodes;
+      auto& nodes = world::find_entity<world::path>(context.world, _id)->nodes;
 
       nodes.erase(nodes.begin() + _insert_before_index);
+
+      world::record_change<world::path>(context.world, _id, world::change_type::modify);
    }
 
    bool is_coalescable([[maybe_unused]] const edit& other) const noexcept override
@@ -33,6 +38,16 @@ struct insert_path_node final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::insert_node);
+      writer.write(_id);
+      writer.write(_insert_before_index);
+      writer.write(_node);
+
+      return true;
+   }
+
 private:
    const world::path_id _id;
    const std::size_t _insert_before_index;
@@ -1,4 +1,5 @@
 #include "insert_point.hpp"
+#include "journal_io.hpp"
 #include "world/utility/world_utilities.hpp"
 
 namespace we::edits {
@@ -14,16 +15,22 @@ struct insert_sector_point final : edit<world::edit_context> {
 
    void apply(world::edit_context& context) const noexcept override
    {
-      auto& points = world::find_entity(context.world.sectors, _id)->points;
+      auto& points = world::find_entity<world::sector>(context.world, _id)->points;
 
       points.insert(points.begin() + _insert_before_index, _point);
+
+      world::record_change<world::sector>(context.world, _id,
+                                          world::change_type::modify);
    }
 
    void revert(world::edit_context& context) const noexcept override
    {
-      auto& points = world::find_entity(context.world.sectors, _id)->points;
+      auto& points = world::find_entity<world::sector>(context.world, _id)->points;
 
       points.erase(points.begin() + _insert_before_index);
+
+      world::record_change<world::sector>(context.world, _id,
+                                          world::change_type::modify);
    }
 
    bool is_coalescable([[maybe_unused]] const edit& other) const noexcept override
@@ -33,6 +40,16 @@ struct insert_sector_point final : edit<world::edit_context> {
 
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::insert_point);
+      writer.write(_id);
+      writer.write(_insert_before_index);
+      writer.write(_point);
+
+      return true;
+   }
+
 private:
    const world::sector_id _id;
    const std::size_t _insert_before_index;
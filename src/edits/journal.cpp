@@ -0,0 +1,807 @@
+#include "journal.hpp"
+#include "add_game_mode.hpp"
+#include "add_layer.hpp"
+#include "add_property.hpp"
+#include "add_world_req_entry.hpp"
+#include "add_world_req_list.hpp"
+#include "bundle.hpp"
+#include "creation_entity_set.hpp"
+#include "delete_entity.hpp"
+#include "delete_game_mode.hpp"
+#include "delete_layer.hpp"
+#include "delete_world_req_entry.hpp"
+#include "delete_world_req_list.hpp"
+#include "game_mode_link_layer.hpp"
+#include "game_mode_unlink_layer.hpp"
+#include "insert_entity.hpp"
+#include "insert_node.hpp"
+#include "insert_point.hpp"
+#include "set_value.hpp"
+#include "ui_action.hpp"
+
+#include <stdexcept>
+
+namespace we::edits {
+
+namespace {
+
+constexpr uint32 journal_magic = 0x314a4557; // WEJ1
+constexpr uint32 journal_version = 1;
+
+/// @brief The operations recorded in a journal.
+enum class journal_op : uint8 {
+   apply = 0,
+   revert = 1,
+   reapply = 2,
+   close_last = 3,
+   clear = 4,
+};
+
+constexpr uint8 apply_flag_closed = 0b1;
+constexpr uint8 apply_flag_transparent = 0b10;
+
+using edit_ptr = std::unique_ptr<edit<world::edit_context>>;
+
+[[noreturn]] void throw_invalid_member()
+{
+   throw std::runtime_error{"Invalid member type in edit journal."};
+}
+
+template<typename T>
+constexpr bool is_vector_v = detail::is_instance_of<T, std::vector>::value;
+
+template<typename Entity>
+auto read_delete_entity(journal_reader& reader, const world::world& world) -> edit_ptr
+{
+   const world::id<Entity> id = reader.read<world::id<Entity>>();
+
+   if (not world::find_entity<Entity>(world, id)) {
+      throw std::runtime_error{"Edit journal deletes a missing entity."};
+   }
+
+   return make_delete_entity(id, world);
+}
+
+}
+
+journal::journal(const std::filesystem::path& path)
+   : _file{path, io::output_open_mode::create}
+{
+   _file.write_object(journal_magic);
+   _file.write_object(journal_version);
+   _file.flush();
+
+   _thread = std::jthread{[this](std::stop_token stop_token) { write_loop(stop_token); }};
+}
+
+journal::~journal()
+{
+   push_coalesced_record();
+
+   _thread.request_stop();
+   _thread.join();
+}
+
+void journal::applied(const edit<world::edit_context>& edit, const apply_flags flags,
+                      const bool coalesced) noexcept
+{
+   if (not coalesced) {
+      push_coalesced_record();
+
+      write_apply_record(_record, edit, flags);
+      push_record(_record);
+
+      return;
+   }
+
+   // Replaying only the last coalesced edit gives the same top edit. Transparency
+   // sticks to the top edit so it's carried over from the edits replaced.
+   const bool transparent =
+      flags.transparent or (_has_coalesced_record and _coalesced_record_transparent);
+
+   write_apply_record(_coalesced_record, edit,
+                      {.closed = flags.closed, .transparent = transparent});
+
+   _has_coalesced_record = true;
+   _coalesced_record_transparent = transparent;
+}
+
+void journal::reverted(const std::size_t count) noexcept
+{
+   if (count == 0) return;
+
+   push_coalesced_record();
+
+   _record.clear();
+   _record.write(journal_op::revert);
+   _record.write(static_cast<uint64>(count));
+
+   push_record(_record);
+}
+
+void journal::reapplied(const std::size_t count) noexcept
+{
+   if (count == 0) return;
+
+   push_coalesced_record();
+
+   _record.clear();
+   _record.write(journal_op::reapply);
+   _record.write(static_cast<uint64>(count));
+
+   push_record(_record);
+}
+
+void journal::closed_last() noexcept
+{
+   push_coalesced_record();
+
+   _record.clear();
+   _record.write(journal_op::close_last);
+
+   push_record(_record);
+}
+
+void journal::cleared() noexcept
+{
+   push_coalesced_record();
+
+   _record.clear();
+   _record.write(journal_op::clear);
+
+   push_record(_record);
+}
+
+void journal::flush() noexcept
+{
+   push_coalesced_record();
+
+   std::unique_lock lock{_mutex};
+
+   _written_condition.wait(lock, [&] { return _written_total == _pending_total; });
+}
+
+auto journal::record_count() const noexcept -> std::size_t
+{
+   return _record_count;
+}
+
+bool journal::has_unsupported_edit() const noexcept
+{
+   return _has_unsupported_edit;
+}
+
+void journal::write_apply_record(journal_writer& record,
+                                 const edit<world::edit_context>& edit,
+                                 const apply_flags flags) noexcept
+{
+   record.clear();
+   record.write(journal_op::apply);
+   record.write(static_cast<uint8>((flags.closed ? apply_flag_closed : 0) |
+                                   (flags.transparent ? apply_flag_transparent : 0)));
+
+   if (not edit.write_journal(record)) {
+      record.clear();
+      record.write(journal_op::apply);
+      record.write(uint8{0});
+      record.write(journal_edit_type::unsupported);
+
+      _has_unsupported_edit = true;
+   }
+}
+
+void journal::push_record(const journal_writer& record) noexcept
+{
+   const std::span<const std::byte> bytes = record.bytes();
+   const uint32 record_size = static_cast<uint32>(bytes.size());
+
+   {
+      std::scoped_lock lock{_mutex};
+
+      _pending.insert(_pending.end(), reinterpret_cast<const std::byte*>(&record_size),
+                      reinterpret_cast<const std::byte*>(&record_size) +
+                         sizeof(record_size));
+      _pending.insert(_pending.end(), bytes.begin(), bytes.end());
+      _pending_total += sizeof(record_size) + bytes.size();
+   }
+
+   _record_count += 1;
+
+   _pending_condition.notify_one();
+}
+
+void journal::push_coalesced_record() noexcept
+{
+   if (not _has_coalesced_record) return;
+
+   push_record(_coalesced_record);
+
+   _has_coalesced_record = false;
+   _coalesced_record_transparent = false;
+}
+
+void journal::write_loop(std::stop_token stop_token) noexcept
+{
+   std::vector<std::byte> writing;
+
+   while (true) {
+      {
+         std::unique_lock lock{_mutex};
+
+         _pending_condition.wait(lock, stop_token, [&] { return not _pending.empty(); });
+
+         // Stopping only exits once everything pending has been written.
+         if (_pending.empty()) return;
+
+         std::swap(writing, _pending);
+      }
+
+      _file.write(writing);
+      _file.flush();
+
+      {
+         std::scoped_lock lock{_mutex};
+
+         _written_total += writing.size();
+      }
+
+      writing.clear();
+
+      _written_condition.notify_all();
+   }
+}
+
+auto replay_journal(std::span<const std::byte> bytes, stack<world::edit_context>& stack,
+                    world::edit_context& context) noexcept -> journal_replay_result
+{
+   journal_replay_result result;
+   journal_reader reader{bytes};
+
+   try {
+      if (reader.read<uint32>() != journal_magic) {
+         result.error = "File is not an edit journal.";
+
+         return result;
+      }
+
+      if (reader.read<uint32>() != journal_version) {
+         result.error = "Unsupported edit journal version.";
+
+         return result;
+      }
+   }
+   catch (std::exception& e) {
+      result.error = e.what();
+
+      return result;
+   }
+
+   // A record that was cut off by a crash while it was being written is treated as the
+   // end of the journal.
+   while (reader.remaining() >= sizeof(uint32)) {
+      const uint32 record_size = reader.read<uint32>();
+
+      if (record_size > reader.remaining()) break;
+
+      journal_reader record{reader.read_bytes(record_size)};
+
+      try {
+         switch (record.read<journal_op>()) {
+         case journal_op::apply: {
+            const uint8 flags = record.read<uint8>();
+
+            edit_ptr edit = read_journal_edit(record, context.world);
+
+            if (not edit) {
+               result.error = "Edit journal contains an edit that can not be replayed.";
+
+               return result;
+            }
+
+            stack.apply(std::move(edit), context,
+                        {.closed = (flags & apply_flag_closed) != 0,
+                         .transparent = (flags & apply_flag_transparent) != 0});
+         } break;
+         case journal_op::revert: {
+            const uint64 count = record.read<uint64>();
+
+            if (stack.applied_size() < count) {
+               result.error = "Edit journal undoes edits made before it was started.";
+
+               return result;
+            }
+
+            stack.revert(count, context);
+         } break;
+         case journal_op::reapply: {
+            const uint64 count = record.read<uint64>();
+
+            if (stack.reverted_size() < count) {
+               result.error = "Edit journal redoes edits that were not undone.";
+
+               return result;
+            }
+
+            stack.reapply(count, context);
+         } break;
+         case journal_op::close_last: {
+            stack.close_last();
+         } break;
+         case journal_op::clear: {
+            stack.clear();
+         } break;
+         default:
+            result.error = "Invalid record in edit journal.";
+
+            return result;
+         }
+      }
+      catch (std::exception& e) {
+         result.error = e.what();
+
+         return result;
+      }
+
+      result.records += 1;
+   }
+
+   result.complete = true;
+
+   return result;
+}
+
+auto read_journal_edit(journal_reader& reader, const world::world& world) -> edit_ptr
+{
+   switch (reader.read<journal_edit_type>()) {
+   case journal_edit_type::unsupported:
+      return nullptr;
+   case journal_edit_type::bundle: {
+      const uint32 count = reader.read<uint32>();
+
+      if (count > reader.remaining()) {
+         throw std::runtime_error{"Unexpected end of edit journal."};
+      }
+
+      bundle_vector edits;
+
+      edits.reserve(count);
+
+      for (uint32 i = 0; i < count; ++i) {
+         edit_ptr edit = read_journal_edit(reader, world);
+
+         if (not edit) return nullptr;
+
+         edits.push_back(std::move(edit));
+      }
+
+      return make_bundle(std::move(edits));
+   }
+   case journal_edit_type::add_game_mode:
+      return make_add_game_mode(reader.read<std::string>(), world);
+   case journal_edit_type::add_layer:
+      return make_add_layer(reader.read<std::string>(), world);
+   case journal_edit_type::add_property_path: {
+      const world::path_id id = reader.read<world::path_id>();
+
+      return make_add_property(id, reader.read<std::string>());
+   }
+   case journal_edit_type::add_property_path_node: {
+      const world::path_id id = reader.read<world::path_id>();
+      const std::size_t node = reader.read<std::size_t>();
+
+      return make_add_property(id, node, reader.read<std::string>());
+   }
+   case journal_edit_type::add_world_req_entry: {
+      const int list_index = reader.read<int>();
+
+      return make_add_world_req_entry(list_index, reader.read<std::string>());
+   }
+   case journal_edit_type::add_world_req_list:
+      return make_add_world_req_list(reader.read<std::string>());
+   case journal_edit_type::creation_entity_set: {
+      auto new_creation_entity = reader.read<std::optional<world::creation_entity>>();
+      auto old_creation_entity = reader.read<std::optional<world::creation_entity>>();
+
+      return make_creation_entity_set(std::move(new_creation_entity),
+                                      std::move(old_creation_entity));
+   }
+   case journal_edit_type::delete_entity:
+      return reader.read_entity_type([&]<typename Entity>(std::type_identity<Entity>) {
+         if constexpr (std::is_same_v<Entity, world::path>) {
+            // Paths are deleted through delete_path_node.
+            throw std::runtime_error{"Invalid entity type in edit journal."};
+
+            return edit_ptr{};
+         }
+         else {
+            return read_delete_entity<Entity>(reader, world);
+         }
+      });
+   case journal_edit_type::delete_path_node: {
+      const uint32 path_index = reader.read<uint32>();
+      const uint32 node_index = reader.read<uint32>();
+
+      if (path_index >= world.paths.size() or
+          node_index >= world.paths[path_index].nodes.size()) {
+         throw std::runtime_error{"Edit journal deletes a missing path node."};
+      }
+
+      return make_delete_entity(world::path_id_node_pair{world.paths[path_index].id,
+                                                         node_index},
+                                world);
+   }
+   case journal_edit_type::delete_game_mode: {
+      const int index = reader.read<int>();
+
+      if (index < 0 or index >= std::ssize(world.game_modes)) {
+         throw std::runtime_error{"Edit journal deletes a missing game mode."};
+      }
+
+      return make_delete_game_mode(index, world);
+   }
+   case journal_edit_type::delete_layer: {
+      const int index = reader.read<int>();
+
+      if (index < 0 or index >= std::ssize(world.layer_descriptions)) {
+         throw std::runtime_error{"Edit journal deletes a missing layer."};
+      }
+
+      return make_delete_layer(index, world);
+   }
+   case journal_edit_type::delete_world_req_entry: {
+      const int list_index = reader.read<int>();
+      const int entry_index = reader.read<int>();
+
+      if (list_index < 0 or list_index >= std::ssize(world.requirements) or
+          entry_index < 0 or
+          entry_index >= std::ssize(world.requirements[list_index].entries)) {
+         throw std::runtime_error{"Edit journal deletes a missing requirement."};
+      }
+
+      return make_delete_world_req_entry(list_index, entry_index, world);
+   }
+   case journal_edit_type::delete_world_req_list: {
+      const int list_index = reader.read<int>();
+
+      if (list_index < 0 or list_index >= std::ssize(world.requirements)) {
+         throw std::runtime_error{"Edit journal deletes a missing requirement list."};
+      }
+
+      return make_delete_world_req_list(list_index, world);
+   }
+   case journal_edit_type::game_mode_link_layer: {
+      const int game_mode_index = reader.read<int>();
+      const int layer_index = reader.read<int>();
+
+      if (game_mode_index < 0 or game_mode_index >= std::ssize(world.game_modes) or
+          layer_index < 0 or layer_index >= std::ssize(world.layer_descriptions)) {
+         throw std::runtime_error{"Edit journal links a missing layer or game mode."};
+      }
+
+      return make_game_mode_link_layer(game_mode_index, layer_index, world);
+   }
+   case journal_edit_type::game_mode_unlink_layer: {
+      const int game_mode_index = reader.read<int>();
+      const int game_mode_layers_index = reader.read<int>();
+
+      if (game_mode_index < 0 or game_mode_index >= std::ssize(world.game_modes) or
+          game_mode_layers_index < 0 or
+          game_mode_layers_index >=
+             std::ssize(world.game_modes[game_mode_index].layers)) {
+         throw std::runtime_error{"Edit journal unlinks a missing layer or game mode."};
+      }
+
+      return make_game_mode_unlink_layer(game_mode_index, game_mode_layers_index, world);
+   }
+   case journal_edit_type::insert_entity:
+      return reader.read_entity_type([&]<typename Entity>(std::type_identity<Entity>) {
+         return make_insert_entity(reader.read<Entity>());
+      });
+   case journal_edit_type::insert_node: {
+      const world::path_id id = reader.read<world::path_id>();
+      const std::size_t insert_before_index = reader.read<std::size_t>();
+
+      return make_insert_node(id, insert_before_index, reader.read<world::path::node>());
+   }
+   case journal_edit_type::insert_point: {
+      const world::sector_id id = reader.read<world::sector_id>();
+      const std::size_t insert_before_index = reader.read<std::size_t>();
+
+      return make_insert_point(id, insert_before_index, reader.read<float2>());
+   }
+   case journal_edit_type::set_value:
+      return reader.read_entity_type([&]<typename Entity>(std::type_identity<Entity>) {
+         return reader.read_member<Entity>([&]<typename T>(T Entity::*member) -> edit_ptr {
+            const world::id<Entity> id = reader.read<world::id<Entity>>();
+            T new_value = reader.read<T>();
+            T original_value = reader.read<T>();
+
+            return make_set_value(id, member, std::move(new_value),
+                                  std::move(original_value));
+         });
+      });
+   case journal_edit_type::set_values:
+      return reader.read_entity_type([&]<typename Entity>(std::type_identity<Entity>) {
+         return reader.read_member<Entity>([&]<typename T>(T Entity::*member) -> edit_ptr {
+            auto ids = reader.read<std::vector<world::id<Entity>>>();
+            auto new_values = reader.read<std::vector<T>>();
+            auto original_values = reader.read<std::vector<T>>();
+
+            if (ids.size() != new_values.size() or ids.size() != original_values.size()) {
+               throw std::runtime_error{"Mismatched values in edit journal."};
+            }
+
+            return make_set_values(std::move(ids), member, std::move(new_values),
+                                   std::move(original_values));
+         });
+      });
+   case journal_edit_type::set_path_node_value:
+      return reader.read_member<world::path::node>(
+         [&]<typename T>(T world::path::node::*member) -> edit_ptr {
+            const world::path_id id = reader.read<world::path_id>();
+            const std::size_t node = reader.read<std::size_t>();
+            T new_value = reader.read<T>();
+            T original_value = reader.read<T>();
+
+            return make_set_path_node_value(id, node, member, std::move(new_value),
+                                            std::move(original_value));
+         });
+   case journal_edit_type::set_global_lights_value:
+      return reader.read_member<world::global_lights>(
+         [&]<typename T>(T world::global_lights::*member) -> edit_ptr {
+            T new_value = reader.read<T>();
+            T original_value = reader.read<T>();
+
+            return make_set_global_lights_value(member, std::move(new_value),
+                                                std::move(original_value));
+         });
+   case journal_edit_type::set_creation_value:
+      return reader.read_entity_type([&]<typename Entity>(std::type_identity<Entity>) {
+         return reader.read_member<Entity>([&]<typename T>(T Entity::*member) -> edit_ptr {
+            T new_value = reader.read<T>();
+            T original_value = reader.read<T>();
+
+            return make_set_creation_value(member, std::move(new_value),
+                                           std::move(original_value));
+         });
+      });
+   case journal_edit_type::set_creation_value_with_meta:
+      return reader.read_entity_type([&]<typename Entity>(std::type_identity<Entity>) {
+         return reader.read_member<Entity>([&]<typename T>(T Entity::*member) {
+            return reader.read_member<world::edit_context>(
+               [&]<typename U>(U world::edit_context::*meta_member) -> edit_ptr {
+                  T new_value = reader.read<T>();
+                  T original_value = reader.read<T>();
+                  U meta_new_value = reader.read<U>();
+                  U meta_original_value = reader.read<U>();
+
+                  return make_set_creation_value_with_meta(member, std::move(new_value),
+                                                           std::move(original_value),
+                                                           meta_member,
+                                                           std::move(meta_new_value),
+                                                           std::move(meta_original_value));
+               });
+         });
+      });
+   case journal_edit_type::set_creation_location:
+      return reader.read_entity_type([&]<typename Entity>(std::type_identity<Entity>) {
+         if constexpr (requires(Entity entity) {
+                          entity.rotation = quaternion{};
+                          entity.position = float3{};
+                       }) {
+            const auto new_rotation = reader.read<quaternion>();
+            const auto original_rotation = reader.read<quaternion>();
+            const auto new_position = reader.read<float3>();
+            const auto original_position = reader.read<float3>();
+            const auto new_euler_rotation = reader.read<float3>();
+            const auto original_euler_rotation = reader.read<float3>();
+
+            return edit_ptr{
+               make_set_creation_location<Entity>(new_rotation, original_rotation,
+                                                  new_position, original_position,
+                                                  new_euler_rotation,
+                                                  original_euler_rotation)};
+         }
+         else {
+            throw std::runtime_error{"Invalid entity type in edit journal."};
+
+            return edit_ptr{};
+         }
+      });
+   case journal_edit_type::set_creation_path_node_value:
+      return reader.read_member<world::path::node>(
+         [&]<typename T>(T world::path::node::*member) -> edit_ptr {
+            T new_value = reader.read<T>();
+            T original_value = reader.read<T>();
+
+            return make_set_creation_path_node_value(member, std::move(new_value),
+                                                     std::move(original_value));
+         });
+   case journal_edit_type::set_instance_property_value: {
+      const world::object_id id = reader.read<world::object_id>();
+      const std::size_t property_index = reader.read<std::size_t>();
+      std::string new_value = reader.read<std::string>();
+      std::string original_value = reader.read<std::string>();
+
+      return make_set_instance_property_value(id, property_index, std::move(new_value),
+                                              std::move(original_value));
+   }
+   case journal_edit_type::set_creation_path_node_location: {
+      const auto new_rotation = reader.read<quaternion>();
+      const auto original_rotation = reader.read<quaternion>();
+      const auto new_position = reader.read<float3>();
+      const auto original_position = reader.read<float3>();
+      const auto new_euler_rotation = reader.read<float3>();
+      const auto original_euler_rotation = reader.read<float3>();
+
+      return make_set_creation_path_node_location(new_rotation, original_rotation,
+                                                  new_position, original_position,
+                                                  new_euler_rotation,
+                                                  original_euler_rotation);
+   }
+   case journal_edit_type::set_creation_region_metrics: {
+      const auto new_rotation = reader.read<quaternion>();
+      const auto original_rotation = reader.read<quaternion>();
+      const auto new_position = reader.read<float3>();
+      const auto original_position = reader.read<float3>();
+      const auto new_size = reader.read<float3>();
+      const auto original_size = reader.read<float3>();
+
+      return make_set_creation_region_metrics(new_rotation, original_rotation,
+                                              new_position, original_position,
+                                              new_size, original_size);
+   }
+   case journal_edit_type::set_creation_sector_point: {
+      const auto new_position = reader.read<float2>();
+      const auto original_position = reader.read<float2>();
+
+      return make_set_creation_sector_point(new_position, original_position);
+   }
+   case journal_edit_type::set_creation_portal_size: {
+      const auto new_width = reader.read<float>();
+      const auto original_width = reader.read<float>();
+      const auto new_height = reader.read<float>();
+      const auto original_height = reader.read<float>();
+
+      return make_set_creation_portal_size(new_width, original_width, new_height,
+                                           original_height);
+   }
+   case journal_edit_type::set_creation_barrier_metrics: {
+      const auto new_rotation = reader.read<float>();
+      const auto original_rotation = reader.read<float>();
+      const auto new_position = reader.read<float3>();
+      const auto original_position = reader.read<float3>();
+      const auto new_size = reader.read<float2>();
+      const auto original_size = reader.read<float2>();
+
+      return make_set_creation_barrier_metrics(new_rotation, original_rotation,
+                                               new_position, original_position,
+                                               new_size, original_size);
+   }
+   case journal_edit_type::ui_edit:
+      return reader.read_entity_type([&]<typename Entity>(std::type_identity<Entity>) {
+         return reader.read_member<Entity>([&]<typename T>(T Entity::*member) -> edit_ptr {
+            const world::id<Entity> id = reader.read<world::id<Entity>>();
+            T new_value = reader.read<T>();
+            T original_value = reader.read<T>();
+
+            return std::make_unique<ui_edit<Entity, T>>(id, member, std::move(new_value),
+                                                        std::move(original_value));
+         });
+      });
+   case journal_edit_type::ui_edit_indexed:
+      return reader.read_entity_type([&]<typename Entity>(std::type_identity<Entity>) {
+         return reader.read_member<Entity>([&]<typename T>(T Entity::*member) -> edit_ptr {
+            if constexpr (is_vector_v<T>) {
+               using value_type = typename T::value_type;
+
+               const world::id<Entity> id = reader.read<world::id<Entity>>();
+               const std::size_t item_index = reader.read<std::size_t>();
+               value_type new_value = reader.read<value_type>();
+               value_type original_value = reader.read<value_type>();
+
+               return std::make_unique<ui_edit_indexed<Entity, value_type>>(
+                  id, member, item_index, std::move(new_value),
+                  std::move(original_value));
+            }
+            else {
+               throw_invalid_member();
+            }
+         });
+      });
+   case journal_edit_type::ui_edit_path_node:
+      return reader.read_member<world::path::node>(
+         [&]<typename T>(T world::path::node::*member) -> edit_ptr {
+            const world::path_id id = reader.read<world::path_id>();
+            const std::size_t node_index = reader.read<std::size_t>();
+            T new_value = reader.read<T>();
+            T original_value = reader.read<T>();
+
+            return std::make_unique<ui_edit_path_node<T>>(id, node_index, member,
+                                                          std::move(new_value),
+                                                          std::move(original_value));
+         });
+   case journal_edit_type::ui_edit_path_node_indexed:
+      return reader.read_member<world::path::node>(
+         [&]<typename T>(T world::path::node::*member) -> edit_ptr {
+            if constexpr (is_vector_v<T>) {
+               using value_type = typename T::value_type;
+
+               const world::path_id id = reader.read<world::path_id>();
+               const std::size_t node_index = reader.read<std::size_t>();
+               const std::size_t item_index = reader.read<std::size_t>();
+               value_type new_value = reader.read<value_type>();
+               value_type original_value = reader.read<value_type>();
+
+               return std::make_unique<ui_edit_path_node_indexed<value_type>>(
+                  id, node_index, member, item_index, std::move(new_value),
+                  std::move(original_value));
+            }
+            else {
+               throw_invalid_member();
+            }
+         });
+   case journal_edit_type::ui_creation_edit:
+      return reader.read_entity_type([&]<typename Entity>(std::type_identity<Entity>) {
+         return reader.read_member<Entity>([&]<typename T>(T Entity::*member) -> edit_ptr {
+            T new_value = reader.read<T>();
+            T original_value = reader.read<T>();
+
+            return std::make_unique<ui_creation_edit<Entity, T>>(member,
+                                                                 std::move(new_value),
+                                                                 std::move(original_value));
+         });
+      });
+   case journal_edit_type::ui_creation_edit_with_meta:
+      return reader.read_entity_type([&]<typename Entity>(std::type_identity<Entity>) {
+         return reader.read_member<Entity>([&]<typename T>(T Entity::*member) {
+            return reader.read_member<world::edit_context>(
+               [&]<typename U>(U world::edit_context::*meta_member) -> edit_ptr {
+                  T new_value = reader.read<T>();
+                  T original_value = reader.read<T>();
+                  U meta_new_value = reader.read<U>();
+                  U meta_original_value = reader.read<U>();
+
+                  return std::make_unique<ui_creation_edit_with_meta<Entity, T, U>>(
+                     member, std::move(new_value), std::move(original_value),
+                     meta_member, std::move(meta_new_value),
+                     std::move(meta_original_value));
+               });
+         });
+      });
+   case journal_edit_type::ui_creation_path_node_edit:
+      return reader.read_member<world::path::node>(
+         [&]<typename T>(T world::path::node::*member) -> edit_ptr {
+            T new_value = reader.read<T>();
+            T original_value = reader.read<T>();
+
+            return std::make_unique<ui_creation_path_node_edit<T>>(member,
+                                                                   std::move(new_value),
+                                                                   std::move(original_value));
+         });
+   case journal_edit_type::ui_creation_path_node_edit_with_meta:
+      return reader.read_member<world::path::node>([&]<typename T>(T world::path::node::*member) {
+         return reader.read_member<world::edit_context>(
+            [&]<typename U>(U world::edit_context::*meta_member) -> edit_ptr {
+               T new_value = reader.read<T>();
+               T original_value = reader.read<T>();
+               U meta_new_value = reader.read<U>();
+               U meta_original_value = reader.read<U>();
+
+               return std::make_unique<ui_creation_path_node_edit_with_meta<T, U>>(
+                  member, std::move(new_value), std::move(original_value), meta_member,
+                  std::move(meta_new_value), std::move(meta_original_value));
+            });
+      });
+   case journal_edit_type::ui_creation_sector_point_edit: {
+      const auto new_value = reader.read<float2>();
+      const auto original_value = reader.read<float2>();
+
+      return std::make_unique<ui_creation_sector_point_edit>(new_value, original_value);
+   }
+   }
+
+   throw std::runtime_error{"Invalid edit type in edit journal."};
+}
+
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "edit.hpp"
+#include "io/output_file.hpp"
+#include "journal_io.hpp"
+#include "stack.hpp"
+#include "world/interaction_context.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace we::edits {
+
+/// @brief Records the operations performed on a world's edit stack to a file as they
+/// happen. The file can be replayed onto the world as it was when the journal was started
+/// to recover edits after a crash or to reproduce an editing session (such as for
+/// benchmarking).
+///
+/// Records are serialized on the thread that uses the edit stack and written to the file
+/// by a background thread so journaling never waits on the disk.
+///
+/// Coalescing keeps the new values of the later edit so only the last edit coalesced
+/// into the top of the stack is journaled. It's held back until another operation
+/// supersedes it, dragging an object journals the start and end of the drag instead of
+/// every frame. A crash loses the held back edit.
+class journal final : public stack_listener<world::edit_context> {
+public:
+   /// @brief Start a journal, replacing any existing file.
+   /// @param path The path to the journal file.
+   explicit journal(const std::filesystem::path& path);
+
+   journal(const journal&) = delete;
+   auto operator=(const journal&) -> journal& = delete;
+
+   journal(journal&&) = delete;
+   auto operator=(journal&&) -> journal& = delete;
+
+   /// @brief Writes any pending records and closes the journal.
+   ~journal();
+
+   void applied(const edit<world::edit_context>& edit, const apply_flags flags,
+                const bool coalesced) noexcept override;
+
+   void reverted(const std::size_t count) noexcept override;
+
+   void reapplied(const std::size_t count) noexcept override;
+
+   void closed_last() noexcept override;
+
+   void cleared() noexcept override;
+
+   /// @brief Wait for every record to be written to the file, including any held back
+   /// coalesced edit.
+   void flush() noexcept;
+
+   /// @brief The number of records in the journal. A held back coalesced edit isn't
+   /// counted until it's written.
+   auto record_count() const noexcept -> std::size_t;
+
+   /// @brief Check if an edit that can not be journaled has been recorded. Replaying the
+   /// journal will stop at the first such edit.
+   bool has_unsupported_edit() const noexcept;
+
+private:
+   void write_apply_record(journal_writer& record, const edit<world::edit_context>& edit,
+                           const apply_flags flags) noexcept;
+
+   void push_record(const journal_writer& record) noexcept;
+
+   void push_coalesced_record() noexcept;
+
+   void write_loop(std::stop_token stop_token) noexcept;
+
+   journal_writer _record;
+   journal_writer _coalesced_record;
+   bool _has_coalesced_record = false;
+   bool _coalesced_record_transparent = false;
+   std::size_t _record_count = 0;
+   bool _has_unsupported_edit = false;
+
+   io::output_file _file;
+
+   std::mutex _mutex;
+   std::condition_variable_any _pending_condition;
+   std::condition_variable _written_condition;
+   std::vector<std::byte> _pending;
+   std::size_t _pending_total = 0;
+   std::size_t _written_total = 0;
+
+   std::jthread _thread;
+};
+
+/// @brief The result of replaying a journal.
+struct journal_replay_result {
+   /// @brief The number of records replayed.
+   std::size_t records = 0;
+
+   /// @brief True if every record in the journal was replayed.
+   bool complete = false;
+
+   /// @brief Why replaying stopped early, empty if the journal was completely replayed.
+   std::string error;
+};
+
+/// @brief Replay a journal onto an edit stack. Replaying stops at records that can not be
+/// replayed, such as edits that could not be journaled or reverts of edits made before the
+/// journal was started. Records cut off by the journal not being closed are ignored.
+/// @param bytes The contents of the journal file.
+/// @param stack The edit stack to replay the journal onto.
+/// @param context The edit context, this must match the world the journal was started with.
+/// @return The result of the replay.
+auto replay_journal(std::span<const std::byte> bytes, stack<world::edit_context>& stack,
+                    world::edit_context& context) noexcept -> journal_replay_result;
+
+/// @brief Read an edit written by edit::write_journal.
+/// @param reader The reader to read the edit from.
+/// @param world The world the edit will be applied to. Used to reconstruct edits that depend on it.
+/// @return The edit or nullptr if the edit was unsupported when it was written.
+auto read_journal_edit(journal_reader& reader, const world::world& world)
+   -> std::unique_ptr<edit<world::edit_context>>;
+
+}
@@ -0,0 +1,567 @@
+#pragma once
+
+#include "types.hpp"
+#include "world/interaction_context.hpp"
+#include "world/world.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace we::edits {
+
+/// @brief Identifies the type of edit in an edit journal record. Values are written to
+/// journals so existing ones must not be changed or reordered.
+enum class journal_edit_type : uint16 {
+   unsupported = 0,
+
+   bundle = 1,
+
+   add_game_mode = 2,
+   add_layer = 3,
+   add_property_path = 4,
+   add_property_path_node = 5,
+   add_world_req_entry = 6,
+   add_world_req_list = 7,
+   creation_entity_set = 8,
+   delete_entity = 9,
+   delete_path_node = 10,
+   delete_game_mode = 11,
+   delete_layer = 12,
+   delete_world_req_entry = 13,
+   delete_world_req_list = 14,
+   game_mode_link_layer = 15,
+   game_mode_unlink_layer = 16,
+   insert_entity = 17,
+   insert_node = 18,
+   insert_point = 19,
+
+   set_value = 20,
+   set_values = 21,
+   set_path_node_value = 22,
+   set_global_lights_value = 23,
+   set_creation_value = 24,
+   set_creation_value_with_meta = 25,
+   set_creation_location = 26,
+   set_creation_path_node_value = 27,
+   set_instance_property_value = 28,
+   set_creation_path_node_location = 29,
+   set_creation_region_metrics = 30,
+   set_creation_sector_point = 31,
+   set_creation_portal_size = 32,
+   set_creation_barrier_metrics = 33,
+
+   ui_edit = 34,
+   ui_edit_indexed = 35,
+   ui_edit_path_node = 36,
+   ui_edit_path_node_indexed = 37,
+   ui_creation_edit = 38,
+   ui_creation_edit_with_meta = 39,
+   ui_creation_path_node_edit = 40,
+   ui_creation_path_node_edit_with_meta = 41,
+   ui_creation_sector_point_edit = 42,
+};
+
+/// @brief The members of a struct written to journals, in order. Specialized for every
+/// struct that can be written. Edits that hold member pointers write them as an index
+/// into this.
+template<typename T>
+inline constexpr std::nullptr_t journal_members = nullptr;
+
+template<>
+inline constexpr auto journal_members<world::instance_property> =
+   std::tuple{&world::instance_property::key,
+              &world::instance_property::value};
+
+template<>
+inline constexpr auto journal_members<world::object> =
+   std::tuple{&world::object::name,
+              &world::object::layer,
+              &world::object::rotation,
+              &world::object::position,
+              &world::object::team,
+              &world::object::class_name,
+              &world::object::instance_properties,
+              &world::object::id};
+
+template<>
+inline constexpr auto journal_members<world::light> =
+   std::tuple{&world::light::name,
+              &world::light::layer,
+              &world::light::rotation,
+              &world::light::position,
+              &world::light::color,
+              &world::light::static_,
+              &world::light::shadow_caster,
+              &world::light::specular_caster,
+              &world::light::light_type,
+              &world::light::texture_addressing,
+              &world::light::range,
+              &world::light::inner_cone_angle,
+              &world::light::outer_cone_angle,
+              &world::light::directional_texture_tiling,
+              &world::light::directional_texture_offset,
+              &world::light::texture,
+              &world::light::region_name,
+              &world::light::region_size,
+              &world::light::region_rotation,
+              &world::light::id};
+
+template<>
+inline constexpr auto journal_members<world::path::property> =
+   std::tuple{&world::path::property::key,
+              &world::path::property::value};
+
+template<>
+inline constexpr auto journal_members<world::path::node> =
+   std::tuple{&world::path::node::rotation,
+              &world::path::node::position,
+              &world::path::node::properties};
+
+template<>
+inline constexpr auto journal_members<world::path> =
+   std::tuple{&world::path::name,
+              &world::path::layer,
+              &world::path::type,
+              &world::path::spline_type,
+              &world::path::properties,
+              &world::path::nodes,
+              &world::path::id};
+
+template<>
+inline constexpr auto journal_members<world::region> =
+   std::tuple{&world::region::name,
+              &world::region::layer,
+              &world::region::rotation,
+              &world::region::position,
+              &world::region::size,
+              &world::region::shape,
+              &world::region::description,
+              &world::region::id};
+
+template<>
+inline constexpr auto journal_members<world::sector> =
+   std::tuple{&world::sector::name,
+              &world::sector::base,
+              &world::sector::height,
+              &world::sector::points,
+              &world::sector::objects,
+              &world::sector::id};
+
+template<>
+inline constexpr auto journal_members<world::portal> =
+   std::tuple{&world::portal::name,
+              &world::portal::rotation,
+              &world::portal::position,
+              &world::portal::width,
+              &world::portal::height,
+              &world::portal::sector1,
+              &world::portal::sector2,
+              &world::portal::id};
+
+template<>
+inline constexpr auto journal_members<world::hintnode> =
+   std::tuple{&world::hintnode::name,
+              &world::hintnode::layer,
+              &world::hintnode::rotation,
+              &world::hintnode::position,
+              &world::hintnode::type,
+              &world::hintnode::mode,
+              &world::hintnode::radius,
+              &world::hintnode::primary_stance,
+              &world::hintnode::secondary_stance,
+              &world::hintnode::command_post,
+              &world::hintnode::id};
+
+template<>
+inline constexpr auto journal_members<world::barrier> =
+   std::tuple{&world::barrier::name,
+              &world::barrier::position,
+              &world::barrier::size,
+              &world::barrier::rotation_angle,
+              &world::barrier::flags,
+              &world::barrier::id};
+
+template<>
+inline constexpr auto journal_members<world::planning_hub> =
+   std::tuple{&world::planning_hub::name,
+              &world::planning_hub::position,
+              &world::planning_hub::radius,
+              &world::planning_hub::id};
+
+template<>
+inline constexpr auto journal_members<world::planning_connection> =
+   std::tuple{&world::planning_connection::name,
+              &world::planning_connection::start,
+              &world::planning_connection::end,
+              &world::planning_connection::flags,
+              &world::planning_connection::jump,
+              &world::planning_connection::jet_jump,
+              &world::planning_connection::one_way,
+              &world::planning_connection::dynamic_group,
+              &world::planning_connection::forward_weights,
+              &world::planning_connection::backward_weights,
+              &world::planning_connection::id};
+
+template<>
+inline constexpr auto journal_members<world::boundary> =
+   std::tuple{&world::boundary::name,
+              &world::boundary::position,
+              &world::boundary::size,
+              &world::boundary::id};
+
+template<>
+inline constexpr auto journal_members<world::global_lights> =
+   std::tuple{&world::global_lights::global_light_1,
+              &world::global_lights::global_light_2,
+              &world::global_lights::ambient_sky_color,
+              &world::global_lights::ambient_ground_color,
+              &world::global_lights::env_map_texture};
+
+template<>
+inline constexpr auto journal_members<world::requirement_list> =
+   std::tuple{&world::requirement_list::file_type,
+              &world::requirement_list::platform,
+              &world::requirement_list::alignment,
+              &world::requirement_list::entries};
+
+template<>
+inline constexpr auto journal_members<world::edit_context> =
+   std::tuple{&world::edit_context::euler_rotation,
+              &world::edit_context::light_region_euler_rotation};
+
+namespace detail {
+
+template<typename T, template<typename...> typename Template>
+struct is_instance_of : std::false_type {};
+
+template<template<typename...> typename Template, typename... Args>
+struct is_instance_of<Template<Args...>, Template> : std::true_type {};
+
+template<typename T, typename Variant>
+inline constexpr std::size_t variant_index = 0;
+
+template<typename T, typename... Types>
+inline constexpr std::size_t variant_index<T, std::variant<Types...>> = [] {
+   std::size_t index = 0;
+
+   ((std::is_same_v<T, Types> ? false : (index += 1, true)) and ...);
+
+   return index;
+}();
+
+template<typename T>
+concept has_journal_members =
+   not std::is_same_v<std::remove_cvref_t<decltype(journal_members<T>)>, std::nullptr_t>;
+
+/// @brief Converts to any type, used to count the members of an aggregate.
+struct any_member {
+   template<typename T>
+   operator T() const noexcept;
+};
+
+/// @brief The number of members of an aggregate. Counted as the most initializers the
+/// aggregate can be brace initialized from.
+template<typename T, typename... Initializers>
+consteval auto aggregate_member_count() noexcept -> std::size_t
+{
+   if constexpr (requires { T{Initializers{}..., any_member{}}; }) {
+      return aggregate_member_count<T, Initializers..., any_member>();
+   }
+   else {
+      return sizeof...(Initializers);
+   }
+}
+
+/// @brief Check that journal_members lists every member of a struct. A member added to
+/// a struct but not journal_members would otherwise silently not be journaled.
+template<typename T>
+inline constexpr bool has_complete_journal_members =
+   std::tuple_size_v<std::remove_cvref_t<decltype(journal_members<T>)>> ==
+   aggregate_member_count<T>();
+
+}
+
+/// @brief Writes edits and the values they hold to a byte buffer for an edit journal.
+class journal_writer {
+public:
+   /// @brief Write a value. Supports trivially copyable types, strings, vectors,
+   /// optionals, variants and structs with journal_members.
+   /// @param value The value to write.
+   template<typename T>
+   void write(const T& value) noexcept
+   {
+      if constexpr (detail::has_journal_members<T>) {
+         static_assert(detail::has_complete_journal_members<T>,
+                       "journal_members is missing members of the type.");
+
+         std::apply([&](const auto... members) { (write(value.*members), ...); },
+                    journal_members<T>);
+      }
+      else if constexpr (std::is_base_of_v<std::string, T>) {
+         write(static_cast<uint32>(value.size()));
+         write_bytes(value.data(), value.size());
+      }
+      else if constexpr (detail::is_instance_of<T, std::vector>::value) {
+         write(static_cast<uint32>(value.size()));
+
+         for (const auto& element : value) write(element);
+      }
+      else if constexpr (detail::is_instance_of<T, std::optional>::value) {
+         write(value.has_value());
+
+         if (value) write(*value);
+      }
+      else if constexpr (detail::is_instance_of<T, std::variant>::value) {
+         write(static_cast<uint8>(value.index()));
+
+         std::visit([&](const auto& alternative) { write(alternative); }, value);
+      }
+      else {
+         static_assert(std::is_trivially_copyable_v<T> and not std::is_pointer_v<T>,
+                       "Type can not be written to a journal.");
+
+         write_bytes(&value, sizeof(T));
+      }
+   }
+
+   /// @brief Write a member pointer as its index in journal_members. Members missing
+   /// from journal_members are written as an invalid index that fails to read.
+   /// @param member The member pointer.
+   template<typename Struct, typename T>
+   void write_member(T Struct::*member) noexcept
+   {
+      uint8 member_index = std::numeric_limits<uint8>::max();
+      uint8 i = 0;
+
+      std::apply(
+         [&](const auto... members) {
+            (
+               [&](const auto other_member) {
+                  if constexpr (std::is_same_v<std::remove_const_t<decltype(other_member)>,
+                                               T Struct::*>) {
+                     if (other_member == member) member_index = i;
+                  }
+
+                  i += 1;
+               }(members),
+               ...);
+         },
+         journal_members<Struct>);
+
+      write(member_index);
+   }
+
+   /// @brief Write the index of an entity type in world::creation_entity. Used by edits
+   /// templated on an entity type.
+   template<typename Entity>
+   void write_entity_type() noexcept
+   {
+      write(static_cast<uint8>(detail::variant_index<Entity, world::creation_entity>));
+   }
+
+   /// @brief The bytes written.
+   auto bytes() const noexcept -> std::span<const std::byte>
+   {
+      return _bytes;
+   }
+
+   /// @brief Clear the written bytes while keeping the allocated memory.
+   void clear() noexcept
+   {
+      _bytes.clear();
+   }
+
+private:
+   void write_bytes(const void* data, const std::size_t size) noexcept
+   {
+      const std::size_t offset = _bytes.size();
+
+      _bytes.resize(offset + size);
+
+      if (size != 0) std::memcpy(_bytes.data() + offset, data, size);
+   }
+
+   std::vector<std::byte> _bytes;
+};
+
+/// @brief Reads values written by journal_writer. Throws std::runtime_error when reading
+/// past the end of the bytes.
+class journal_reader {
+public:
+   explicit journal_reader(const std::span<const std::byte> bytes) noexcept
+      : _bytes{bytes}
+   {
+   }
+
+   /// @brief Read a value.
+   template<typename T>
+   auto read() -> T
+   {
+      T value{};
+
+      read(value);
+
+      return value;
+   }
+
+   /// @brief Read a value.
+   /// @param out The value to read into.
+   template<typename T>
+   void read(T& out)
+   {
+      if constexpr (detail::has_journal_members<T>) {
+         static_assert(detail::has_complete_journal_members<T>,
+                       "journal_members is missing members of the type.");
+
+         std::apply([&](const auto... members) { (read(out.*members), ...); },
+                    journal_members<T>);
+      }
+      else if constexpr (std::is_base_of_v<std::string, T>) {
+         const std::span<const std::byte> bytes = read_bytes(read<uint32>());
+
+         static_cast<std::string&>(out).assign(reinterpret_cast<const char*>(bytes.data()),
+                                               bytes.size());
+      }
+      else if constexpr (detail::is_instance_of<T, std::vector>::value) {
+         const uint32 size = read<uint32>();
+
+         if (size > remaining()) throw_overrun();
+
+         out.clear();
+         out.reserve(size);
+
+         for (uint32 i = 0; i < size; ++i) {
+            if constexpr (std::is_same_v<typename T::value_type, bool>) {
+               out.push_back(read<bool>());
+            }
+            else {
+               read(out.emplace_back());
+            }
+         }
+      }
+      else if constexpr (detail::is_instance_of<T, std::optional>::value) {
+         if (read<bool>()) {
+            read(out.emplace());
+         }
+         else {
+            out = std::nullopt;
+         }
+      }
+      else if constexpr (detail::is_instance_of<T, std::variant>::value) {
+         const uint8 index = read<uint8>();
+
+         if (index >= std::variant_size_v<T>) {
+            throw std::runtime_error{"Invalid variant index in edit journal."};
+         }
+
+         read_variant(out, index, std::make_index_sequence<std::variant_size_v<T>>{});
+      }
+      else {
+         static_assert(std::is_trivially_copyable_v<T> and not std::is_pointer_v<T>,
+                       "Type can not be read from a journal.");
+
+         std::memcpy(&out, read_bytes(sizeof(T)).data(), sizeof(T));
+      }
+   }
+
+   /// @brief Read a member pointer written by journal_writer::write_member and call a
+   /// function with it.
+   /// @param callback The function to call, passed the typed member pointer.
+   /// @return The return value of the callback.
+   template<typename Struct, typename Callback>
+   auto read_member(Callback&& callback)
+   {
+      using result_type = decltype(callback(std::get<0>(journal_members<Struct>)));
+
+      const uint8 member_index = read<uint8>();
+
+      std::optional<result_type> result;
+      uint8 i = 0;
+
+      std::apply(
+         [&](const auto... members) {
+            ((i++ == member_index ? (void)result.emplace(callback(members)) : (void)0),
+             ...);
+         },
+         journal_members<Struct>);
+
+      if (not result) throw std::runtime_error{"Invalid member in edit journal."};
+
+      return std::move(*result);
+   }
+
+   /// @brief Read an entity type written by journal_writer::write_entity_type and call a
+   /// function with it.
+   /// @param callback The function to call, passed a std::type_identity of the entity.
+   /// @return The return value of the callback.
+   template<typename Callback>
+   auto read_entity_type(Callback&& callback)
+   {
+      using result_type = decltype(callback(std::type_identity<world::object>{}));
+
+      const uint8 index = read<uint8>();
+
+      if (index >= std::variant_size_v<world::creation_entity>) {
+         throw std::runtime_error{"Invalid entity type in edit journal."};
+      }
+
+      std::optional<result_type> result;
+
+      [&]<std::size_t... indices>(std::index_sequence<indices...>) {
+         ((index == indices
+              ? (void)result.emplace(callback(
+                   std::type_identity<
+                      std::variant_alternative_t<indices, world::creation_entity>>{}))
+              : (void)0),
+          ...);
+      }(std::make_index_sequence<std::variant_size_v<world::creation_entity>>{});
+
+      return std::move(*result);
+   }
+
+   /// @brief The number of bytes left to read.
+   auto remaining() const noexcept -> std::size_t
+   {
+      return _bytes.size() - _head;
+   }
+
+   /// @brief Read raw bytes.
+   /// @param size The number of bytes to read.
+   auto read_bytes(const std::size_t size) -> std::span<const std::byte>
+   {
+      if (size > remaining()) throw_overrun();
+
+      const std::span<const std::byte> bytes = _bytes.subspan(_head, size);
+
+      _head += size;
+
+      return bytes;
+   }
+
+private:
+   template<typename T, std::size_t... indices>
+   void read_variant(T& out, const uint8 index, std::index_sequence<indices...>)
+   {
+      ((index == indices ? (void)read(out.template emplace<indices>()) : (void)0), ...);
+   }
+
+   [[noreturn]] static void throw_overrun()
+   {
+      throw std::runtime_error{"Unexpected end of edit journal."};
+   }
+
+   std::span<const std::byte> _bytes;
+   std::size_t _head = 0;
+};
+
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "world/world.hpp"
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace we::edits {
+
+/// @brief Estimate the heap memory owned by a value. Used by edits to report their
+/// memory use to the edit stack. Values without heap memory (or that aren't known to
+/// have any) return 0.
+template<typename T>
+inline auto heap_memory_use(const T& value) noexcept -> std::size_t;
+
+namespace detail {
+
+template<typename T>
+struct is_vector : std::false_type {};
+
+template<typename T, typename Allocator>
+struct is_vector<std::vector<T, Allocator>> : std::true_type {};
+
+inline auto string_heap_memory_use(const std::string& string) noexcept -> std::size_t
+{
+   // Strings short enough to fit in the small string buffer don't allocate.
+   if (string.capacity() <= std::string{}.capacity()) return 0;
+
+   return string.capacity() + 1;
+}
+
+inline auto entity_heap_memory_use(const world::instance_property& property) noexcept
+   -> std::size_t
+{
+   return heap_memory_use(property.key) + heap_memory_use(property.value);
+}
+
+inline auto entity_heap_memory_use(const world::path::property& property) noexcept
+   -> std::size_t
+{
+   return heap_memory_use(property.key) + heap_memory_use(property.value);
+}
+
+inline auto entity_heap_memory_use(const world::path::node& node) noexcept
+   -> std::size_t
+{
+   return heap_memory_use(node.properties);
+}
+
+inline auto entity_heap_memory_use(const world::object& object) noexcept -> std::size_t
+{
+   return heap_memory_use(object.name) + heap_memory_use(object.class_name) +
+          heap_memory_use(object.instance_properties);
+}
+
+inline auto entity_heap_memory_use(const world::light& light) noexcept -> std::size_t
+{
+   return heap_memory_use(light.name) + heap_memory_use(light.texture) +
+          heap_memory_use(light.region_name);
+}
+
+inline auto entity_heap_memory_use(const world::path& path) noexcept -> std::size_t
+{
+   return heap_memory_use(path.name) + heap_memory_use(path.properties) +
+          heap_memory_use(path.nodes);
+}
+
+inline auto entity_heap_memory_use(const world::region& region) noexcept -> std::size_t
+{
+   return heap_memory_use(region.name) + heap_memory_use(region.description);
+}
+
+inline auto entity_heap_memory_use(const world::sector& sector) noexcept -> std::size_t
+{
+   return heap_memory_use(sector.name) + heap_memory_use(sector.points) +
+          heap_memory_use(sector.objects);
+}
+
+inline auto entity_heap_memory_use(const world::portal& portal) noexcept -> std::size_t
+{
+   return heap_memory_use(portal.name) + heap_memory_use(portal.sector1) +
+          heap_memory_use(portal.sector2);
+}
+
+inline auto entity_heap_memory_use(const world::hintnode& hintnode) noexcept
+   -> std::size_t
+{
+   return heap_memory_use(hintnode.name) + heap_memory_use(hintnode.command_post);
+}
+
+template<typename T>
+inline auto entity_heap_memory_use(const T& entity) noexcept -> std::size_t
+   requires requires { entity.name; }
+{
+   return heap_memory_use(entity.name);
+}
+
+}
+
+template<typename T>
+inline auto heap_memory_use(const T& value) noexcept -> std::size_t
+{
+   if constexpr (std::is_trivially_copyable_v<T>) {
+      return 0;
+   }
+   else if constexpr (std::is_base_of_v<std::string, T>) {
+      return detail::string_heap_memory_use(value);
+   }
+   else if constexpr (detail::is_vector<T>::value) {
+      std::size_t memory_use = value.capacity() * sizeof(typename T::value_type);
+
+      if constexpr (not std::is_trivially_copyable_v<typename T::value_type>) {
+         for (const auto& element : value) memory_use += heap_memory_use(element);
+      }
+
+      return memory_use;
+   }
+   else if constexpr (requires { detail::entity_heap_memory_use(value); }) {
+      return detail::entity_heap_memory_use(value);
+   }
+   else {
+      return 0;
+   }
+}
+
+}
@@ -7,7 +7,8 @@ namespace {
 struct set_instance_property_value final : edit<world::edit_context> {
    set_instance_property_value(world::object_id id, std::size_t property_index,
                                std::string new_value, std::string original_value)
-      : id{id},
+      : edit{edit_kind_of<set_instance_property_value>},
+        id{id},
         property_index{property_index},
         new_value{std::move(new_value)},
         original_value{std::move(original_value)}
@@ -19,6 +20,8 @@ struct set_instance_property_value final : edit<world::edit_context> {
       find_entity<world::object>(context.world, id)
          ->instance_properties[property_index]
          .value = new_value;
+
+      world::record_change<world::object>(context.world, id, world::change_type::modify);
    }
 
    void revert(world::edit_context& context) const noexcept override
@@ -26,12 +29,14 @@ struct set_instance_property_value final : edit<world::edit_context> {
       find_entity<world::object>(context.world, id)
          ->instance_properties[property_index]
          .value = original_value;
+
+      world::record_change<world::object>(context.world, id, world::change_type::modify);
    }
 
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const set_instance_property_value* other =
-         dynamic_cast<const set_instance_property_value*>(&other_unknown);
+         edit_cast<set_instance_property_value>(&other_unknown);
 
       if (not other) return false;
 
@@ -41,11 +46,22 @@ struct set_instance_property_value final : edit<world::edit_context> {
    void coalesce(edit& other_unknown) noexcept override
    {
       set_instance_property_value& other =
-         dynamic_cast<set_instance_property_value&>(other_unknown);
+         edit_cast<set_instance_property_value>(other_unknown);
 
       new_value = std::move(other.new_value);
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::set_instance_property_value);
+      writer.write(id);
+      writer.write(property_index);
+      writer.write(new_value);
+      writer.write(original_value);
+
+      return true;
+   }
+
    world::object_id id;
    std::size_t property_index;
 
@@ -58,7 +74,8 @@ struct set_creation_path_node_location final : edit<world::edit_context> {
                                    float3 new_position, float3 original_position,
                                    float3 new_euler_rotation,
                                    float3 original_euler_rotation)
-      : new_rotation{new_rotation},
+      : edit{edit_kind_of<set_creation_path_node_location>},
+        new_rotation{new_rotation},
         new_position{new_position},
         new_euler_rotation{new_euler_rotation},
         original_rotation{original_rotation},
@@ -86,7 +103,7 @@ struct set_creation_path_node_location final : edit<world::edit_context> {
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const set_creation_path_node_location* other =
-         dynamic_cast<const set_creation_path_node_location*>(&other_unknown);
+         edit_cast<set_creation_path_node_location>(&other_unknown);
 
       return other != nullptr;
    }
@@ -94,13 +111,26 @@ struct set_creation_path_node_location final : edit<world::edit_context> {
    void coalesce(edit& other_unknown) noexcept override
    {
       set_creation_path_node_location& other =
-         dynamic_cast<set_creation_path_node_location&>(other_unknown);
+         edit_cast<set_creation_path_node_location>(other_unknown);
 
       new_rotation = other.new_rotation;
       new_position = other.new_position;
       new_euler_rotation = other.new_euler_rotation;
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::set_creation_path_node_location);
+      writer.write(new_rotation);
+      writer.write(original_rotation);
+      writer.write(new_position);
+      writer.write(original_position);
+      writer.write(new_euler_rotation);
+      writer.write(original_euler_rotation);
+
+      return true;
+   }
+
    quaternion new_rotation;
    float3 new_position;
    float3 new_euler_rotation;
@@ -114,7 +144,8 @@ struct set_creation_region_metrics final : edit<world::edit_context> {
    set_creation_region_metrics(quaternion new_rotation, quaternion original_rotation,
                                float3 new_position, float3 original_position,
                                float3 new_size, float3 original_size)
-      : new_rotation{new_rotation},
+      : edit{edit_kind_of<set_creation_region_metrics>},
+        new_rotation{new_rotation},
         new_position{new_position},
         new_size{new_size},
         original_rotation{original_rotation},
@@ -140,7 +171,7 @@ struct set_creation_region_metrics final : edit<world::edit_context> {
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const set_creation_region_metrics* other =
-         dynamic_cast<const set_creation_region_metrics*>(&other_unknown);
+         edit_cast<set_creation_region_metrics>(&other_unknown);
 
       return other != nullptr;
    }
@@ -148,13 +179,26 @@ struct set_creation_region_metrics final : edit<world::edit_context> {
    void coalesce(edit& other_unknown) noexcept override
    {
       set_creation_region_metrics& other =
-         dynamic_cast<set_creation_region_metrics&>(other_unknown);
+         edit_cast<set_creation_region_metrics>(other_unknown);
 
       new_rotation = other.new_rotation;
       new_position = other.new_position;
       new_size = other.new_size;
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::set_creation_region_metrics);
+      writer.write(new_rotation);
+      writer.write(original_rotation);
+      writer.write(new_position);
+      writer.write(original_position);
+      writer.write(new_size);
+      writer.write(original_size);
+
+      return true;
+   }
+
    quaternion new_rotation;
    float3 new_position;
    float3 new_size;
@@ -166,7 +210,9 @@ struct set_creation_region_metrics final : edit<world::edit_context> {
 
 struct set_creation_sector_point final : edit<world::edit_context> {
    set_creation_sector_point(float2 new_position, float2 original_position)
-      : new_position{new_position}, original_position{original_position}
+      : edit{edit_kind_of<set_creation_sector_point>},
+        new_position{new_position},
+        original_position{original_position}
    {
    }
 
@@ -183,7 +229,7 @@ struct set_creation_sector_point final : edit<world::edit_context> {
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const set_creation_sector_point* other =
-         dynamic_cast<const set_creation_sector_point*>(&other_unknown);
+         edit_cast<set_creation_sector_point>(&other_unknown);
 
       return other != nullptr;
    }
@@ -191,11 +237,20 @@ struct set_creation_sector_point final : edit<world::edit_context> {
    void coalesce(edit& other_unknown) noexcept override
    {
       set_creation_sector_point& other =
-         dynamic_cast<set_creation_sector_point&>(other_unknown);
+         edit_cast<set_creation_sector_point>(other_unknown);
 
       new_position = other.new_position;
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::set_creation_sector_point);
+      writer.write(new_position);
+      writer.write(original_position);
+
+      return true;
+   }
+
    float2 new_position;
    float2 original_position;
 };
@@ -203,7 +258,11 @@ struct set_creation_sector_point final : edit<world::edit_context> {
 struct set_creation_portal_size final : edit<world::edit_context> {
    set_creation_portal_size(float new_width, float original_width,
                             float new_height, float original_height)
-      : new_width{new_width}, original_width{original_width}, new_height{new_height}, original_height{original_height}
+      : edit{edit_kind_of<set_creation_portal_size>},
+        new_width{new_width},
+        original_width{original_width},
+        new_height{new_height},
+        original_height{original_height}
    {
    }
 
@@ -222,7 +281,7 @@ struct set_creation_portal_size final : edit<world::edit_context> {
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const set_creation_portal_size* other =
-         dynamic_cast<const set_creation_portal_size*>(&other_unknown);
+         edit_cast<set_creation_portal_size>(&other_unknown);
 
       return other != nullptr;
    }
@@ -230,12 +289,23 @@ struct set_creation_portal_size final : edit<world::edit_context> {
    void coalesce(edit& other_unknown) noexcept override
    {
       set_creation_portal_size& other =
-         dynamic_cast<set_creation_portal_size&>(other_unknown);
+         edit_cast<set_creation_portal_size>(other_unknown);
 
       this->new_width = other.new_width;
       this->new_height = other.new_height;
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::set_creation_portal_size);
+      writer.write(new_width);
+      writer.write(original_width);
+      writer.write(new_height);
+      writer.write(original_height);
+
+      return true;
+   }
+
    float new_width;
    float original_width;
    float new_height;
@@ -246,7 +316,8 @@ struct set_creation_barrier_metrics final : edit<world::edit_context> {
    set_creation_barrier_metrics(float new_rotation, float original_rotation,
                                 float3 new_position, float3 original_position,
                                 float2 new_size, float2 original_size)
-      : new_rotation{new_rotation},
+      : edit{edit_kind_of<set_creation_barrier_metrics>},
+        new_rotation{new_rotation},
         new_position{new_position},
         new_size{new_size},
         original_rotation{original_rotation},
@@ -273,7 +344,7 @@ struct set_creation_barrier_metrics final : edit<world::edit_context> {
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const set_creation_barrier_metrics* other =
-         dynamic_cast<const set_creation_barrier_metrics*>(&other_unknown);
+         edit_cast<set_creation_barrier_metrics>(&other_unknown);
 
       return other != nullptr;
    }
@@ -281,13 +352,26 @@ struct set_creation_barrier_metrics final : edit<world::edit_context> {
    void coalesce(edit& other_unknown) noexcept override
    {
       set_creation_barrier_metrics& other =
-         dynamic_cast<set_creation_barrier_metrics&>(other_unknown);
+         edit_cast<set_creation_barrier_metrics>(other_unknown);
 
       new_rotation = other.new_rotation;
       new_position = other.new_position;
       new_size = other.new_size;
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::set_creation_barrier_metrics);
+      writer.write(new_rotation);
+      writer.write(original_rotation);
+      writer.write(new_position);
+      writer.write(original_position);
+      writer.write(new_size);
+      writer.write(original_size);
+
+      return true;
+   }
+
    float new_rotation;
    float3 new_position;
    float2 new_size;
@@ -1,9 +1,14 @@
 #pragma once
 
 #include "edit.hpp"
+#include "journal_io.hpp"
+#include "memory_use.hpp"
 #include "world/interaction_context.hpp"
 #include "world/utility/world_utilities.hpp"
 
+#include <cassert>
+#include <vector>
+
 namespace we::edits {
 
 template<typename Entity, typename T>
@@ -13,7 +18,8 @@ struct set_value final : edit<world::edit_context> {
 
    set_value(world::id<Entity> id, value_type entity_type::*value_member_ptr,
              value_type new_value, value_type original_value)
-      : id{id},
+      : edit{edit_kind_of<set_value>},
+        id{id},
         value_member_ptr{value_member_ptr},
         new_value{std::move(new_value)},
         original_value{std::move(original_value)}
@@ -22,17 +28,22 @@ struct set_value final : edit<world::edit_context> {
 
    void apply(world::edit_context& context) const noexcept override
    {
-      find_entity<entity_type>(context.world, id)->*value_member_ptr = new_value;
+      world::set_entity_value<entity_type>(context.world, id, value_member_ptr, new_value);
+
+      world::record_change<entity_type>(context.world, id, world::change_type::modify);
    }
 
    void revert(world::edit_context& context) const noexcept override
    {
-      find_entity<entity_type>(context.world, id)->*value_member_ptr = original_value;
+      world::set_entity_value<entity_type>(context.world, id, value_member_ptr,
+                                           original_value);
+
+      world::record_change<entity_type>(context.world, id, world::change_type::modify);
    }
 
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
-      const set_value* other = dynamic_cast<const set_value*>(&other_unknown);
+      const set_value* other = edit_cast<set_value>(&other_unknown);
 
       if (not other) return false;
 
@@ -41,11 +52,29 @@ struct set_value final : edit<world::edit_context> {
 
    void coalesce(edit& other_unknown) noexcept override
    {
-      set_value& other = dynamic_cast<set_value&>(other_unknown);
+      set_value& other = edit_cast<set_value>(other_unknown);
 
       new_value = std::move(other.new_value);
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::set_value);
+      writer.write_entity_type<Entity>();
+      writer.write_member(value_member_ptr);
+      writer.write(id);
+      writer.write(new_value);
+      writer.write(original_value);
+
+      return true;
+   }
+
+   auto memory_use() const noexcept -> std::size_t override
+   {
+      return sizeof(set_value) + heap_memory_use(new_value) +
+             heap_memory_use(original_value);
+   }
+
    world::id<Entity> id;
    value_type entity_type::*value_member_ptr;
 
@@ -63,6 +92,102 @@ inline auto make_set_value(world::id<Entity> id, T Entity::*value_member_ptr,
                                                  std::move(original_value));
 }
 
+/// @brief Sets the same member of many entities. Used instead of a bundle of set_value
+/// edits for large selections, the IDs and values are stored in arrays so the edit is
+/// one allocation per array and coalesces as a single unit.
+template<typename Entity, typename T>
+struct set_values final : edit<world::edit_context> {
+   using entity_type = Entity;
+   using value_type = T;
+
+   set_values(std::vector<world::id<Entity>> ids,
+              value_type entity_type::*value_member_ptr,
+              std::vector<value_type> new_values, std::vector<value_type> original_values)
+      : edit{edit_kind_of<set_values>},
+        ids{std::move(ids)},
+        value_member_ptr{value_member_ptr},
+        new_values{std::move(new_values)},
+        original_values{std::move(original_values)}
+   {
+      assert(this->ids.size() == this->new_values.size());
+      assert(this->ids.size() == this->original_values.size());
+   }
+
+   void apply(world::edit_context& context) const noexcept override
+   {
+      for (std::size_t i = 0; i < ids.size(); ++i) {
+         world::set_entity_value<entity_type>(context.world, ids[i], value_member_ptr,
+                                              new_values[i]);
+
+         world::record_change<entity_type>(context.world, ids[i],
+                                           world::change_type::modify);
+      }
+   }
+
+   void revert(world::edit_context& context) const noexcept override
+   {
+      for (std::size_t i = 0; i < ids.size(); ++i) {
+         world::set_entity_value<entity_type>(context.world, ids[i], value_member_ptr,
+                                              original_values[i]);
+
+         world::record_change<entity_type>(context.world, ids[i],
+                                           world::change_type::modify);
+      }
+   }
+
+   bool is_coalescable(const edit& other_unknown) const noexcept override
+   {
+      const set_values* other = edit_cast<set_values>(&other_unknown);
+
+      if (not other) return false;
+
+      return this->value_member_ptr == other->value_member_ptr and
+             this->ids == other->ids;
+   }
+
+   void coalesce(edit& other_unknown) noexcept override
+   {
+      set_values& other = edit_cast<set_values>(other_unknown);
+
+      new_values = std::move(other.new_values);
+   }
+
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::set_values);
+      writer.write_entity_type<Entity>();
+      writer.write_member(value_member_ptr);
+      writer.write(ids);
+      writer.write(new_values);
+      writer.write(original_values);
+
+      return true;
+   }
+
+   auto memory_use() const noexcept -> std::size_t override
+   {
+      return sizeof(set_values) + heap_memory_use(ids) + heap_memory_use(new_values) +
+             heap_memory_use(original_values);
+   }
+
+   std::vector<world::id<Entity>> ids;
+   value_type entity_type::*value_member_ptr;
+
+   std::vector<value_type> new_values;
+   std::vector<value_type> original_values;
+};
+
+template<typename Entity, typename T>
+inline auto make_set_values(std::vector<world::id<Entity>> ids,
+                            T Entity::*value_member_ptr, std::vector<T> new_values,
+                            std::vector<T> original_values)
+   -> std::unique_ptr<set_values<Entity, T>>
+{
+   return std::make_unique<set_values<Entity, T>>(std::move(ids), value_member_ptr,
+                                                  std::move(new_values),
+                                                  std::move(original_values));
+}
+
 template<typename T>
 struct set_path_node_value final : edit<world::edit_context> {
    using value_type = T;
@@ -70,7 +195,8 @@ struct set_path_node_value final : edit<world::edit_context> {
    set_path_node_value(world::path_id id, std::size_t node,
                        value_type world::path::node::*value_member_ptr,
                        value_type new_value, value_type original_value)
-      : id{id},
+      : edit{edit_kind_of<set_path_node_value>},
+        id{id},
         node{node},
         value_member_ptr{value_member_ptr},
         new_value{std::move(new_value)},
@@ -82,18 +208,22 @@ struct set_path_node_value final : edit<world::edit_context> {
    {
       find_entity<world::path>(context.world, id)->nodes[node].*value_member_ptr =
          new_value;
+
+      world::record_change<world::path>(context.world, id, world::change_type::modify);
    }
 
    void revert(world::edit_context& context) const noexcept override
    {
       find_entity<world::path>(context.world, id)->nodes[node].*value_member_ptr =
          original_value;
+
+      world::record_change<world::path>(context.world, id, world::change_type::modify);
    }
 
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const set_path_node_value* other =
-         dynamic_cast<const set_path_node_value*>(&other_unknown);
+         edit_cast<set_path_node_value>(&other_unknown);
 
       if (not other) return false;
 
@@ -103,11 +233,23 @@ struct set_path_node_value final : edit<world::edit_context> {
 
    void coalesce(edit& other_unknown) noexcept override
    {
-      set_path_node_value& other = dynamic_cast<set_path_node_value&>(other_unknown);
+      set_path_node_value& other = edit_cast<set_path_node_value>(other_unknown);
 
       new_value = std::move(other.new_value);
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::set_path_node_value);
+      writer.write_member(value_member_ptr);
+      writer.write(id);
+      writer.write(node);
+      writer.write(new_value);
+      writer.write(original_value);
+
+      return true;
+   }
+
 private:
    world::path_id id;
    std::size_t node;
@@ -134,7 +276,8 @@ struct set_global_lights_value final : edit<world::edit_context> {
 
    set_global_lights_value(value_type world::global_lights::*value_member_ptr,
                            value_type new_value, value_type original_value)
-      : value_member_ptr{value_member_ptr},
+      : edit{edit_kind_of<set_global_lights_value>},
+        value_member_ptr{value_member_ptr},
         new_value{std::move(new_value)},
         original_value{std::move(original_value)}
    {
@@ -153,7 +296,7 @@ struct set_global_lights_value final : edit<world::edit_context> {
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const set_global_lights_value* other =
-         dynamic_cast<const set_global_lights_value*>(&other_unknown);
+         edit_cast<set_global_lights_value>(&other_unknown);
 
       if (not other) return false;
 
@@ -163,11 +306,21 @@ struct set_global_lights_value final : edit<world::edit_context> {
    void coalesce(edit& other_unknown) noexcept override
    {
       set_global_lights_value& other =
-         dynamic_cast<set_global_lights_value&>(other_unknown);
+         edit_cast<set_global_lights_value>(other_unknown);
 
       new_value = std::move(other.new_value);
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::set_global_lights_value);
+      writer.write_member(value_member_ptr);
+      writer.write(new_value);
+      writer.write(original_value);
+
+      return true;
+   }
+
    value_type world::global_lights::*value_member_ptr;
 
    value_type new_value;
@@ -191,7 +344,8 @@ struct set_creation_value final : edit<world::edit_context> {
 
    set_creation_value(value_type entity_type::*value_member_ptr,
                       value_type new_value, value_type original_value)
-      : value_member_ptr{value_member_ptr},
+      : edit{edit_kind_of<set_creation_value>},
+        value_member_ptr{value_member_ptr},
         new_value{std::move(new_value)},
         original_value{std::move(original_value)}
    {
@@ -210,7 +364,7 @@ struct set_creation_value final : edit<world::edit_context> {
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const set_creation_value* other =
-         dynamic_cast<const set_creation_value*>(&other_unknown);
+         edit_cast<set_creation_value>(&other_unknown);
 
       if (not other) return false;
 
@@ -219,11 +373,22 @@ struct set_creation_value final : edit<world::edit_context> {
 
    void coalesce(edit& other_unknown) noexcept override
    {
-      set_creation_value& other = dynamic_cast<set_creation_value&>(other_unknown);
+      set_creation_value& other = edit_cast<set_creation_value>(other_unknown);
 
       new_value = std::move(other.new_value);
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::set_creation_value);
+      writer.write_entity_type<Entity>();
+      writer.write_member(value_member_ptr);
+      writer.write(new_value);
+      writer.write(original_value);
+
+      return true;
+   }
+
    value_type entity_type::*value_member_ptr;
 
    value_type new_value;
@@ -251,7 +416,8 @@ struct set_creation_value_with_meta final : edit<world::edit_context> {
                                 meta_value_type world::edit_context::*meta_value_member_ptr,
                                 meta_value_type meta_new_value,
                                 meta_value_type meta_original_value)
-      : value_member_ptr{value_member_ptr},
+      : edit{edit_kind_of<set_creation_value_with_meta>},
+        value_member_ptr{value_member_ptr},
         meta_value_member_ptr{meta_value_member_ptr},
         new_value{std::move(new_value)},
         meta_new_value{std::move(meta_new_value)},
@@ -275,7 +441,7 @@ struct set_creation_value_with_meta final : edit<world::edit_context> {
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const set_creation_value_with_meta* other =
-         dynamic_cast<const set_creation_value_with_meta*>(&other_unknown);
+         edit_cast<set_creation_value_with_meta>(&other_unknown);
 
       if (not other) return false;
 
@@ -286,12 +452,26 @@ struct set_creation_value_with_meta final : edit<world::edit_context> {
    void coalesce(edit& other_unknown) noexcept override
    {
       set_creation_value_with_meta& other =
-         dynamic_cast<set_creation_value_with_meta&>(other_unknown);
+         edit_cast<set_creation_value_with_meta>(other_unknown);
 
       new_value = std::move(other.new_value);
       meta_new_value = std::move(other.meta_new_value);
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::set_creation_value_with_meta);
+      writer.write_entity_type<Entity>();
+      writer.write_member(value_member_ptr);
+      writer.write_member(meta_value_member_ptr);
+      writer.write(new_value);
+      writer.write(original_value);
+      writer.write(meta_new_value);
+      writer.write(meta_original_value);
+
+      return true;
+   }
+
    value_type entity_type::*value_member_ptr;
    meta_value_type world::edit_context::*meta_value_member_ptr;
 
@@ -322,7 +502,8 @@ struct set_creation_location final : edit<world::edit_context> {
    set_creation_location(quaternion new_rotation, quaternion original_rotation,
                          float3 new_position, float3 original_position,
                          float3 new_euler_rotation, float3 original_euler_rotation)
-      : new_rotation{new_rotation},
+      : edit{edit_kind_of<set_creation_location>},
+        new_rotation{new_rotation},
         new_position{new_position},
         new_euler_rotation{new_euler_rotation},
         original_rotation{original_rotation},
@@ -348,7 +529,7 @@ struct set_creation_location final : edit<world::edit_context> {
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const set_creation_location* other =
-         dynamic_cast<const set_creation_location*>(&other_unknown);
+         edit_cast<set_creation_location>(&other_unknown);
 
       return other != nullptr;
    }
@@ -356,13 +537,27 @@ struct set_creation_location final : edit<world::edit_context> {
    void coalesce(edit& other_unknown) noexcept override
    {
       set_creation_location& other =
-         dynamic_cast<set_creation_location&>(other_unknown);
+         edit_cast<set_creation_location>(other_unknown);
 
       new_rotation = other.new_rotation;
       new_position = other.new_position;
       new_euler_rotation = other.new_euler_rotation;
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::set_creation_location);
+      writer.write_entity_type<Entity>();
+      writer.write(new_rotation);
+      writer.write(original_rotation);
+      writer.write(new_position);
+      writer.write(original_position);
+      writer.write(new_euler_rotation);
+      writer.write(original_euler_rotation);
+
+      return true;
+   }
+
    quaternion new_rotation;
    float3 new_position;
    float3 new_euler_rotation;
@@ -392,7 +587,8 @@ struct set_creation_path_node_value final : edit<world::edit_context> {
 
    set_creation_path_node_value(value_type world::path::node::*value_member_ptr,
                                 value_type new_value, value_type original_value)
-      : value_member_ptr{value_member_ptr},
+      : edit{edit_kind_of<set_creation_path_node_value>},
+        value_member_ptr{value_member_ptr},
         new_value{std::move(new_value)},
         original_value{std::move(original_value)}
    {
@@ -413,7 +609,7 @@ struct set_creation_path_node_value final : edit<world::edit_context> {
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const set_creation_path_node_value* other =
-         dynamic_cast<const set_creation_path_node_value*>(&other_unknown);
+         edit_cast<set_creation_path_node_value>(&other_unknown);
 
       if (not other) return false;
 
@@ -423,11 +619,21 @@ struct set_creation_path_node_value final : edit<world::edit_context> {
    void coalesce(edit& other_unknown) noexcept override
    {
       set_creation_path_node_value& other =
-         dynamic_cast<set_creation_path_node_value&>(other_unknown);
+         edit_cast<set_creation_path_node_value>(other_unknown);
 
       new_value = std::move(other.new_value);
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::set_creation_path_node_value);
+      writer.write_member(value_member_ptr);
+      writer.write(new_value);
+      writer.write(original_value);
+
+      return true;
+   }
+
    value_type world::path::node::*value_member_ptr;
 
    value_type new_value;
@@ -3,6 +3,7 @@
 #include "container/paged_stack.hpp"
 #include "edit.hpp"
 
+#include <limits>
 #include <memory>
 
 namespace we::edits {
@@ -15,6 +16,39 @@ struct apply_flags {
    bool transparent = false;
 };
 
+/// @brief Receives the operations performed on an edit stack, such as for journaling
+/// them.
+/// @tparam T The type that the edits targets.
+template<typename T>
+struct stack_listener {
+   virtual ~stack_listener() = default;
+
+   /// @brief Called when an edit is applied, before it is coalesced with the edit on
+   /// top of the stack.
+   /// @param edit The edit.
+   /// @param flags The flags the edit was applied with.
+   /// @param coalesced True if the edit will be coalesced into the edit on top of the
+   /// stack instead of being pushed.
+   virtual void applied(const edit<T>& edit, const apply_flags flags,
+                        const bool coalesced) noexcept = 0;
+
+   /// @brief Called when edits are reverted.
+   /// @param count The number of edits that were reverted. Transparent edits count as
+   /// part of the edit below them.
+   virtual void reverted(const std::size_t count) noexcept = 0;
+
+   /// @brief Called when edits are reapplied.
+   /// @param count The number of edits that were reapplied. Transparent edits count as
+   /// part of the edit below them.
+   virtual void reapplied(const std::size_t count) noexcept = 0;
+
+   /// @brief Called when close_last closes an edit.
+   virtual void closed_last() noexcept = 0;
+
+   /// @brief Called when the stack is cleared.
+   virtual void cleared() noexcept = 0;
+};
+
 /// @brief Encapsulates and manages Undo and Redo stacks.
 /// @tparam T The type that the edits targets.
 template<typename T>
@@ -29,26 +63,39 @@ struct stack {
    void apply(std::unique_ptr<edit_type> edit, edit_target& target,
               const apply_flags flags = {}) noexcept
    {
-      if (not _applied.empty() and                  //
-          not _applied.top()->is_closed() and       //
-          _applied.top()->is_coalescable(*edit) and //
-          not edit->is_closed()) {
+      const bool coalesce = not _applied.empty() and            //
+                            not _applied.top()->is_closed() and //
+                            not edit->is_closed() and           //
+                            can_coalesce(*_applied.top(), *edit);
+
+      if (_listener) _listener->applied(*edit, flags, coalesce);
+
+      if (coalesce) {
+         _applied_memory_use -= _applied.top()->memory_use();
+
          _applied.top()->revert(target);
          _applied.top()->coalesce(*edit);
          _applied.top()->apply(target);
+
+         _applied_memory_use += _applied.top()->memory_use();
       }
       else {
          edit->apply(target);
 
+         _applied_memory_use += edit->memory_use();
+
          _applied.push(std::move(edit));
       }
 
       _reverted.clear();
+      _reverted_memory_use = 0;
 
       if (flags.closed) _applied.top()->close();
       if (flags.transparent) _applied.top()->mark_transparent();
 
       _modified_flag = true;
+
+      enforce_memory_budget();
    }
 
    /// @brief Revert an edit. Does nothing if there is no edit to revert
@@ -70,12 +117,21 @@ struct stack {
    /// @param target The target of the edits.
    void revert(const std::size_t count, edit_target& target) noexcept
    {
+      std::size_t reverted_count = 0;
+
       for (std::size_t i = 0; i < count; ++i) {
+         if (_applied.empty()) break;
+
+         reverted_count += 1;
+
          while (not _applied.empty() and _applied.top()->is_transparent()) {
             std::unique_ptr<edit_type>& transparent_edit = _applied.top();
 
             transparent_edit->revert(target);
 
+            transfer_memory_use(*transparent_edit, _applied_memory_use,
+                                _reverted_memory_use);
+
             _reverted.push(std::move(transparent_edit));
             _applied.pop();
          }
@@ -86,6 +142,8 @@ struct stack {
 
          edit->revert(target);
 
+         transfer_memory_use(*edit, _applied_memory_use, _reverted_memory_use);
+
          _reverted.push(std::move(edit));
          _applied.pop();
       }
@@ -93,6 +151,8 @@ struct stack {
       if (not _applied.empty()) _applied.top()->close();
 
       _modified_flag = true;
+
+      if (_listener) _listener->reverted(reverted_count);
    }
 
    /// @brief Reapplies a number of edits. Does nothing if there is no edit to reapply.
@@ -100,13 +160,19 @@ struct stack {
    /// @param target The target of the edits.
    void reapply(const std::size_t count, edit_target& target) noexcept
    {
+      std::size_t reapplied_count = 0;
+
       for (std::size_t i = 0; i < count; ++i) {
          if (_reverted.empty()) break;
 
+         reapplied_count += 1;
+
          std::unique_ptr<edit_type>& edit = _reverted.top();
 
          edit->apply(target);
 
+         transfer_memory_use(*edit, _reverted_memory_use, _applied_memory_use);
+
          _applied.push(std::move(edit));
          _reverted.pop();
 
@@ -115,12 +181,17 @@ struct stack {
 
             transparent_edit->apply(target);
 
+            transfer_memory_use(*transparent_edit, _reverted_memory_use,
+                                _applied_memory_use);
+
             _applied.push(std::move(transparent_edit));
             _reverted.pop();
          }
       }
 
       _modified_flag = true;
+
+      if (_listener) _listener->reapplied(reapplied_count);
    }
 
    /// @brief Revert all edits.
@@ -164,7 +235,11 @@ struct stack {
    /// @brief Call close() on the edit at the top of the applied stack, if there is one. Else does nothing.
    void close_last() noexcept
    {
-      if (not _applied.empty()) _applied.top()->close();
+      if (_applied.empty()) return;
+
+      _applied.top()->close();
+
+      if (_listener) _listener->closed_last();
    }
 
    /// @brief Clear both the applied and reverted stacks while keeping their allocated memory.
@@ -172,6 +247,39 @@ struct stack {
    {
       _applied.clear();
       _reverted.clear();
+
+      _applied_memory_use = 0;
+      _reverted_memory_use = 0;
+
+      if (_listener) _listener->cleared();
+   }
+
+   /// @brief Set the memory budget for the stack. When applying an edit takes the stack
+   /// over budget the oldest edits are dropped from the applied stack until it is back
+   /// under budget. The most recent edit is always kept.
+   /// @param budget The budget in bytes.
+   void set_memory_budget(const std::size_t budget) noexcept
+   {
+      _memory_budget = budget;
+   }
+
+   /// @brief The memory budget for the stack in bytes.
+   auto memory_budget() const noexcept -> std::size_t
+   {
+      return _memory_budget;
+   }
+
+   /// @brief Estimated memory used by the edits in the applied and reverted stacks.
+   auto memory_use() const noexcept -> std::size_t
+   {
+      return _applied_memory_use + _reverted_memory_use;
+   }
+
+   /// @brief Set the listener for the stack. Only one listener is supported.
+   /// @param listener The listener or nullptr to remove the current one.
+   void set_listener(stack_listener<T>* listener) noexcept
+   {
+      _listener = listener;
    }
 
    /// @brief Check the value of the modified flag. (Set whenever an edited is applied/reverted/reapplied)
@@ -188,9 +296,50 @@ struct stack {
    }
 
 private:
+   static void transfer_memory_use(const edit_type& edit, std::size_t& from,
+                                   std::size_t& to) noexcept
+   {
+      const std::size_t memory_use = edit.memory_use();
+
+      from -= memory_use;
+      to += memory_use;
+   }
+
+   void enforce_memory_budget() noexcept
+   {
+      if (memory_use() <= _memory_budget) return;
+
+      std::size_t drop_count = 0;
+
+      while (memory_use() > _memory_budget) {
+         // Transparent edits are reverted together with the edit below them, so they
+         // are dropped or kept together with it.
+         std::size_t group_end = drop_count + 1;
+
+         while (group_end < _applied.size() and _applied[group_end]->is_transparent()) {
+            group_end += 1;
+         }
+
+         // The latest edit is always kept, along with any transparent edits on it.
+         if (group_end >= _applied.size()) break;
+
+         for (; drop_count < group_end; ++drop_count) {
+            _applied_memory_use -= _applied[drop_count]->memory_use();
+         }
+      }
+
+      _applied.erase_bottom(drop_count);
+   }
+
    container::paged_stack<std::unique_ptr<edit_type>, 8192> _applied;
    container::paged_stack<std::unique_ptr<edit_type>, 8192> _reverted;
 
+   std::size_t _applied_memory_use = 0;
+   std::size_t _reverted_memory_use = 0;
+   std::size_t _memory_budget = std::numeric_limits<std::size_t>::max();
+
+   stack_listener<T>* _listener = nullptr;
+
    bool _modified_flag = false;
 };
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "edit.hpp"
+#include "journal_io.hpp"
+#include "memory_use.hpp"
 #include "types.hpp"
 #include "world/interaction_context.hpp"
 #include "world/utility/world_utilities.hpp"
@@ -18,7 +20,8 @@ struct ui_edit final : edit<world::edit_context> {
 
    ui_edit(entity_id_type id, value_type entity_type::*value_member_ptr,
            value_type new_value, value_type original_value)
-      : id{id},
+      : edit{edit_kind_of<ui_edit>},
+        id{id},
         value_member_ptr{value_member_ptr},
         new_value{std::move(new_value)},
         original_value{std::move(original_value)}
@@ -27,17 +30,22 @@ struct ui_edit final : edit<world::edit_context> {
 
    void apply(world::edit_context& context) const noexcept
    {
-      find_entity<entity_type>(context.world, id)->*value_member_ptr = new_value;
+      world::set_entity_value<entity_type>(context.world, id, value_member_ptr, new_value);
+
+      world::record_change<entity_type>(context.world, id, world::change_type::modify);
    }
 
    void revert(world::edit_context& context) const noexcept
    {
-      find_entity<entity_type>(context.world, id)->*value_member_ptr = original_value;
+      world::set_entity_value<entity_type>(context.world, id, value_member_ptr,
+                                           original_value);
+
+      world::record_change<entity_type>(context.world, id, world::change_type::modify);
    }
 
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
-      const ui_edit* other = dynamic_cast<const ui_edit*>(&other_unknown);
+      const ui_edit* other = edit_cast<ui_edit>(&other_unknown);
 
       if (not other) return false;
 
@@ -46,11 +54,29 @@ struct ui_edit final : edit<world::edit_context> {
 
    void coalesce(edit& other_unknown) noexcept override
    {
-      ui_edit& other = dynamic_cast<ui_edit&>(other_unknown);
+      ui_edit& other = edit_cast<ui_edit>(other_unknown);
 
       new_value = std::move(other.new_value);
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::ui_edit);
+      writer.write_entity_type<Entity>();
+      writer.write_member(value_member_ptr);
+      writer.write(id);
+      writer.write(new_value);
+      writer.write(original_value);
+
+      return true;
+   }
+
+   auto memory_use() const noexcept -> std::size_t override
+   {
+      return sizeof(ui_edit) + heap_memory_use(new_value) +
+             heap_memory_use(original_value);
+   }
+
    entity_id_type id;
    value_type entity_type::*value_member_ptr;
 
@@ -68,7 +94,8 @@ struct ui_edit_indexed final : edit<world::edit_context> {
                    std::vector<value_type> entity_type::*value_member_ptr,
                    std::size_t item_index, value_type new_value,
                    value_type original_value)
-      : id{id},
+      : edit{edit_kind_of<ui_edit_indexed>},
+        id{id},
         value_member_ptr{value_member_ptr},
         item_index{item_index},
         new_value{std::move(new_value)},
@@ -84,6 +111,8 @@ struct ui_edit_indexed final : edit<world::edit_context> {
       if (item_index >= vec.size()) std::terminate();
 
       vec[item_index] = new_value;
+
+      world::record_change<entity_type>(context.world, id, world::change_type::modify);
    }
 
    void revert(world::edit_context& context) const noexcept
@@ -94,12 +123,14 @@ struct ui_edit_indexed final : edit<world::edit_context> {
       if (item_index >= vec.size()) std::terminate();
 
       vec[item_index] = original_value;
+
+      world::record_change<entity_type>(context.world, id, world::change_type::modify);
    }
 
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const ui_edit_indexed* other =
-         dynamic_cast<const ui_edit_indexed*>(&other_unknown);
+         edit_cast<ui_edit_indexed>(&other_unknown);
 
       if (not other) return false;
 
@@ -110,11 +141,24 @@ struct ui_edit_indexed final : edit<world::edit_context> {
 
    void coalesce(edit& other_unknown) noexcept override
    {
-      ui_edit_indexed& other = dynamic_cast<ui_edit_indexed&>(other_unknown);
+      ui_edit_indexed& other = edit_cast<ui_edit_indexed>(other_unknown);
 
       new_value = std::move(other.new_value);
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::ui_edit_indexed);
+      writer.write_entity_type<Entity>();
+      writer.write_member(value_member_ptr);
+      writer.write(id);
+      writer.write(item_index);
+      writer.write(new_value);
+      writer.write(original_value);
+
+      return true;
+   }
+
    entity_id_type id;
    std::vector<value_type> entity_type::*value_member_ptr;
    std::size_t item_index;
@@ -133,7 +177,8 @@ struct ui_edit_path_node final : edit<world::edit_context> {
    ui_edit_path_node(entity_id_type id, std::size_t node_index,
                      value_type node_type::*value_member_ptr,
                      value_type new_value, value_type original_value)
-      : id{id},
+      : edit{edit_kind_of<ui_edit_path_node>},
+        id{id},
         node_index{node_index},
         value_member_ptr{value_member_ptr},
         new_value{std::move(new_value)},
@@ -150,6 +195,8 @@ struct ui_edit_path_node final : edit<world::edit_context> {
       world::path::node& node = path->nodes[node_index];
 
       node.*value_member_ptr = new_value;
+
+      world::record_change<entity_type>(context.world, id, world::change_type::modify);
    }
 
    void revert(world::edit_context& context) const noexcept
@@ -161,12 +208,14 @@ struct ui_edit_path_node final : edit<world::edit_context> {
       world::path::node& node = path->nodes[node_index];
 
       node.*value_member_ptr = original_value;
+
+      world::record_change<entity_type>(context.world, id, world::change_type::modify);
    }
 
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const ui_edit_path_node* other =
-         dynamic_cast<const ui_edit_path_node*>(&other_unknown);
+         edit_cast<ui_edit_path_node>(&other_unknown);
 
       if (not other) return false;
 
@@ -177,11 +226,23 @@ struct ui_edit_path_node final : edit<world::edit_context> {
 
    void coalesce(edit& other_unknown) noexcept override
    {
-      ui_edit_path_node& other = dynamic_cast<ui_edit_path_node&>(other_unknown);
+      ui_edit_path_node& other = edit_cast<ui_edit_path_node>(other_unknown);
 
       new_value = std::move(other.new_value);
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::ui_edit_path_node);
+      writer.write_member(value_member_ptr);
+      writer.write(id);
+      writer.write(node_index);
+      writer.write(new_value);
+      writer.write(original_value);
+
+      return true;
+   }
+
    entity_id_type id;
    std::size_t node_index;
    value_type node_type::*value_member_ptr;
@@ -201,7 +262,8 @@ struct ui_edit_path_node_indexed final : edit<world::edit_context> {
                              std::vector<value_type> node_type::*value_member_ptr,
                              std::size_t item_index, value_type new_value,
                              value_type original_value)
-      : id{id},
+      : edit{edit_kind_of<ui_edit_path_node_indexed>},
+        id{id},
         node_index{node_index},
         value_member_ptr{value_member_ptr},
         item_index{item_index},
@@ -223,6 +285,8 @@ struct ui_edit_path_node_indexed final : edit<world::edit_context> {
       if (item_index >= vec.size()) std::terminate();
 
       vec[item_index] = new_value;
+
+      world::record_change<entity_type>(context.world, id, world::change_type::modify);
    }
 
    void revert(world::edit_context& context) const noexcept
@@ -238,12 +302,14 @@ struct ui_edit_path_node_indexed final : edit<world::edit_context> {
       if (item_index >= vec.size()) std::terminate();
 
       vec[item_index] = original_value;
+
+      world::record_change<entity_type>(context.world, id, world::change_type::modify);
    }
 
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const ui_edit_path_node_indexed* other =
-         dynamic_cast<const ui_edit_path_node_indexed*>(&other_unknown);
+         edit_cast<ui_edit_path_node_indexed>(&other_unknown);
 
       if (not other) return false;
 
@@ -256,11 +322,24 @@ struct ui_edit_path_node_indexed final : edit<world::edit_context> {
    void coalesce(edit& other_unknown) noexcept override
    {
       ui_edit_path_node_indexed& other =
-         dynamic_cast<ui_edit_path_node_indexed&>(other_unknown);
+         edit_cast<ui_edit_path_node_indexed>(other_unknown);
 
       new_value = std::move(other.new_value);
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::ui_edit_path_node_indexed);
+      writer.write_member(value_member_ptr);
+      writer.write(id);
+      writer.write(node_index);
+      writer.write(item_index);
+      writer.write(new_value);
+      writer.write(original_value);
+
+      return true;
+   }
+
    entity_id_type id;
    std::size_t node_index;
    std::vector<value_type> node_type::*value_member_ptr;
@@ -279,7 +358,8 @@ struct ui_creation_edit final : edit<world::edit_context> {
 
    ui_creation_edit(value_type entity_type::*value_member_ptr,
                     value_type new_value, value_type original_value)
-      : value_member_ptr{value_member_ptr},
+      : edit{edit_kind_of<ui_creation_edit>},
+        value_member_ptr{value_member_ptr},
         new_value{std::move(new_value)},
         original_value{std::move(original_value)}
    {
@@ -298,7 +378,7 @@ struct ui_creation_edit final : edit<world::edit_context> {
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const ui_creation_edit* other =
-         dynamic_cast<const ui_creation_edit*>(&other_unknown);
+         edit_cast<ui_creation_edit>(&other_unknown);
 
       if (not other) return false;
 
@@ -307,11 +387,22 @@ struct ui_creation_edit final : edit<world::edit_context> {
 
    void coalesce(edit& other_unknown) noexcept override
    {
-      ui_creation_edit& other = dynamic_cast<ui_creation_edit&>(other_unknown);
+      ui_creation_edit& other = edit_cast<ui_creation_edit>(other_unknown);
 
       new_value = std::move(other.new_value);
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::ui_creation_edit);
+      writer.write_entity_type<Entity>();
+      writer.write_member(value_member_ptr);
+      writer.write(new_value);
+      writer.write(original_value);
+
+      return true;
+   }
+
    value_type entity_type::*value_member_ptr;
 
    value_type new_value;
@@ -329,7 +420,8 @@ struct ui_creation_edit_with_meta final : edit<world::edit_context> {
                               meta_value_type world::edit_context::*meta_value_member_ptr,
                               meta_value_type meta_new_value,
                               meta_value_type meta_original_value)
-      : value_member_ptr{value_member_ptr},
+      : edit{edit_kind_of<ui_creation_edit_with_meta>},
+        value_member_ptr{value_member_ptr},
         meta_value_member_ptr{meta_value_member_ptr},
         new_value{std::move(new_value)},
         meta_new_value{std::move(meta_new_value)},
@@ -353,7 +445,7 @@ struct ui_creation_edit_with_meta final : edit<world::edit_context> {
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const ui_creation_edit_with_meta* other =
-         dynamic_cast<const ui_creation_edit_with_meta*>(&other_unknown);
+         edit_cast<ui_creation_edit_with_meta>(&other_unknown);
 
       if (not other) return false;
 
@@ -364,12 +456,26 @@ struct ui_creation_edit_with_meta final : edit<world::edit_context> {
    void coalesce(edit& other_unknown) noexcept override
    {
       ui_creation_edit_with_meta& other =
-         dynamic_cast<ui_creation_edit_with_meta&>(other_unknown);
+         edit_cast<ui_creation_edit_with_meta>(other_unknown);
 
       new_value = std::move(other.new_value);
       meta_new_value = std::move(other.meta_new_value);
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::ui_creation_edit_with_meta);
+      writer.write_entity_type<Entity>();
+      writer.write_member(value_member_ptr);
+      writer.write_member(meta_value_member_ptr);
+      writer.write(new_value);
+      writer.write(original_value);
+      writer.write(meta_new_value);
+      writer.write(meta_original_value);
+
+      return true;
+   }
+
    value_type entity_type::*value_member_ptr;
    meta_value_type world::edit_context::*meta_value_member_ptr;
 
@@ -386,7 +492,8 @@ struct ui_creation_path_node_edit final : edit<world::edit_context> {
 
    ui_creation_path_node_edit(value_type world::path::node::*value_member_ptr,
                               value_type new_value, value_type original_value)
-      : value_member_ptr{value_member_ptr},
+      : edit{edit_kind_of<ui_creation_path_node_edit>},
+        value_member_ptr{value_member_ptr},
         new_value{std::move(new_value)},
         original_value{std::move(original_value)}
    {
@@ -407,7 +514,7 @@ struct ui_creation_path_node_edit final : edit<world::edit_context> {
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const ui_creation_path_node_edit* other =
-         dynamic_cast<const ui_creation_path_node_edit*>(&other_unknown);
+         edit_cast<ui_creation_path_node_edit>(&other_unknown);
 
       if (not other) return false;
 
@@ -417,11 +524,21 @@ struct ui_creation_path_node_edit final : edit<world::edit_context> {
    void coalesce(edit& other_unknown) noexcept override
    {
       ui_creation_path_node_edit& other =
-         dynamic_cast<ui_creation_path_node_edit&>(other_unknown);
+         edit_cast<ui_creation_path_node_edit>(other_unknown);
 
       new_value = std::move(other.new_value);
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::ui_creation_path_node_edit);
+      writer.write_member(value_member_ptr);
+      writer.write(new_value);
+      writer.write(original_value);
+
+      return true;
+   }
+
    value_type world::path::node::*value_member_ptr;
    value_type new_value;
    value_type original_value;
@@ -437,7 +554,8 @@ struct ui_creation_path_node_edit_with_meta final : edit<world::edit_context> {
       value_type original_value,
       meta_value_type world::edit_context::*meta_value_member_ptr,
       meta_value_type meta_new_value, meta_value_type meta_original_value)
-      : value_member_ptr{value_member_ptr},
+      : edit{edit_kind_of<ui_creation_path_node_edit_with_meta>},
+        value_member_ptr{value_member_ptr},
         meta_value_member_ptr{meta_value_member_ptr},
         new_value{std::move(new_value)},
         meta_new_value{std::move(meta_new_value)},
@@ -463,7 +581,7 @@ struct ui_creation_path_node_edit_with_meta final : edit<world::edit_context> {
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const ui_creation_path_node_edit_with_meta* other =
-         dynamic_cast<const ui_creation_path_node_edit_with_meta*>(&other_unknown);
+         edit_cast<ui_creation_path_node_edit_with_meta>(&other_unknown);
 
       if (not other) return false;
 
@@ -474,12 +592,25 @@ struct ui_creation_path_node_edit_with_meta final : edit<world::edit_context> {
    void coalesce(edit& other_unknown) noexcept override
    {
       ui_creation_path_node_edit_with_meta& other =
-         dynamic_cast<ui_creation_path_node_edit_with_meta&>(other_unknown);
+         edit_cast<ui_creation_path_node_edit_with_meta>(other_unknown);
 
       new_value = std::move(other.new_value);
       meta_new_value = std::move(other.meta_new_value);
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::ui_creation_path_node_edit_with_meta);
+      writer.write_member(value_member_ptr);
+      writer.write_member(meta_value_member_ptr);
+      writer.write(new_value);
+      writer.write(original_value);
+      writer.write(meta_new_value);
+      writer.write(meta_original_value);
+
+      return true;
+   }
+
    value_type world::path::node::*value_member_ptr;
    meta_value_type world::edit_context::*meta_value_member_ptr;
 
@@ -494,7 +625,9 @@ struct ui_creation_sector_point_edit final : edit<world::edit_context> {
    using value_type = float2;
 
    ui_creation_sector_point_edit(value_type new_value, value_type original_value)
-      : new_value{std::move(new_value)}, original_value{std::move(original_value)}
+      : edit{edit_kind_of<ui_creation_sector_point_edit>},
+        new_value{std::move(new_value)},
+        original_value{std::move(original_value)}
    {
    }
 
@@ -511,7 +644,7 @@ struct ui_creation_sector_point_edit final : edit<world::edit_context> {
    bool is_coalescable(const edit& other_unknown) const noexcept override
    {
       const ui_creation_sector_point_edit* other =
-         dynamic_cast<const ui_creation_sector_point_edit*>(&other_unknown);
+         edit_cast<ui_creation_sector_point_edit>(&other_unknown);
 
       return other != nullptr;
    }
@@ -519,11 +652,20 @@ struct ui_creation_sector_point_edit final : edit<world::edit_context> {
    void coalesce(edit& other_unknown) noexcept override
    {
       ui_creation_sector_point_edit& other =
-         dynamic_cast<ui_creation_sector_point_edit&>(other_unknown);
+         edit_cast<ui_creation_sector_point_edit>(other_unknown);
 
       new_value = std::move(other.new_value);
    }
 
+   bool write_journal(journal_writer& writer) const noexcept override
+   {
+      writer.write(journal_edit_type::ui_creation_sector_point_edit);
+      writer.write(new_value);
+      writer.write(original_value);
+
+      return true;
+   }
+
    value_type new_value;
    value_type original_value;
 };
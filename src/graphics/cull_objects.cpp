@@ -1,9 +1,13 @@
 #include "cull_objects.hpp"
+#include "math/vector_funcs.hpp"
 
+#include <array>
+#include <bit>
 #include <cassert>
 #include <ranges>
 
 #include <immintrin.h>
+#include <intrin.h>
 
 namespace we::graphics {
 
@@ -12,8 +16,8 @@ using std::ranges::views::drop;
 void cull_objects_scalar(const frustum& frustum,
                          std::span<const math::bounding_box> bbox,
                          std::span<const material_pipeline_flags> pipeline_flags,
-                         std::vector<uint16>& out_opaque_list,
-                         std::vector<uint16>& out_transparent_list) noexcept
+                         std::vector<uint32>& out_opaque_list,
+                         std::vector<uint32>& out_transparent_list) noexcept
 {
    assert(bbox.size() == pipeline_flags.size());
 
@@ -31,7 +35,7 @@ void cull_objects_scalar(const frustum& frustum,
             ? out_transparent_list
             : out_opaque_list;
 
-      render_list.push_back(static_cast<uint16>(i));
+      render_list.push_back(static_cast<uint32>(i));
    }
 }
 
@@ -94,22 +98,27 @@ auto outside_plane(__m256 plane_x, __m256 plane_y, __m256 plane_z,
    return _mm256_and_ps(corner0123_outside, corner4567_outside);
 }
 
-auto outside_corners(std::array<__m256, 8> corners, __m256 bbox_corner_min,
+/// @brief Test boxes against the bounds of the frustum's corners along an axis. Boxes
+/// entirely below or above every corner are outside, same as in intersects.
+auto outside_corners(__m256 corners_min, __m256 corners_max, __m256 bbox_corner_min,
                      __m256 bbox_corner_max) noexcept -> __m256
 {
-   const float one = 1.0f;
-   __m256 outside_mask = _mm256_broadcast_ss(&one);
+   const __m256 below = _mm256_cmp_ps(corners_min, bbox_corner_max, _CMP_GT_OQ);
+   const __m256 above = _mm256_cmp_ps(corners_max, bbox_corner_min, _CMP_LT_OQ);
 
-   for (const __m256 corner : corners) {
-      const __m256 min_outside = _mm256_cmp_ps(corner, bbox_corner_min, _CMP_LT_OQ);
-      const __m256 max_outside = _mm256_cmp_ps(corner, bbox_corner_max, _CMP_GT_OQ);
+   return _mm256_or_ps(below, above);
+}
 
-      const __m256 min_max_outside = _mm256_or_ps(min_outside, max_outside);
+auto corners_bounds(const frustum& frustum) noexcept -> math::bounding_box
+{
+   math::bounding_box bounds{.min = frustum.corners[0], .max = frustum.corners[0]};
 
-      outside_mask = _mm256_and_ps(outside_mask, min_max_outside);
+   for (const float3& corner : frustum.corners) {
+      bounds.min = min(bounds.min, corner);
+      bounds.max = max(bounds.max, corner);
    }
 
-   return outside_mask;
+   return bounds;
 }
 
 }
@@ -121,8 +130,8 @@ void cull_objects_avx2(const frustum& frustum, std::span<const float> bbox_min_x
                        std::span<const float> bbox_max_y,
                        std::span<const float> bbox_max_z,
                        std::span<const material_pipeline_flags> pipeline_flags,
-                       std::vector<uint16>& out_opaque_list,
-                       std::vector<uint16>& out_transparent_list) noexcept
+                       std::vector<uint32>& out_opaque_list,
+                       std::vector<uint32>& out_transparent_list) noexcept
 {
    assert(bbox_min_x.size() == bbox_min_y.size());
    assert(bbox_min_x.size() == bbox_min_z.size());
@@ -136,6 +145,8 @@ void cull_objects_avx2(const frustum& frustum, std::span<const float> bbox_min_x
    out_opaque_list.reserve(bbox_min_x.size());
    out_transparent_list.reserve(bbox_min_x.size());
 
+   const math::bounding_box corners = corners_bounds(frustum);
+
    const std::size_t simd_iterations = bbox_min_x.size() / avx_width;
    const std::size_t scalar_iterations = bbox_min_x.size() % avx_width;
 
@@ -163,12 +174,8 @@ void cull_objects_avx2(const frustum& frustum, std::span<const float> bbox_min_x
       if (not inside_mask) continue;
 
       const __m256 outside_x =
-         outside_corners({_mm256_broadcast_ss(&frustum.corners[0].x),
-                          _mm256_broadcast_ss(&frustum.corners[1].x),
-                          _mm256_broadcast_ss(&frustum.corners[2].x),
-                          _mm256_broadcast_ss(&frustum.corners[3].x),
-                          _mm256_broadcast_ss(&frustum.corners[4].x),
-                          _mm256_broadcast_ss(&frustum.corners[5].x)},
+         outside_corners(_mm256_broadcast_ss(&corners.min.x),
+                         _mm256_broadcast_ss(&corners.max.x),
                          _mm256_load_ps(&bbox_min_x[i * avx_width]),
                          _mm256_load_ps(&bbox_max_x[i * avx_width]));
 
@@ -177,12 +184,8 @@ void cull_objects_avx2(const frustum& frustum, std::span<const float> bbox_min_x
       if (not inside_mask) continue;
 
       const __m256 outside_y =
-         outside_corners({_mm256_broadcast_ss(&frustum.corners[0].y),
-                          _mm256_broadcast_ss(&frustum.corners[1].y),
-                          _mm256_broadcast_ss(&frustum.corners[2].y),
-                          _mm256_broadcast_ss(&frustum.corners[3].y),
-                          _mm256_broadcast_ss(&frustum.corners[4].y),
-                          _mm256_broadcast_ss(&frustum.corners[5].y)},
+         outside_corners(_mm256_broadcast_ss(&corners.min.y),
+                         _mm256_broadcast_ss(&corners.max.y),
                          _mm256_load_ps(&bbox_min_y[i * avx_width]),
                          _mm256_load_ps(&bbox_max_y[i * avx_width]));
 
@@ -191,12 +194,8 @@ void cull_objects_avx2(const frustum& frustum, std::span<const float> bbox_min_x
       if (not inside_mask) continue;
 
       const __m256 outside_z =
-         outside_corners({_mm256_broadcast_ss(&frustum.corners[0].z),
-                          _mm256_broadcast_ss(&frustum.corners[1].z),
-                          _mm256_broadcast_ss(&frustum.corners[2].z),
-                          _mm256_broadcast_ss(&frustum.corners[3].z),
-                          _mm256_broadcast_ss(&frustum.corners[4].z),
-                          _mm256_broadcast_ss(&frustum.corners[5].z)},
+         outside_corners(_mm256_broadcast_ss(&corners.min.z),
+                         _mm256_broadcast_ss(&corners.max.z),
                          _mm256_load_ps(&bbox_min_z[i * avx_width]),
                          _mm256_load_ps(&bbox_max_z[i * avx_width]));
 
@@ -212,7 +211,7 @@ void cull_objects_avx2(const frustum& frustum, std::span<const float> bbox_min_x
                ? out_transparent_list
                : out_opaque_list;
 
-         render_list.push_back(static_cast<uint16>(i));
+         render_list.push_back(static_cast<uint32>(i));
       };
 
       if (inside_mask & 0b1) push_index((i * avx_width) + 0);
@@ -238,14 +237,14 @@ void cull_objects_avx2(const frustum& frustum, std::span<const float> bbox_min_x
             ? out_transparent_list
             : out_opaque_list;
 
-      render_list.push_back(static_cast<uint16>(i));
+      render_list.push_back(static_cast<uint32>(i));
    }
 }
 
 void cull_objects_shadow_cascade_scalar(const frustum& frustum,
                                         std::span<const math::bounding_box> bbox,
                                         std::span<const material_pipeline_flags> pipeline_flags,
-                                        std::vector<uint16>& out_list) noexcept
+                                        std::vector<uint32>& out_list) noexcept
 {
    assert(bbox.size() == pipeline_flags.size());
 
@@ -257,7 +256,7 @@ void cull_objects_shadow_cascade_scalar(const frustum& frustum,
 
       if (not(are_flags_set(pipeline_flags[i], material_pipeline_flags::transparent) or
               are_flags_set(pipeline_flags[i], material_pipeline_flags::additive))) {
-         out_list.push_back(static_cast<uint16>(i));
+         out_list.push_back(static_cast<uint32>(i));
       }
    }
 }
@@ -268,7 +267,7 @@ void cull_objects_shadow_cascade_avx2(
    std::span<const float> bbox_max_x, std::span<const float> bbox_max_y,
    std::span<const float> bbox_max_z,
    std::span<const material_pipeline_flags> pipeline_flags,
-   std::vector<uint16>& out_list) noexcept
+   std::vector<uint32>& out_list) noexcept
 {
    assert(bbox_min_x.size() == bbox_min_y.size());
    assert(bbox_min_x.size() == bbox_min_z.size());
@@ -309,7 +308,7 @@ void cull_objects_shadow_cascade_avx2(
       const auto push_index = [&pipeline_flags, &out_list](const std::size_t i) {
          if (not(are_flags_set(pipeline_flags[i], material_pipeline_flags::transparent) or
                  are_flags_set(pipeline_flags[i], material_pipeline_flags::additive))) {
-            out_list.push_back(static_cast<uint16>(i));
+            out_list.push_back(static_cast<uint32>(i));
          }
       };
 
@@ -325,15 +324,271 @@ void cull_objects_shadow_cascade_avx2(
 
    for (std::size_t i = bbox_min_x.size() - scalar_iterations;
         i < bbox_min_x.size(); ++i) {
-      if (not intersects(frustum, {{bbox_min_x[i], bbox_min_y[i], bbox_min_z[i]},
-                                   {bbox_max_x[i], bbox_max_y[i], bbox_max_z[i]}})) {
+      if (not intersects_shadow_cascade(frustum,
+                                        {{bbox_min_x[i], bbox_min_y[i], bbox_min_z[i]},
+                                         {bbox_max_x[i], bbox_max_y[i], bbox_max_z[i]}})) {
          continue;
       }
 
       if (not(are_flags_set(pipeline_flags[i], material_pipeline_flags::transparent) or
               are_flags_set(pipeline_flags[i], material_pipeline_flags::additive))) {
-         out_list.push_back(static_cast<uint16>(i));
+         out_list.push_back(static_cast<uint32>(i));
+      }
+   }
+}
+
+namespace {
+
+constexpr int avx512_width = 16;
+
+auto outside_plane(__m512 plane_x, __m512 plane_y, __m512 plane_z, __m512 plane_w,
+                   __m512 point_x, __m512 point_y, __m512 point_z) noexcept -> __mmask16
+{
+   // Summed in the same order as the AVX2 version so both give the same results.
+   const __m512 x = _mm512_mul_ps(plane_x, point_x);
+   const __m512 y = _mm512_mul_ps(plane_y, point_y);
+   const __m512 z = _mm512_mul_ps(plane_z, point_z);
+
+   const __m512 xy_sum = _mm512_add_ps(x, y);
+   const __m512 zw_sum = _mm512_add_ps(z, plane_w);
+
+   const __m512 plane_distance = _mm512_add_ps(xy_sum, zw_sum);
+
+   return _mm512_cmp_ps_mask(plane_distance, _mm512_setzero_ps(), _CMP_LT_OQ);
+}
+
+struct bbox_avx512 {
+   __m512 min_x;
+   __m512 min_y;
+   __m512 min_z;
+   __m512 max_x;
+   __m512 max_y;
+   __m512 max_z;
+};
+
+auto outside_plane(const float4& plane, const bbox_avx512& bbox) noexcept -> __mmask16
+{
+   const __m512 plane_x = _mm512_set1_ps(plane.x);
+   const __m512 plane_y = _mm512_set1_ps(plane.y);
+   const __m512 plane_z = _mm512_set1_ps(plane.z);
+   const __m512 plane_w = _mm512_set1_ps(plane.w);
+
+   return outside_plane(plane_x, plane_y, plane_z, plane_w, bbox.min_x, bbox.min_y,
+                        bbox.min_z) &
+          outside_plane(plane_x, plane_y, plane_z, plane_w, bbox.max_x, bbox.min_y,
+                        bbox.min_z) &
+          outside_plane(plane_x, plane_y, plane_z, plane_w, bbox.min_x, bbox.max_y,
+                        bbox.min_z) &
+          outside_plane(plane_x, plane_y, plane_z, plane_w, bbox.max_x, bbox.max_y,
+                        bbox.min_z) &
+          outside_plane(plane_x, plane_y, plane_z, plane_w, bbox.min_x, bbox.min_y,
+                        bbox.max_z) &
+          outside_plane(plane_x, plane_y, plane_z, plane_w, bbox.max_x, bbox.min_y,
+                        bbox.max_z) &
+          outside_plane(plane_x, plane_y, plane_z, plane_w, bbox.min_x, bbox.max_y,
+                        bbox.max_z) &
+          outside_plane(plane_x, plane_y, plane_z, plane_w, bbox.max_x, bbox.max_y,
+                        bbox.max_z);
+}
+
+auto outside_corners(const float corners_min, const float corners_max,
+                     __m512 bbox_corner_min, __m512 bbox_corner_max) noexcept -> __mmask16
+{
+   return _mm512_cmp_ps_mask(_mm512_set1_ps(corners_min), bbox_corner_max, _CMP_GT_OQ) |
+          _mm512_cmp_ps_mask(_mm512_set1_ps(corners_max), bbox_corner_min, _CMP_LT_OQ);
+}
+
+/// @brief Load up to 16 boxes starting at first. Lanes past the end of the arrays are
+/// left zeroed and out of load_mask.
+auto load_bbox_avx512(const std::size_t first, const std::size_t count,
+                      std::span<const float> bbox_min_x,
+                      std::span<const float> bbox_min_y,
+                      std::span<const float> bbox_min_z,
+                      std::span<const float> bbox_max_x,
+                      std::span<const float> bbox_max_y,
+                      std::span<const float> bbox_max_z,
+                      __mmask16& load_mask) noexcept -> bbox_avx512
+{
+   load_mask = count - first >= avx512_width
+                  ? __mmask16{0xffff}
+                  : static_cast<__mmask16>((1u << (count - first)) - 1u);
+
+   return {.min_x = _mm512_maskz_loadu_ps(load_mask, &bbox_min_x[first]),
+           .min_y = _mm512_maskz_loadu_ps(load_mask, &bbox_min_y[first]),
+           .min_z = _mm512_maskz_loadu_ps(load_mask, &bbox_min_z[first]),
+           .max_x = _mm512_maskz_loadu_ps(load_mask, &bbox_max_x[first]),
+           .max_y = _mm512_maskz_loadu_ps(load_mask, &bbox_max_y[first]),
+           .max_z = _mm512_maskz_loadu_ps(load_mask, &bbox_max_z[first])};
+}
+
+}
+
+void cull_objects_avx512(const frustum& frustum, std::span<const float> bbox_min_x,
+                         std::span<const float> bbox_min_y,
+                         std::span<const float> bbox_min_z,
+                         std::span<const float> bbox_max_x,
+                         std::span<const float> bbox_max_y,
+                         std::span<const float> bbox_max_z,
+                         std::span<const material_pipeline_flags> pipeline_flags,
+                         std::vector<uint32>& out_opaque_list,
+                         std::vector<uint32>& out_transparent_list) noexcept
+{
+   assert(bbox_min_x.size() == bbox_min_y.size());
+   assert(bbox_min_x.size() == bbox_min_z.size());
+   assert(bbox_min_x.size() == bbox_max_x.size());
+   assert(bbox_min_x.size() == bbox_max_y.size());
+   assert(bbox_min_x.size() == bbox_max_z.size());
+   assert(bbox_min_x.size() == pipeline_flags.size());
+
+   out_opaque_list.clear();
+   out_transparent_list.clear();
+   out_opaque_list.reserve(bbox_min_x.size());
+   out_transparent_list.reserve(bbox_min_x.size());
+
+   const math::bounding_box corners = corners_bounds(frustum);
+
+   // The last boxes are culled with masked loads instead of a scalar loop.
+   for (std::size_t first = 0; first < bbox_min_x.size(); first += avx512_width) {
+      __mmask16 inside_mask = 0;
+
+      const bbox_avx512 bbox =
+         load_bbox_avx512(first, bbox_min_x.size(), bbox_min_x, bbox_min_y, bbox_min_z,
+                          bbox_max_x, bbox_max_y, bbox_max_z, inside_mask);
+
+      for (const auto& plane : frustum.planes) {
+         inside_mask &= ~outside_plane(plane, bbox);
       }
+
+      if (not inside_mask) continue;
+
+      inside_mask &=
+         ~outside_corners(corners.min.x, corners.max.x, bbox.min_x, bbox.max_x);
+      inside_mask &=
+         ~outside_corners(corners.min.y, corners.max.y, bbox.min_y, bbox.max_y);
+      inside_mask &=
+         ~outside_corners(corners.min.z, corners.max.z, bbox.min_z, bbox.max_z);
+
+      for (uint32 mask = inside_mask; mask != 0; mask &= mask - 1) {
+         const std::size_t i = first + std::countr_zero(mask);
+
+         auto& render_list =
+            are_flags_set(pipeline_flags[i], material_pipeline_flags::transparent) or
+                  are_flags_set(pipeline_flags[i], material_pipeline_flags::additive)
+               ? out_transparent_list
+               : out_opaque_list;
+
+         render_list.push_back(static_cast<uint32>(i));
+      }
+   }
+}
+
+void cull_objects_shadow_cascade_avx512(
+   const frustum& frustum, std::span<const float> bbox_min_x,
+   std::span<const float> bbox_min_y, std::span<const float> bbox_min_z,
+   std::span<const float> bbox_max_x, std::span<const float> bbox_max_y,
+   std::span<const float> bbox_max_z,
+   std::span<const material_pipeline_flags> pipeline_flags,
+   std::vector<uint32>& out_list) noexcept
+{
+   assert(bbox_min_x.size() == bbox_min_y.size());
+   assert(bbox_min_x.size() == bbox_min_z.size());
+   assert(bbox_min_x.size() == bbox_max_x.size());
+   assert(bbox_min_x.size() == bbox_max_y.size());
+   assert(bbox_min_x.size() == bbox_max_z.size());
+   assert(bbox_min_x.size() == pipeline_flags.size());
+
+   out_list.clear();
+   out_list.reserve(bbox_min_x.size());
+
+   for (std::size_t first = 0; first < bbox_min_x.size(); first += avx512_width) {
+      __mmask16 inside_mask = 0;
+
+      const bbox_avx512 bbox =
+         load_bbox_avx512(first, bbox_min_x.size(), bbox_min_x, bbox_min_y, bbox_min_z,
+                          bbox_max_x, bbox_max_y, bbox_max_z, inside_mask);
+
+      for (const auto& plane : frustum.planes | drop(1)) {
+         inside_mask &= ~outside_plane(plane, bbox);
+      }
+
+      for (uint32 mask = inside_mask; mask != 0; mask &= mask - 1) {
+         const std::size_t i = first + std::countr_zero(mask);
+
+         if (not(are_flags_set(pipeline_flags[i], material_pipeline_flags::transparent) or
+                 are_flags_set(pipeline_flags[i], material_pipeline_flags::additive))) {
+            out_list.push_back(static_cast<uint32>(i));
+         }
+      }
+   }
+}
+
+bool is_cull_objects_avx512_supported() noexcept
+{
+   static const bool supported = [] {
+      std::array<int, 4> info{};
+
+      __cpuid(info.data(), 0);
+
+      if (info[0] < 7) return false;
+
+      // The OS must save the AVX-512 registers (XCR0 bits 5-7) as well as the AVX ones.
+      __cpuid(info.data(), 1);
+
+      const bool osxsave = (info[2] & (1 << 27)) != 0;
+
+      if (not osxsave) return false;
+
+      constexpr uint64 avx512_xcr0_mask = 0b1110'0110;
+
+      if ((_xgetbv(0) & avx512_xcr0_mask) != avx512_xcr0_mask) return false;
+
+      __cpuidex(info.data(), 7, 0);
+
+      const bool avx512f = (info[1] & (1 << 16)) != 0;
+
+      return avx512f;
+   }();
+
+   return supported;
+}
+
+void cull_objects(const frustum& frustum, std::span<const float> bbox_min_x,
+                  std::span<const float> bbox_min_y, std::span<const float> bbox_min_z,
+                  std::span<const float> bbox_max_x, std::span<const float> bbox_max_y,
+                  std::span<const float> bbox_max_z,
+                  std::span<const material_pipeline_flags> pipeline_flags,
+                  std::vector<uint32>& out_opaque_list,
+                  std::vector<uint32>& out_transparent_list) noexcept
+{
+   if (is_cull_objects_avx512_supported()) {
+      cull_objects_avx512(frustum, bbox_min_x, bbox_min_y, bbox_min_z, bbox_max_x,
+                          bbox_max_y, bbox_max_z, pipeline_flags, out_opaque_list,
+                          out_transparent_list);
+   }
+   else {
+      cull_objects_avx2(frustum, bbox_min_x, bbox_min_y, bbox_min_z, bbox_max_x,
+                        bbox_max_y, bbox_max_z, pipeline_flags, out_opaque_list,
+                        out_transparent_list);
+   }
+}
+
+void cull_objects_shadow_cascade(
+   const frustum& frustum, std::span<const float> bbox_min_x,
+   std::span<const float> bbox_min_y, std::span<const float> bbox_min_z,
+   std::span<const float> bbox_max_x, std::span<const float> bbox_max_y,
+   std::span<const float> bbox_max_z,
+   std::span<const material_pipeline_flags> pipeline_flags,
+   std::vector<uint32>& out_list) noexcept
+{
+   if (is_cull_objects_avx512_supported()) {
+      cull_objects_shadow_cascade_avx512(frustum, bbox_min_x, bbox_min_y, bbox_min_z,
+                                         bbox_max_x, bbox_max_y, bbox_max_z,
+                                         pipeline_flags, out_list);
+   }
+   else {
+      cull_objects_shadow_cascade_avx2(frustum, bbox_min_x, bbox_min_y, bbox_min_z,
+                                       bbox_max_x, bbox_max_y, bbox_max_z,
+                                       pipeline_flags, out_list);
    }
 }
 
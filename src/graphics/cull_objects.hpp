@@ -9,11 +9,42 @@
 
 namespace we::graphics {
 
+/// @brief Cull objects against a frustum and split them into opaque and transparent
+/// lists, using the widest SIMD the CPU supports. The lists are in ascending order and
+/// hold the same objects as cull_objects_scalar would.
+/// @param frustum The frustum to cull against.
+/// @param bbox_min_x The bounding boxes of the objects, as a structure of arrays. Each
+/// array must be 32 byte aligned.
+/// @param pipeline_flags The pipeline flags of the objects.
+/// @param out_opaque_list Receives the indices of the visible opaque objects.
+/// @param out_transparent_list Receives the indices of the visible transparent objects.
+void cull_objects(const frustum& frustum, std::span<const float> bbox_min_x,
+                  std::span<const float> bbox_min_y, std::span<const float> bbox_min_z,
+                  std::span<const float> bbox_max_x, std::span<const float> bbox_max_y,
+                  std::span<const float> bbox_max_z,
+                  std::span<const material_pipeline_flags> pipeline_flags,
+                  std::vector<uint32>& out_opaque_list,
+                  std::vector<uint32>& out_transparent_list) noexcept;
+
+/// @brief Cull opaque objects against a shadow cascade, using the widest SIMD the CPU
+/// supports. The near plane is skipped, like intersects_shadow_cascade.
+void cull_objects_shadow_cascade(
+   const frustum& frustum, std::span<const float> bbox_min_x,
+   std::span<const float> bbox_min_y, std::span<const float> bbox_min_z,
+   std::span<const float> bbox_max_x, std::span<const float> bbox_max_y,
+   std::span<const float> bbox_max_z,
+   std::span<const material_pipeline_flags> pipeline_flags,
+   std::vector<uint32>& out_list) noexcept;
+
+/// @brief Test if the CPU and OS support AVX-512, and with it the _avx512 variants below.
+/// The build targets AVX2 so the _avx2 variants are always supported.
+[[nodiscard]] bool is_cull_objects_avx512_supported() noexcept;
+
 void cull_objects_scalar(const frustum& frustum,
                          std::span<const math::bounding_box> bbox,
                          std::span<const material_pipeline_flags> pipeline_flags,
-                         std::vector<uint16>& out_opaque_list,
-                         std::vector<uint16>& out_transparent_list) noexcept;
+                         std::vector<uint32>& out_opaque_list,
+                         std::vector<uint32>& out_transparent_list) noexcept;
 
 void cull_objects_avx2(const frustum& frustum, std::span<const float> bbox_min_x,
                        std::span<const float> bbox_min_y,
@@ -22,13 +53,23 @@ void cull_objects_avx2(const frustum& frustum, std::span<const float> bbox_min_x
                        std::span<const float> bbox_max_y,
                        std::span<const float> bbox_max_z,
                        std::span<const material_pipeline_flags> pipeline_flags,
-                       std::vector<uint16>& out_opaque_list,
-                       std::vector<uint16>& out_transparent_list) noexcept;
+                       std::vector<uint32>& out_opaque_list,
+                       std::vector<uint32>& out_transparent_list) noexcept;
+
+void cull_objects_avx512(const frustum& frustum, std::span<const float> bbox_min_x,
+                         std::span<const float> bbox_min_y,
+                         std::span<const float> bbox_min_z,
+                         std::span<const float> bbox_max_x,
+                         std::span<const float> bbox_max_y,
+                         std::span<const float> bbox_max_z,
+                         std::span<const material_pipeline_flags> pipeline_flags,
+                         std::vector<uint32>& out_opaque_list,
+                         std::vector<uint32>& out_transparent_list) noexcept;
 
 void cull_objects_shadow_cascade_scalar(const frustum& frustum,
                                         std::span<const math::bounding_box> bbox,
                                         std::span<const material_pipeline_flags> pipeline_flags,
-                                        std::vector<uint16>& out_list) noexcept;
+                                        std::vector<uint32>& out_list) noexcept;
 
 void cull_objects_shadow_cascade_avx2(
    const frustum& frustum, std::span<const float> bbox_min_x,
@@ -36,6 +77,14 @@ void cull_objects_shadow_cascade_avx2(
    std::span<const float> bbox_max_x, std::span<const float> bbox_max_y,
    std::span<const float> bbox_max_z,
    std::span<const material_pipeline_flags> pipeline_flags,
-   std::vector<uint16>& out_list) noexcept;
+   std::vector<uint32>& out_list) noexcept;
+
+void cull_objects_shadow_cascade_avx512(
+   const frustum& frustum, std::span<const float> bbox_min_x,
+   std::span<const float> bbox_min_y, std::span<const float> bbox_min_z,
+   std::span<const float> bbox_max_x, std::span<const float> bbox_max_y,
+   std::span<const float> bbox_max_z,
+   std::span<const material_pipeline_flags> pipeline_flags,
+   std::vector<uint32>& out_list) noexcept;
 
 }
\ No newline at end of file
@@ -1,9 +1,12 @@
 
 #include "frustum.hpp"
 #include "math/matrix_funcs.hpp"
+#include "math/quaternion_funcs.hpp"
 #include "math/vector_funcs.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 
 #include <functional>
 
@@ -127,7 +130,8 @@ bool intersects(const frustum& frustum, const math::bounding_box& bbox)
 
 bool intersects_shadow_cascade(const frustum& frustum, const math::bounding_box& bbox)
 {
-   for (std::size_t i = 0; i < (frustum.planes.size() - 1); ++i) {
+   // The near plane is skipped, objects between it and the sun still cast shadows.
+   for (std::size_t i = 1; i < frustum.planes.size(); ++i) {
       const float4 plane = frustum.planes[i];
 
       if (outside_plane(plane, {bbox.min.x, bbox.min.y, bbox.min.z}) &
@@ -155,4 +159,47 @@ bool intersects(const frustum& frustum, const float3& position, const float radi
 
    return true;
 }
+
+bool intersects_cone(const frustum& frustum, const float3& apex, const float3& direction,
+                     const float height, const float half_angle)
+{
+   const float3 base_centre = apex + direction * height;
+   const float base_radius = height * std::tan(half_angle);
+
+   for (const auto& plane : frustum.planes) {
+      const float3 normal{plane.x, plane.y, plane.z};
+      const float normal_dot_direction = dot(normal, direction);
+
+      // The point of the base furthest along the plane's normal. The apex is the cone's
+      // only other candidate for its furthest point.
+      const float base_distance =
+         dot(plane, float4{base_centre, 1.0f}) +
+         base_radius *
+            std::sqrt(std::max(1.0f - normal_dot_direction * normal_dot_direction, 0.0f));
+
+      if (outside_plane(plane, apex) and base_distance < 0.0f) return false;
+   }
+
+   return true;
+}
+
+bool intersects_oriented_box(const frustum& frustum, const float3& position,
+                             const quaternion& rotation, const float3& half_extents)
+{
+   const std::array<float3, 3> axes{rotation * float3{half_extents.x, 0.0f, 0.0f},
+                                    rotation * float3{0.0f, half_extents.y, 0.0f},
+                                    rotation * float3{0.0f, 0.0f, half_extents.z}};
+
+   for (const auto& plane : frustum.planes) {
+      const float3 normal{plane.x, plane.y, plane.z};
+      const float radius = std::abs(dot(normal, axes[0])) +
+                           std::abs(dot(normal, axes[1])) +
+                           std::abs(dot(normal, axes[2]));
+
+      if (outside_plane(plane, position, radius)) return false;
+   }
+
+   return true;
+}
+
 }
@@ -47,4 +47,22 @@ bool intersects_shadow_cascade(const frustum& frustum, const math::bounding_box&
 
 bool intersects(const frustum& frustum, const float3& position, const float radius);
 
+/// @brief Test a cone, like the one a spot light lights, against a frustum.
+/// @param frustum The frustum.
+/// @param apex The cone's apex.
+/// @param direction The normalized direction the cone opens in.
+/// @param height The length of the cone along direction.
+/// @param half_angle The angle between the cone's axis and its side. Must be less than 90
+/// degrees.
+bool intersects_cone(const frustum& frustum, const float3& apex, const float3& direction,
+                     const float height, const float half_angle);
+
+/// @brief Test an oriented box against a frustum.
+/// @param frustum The frustum.
+/// @param position The centre of the box.
+/// @param rotation The box's rotation.
+/// @param half_extents The box's size along each of its axes from its centre.
+bool intersects_oriented_box(const frustum& frustum, const float3& position,
+                             const quaternion& rotation, const float3& half_extents);
+
 }
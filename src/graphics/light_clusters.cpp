@@ -1,10 +1,11 @@
 
 #include "light_clusters.hpp"
-#include "cull_objects.hpp"
+#include "light_culling.hpp"
 #include "math/align.hpp"
 #include "math/matrix_funcs.hpp"
 #include "math/quaternion_funcs.hpp"
 #include "math/vector_funcs.hpp"
+#include "shadow_cascades.hpp"
 #include "utility/enum_bitflags.hpp"
 #include "utility/srgb_conversion.hpp"
 
@@ -147,103 +148,6 @@ constexpr std::array<uint16, 144> sphere_proxy_indices{
    9,  11, 19, 13, 8,  9,  7, 16, 9,  6,  8,  13, 22, 5,  6,  4,  17, 6,
    3,  5,  22, 21, 2,  3,  1, 18, 3,  0,  2,  21, 19, 11, 0,  10, 25, 0};
 
-auto make_shadow_cascade_splits(const camera& camera)
-   -> std::array<float, cascade_count + 1>
-{
-   const float clip_ratio = camera.far_clip() / camera.near_clip();
-   const float clip_range = camera.far_clip() - camera.near_clip();
-
-   std::array<float, 5> cascade_splits{};
-
-   for (int i = 0; i < cascade_splits.size(); ++i) {
-      const float split = (camera.near_clip() * std::pow(clip_ratio, i / 4.0f));
-      const float split_normalized = (split - camera.near_clip()) / clip_range;
-
-      cascade_splits[i] = split_normalized;
-   }
-
-   return cascade_splits;
-}
-
-auto make_cascade_shadow_camera(const float3 light_direction,
-                                const float near_split, const float far_split,
-                                const frustum& view_frustum) -> shadow_ortho_camera
-{
-   auto view_frustum_corners = view_frustum.corners;
-
-   for (int i = 0; i < 4; ++i) {
-      float3 corner_ray = view_frustum_corners[i + 4] - view_frustum_corners[i];
-
-      view_frustum_corners[i + 4] = view_frustum_corners[i] + (corner_ray * far_split);
-      view_frustum_corners[i] += (corner_ray * near_split);
-   }
-
-   float3 view_frustum_center{0.0f, 0.0f, 0.0f};
-
-   for (const auto& corner : view_frustum_corners) {
-      view_frustum_center += corner;
-   }
-
-   view_frustum_center /= 8.0f;
-
-   float radius = std::numeric_limits<float>::lowest();
-
-   for (const auto& corner : view_frustum_corners) {
-      radius = std::max(distance(corner, view_frustum_center), radius);
-   }
-
-   float3 bounds_max{radius, radius, radius};
-   float3 bounds_min{-radius, -radius, -radius};
-   float3 casecase_extents{bounds_max - bounds_min};
-
-   float3 shadow_camera_position =
-      view_frustum_center + light_direction * -bounds_min.z;
-
-   shadow_ortho_camera shadow_camera;
-   shadow_camera.set_projection(bounds_min.x, bounds_min.y, bounds_max.x,
-                                bounds_max.y, 0.0f, casecase_extents.z);
-   shadow_camera.look_at(shadow_camera_position, view_frustum_center,
-                         float3{0.0f, 1.0f, 0.0f});
-
-   auto shadow_view_projection = shadow_camera.view_projection_matrix();
-
-   float4 shadow_origin = shadow_view_projection * float4{0.0f, 0.0f, 0.0f, 1.0f};
-   shadow_origin /= shadow_origin.w;
-   shadow_origin *= float{shadow_res} / 2.0f;
-
-   float2 shadow_origin_xy = {shadow_origin.x, shadow_origin.y};
-
-   float2 rounded_origin = round(shadow_origin_xy);
-   float2 rounded_offset = rounded_origin - shadow_origin_xy;
-   rounded_offset *= 2.0f / float{shadow_res};
-
-   shadow_camera.set_stabilization(rounded_offset);
-
-   return shadow_camera;
-}
-
-auto make_shadow_cascades(const quaternion light_rotation, const camera& camera,
-                          const std::array<float, 2> scene_depth_min_max)
-   -> std::array<shadow_ortho_camera, cascade_count>
-{
-   const frustum view_frustum{camera.inv_view_projection_matrix(),
-                              scene_depth_min_max[0], scene_depth_min_max[1]};
-
-   const float3 light_direction =
-      normalize(light_rotation * float3{0.0f, 0.0f, -1.0f});
-
-   const std::array cascade_splits = make_shadow_cascade_splits(camera);
-
-   std::array<shadow_ortho_camera, cascade_count> cameras;
-
-   for (int i = 0; i < cascade_count; ++i) {
-      cameras[i] = make_cascade_shadow_camera(light_direction, cascade_splits[i],
-                                              cascade_splits[i + 1], view_frustum);
-   }
-
-   return cameras;
-}
-
 }
 
 light_clusters::light_clusters(gpu::device& device,
@@ -371,6 +275,8 @@ void light_clusters::prepare_lights(const camera& view_camera,
    _light_proxy_count = 0;
    uint32 region_lights_count = 0;
 
+   _shadow_casters.next_frame();
+
    light_constants light_constants{.light_tiles_width = _tiles_width,
                                    .light_tiles_index = _lights_tiles_srv.get(),
                                    .light_region_list_index =
@@ -404,7 +310,8 @@ void light_clusters::prepare_lights(const camera& view_camera,
 
          if (light.shadow_caster) {
             _sun_shadow_cascades =
-               make_shadow_cascades(light.rotation, view_camera, scene_depth_min_max);
+               make_shadow_cascades(light.rotation, view_camera, scene_depth_min_max,
+                                    shadow_res);
 
             flags |= light_flags::is_shadow_caster;
          }
@@ -420,10 +327,6 @@ void light_clusters::prepare_lights(const camera& view_camera,
             (1u << (light_index % tile_light_word_bits));
       } break;
       case world::light_type::point: {
-         if (not intersects(view_frustum, light.position, light.range)) {
-            return;
-         }
-
          lights[light_index] = {.type = light_type::point,
                                 .position = light.position,
                                 .range = light.range,
@@ -439,18 +342,6 @@ void light_clusters::prepare_lights(const camera& view_camera,
          const float3 light_direction =
             normalize(light.rotation * float3{0.0f, 0.0f, -1.0f});
 
-         const float half_range = light.range / 2.0f;
-         const float cone_radius = half_range * std::tan(light.outer_cone_angle);
-
-         const float light_bounds_radius = std::max(cone_radius, half_range);
-         const float3 light_centre =
-            light.position - (light_direction * (half_range));
-
-         // TODO: Cone-frustum intersection (but how much of a problem is it?)
-         if (not intersects(view_frustum, light_centre, light_bounds_radius)) {
-            return;
-         }
-
          lights[light_index] = {.direction = light_direction,
                                 .type = light_type::spot,
                                 .position = light.position,
@@ -553,15 +444,22 @@ void light_clusters::prepare_lights(const camera& view_camera,
       }
    };
 
-   // frustum cull lights
-   for (auto& light : world.lights) {
+   // The placement light goes first so it's never the one dropped when there are too many
+   // lights.
+   if (optional_placement_light and
+       is_light_visible(view_frustum, *optional_placement_light)) {
+      process_light(*optional_placement_light);
+   }
+
+   // Visible lights come sorted by influence, any past max_lights are the least noticeable.
+   cull_lights(view_frustum, view_camera.position(), world.lights, _visible_lights);
+
+   for (const uint32 light_index : _visible_lights) {
       if (_light_count >= max_lights) break;
 
-      process_light(light);
+      process_light(world.lights[light_index]);
    }
 
-   if (optional_placement_light) process_light(*optional_placement_light);
-
    light_constants.shadow_transforms = {_sun_shadow_cascades[0].texture_matrix(),
                                         _sun_shadow_cascades[1].texture_matrix(),
                                         _sun_shadow_cascades[2].texture_matrix(),
@@ -708,6 +606,19 @@ void light_clusters::tile_lights(root_signature_library& root_signatures,
    }
 }
 
+void light_clusters::cull_shadow_cascade(const uint32 cascade_index,
+                                         const world_mesh_list& meshes,
+                                         const world_mesh_bvh& meshes_bvh) noexcept
+{
+   _shadow_casters.cull(cascade_index, _sun_shadow_cascades[cascade_index], meshes,
+                        meshes_bvh);
+}
+
+void light_clusters::invalidate_shadow_casters() noexcept
+{
+   _shadow_casters.invalidate();
+}
+
 void light_clusters::draw_shadow_maps(
    const world_mesh_list& meshes, root_signature_library& root_signatures,
    pipeline_library& pipelines, gpu::graphics_command_list& command_list,
@@ -737,14 +648,6 @@ void light_clusters::draw_shadow_maps(
    for (int cascade_index = 0; cascade_index < cascade_count; ++cascade_index) {
       auto& shadow_camera = _sun_shadow_cascades[cascade_index];
 
-      frustum shadow_frustum{shadow_camera.inv_view_projection_matrix()};
-
-      cull_objects_shadow_cascade_avx2(shadow_frustum, meshes.bbox.min.x,
-                                       meshes.bbox.min.y, meshes.bbox.min.z,
-                                       meshes.bbox.max.x, meshes.bbox.max.y,
-                                       meshes.bbox.max.z, meshes.pipeline_flags,
-                                       _shadow_render_list);
-
       gpu::dsv_handle depth_stencil_view = _shadow_map_dsv[cascade_index].get();
 
       command_list.clear_depth_stencil_view(depth_stencil_view, {}, 1.0f, 0x0);
@@ -767,7 +670,7 @@ void light_clusters::draw_shadow_maps(
 
       command_list.set_pipeline_state(pipelines.mesh_shadow.get());
 
-      for (const uint16 i : _shadow_render_list) {
+      for (const uint32 i : _shadow_casters.casters(cascade_index)) {
          if (std::exchange(pipeline_flags, meshes.pipeline_flags[i]) !=
              meshes.pipeline_flags[i]) {
 
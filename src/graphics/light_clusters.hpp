@@ -11,9 +11,11 @@
 #include "profiler.hpp"
 #include "root_signature_library.hpp"
 #include "shadow_camera.hpp"
+#include "shadow_cascades.hpp"
 #include "terrain.hpp"
 #include "world/object_class.hpp"
 #include "world/world.hpp"
+#include "world_mesh_bvh.hpp"
 #include "world_mesh_list.hpp"
 
 #include <array>
@@ -41,6 +43,20 @@ public:
                     dynamic_buffer_allocator& dynamic_buffer_allocator,
                     profiler& profiler);
 
+   /// @brief Cull the world meshes against one of the sun's shadow cascades. Each cascade
+   /// has its own render list so every cascade can be culled at once from different
+   /// threads. Must be called for every cascade after prepare_lights and before
+   /// draw_shadow_maps.
+   ///
+   /// The distant cascades reuse their casters from earlier frames when they can, see
+   /// shadow_caster_cache.
+   void cull_shadow_cascade(const uint32 cascade_index, const world_mesh_list& meshes,
+                            const world_mesh_bvh& meshes_bvh) noexcept;
+
+   /// @brief Throw away the shadow casters kept from earlier frames. Call whenever the
+   /// world mesh list changed.
+   void invalidate_shadow_casters() noexcept;
+
    void draw_shadow_maps(const world_mesh_list& meshes,
                          root_signature_library& root_signatures,
                          pipeline_library& pipelines,
@@ -50,7 +66,7 @@ public:
 
    auto lights_constant_buffer_view() const noexcept -> gpu_virtual_address;
 
-   constexpr static uint32 sun_cascade_count = 4;
+   constexpr static uint32 sun_cascade_count = sun_shadow_cascade_count;
 
 private:
    void update_render_resolution(uint32 width, uint32 height, bool recreate_descriptors);
@@ -90,10 +106,11 @@ private:
    std::array<uint32, 8> _tiles_start_value;
    uint32 _light_count = 0;
    uint32 _light_proxy_count = 0;
+   std::vector<uint32> _visible_lights;
    gpu_virtual_address _sphere_light_proxies_srv = 0;
 
    std::array<shadow_ortho_camera, sun_cascade_count> _sun_shadow_cascades;
-   std::vector<uint16> _shadow_render_list;
+   shadow_caster_cache _shadow_casters;
 };
 
 }
@@ -0,0 +1,132 @@
+#include "light_culling.hpp"
+#include "math/quaternion_funcs.hpp"
+#include "math/vector_funcs.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace we::graphics {
+
+namespace {
+
+struct light_bounds {
+   float3 position;
+   float radius = 0.0f;
+};
+
+auto get_light_direction(const world::light& light) noexcept -> float3
+{
+   return normalize(light.rotation * float3{0.0f, 0.0f, -1.0f});
+}
+
+auto get_cylinder_half_extents(const world::light& light) noexcept -> float3
+{
+   const float radius = length(float2{light.region_size.x, light.region_size.z});
+
+   return {radius, light.region_size.y, radius};
+}
+
+auto get_light_bounds(const world::light& light) noexcept -> light_bounds
+{
+   switch (light.light_type) {
+   case world::light_type::point:
+   case world::light_type::spot:
+      return {.position = light.position, .radius = light.range};
+   case world::light_type::directional_region_box:
+   case world::light_type::directional_region_sphere:
+      return {.position = light.position, .radius = length(light.region_size)};
+   case world::light_type::directional_region_cylinder:
+      return {.position = light.position,
+              .radius = length(get_cylinder_half_extents(light))};
+   default:
+      return {.position = light.position, .radius = std::numeric_limits<float>::max()};
+   }
+}
+
+}
+
+bool is_light_visible(const frustum& frustum, const world::light& light) noexcept
+{
+   switch (light.light_type) {
+   case world::light_type::directional:
+      return true;
+   case world::light_type::point:
+      return intersects(frustum, light.position, light.range);
+   case world::light_type::spot: {
+      if (not intersects(frustum, light.position, light.range)) return false;
+
+      // The lit volume is the part of the sphere inside the cone. Wide cones are left to
+      // the sphere test.
+      const float half_angle = light.outer_cone_angle / 2.0f;
+
+      if (half_angle >= 1.5f) return true;
+
+      // The light's direction points from the lit surfaces towards the light, like in the
+      // shaders, so the cone opens along its negation.
+      return intersects_cone(frustum, light.position, -get_light_direction(light),
+                             light.range, half_angle);
+   }
+   case world::light_type::directional_region_box:
+      return intersects_oriented_box(frustum, light.position, light.region_rotation,
+                                     light.region_size);
+   case world::light_type::directional_region_sphere:
+      return intersects(frustum, light.position, length(light.region_size));
+   case world::light_type::directional_region_cylinder:
+      return intersects_oriented_box(frustum, light.position, light.region_rotation,
+                                     get_cylinder_half_extents(light));
+   }
+
+   return true;
+}
+
+auto light_screen_influence(const world::light& light, const float3& camera_position) noexcept
+   -> float
+{
+   if (light.light_type == world::light_type::directional) {
+      return std::numeric_limits<float>::infinity();
+   }
+
+   const light_bounds bounds = get_light_bounds(light);
+   const float radius_sq = bounds.radius * bounds.radius;
+   const float3 offset = bounds.position - camera_position;
+
+   // Roughly the fraction of the view the bounds cover, 1 once the camera is inside them.
+   const float coverage = radius_sq / std::max(dot(offset, offset), radius_sq);
+   const float brightness = std::max({light.color.x, light.color.y, light.color.z});
+
+   return coverage * brightness;
+}
+
+void cull_lights(const frustum& view_frustum, const float3& camera_position,
+                 std::span<const world::light> lights, std::vector<uint32>& out_lights) noexcept
+{
+   struct visible_light {
+      float influence;
+      uint32 index;
+   };
+
+   std::vector<visible_light> visible_lights;
+
+   visible_lights.reserve(lights.size());
+
+   for (uint32 i = 0; i < lights.size(); ++i) {
+      if (not is_light_visible(view_frustum, lights[i])) continue;
+
+      visible_lights.push_back(
+         {.influence = light_screen_influence(lights[i], camera_position), .index = i});
+   }
+
+   std::ranges::stable_sort(visible_lights, [](const visible_light& l,
+                                               const visible_light& r) {
+      return l.influence > r.influence;
+   });
+
+   out_lights.resize(visible_lights.size());
+
+   for (std::size_t i = 0; i < visible_lights.size(); ++i) {
+      out_lights[i] = visible_lights[i].index;
+   }
+}
+
+}
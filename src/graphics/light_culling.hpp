@@ -0,0 +1,41 @@
+#pragma once
+
+#include "frustum.hpp"
+#include "types.hpp"
+#include "world/light.hpp"
+
+#include <span>
+#include <vector>
+
+namespace we::graphics {
+
+/// @brief Test if a light lights any of a frustum. Directional lights always do, other
+/// lights are tested with their exact shape: a sphere for point lights, a cone capped by
+/// a sphere for spot lights and the region for region lights.
+/// @param frustum The frustum.
+/// @param light The light.
+[[nodiscard]] bool is_light_visible(const frustum& frustum,
+                                    const world::light& light) noexcept;
+
+/// @brief Estimate how much of the screen a light affects. Directional lights light
+/// everything and have infinite influence, for other lights it's their brightness scaled
+/// by how large their bounds appear from the camera.
+/// @param light The light.
+/// @param camera_position The position of the camera.
+[[nodiscard]] auto light_screen_influence(const world::light& light,
+                                          const float3& camera_position) noexcept
+   -> float;
+
+/// @brief Cull lights against the view frustum and order the visible lights by their
+/// screen influence, most influential first. Lights with the same influence keep their
+/// order. When there are more visible lights than can be drawn taking them from the front
+/// keeps the ones that matter most.
+/// @param view_frustum The view frustum.
+/// @param camera_position The position of the camera.
+/// @param lights The lights.
+/// @param out_lights Receives the indices of the visible lights.
+void cull_lights(const frustum& view_frustum, const float3& camera_position,
+                 std::span<const world::light> lights,
+                 std::vector<uint32>& out_lights) noexcept;
+
+}
@@ -0,0 +1,132 @@
+#include "meta_culling.hpp"
+#include "math/vector_funcs.hpp"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace we::graphics {
+
+namespace {
+
+constexpr std::size_t path_group_nodes = 32;
+
+auto distance_to_sphere(const float3& point, const float3& position,
+                        const float radius) noexcept -> float
+{
+   return std::max(distance(point, position) - radius, 0.0f);
+}
+
+auto distance_to_box(const float3& point, const math::bounding_box& bbox) noexcept
+   -> float
+{
+   return distance(point, clamp(point, bbox.min, bbox.max));
+}
+
+auto fade_from_distance(const float distance, const float draw_distance) noexcept -> float
+{
+   const float fade_distance = draw_distance * meta_culling::fade_fraction;
+
+   return std::clamp((draw_distance - distance) / fade_distance, 0.0f, 1.0f);
+}
+
+auto make_segment_bbox(const float3& a, const float3& b) noexcept -> math::bounding_box
+{
+   return {.min = min(a, b), .max = max(a, b)};
+}
+
+}
+
+meta_culling::meta_culling(const frustum& view_frustum, const float3& camera_position,
+                           const float draw_distance) noexcept
+   : _frustum{view_frustum},
+     _camera_position{camera_position},
+     _draw_distance{draw_distance}
+{
+}
+
+bool meta_culling::visible(const float3& position, const float radius) const noexcept
+{
+   if (distance_to_sphere(_camera_position, position, radius) > _draw_distance) {
+      return false;
+   }
+
+   return intersects(_frustum, position, radius);
+}
+
+bool meta_culling::visible(const math::bounding_box& bbox) const noexcept
+{
+   if (distance_to_box(_camera_position, bbox) > _draw_distance) return false;
+
+   return intersects(_frustum, bbox);
+}
+
+bool meta_culling::visible(const float3& position, const quaternion& rotation,
+                           const float3& half_extents) const noexcept
+{
+   if (distance_to_sphere(_camera_position, position, length(half_extents)) >
+       _draw_distance) {
+      return false;
+   }
+
+   return intersects_oriented_box(_frustum, position, rotation, half_extents);
+}
+
+bool meta_culling::detailed(const float3& position, const float radius) const noexcept
+{
+   return distance_to_sphere(_camera_position, position, radius) <=
+          _draw_distance * detail_fraction;
+}
+
+auto meta_culling::fade(const float3& position, const float radius) const noexcept
+   -> float
+{
+   return fade_from_distance(distance_to_sphere(_camera_position, position, radius),
+                             _draw_distance);
+}
+
+auto meta_culling::fade(const math::bounding_box& bbox) const noexcept -> float
+{
+   return fade_from_distance(distance_to_box(_camera_position, bbox), _draw_distance);
+}
+
+void cull_path(const meta_culling& culling, std::span<const world::path::node> nodes,
+               const float node_radius, std::vector<uint32>& out_nodes,
+               std::vector<uint32>& out_connections) noexcept
+{
+   out_nodes.clear();
+   out_connections.clear();
+
+   for (std::size_t group_start = 0; group_start < nodes.size();
+        group_start += path_group_nodes) {
+      const std::size_t group_end = std::min(group_start + path_group_nodes, nodes.size());
+
+      // The group's bounds include the first node of the next group so they also cover
+      // the connection between the two groups.
+      const std::size_t bounds_end = std::min(group_end + 1, nodes.size());
+
+      math::bounding_box group_bbox{.min = float3{FLT_MAX, FLT_MAX, FLT_MAX},
+                                    .max = float3{-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+
+      for (std::size_t i = group_start; i < bounds_end; ++i) {
+         group_bbox = math::integrate(group_bbox, nodes[i].position);
+      }
+
+      group_bbox.min -= node_radius;
+      group_bbox.max += node_radius;
+
+      if (not culling.visible(group_bbox)) continue;
+
+      for (std::size_t i = group_start; i < group_end; ++i) {
+         if (culling.visible(nodes[i].position, node_radius)) {
+            out_nodes.push_back(static_cast<uint32>(i));
+         }
+
+         if (i + 1 < nodes.size() and
+             culling.visible(make_segment_bbox(nodes[i].position, nodes[i + 1].position))) {
+            out_connections.push_back(static_cast<uint32>(i));
+         }
+      }
+   }
+}
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "frustum.hpp"
+#include "math/bounding_box.hpp"
+#include "types.hpp"
+#include "world/path.hpp"
+
+#include <span>
+#include <vector>
+
+namespace we::graphics {
+
+/// @brief Frustum and distance culling for meta entities (paths, regions, hintnodes,
+/// etc). Entities past the draw distance are culled, ones approaching it fade out and only
+/// ones close to the camera draw small details like orientation arrows.
+struct meta_culling {
+   /// @brief The fraction of the draw distance over which entities fade out.
+   constexpr static float fade_fraction = 0.25f;
+
+   /// @brief The fraction of the draw distance within which details are drawn.
+   constexpr static float detail_fraction = 0.25f;
+
+   /// @param view_frustum The view frustum. Must outlive the meta_culling.
+   /// @param camera_position The position of the camera.
+   /// @param draw_distance The distance past which entities are culled.
+   meta_culling(const frustum& view_frustum, const float3& camera_position,
+                const float draw_distance) noexcept;
+
+   /// @brief Test if a sphere is in view and within the draw distance.
+   [[nodiscard]] bool visible(const float3& position, const float radius) const noexcept;
+
+   /// @brief Test if a box is in view and within the draw distance.
+   [[nodiscard]] bool visible(const math::bounding_box& bbox) const noexcept;
+
+   /// @brief Test if an oriented box is in view and within the draw distance.
+   [[nodiscard]] bool visible(const float3& position, const quaternion& rotation,
+                              const float3& half_extents) const noexcept;
+
+   /// @brief Test if a sphere is close enough to the camera to draw its details.
+   [[nodiscard]] bool detailed(const float3& position, const float radius) const noexcept;
+
+   /// @brief Get the opacity to draw a sphere with. 1 until it approaches the draw
+   /// distance then falls to 0 at it.
+   [[nodiscard]] auto fade(const float3& position, const float radius) const noexcept
+      -> float;
+
+   /// @brief Get the opacity to draw a box with. See the sphere overload.
+   [[nodiscard]] auto fade(const math::bounding_box& bbox) const noexcept -> float;
+
+private:
+   const frustum& _frustum;
+   float3 _camera_position;
+   float _draw_distance;
+};
+
+/// @brief Cull the nodes of a path and the connections between them. Nodes are tested
+/// in groups first so paths and parts of paths out of view are skipped without testing
+/// every node.
+/// @param culling The culling to test against.
+/// @param nodes The path's nodes.
+/// @param node_radius The radius of a node's visualizer.
+/// @param out_nodes Receives the indices of the visible nodes.
+/// @param out_connections Receives the indices of the visible connections. Connection i
+/// links node i and i + 1.
+void cull_path(const meta_culling& culling, std::span<const world::path::node> nodes,
+               const float node_radius, std::vector<uint32>& out_nodes,
+               std::vector<uint32>& out_connections) noexcept;
+
+}
@@ -210,6 +210,35 @@ void meta_draw_batcher::add_line_overlay(const float3& a, const float3& b,
    _lines_overlay.emplace_back(a, color, b);
 }
 
+void meta_draw_batcher::append(const meta_draw_batcher& other)
+{
+   const auto append_vector = []<typename T>(std::vector<T>& to,
+                                             const std::vector<T>& from) {
+      to.insert(to.end(), from.begin(), from.end());
+   };
+
+   append_vector(_octahedrons_outlined, other._octahedrons_outlined);
+
+   append_vector(_octahedrons, other._octahedrons);
+   append_vector(_hint_hexahedrons, other._hint_hexahedrons);
+   append_vector(_boxes, other._boxes);
+   append_vector(_spheres, other._spheres);
+   append_vector(_cylinders, other._cylinders);
+   append_vector(_cones, other._cones);
+   append_vector(_triangles, other._triangles);
+   append_vector(_lines_solid, other._lines_solid);
+
+   append_vector(_octahedrons_wireframe, other._octahedrons_wireframe);
+   append_vector(_hint_hexahedrons_wireframe, other._hint_hexahedrons_wireframe);
+   append_vector(_boxes_wireframe, other._boxes_wireframe);
+   append_vector(_spheres_wireframe, other._spheres_wireframe);
+   append_vector(_cylinders_wireframe, other._cylinders_wireframe);
+   append_vector(_cones_wireframe, other._cones_wireframe);
+   append_vector(_triangles_wireframe, other._triangles_wireframe);
+
+   append_vector(_lines_overlay, other._lines_overlay);
+}
+
 void meta_draw_batcher::draw(gpu::graphics_command_list& command_list,
                              gpu_virtual_address frame_constant_buffer,
                              root_signature_library& root_signature_library,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "async/thread_pool.hpp"
 #include "dynamic_buffer_allocator.hpp"
 #include "geometric_shapes.hpp"
 #include "gpu/rhi.hpp"
@@ -7,6 +8,7 @@
 #include "root_signature_library.hpp"
 #include "types.hpp"
 
+#include <algorithm>
 #include <vector>
 
 namespace we::graphics {
@@ -15,6 +17,8 @@ struct alignas(16) meta_draw_outlined {
    float4x4 transform;
    float4 color;
    float4 outline_color;
+
+   bool operator==(const meta_draw_outlined&) const noexcept = default;
 };
 
 static_assert(sizeof(meta_draw_outlined) == 96);
@@ -23,6 +27,8 @@ struct alignas(16) meta_draw_object {
    float4x4 transform;
 
    float4 color;
+
+   bool operator==(const meta_draw_object&) const noexcept = default;
 };
 
 static_assert(sizeof(meta_draw_object) == 80);
@@ -32,6 +38,8 @@ struct alignas(16) meta_draw_sphere {
    float radius;
 
    float4 color;
+
+   bool operator==(const meta_draw_sphere&) const noexcept = default;
 };
 
 static_assert(sizeof(meta_draw_sphere) == 32);
@@ -39,6 +47,8 @@ static_assert(sizeof(meta_draw_sphere) == 32);
 struct alignas(16) meta_draw_vertex {
    float3 v;
    uint32 color;
+
+   bool operator==(const meta_draw_vertex&) const noexcept = default;
 };
 
 static_assert(sizeof(meta_draw_vertex) == 16);
@@ -48,6 +58,8 @@ struct alignas(16) meta_draw_line {
    uint32 color;
    float3 positio1;
    uint32 pad;
+
+   bool operator==(const meta_draw_line&) const noexcept = default;
 };
 
 static_assert(sizeof(meta_draw_line) == 32);
@@ -98,12 +110,20 @@ struct meta_draw_batcher {
 
    void add_line_overlay(const float3& a, const float3& b, const uint32 color);
 
+   /// @brief Append the draws recorded in another batcher after the ones in this one.
+   /// Appending batchers in the order their draws were recorded gives the same result as
+   /// recording all the draws into one batcher.
+   /// @param other The batcher to append the draws of.
+   void append(const meta_draw_batcher& other);
+
    void draw(gpu::graphics_command_list& command_list,
              gpu_virtual_address frame_constant_buffer,
              root_signature_library& root_signature_library,
              pipeline_library& pipeline_library, geometric_shapes& shapes,
              dynamic_buffer_allocator& dynamic_buffer_allocator) const;
 
+   bool operator==(const meta_draw_batcher&) const noexcept = default;
+
 private:
    bool all_empty() const noexcept;
 
@@ -129,4 +149,47 @@ private:
    std::vector<meta_draw_line> _lines_overlay;
 };
 
+/// @brief Record meta draws for a range of items across a thread pool. Each worker records
+/// a contiguous run of the items into its own batcher and the batchers are then appended
+/// in order, so the result is the same as recording every item on one thread.
+/// @param batcher The batcher to append the draws to.
+/// @param worker_batchers The batchers the workers record into. Resized as needed, pass
+/// the same vector each frame to reuse their memory.
+/// @param count The number of items.
+/// @param thread_pool The thread pool to record on.
+/// @param record Records a run of items. Called as record(batcher, begin, end), possibly
+/// from several threads at once.
+template<typename Fn>
+void record_meta_draws(meta_draw_batcher& batcher,
+                       std::vector<meta_draw_batcher>& worker_batchers,
+                       const std::size_t count, async::thread_pool& thread_pool,
+                       const Fn& record) noexcept
+   requires(std::is_nothrow_invocable_v<Fn, meta_draw_batcher&, std::size_t, std::size_t>)
+{
+   const std::size_t run_count =
+      std::min(count, thread_pool.thread_count(async::task_priority::normal) + 1);
+
+   if (run_count <= 1) {
+      record(batcher, std::size_t{0}, count);
+
+      return;
+   }
+
+   if (worker_batchers.size() < run_count) worker_batchers.resize(run_count);
+
+   thread_pool.for_each_n(async::task_priority::normal, run_count,
+                          [&](const std::size_t run) noexcept {
+                             meta_draw_batcher& worker_batcher = worker_batchers[run];
+
+                             worker_batcher.clear();
+
+                             record(worker_batcher, count * run / run_count,
+                                    count * (run + 1) / run_count);
+                          });
+
+   for (std::size_t run = 0; run < run_count; ++run) {
+      batcher.append(worker_batchers[run]);
+   }
+}
+
 }
\ No newline at end of file
@@ -79,6 +79,7 @@ void model_manager::update_models() noexcept
             // TODO: Currently we don't have to worry about model lifetime here but if in the future we're rendering
             // thumbnails in the background we may have to revist this.
             _models[name] = pending_create.task.get();
+            _generation += 1;
          }
          catch (std::exception& e) {
             _error_output.write(
@@ -97,15 +98,24 @@ void model_manager::trim_models() noexcept
 {
    std::lock_guard lock{_mutex};
 
+   const std::size_t model_count = _models.size();
+
    erase_if(_models, [](const auto& key_value) {
       const auto& [name, state] = key_value;
 
       return state.asset.use_count() == 1;
    });
 
+   if (_models.size() != model_count) _generation += 1;
+
    _pending_destroys.clear();
 }
 
+auto model_manager::generation() const noexcept -> uint64
+{
+   return _generation;
+}
+
 void model_manager::model_loaded(const lowercase_string& name,
                                  asset_ref<assets::msh::flat_model> asset,
                                  asset_data<assets::msh::flat_model> data) noexcept
@@ -47,6 +47,11 @@ public:
    ///        Also destroys models for which model_manager is the only remaining reference for the asset.
    void trim_models() noexcept;
 
+   /// @brief Get a counter that is incremented whenever a model is created, replaced or
+   /// destroyed. Lets users caching model references or data derived from models know
+   /// when to refresh it.
+   auto generation() const noexcept -> uint64;
+
 private:
    struct model_state {
       std::unique_ptr<model> model;
@@ -82,6 +87,8 @@ private:
 
    std::shared_ptr<async::thread_pool> _thread_pool;
 
+   uint64 _generation = 0;
+
    model _placeholder_model;
 
    event_listener<void(const lowercase_string&, asset_ref<assets::msh::flat_model>,
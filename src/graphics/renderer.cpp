@@ -3,7 +3,6 @@
 #include "async/thread_pool.hpp"
 #include "camera.hpp"
 #include "copy_command_list_pool.hpp"
-#include "cull_objects.hpp"
 #include "dynamic_buffer_allocator.hpp"
 #include "frustum.hpp"
 #include "geometric_shapes.hpp"
@@ -13,6 +12,7 @@
 #include "math/matrix_funcs.hpp"
 #include "math/quaternion_funcs.hpp"
 #include "math/vector_funcs.hpp"
+#include "meta_culling.hpp"
 #include "meta_draw_batcher.hpp"
 #include "model_manager.hpp"
 #include "output_stream.hpp"
@@ -24,15 +24,20 @@
 #include "shader_library.hpp"
 #include "shader_list.hpp"
 #include "sky.hpp"
+#include "software_occlusion.hpp"
 #include "terrain.hpp"
 #include "texture_manager.hpp"
+#include "utility/name_table.hpp"
 #include "utility/overload.hpp"
 #include "utility/srgb_conversion.hpp"
 #include "utility/stopwatch.hpp"
+#include "world/object_bbox_cache.hpp"
 #include "world/object_class_library.hpp"
+#include "world/object_store.hpp"
 #include "world/utility/boundary_nodes.hpp"
 #include "world/utility/world_utilities.hpp"
 #include "world/world.hpp"
+#include "world_mesh_list_builder.hpp"
 
 #include <imgui.h>
 
@@ -89,6 +94,8 @@ struct renderer_impl final : renderer {
                    const world::active_layers active_layers,
                    const world::tool_visualizers& tool_visualizers,
                    const world::object_class_library& world_classes,
+                   const world::object_bbox_cache& world_bboxes,
+                   const world::object_store& world_objects,
                    const settings::graphics& settings) override;
 
    void window_resized(uint16 width, uint16 height) override;
@@ -121,13 +128,14 @@ private:
                    const world::active_entity_types active_entity_types,
                    gpu::graphics_command_list& command_list);
 
-   void draw_world_render_list_depth_prepass(const std::vector<uint16>& list,
+   void draw_world_render_list_depth_prepass(const std::vector<uint32>& list,
                                              gpu::graphics_command_list& command_list);
 
-   void draw_world_render_list(const std::vector<uint16>& list,
+   void draw_world_render_list(const std::vector<uint32>& list,
                                gpu::graphics_command_list& command_list);
 
-   void draw_world_meta_objects(const frustum& view_frustum, const world::world& world,
+   void draw_world_meta_objects(const frustum& view_frustum, const float3& camera_position,
+                                const world::world& world,
                                 const world::interaction_targets& interaction_targets,
                                 const world::active_entity_types active_entity_types,
                                 const world::active_layers active_layers,
@@ -144,9 +152,23 @@ private:
                               const world::world& world,
                               const world::active_layers active_layers,
                               const world::object_class_library& world_classes,
+                              const world::object_bbox_cache& world_bboxes,
+                              const world::object_store& world_objects,
                               const world::object* const creation_object);
 
-   void build_object_render_list(const frustum& view_frustum);
+   void build_render_lists(const camera& camera, const frustum& view_frustum,
+                           const world::world& world,
+                           const world::active_entity_types active_entity_types,
+                           const world::active_layers active_layers,
+                           const world::object_class_library& world_classes,
+                           const world::object_bbox_cache& world_bboxes);
+
+   void build_occlusion_buffer(const camera& camera, const frustum& view_frustum,
+                               const world::world& world,
+                               const world::active_entity_types active_entity_types,
+                               const world::active_layers active_layers,
+                               const world::object_class_library& world_classes,
+                               const world::object_bbox_cache& world_bboxes) noexcept;
 
    void clear_depth_minmax(gpu::copy_command_list& command_list);
 
@@ -227,23 +249,42 @@ private:
    terrain _terrain{_device, _texture_manager};
    sky _sky;
 
-   constexpr static std::size_t max_drawn_objects = 2048;
-   constexpr static std::size_t objects_constants_buffer_size =
-      max_drawn_objects * sizeof(world_mesh_constants);
+   /// @brief A page of object constants. Pages are added as the number of drawn objects
+   /// grows and are never freed, so the GPU addresses handed out from them stay valid.
+   struct object_constants_page {
+      gpu::unique_resource_handle buffer;
+      gpu_virtual_address gpu_address = 0;
 
-   std::array<gpu::unique_resource_handle, gpu::frame_pipeline_length> _object_constants_upload_buffers;
-   std::array<std::byte*, gpu::frame_pipeline_length> _object_constants_upload_cpu_ptrs;
-   gpu::unique_resource_handle _object_constants_buffer =
-      {_device.create_buffer({.size = objects_constants_buffer_size,
-                              .debug_name = "Object Constant Buffers"},
-                             gpu::heap_type::default_),
-       _device.direct_queue};
+      std::array<gpu::unique_resource_handle, gpu::frame_pipeline_length> upload_buffers;
+      std::array<world_mesh_constants*, gpu::frame_pipeline_length> upload_cpu_ptrs;
+   };
+
+   constexpr static std::size_t object_constants_page_objects = 4096;
+   constexpr static std::size_t object_constants_page_size =
+      object_constants_page_objects * sizeof(world_mesh_constants);
+
+   void add_object_constants_page();
+
+   std::vector<object_constants_page> _object_constants_pages;
 
    world_mesh_list _world_mesh_list;
-   std::vector<uint16> _opaque_object_render_list;
-   std::vector<uint16> _transparent_object_render_list;
+   world_mesh_list_state _world_mesh_list_state;
+   world_mesh_bvh _world_mesh_bvh;
+   world_mesh_sort_buffers _world_mesh_sort_buffers;
+   std::vector<model*> _class_models;
+   std::vector<uint32> _opaque_object_render_list;
+   std::vector<uint32> _transparent_object_render_list;
+
+   constexpr static float occluder_min_score = 0.05f;
+   constexpr static std::size_t max_occluder_objects = 32;
+   constexpr static std::size_t max_occluder_object_triangles = 65536;
+
+   occlusion_buffer _occlusion_buffer;
+   occluder_mesh _terrain_occluder;
+   std::vector<uint32> _occluder_objects;
 
    meta_draw_batcher _meta_draw_batcher;
+   std::vector<meta_draw_batcher> _meta_draw_worker_batchers;
 
    imgui_renderer _imgui_renderer{_device, _copy_command_list_pool};
 
@@ -268,17 +309,7 @@ renderer_impl::renderer_impl(const renderer::window_handle window,
                     thread_pool,      _error_output},
      _sky{_device, _model_manager, asset_libraries}
 {
-   // create object constants upload buffers
-   for (std::size_t i = 0; i < _object_constants_upload_buffers.size(); ++i) {
-      _object_constants_upload_buffers[i] = {
-         _device.create_buffer({.size = objects_constants_buffer_size,
-                                .debug_name = "Object Constant Upload Buffers"},
-                               gpu::heap_type::upload),
-         _device.direct_queue};
-
-      _object_constants_upload_cpu_ptrs[i] = static_cast<std::byte*>(
-         _device.map(_object_constants_upload_buffers[i].get(), 0, {}));
-   }
+   add_object_constants_page();
 
    // map depth minmax readback buffer
    {
@@ -307,6 +338,8 @@ void renderer_impl::draw_frame(const camera& camera, const world::world& world,
                                const world::active_layers active_layers,
                                const world::tool_visualizers& tool_visualizers,
                                const world::object_class_library& world_classes,
+                               const world::object_bbox_cache& world_bboxes,
+                               const world::object_store& world_objects,
                                const settings::graphics& settings)
 {
    const frustum view_frustum{camera.inv_view_projection_matrix()};
@@ -326,10 +359,12 @@ void renderer_impl::draw_frame(const camera& camera, const world::world& world,
       if (std::exchange(_terrain_dirty, false)) {
          _terrain.init(world.terrain, _pre_render_command_list,
                        _dynamic_buffer_allocator);
+         _terrain_occluder = make_terrain_occluder(world.terrain);
       }
 
       update_textures(_pre_render_command_list);
       build_world_mesh_list(_pre_render_command_list, world, active_layers, world_classes,
+                            world_bboxes, world_objects,
                             interaction_targets.creation_entity
                                ? std::get_if<world::object>(
                                     &(*interaction_targets.creation_entity))
@@ -355,7 +390,8 @@ void renderer_impl::draw_frame(const camera& camera, const world::world& world,
       _device.direct_queue.sync_with(_device.copy_queue);
    }
 
-   build_object_render_list(view_frustum);
+   build_render_lists(camera, view_frustum, world, active_entity_types, active_layers,
+                      world_classes, world_bboxes);
 
    auto& command_list = _world_command_list;
 
@@ -363,9 +399,8 @@ void renderer_impl::draw_frame(const camera& camera, const world::world& world,
 
    _light_clusters.tile_lights(_root_signatures, _pipelines, command_list,
                                _dynamic_buffer_allocator, _profiler);
-   _light_clusters.draw_shadow_maps(_world_mesh_list, _root_signatures,
-                                    _pipelines, command_list,
-                                    _dynamic_buffer_allocator, _profiler);
+   _light_clusters.draw_shadow_maps(_world_mesh_list, _root_signatures, _pipelines,
+                                    command_list, _dynamic_buffer_allocator, _profiler);
 
    [[likely]] if (_device.supports_enhanced_barriers()) {
       command_list.deferred_barrier(
@@ -417,8 +452,8 @@ void renderer_impl::draw_frame(const camera& camera, const world::world& world,
    // Render World Meta Objects
    _meta_draw_batcher.clear();
 
-   draw_world_meta_objects(view_frustum, world, interaction_targets, active_entity_types,
-                           active_layers, tool_visualizers, settings);
+   draw_world_meta_objects(view_frustum, camera.position(), world, interaction_targets,
+                           active_entity_types, active_layers, tool_visualizers, settings);
 
    draw_interaction_targets(view_frustum, world, interaction_targets,
                             world_classes, settings, command_list);
@@ -579,7 +614,7 @@ void renderer_impl::draw_world(const frustum& view_frustum,
    }
 }
 
-void renderer_impl::draw_world_render_list(const std::vector<uint16>& list,
+void renderer_impl::draw_world_render_list(const std::vector<uint32>& list,
                                            gpu::graphics_command_list& command_list)
 {
 
@@ -612,7 +647,7 @@ void renderer_impl::draw_world_render_list(const std::vector<uint16>& list,
 }
 
 void renderer_impl::draw_world_render_list_depth_prepass(
-   const std::vector<uint16>& list, gpu::graphics_command_list& command_list)
+   const std::vector<uint32>& list, gpu::graphics_command_list& command_list)
 {
    command_list.set_graphics_root_signature(_root_signatures.mesh_depth_prepass.get());
    command_list.set_graphics_cbv(rs::mesh_depth_prepass::frame_cbv,
@@ -665,12 +700,14 @@ void renderer_impl::draw_world_render_list_depth_prepass(
 }
 
 void renderer_impl::draw_world_meta_objects(
-   const frustum& view_frustum, const world::world& world,
+   const frustum& view_frustum, const float3& camera_position, const world::world& world,
    const world::interaction_targets& interaction_targets,
    const world::active_entity_types active_entity_types,
    const world::active_layers active_layers,
    const world::tool_visualizers& tool_visualizers, const settings::graphics& settings)
 {
+   const meta_culling culling{view_frustum, camera_position, settings.meta_draw_distance};
+
    if (active_entity_types.paths and not world.paths.empty()) {
       constexpr bool draw_connections = true;
       constexpr bool draw_orientation = true;
@@ -678,11 +715,15 @@ void renderer_impl::draw_world_meta_objects(
       const float4 path_node_color = {settings.path_node_color, 1.0f};
       const float4 path_node_outline_color = {settings.path_node_outline_color, 1.0f};
 
-      const auto add_path = [&](const world::path& path) {
+      const auto add_path = [&](meta_draw_batcher& batcher, const world::path& path,
+                                std::vector<uint32>& visible_nodes,
+                                std::vector<uint32>& visible_connections) {
          if (not active_layers[path.layer]) return;
 
-         for (auto& node : path.nodes) {
-            if (not intersects(view_frustum, node.position, 0.5f)) continue;
+         cull_path(culling, path.nodes, 0.5f, visible_nodes, visible_connections);
+
+         for (const uint32 node_index : visible_nodes) {
+            const world::path::node& node = path.nodes[node_index];
 
             const float4x4 rotation = to_matrix(node.rotation);
             float4x4 transform = rotation * float4x4{{0.5f, 0.0f, 0.0f, 0.0f},
@@ -692,10 +733,10 @@ void renderer_impl::draw_world_meta_objects(
 
             transform[3] = {node.position, 1.0f};
 
-            _meta_draw_batcher.add_octahedron_outlined(transform, path_node_color,
-                                                       path_node_outline_color);
+            batcher.add_octahedron_outlined(transform, path_node_color,
+                                            path_node_outline_color);
 
-            if (draw_orientation) {
+            if (draw_orientation and culling.detailed(node.position, 0.5f)) {
                float4x4 orientation_transform =
                   rotation * float4x4{{0.25f, 0.0f, 0.0f, 0.0f},
                                       {0.0f, 0.25f, 0.0f, 0.0f},
@@ -703,32 +744,47 @@ void renderer_impl::draw_world_meta_objects(
                                       {0.0f, 0.0f, 0.0f, 1.0f}};
                orientation_transform[3] = {node.position, 1.0f};
 
-               _meta_draw_batcher.add_arrow_outline_solid(orientation_transform,
-                                                          0.8f / 0.25f,
-                                                          utility::pack_srgb_bgra(
-                                                             float4{settings.path_node_orientation_color,
-                                                                    1.0f}));
+               batcher.add_arrow_outline_solid(orientation_transform, 0.8f / 0.25f,
+                                               utility::pack_srgb_bgra(
+                                                  float4{settings.path_node_orientation_color,
+                                                         1.0f}));
             }
          }
 
-         if (not path.nodes.empty() and draw_connections) {
+         if (draw_connections) {
             const uint32 path_node_connection_color = utility::pack_srgb_bgra(
                float4{settings.path_node_connection_color, 1.0f});
 
-            for (std::size_t i = 0; i < (path.nodes.size() - 1); ++i) {
+            for (const uint32 i : visible_connections) {
                const float3 a = path.nodes[i].position;
                const float3 b = path.nodes[i + 1].position;
 
-               _meta_draw_batcher.add_line_solid(a, b, path_node_connection_color);
+               batcher.add_line_solid(a, b, path_node_connection_color);
             }
          }
       };
 
-      for (const auto& path : world.paths) add_path(path);
+      record_meta_draws(_meta_draw_batcher, _meta_draw_worker_batchers,
+                        world.paths.size(), *_thread_pool,
+                        [&](meta_draw_batcher& batcher, const std::size_t begin,
+                            const std::size_t end) noexcept {
+                           std::vector<uint32> visible_nodes;
+                           std::vector<uint32> visible_connections;
+
+                           for (std::size_t i = begin; i < end; ++i) {
+                              add_path(batcher, world.paths[i], visible_nodes,
+                                       visible_connections);
+                           }
+                        });
 
       if (interaction_targets.creation_entity and
           std::holds_alternative<world::path>(*interaction_targets.creation_entity)) {
-         add_path(std::get<world::path>(*interaction_targets.creation_entity));
+         std::vector<uint32> visible_nodes;
+         std::vector<uint32> visible_connections;
+
+         add_path(_meta_draw_batcher,
+                  std::get<world::path>(*interaction_targets.creation_entity),
+                  visible_nodes, visible_connections);
       }
    }
 
@@ -748,46 +804,37 @@ void renderer_impl::draw_world_meta_objects(
          return transform;
       };
 
+      const auto make_faded_color = [&](const float radius) {
+         return float4{color.x, color.y, color.z,
+                       color.w * culling.fade(position, radius)};
+      };
+
       switch (shape) {
       default:
       case world::region_shape::box: {
-         math::bounding_box bbox{.min = {-size}, .max = {size}};
-
-         bbox = rotation * bbox + position;
-
-         if (not intersects(view_frustum, bbox)) {
-            return;
-         }
+         if (not culling.visible(position, rotation, size)) return;
 
          const float4x4 transform = make_region_transform(size);
 
-         _meta_draw_batcher.add_box(transform, color);
+         _meta_draw_batcher.add_box(transform, make_faded_color(length(size)));
       } break;
       case world::region_shape::sphere: {
          const float sphere_radius = length(size);
 
-         if (not intersects(view_frustum, position, sphere_radius)) {
-            return;
-         }
+         if (not culling.visible(position, sphere_radius)) return;
 
-         _meta_draw_batcher.add_sphere(position, sphere_radius, color);
+         _meta_draw_batcher.add_sphere(position, sphere_radius,
+                                       make_faded_color(sphere_radius));
       } break;
       case world::region_shape::cylinder: {
          const float cylinder_length = length(float2{size.x, size.z});
+         const float3 cylinder_size{cylinder_length, size.y, cylinder_length};
 
-         math::bounding_box bbox{.min = {-cylinder_length, -size.y, -cylinder_length},
-                                 .max = {cylinder_length, size.y, cylinder_length}};
-
-         bbox = rotation * bbox + position;
-
-         if (not intersects(view_frustum, bbox)) {
-            return;
-         }
+         if (not culling.visible(position, rotation, cylinder_size)) return;
 
-         const float4x4 transform =
-            make_region_transform(float3{cylinder_length, size.y, cylinder_length});
+         const float4x4 transform = make_region_transform(cylinder_size);
 
-         _meta_draw_batcher.add_cylinder(transform, color);
+         _meta_draw_batcher.add_cylinder(transform, make_faded_color(length(cylinder_size)));
       } break;
       }
    };
@@ -816,6 +863,14 @@ void renderer_impl::draw_world_meta_objects(
       const float4 barrier_color = settings.barrier_color;
 
       const auto add_barrier = [&](const world::barrier& barrier) {
+         const float3 half_extents{barrier.size.x, barrier_height, barrier.size.y};
+
+         if (not culling.visible(barrier.position,
+                                 make_quat_from_euler({0.0f, barrier.rotation_angle, 0.0f}),
+                                 half_extents)) {
+            return;
+         }
+
          const float4x4 rotation =
             make_rotation_matrix_from_euler({0.0f, barrier.rotation_angle, 0.0f});
 
@@ -827,7 +882,12 @@ void renderer_impl::draw_world_meta_objects(
 
          transform[3] = {barrier.position, 1.0f};
 
-         _meta_draw_batcher.add_box(transform, barrier_color); // TODO: Frustum cull
+         _meta_draw_batcher.add_box(transform,
+                                    float4{barrier_color.x, barrier_color.y,
+                                           barrier_color.z,
+                                           barrier_color.w *
+                                              culling.fade(barrier.position,
+                                                           length(half_extents))});
       };
 
       for (auto& barrier : world.barriers) add_barrier(barrier);
@@ -850,6 +910,8 @@ void renderer_impl::draw_world_meta_objects(
 
          switch (light.light_type) {
          case world::light_type::directional: {
+            if (not culling.visible(light.position, 2.2f)) return;
+
             const float4x4 rotation = to_matrix(light.rotation);
             float4x4 transform = rotation * float4x4{{2.0f, 0.0f, 0.0f, 0.0f},
                                                      {0.0f, 2.0f, 0.0f, 0.0f},
@@ -864,9 +926,7 @@ void renderer_impl::draw_world_meta_objects(
                                                           float4{light.color, 1.0f}));
          } break;
          case world::light_type::point: {
-            if (not intersects(view_frustum, light.position, light.range)) {
-               return;
-            }
+            if (not culling.visible(light.position, light.range)) return;
 
             _meta_draw_batcher.add_sphere(light.position, light.range, color);
          } break;
@@ -885,9 +945,7 @@ void renderer_impl::draw_world_meta_objects(
                light.position - (light_direction * (half_range));
 
             // TODO: Better cone culling
-            if (not intersects(view_frustum, light_centre, light_bounds_radius)) {
-               return;
-            }
+            if (not culling.visible(light_centre, light_bounds_radius)) return;
 
             const float4x4 rotation = to_matrix(
                light.rotation * quaternion{0.707107f, -0.707107f, 0.0f, 0.0f});
@@ -953,6 +1011,21 @@ void renderer_impl::draw_world_meta_objects(
       const uint32 sector_color = utility::pack_srgb_bgra(settings.sector_color);
 
       const auto add_sector = [&](const world::sector& sector) {
+         if (sector.points.empty()) return;
+
+         math::bounding_box sector_bbox{.min = {sector.points[0].x, sector.base,
+                                                sector.points[0].y},
+                                        .max = {sector.points[0].x, sector.base,
+                                                sector.points[0].y}};
+
+         for (const float2 point : sector.points) {
+            sector_bbox = integrate(sector_bbox, float3{point.x, sector.base, point.y});
+            sector_bbox = integrate(sector_bbox, float3{point.x, sector.base + sector.height,
+                                                        point.y});
+         }
+
+         if (not culling.visible(sector_bbox)) return;
+
          for (std::size_t i = 0; i < sector.points.size(); ++i) {
             const float2 a = sector.points[i];
             const float2 b = sector.points[(i + 1) % sector.points.size()];
@@ -966,7 +1039,7 @@ void renderer_impl::draw_world_meta_objects(
 
             for (auto v : quad) bbox = integrate(bbox, v);
 
-            if (not intersects(view_frustum, bbox)) continue;
+            if (not culling.visible(bbox)) continue;
 
             _meta_draw_batcher.add_triangle(quad[0], quad[1], quad[2], sector_color);
             _meta_draw_batcher.add_triangle(quad[2], quad[1], quad[3], sector_color);
@@ -979,8 +1052,8 @@ void renderer_impl::draw_world_meta_objects(
                                      float3{point.x, sector.base + sector.height,
                                             point.y}};
 
-            if (not intersects(view_frustum, line[0], 0.001f) and
-                not intersects(view_frustum, line[1], 0.001f)) {
+            if (not culling.visible(line[0], 0.001f) and
+                not culling.visible(line[1], 0.001f)) {
                continue;
             }
 
@@ -1005,8 +1078,7 @@ void renderer_impl::draw_world_meta_objects(
          const float half_width = portal.width * 0.5f;
          const float half_height = portal.height * 0.5f;
 
-         if (not intersects(view_frustum, portal.position,
-                            std::max(half_width, half_height))) {
+         if (not culling.visible(portal.position, std::max(half_width, half_height))) {
             return;
          }
 
@@ -1038,17 +1110,22 @@ void renderer_impl::draw_world_meta_objects(
       const float4 hintnode_color = settings.hintnode_color;
       const uint32 packed_hintnode_color = utility::pack_srgb_bgra(hintnode_color);
 
-      const auto add_hintnode = [&](const world::hintnode& hintnode) {
+      const auto add_hintnode = [&](meta_draw_batcher& batcher,
+                                    const world::hintnode& hintnode) {
          if (not active_layers[hintnode.layer]) return;
 
-         if (not intersects(view_frustum, hintnode.position, 3.0f)) return;
+         if (not culling.visible(hintnode.position, 3.0f)) return;
 
          float4x4 rotation = to_matrix(hintnode.rotation);
 
          float4x4 transform = rotation;
          transform[3] = {hintnode.position, 1.0f};
 
-         _meta_draw_batcher.add_hint_hexahedron(transform, hintnode_color);
+         batcher.add_hint_hexahedron(
+            transform, float4{hintnode_color.x, hintnode_color.y, hintnode_color.z,
+                              hintnode_color.w * culling.fade(hintnode.position, 3.0f)});
+
+         if (not culling.detailed(hintnode.position, 3.0f)) return;
 
          float4x4 arrow_transform = rotation * float4x4{{1.0f, 0.0f, 0.0f, 0.0f},
                                                         {0.0f, 1.0f, 0.0f, 0.0f},
@@ -1056,15 +1133,22 @@ void renderer_impl::draw_world_meta_objects(
                                                         {0.0f, 1.0f, 0.0f, 1.0f}};
          arrow_transform[3] += {hintnode.position, 0.0f};
 
-         _meta_draw_batcher.add_arrow_outline_solid(arrow_transform, 2.4f,
-                                                    packed_hintnode_color);
+         batcher.add_arrow_outline_solid(arrow_transform, 2.4f, packed_hintnode_color);
       };
 
-      for (auto& hintnode : world.hintnodes) add_hintnode(hintnode);
+      record_meta_draws(_meta_draw_batcher, _meta_draw_worker_batchers,
+                        world.hintnodes.size(), *_thread_pool,
+                        [&](meta_draw_batcher& batcher, const std::size_t begin,
+                            const std::size_t end) noexcept {
+                           for (std::size_t i = begin; i < end; ++i) {
+                              add_hintnode(batcher, world.hintnodes[i]);
+                           }
+                        });
 
       if (interaction_targets.creation_entity and
           std::holds_alternative<world::hintnode>(*interaction_targets.creation_entity)) {
-         add_hintnode(std::get<world::hintnode>(*interaction_targets.creation_entity));
+         add_hintnode(_meta_draw_batcher,
+                      std::get<world::hintnode>(*interaction_targets.creation_entity));
       }
    }
 
@@ -1077,7 +1161,7 @@ void renderer_impl::draw_world_meta_objects(
             .min = float3{-hub.radius, -planning_hub_height, -hub.radius} + hub.position,
             .max = float3{hub.radius, planning_hub_height, hub.radius} + hub.position};
 
-         if (not intersects(view_frustum, bbox)) return;
+         if (not culling.visible(bbox)) return;
 
          const float4x4 transform{{hub.radius, 0.0f, 0.0f, 0.0f},
                                   {0.0f, planning_hub_height, 0.0f, 0.0f},
@@ -1104,9 +1188,9 @@ void renderer_impl::draw_world_meta_objects(
 
       const auto add_connection = [&](const world::planning_connection& connection) {
          const world::planning_hub& start =
-            world.planning_hubs[world.planning_hub_index.at(connection.start)];
+            *world::find_entity<world::planning_hub>(world, connection.start);
          const world::planning_hub& end =
-            world.planning_hubs[world.planning_hub_index.at(connection.end)];
+            *world::find_entity<world::planning_hub>(world, connection.end);
 
          const math::bounding_box start_bbox{
             .min = float3{-start.radius, -planning_connection_height, -start.radius} +
@@ -1121,7 +1205,7 @@ void renderer_impl::draw_world_meta_objects(
 
          const math::bounding_box bbox = math::combine(start_bbox, end_bbox);
 
-         if (not intersects(view_frustum, bbox)) return;
+         if (not culling.visible(bbox)) return;
 
          const float3 normal =
             normalize(float3{-(start.position.z - end.position.z), 0.0f,
@@ -1225,6 +1309,15 @@ void renderer_impl::draw_world_meta_objects(
       const auto add_boundary = [&](const world::boundary& boundary) {
          const std::array<float2, 12> nodes = world::get_boundary_nodes(boundary);
 
+         math::bounding_box boundary_bbox{.min = {nodes[0].x, -boundary_height, nodes[0].y},
+                                          .max = {nodes[0].x, boundary_height, nodes[0].y}};
+
+         for (const float2 node : nodes) {
+            boundary_bbox = integrate(boundary_bbox, float3{node.x, 0.0f, node.y});
+         }
+
+         if (not culling.visible(boundary_bbox)) return;
+
          for (std::size_t i = 0; i < nodes.size(); ++i) {
             const float2 a = nodes[i];
             const float2 b = nodes[(i + 1) % nodes.size()];
@@ -1577,9 +1670,9 @@ void renderer_impl::draw_interaction_targets(
          const float height = settings.planning_connection_height;
 
          const world::planning_hub& start =
-            world.planning_hubs[world.planning_hub_index.at(connection.start)];
+            *world::find_entity<world::planning_hub>(world, connection.start);
          const world::planning_hub& end =
-            world.planning_hubs[world.planning_hub_index.at(connection.end)];
+            *world::find_entity<world::planning_hub>(world, connection.end);
 
          const float3 normal =
             normalize(float3{-(start.position.z - end.position.z), 0.0f,
@@ -1645,19 +1738,22 @@ void renderer_impl::draw_interaction_targets(
    const auto draw_target = [&](world::interaction_target target, const float3 color) {
       std::visit(overload{
                     [&](world::object_id id) {
-                       const world::object* object = find_entity(world.objects, id);
+                       const world::object* object =
+                          world::find_entity<world::object>(world, id);
 
                        if (object) draw_entity(*object, color);
                     },
                     [&](world::light_id id) {
-                       const world::light* light = find_entity(world.lights, id);
+                       const world::light* light =
+                          world::find_entity<world::light>(world, id);
 
                        if (light) draw_entity(*light, color);
                     },
                     [&](world::path_id_node_pair id_node) {
                        auto [id, node_index] = id_node;
 
-                       const world::path* path = find_entity(world.paths, id);
+                       const world::path* path =
+                          world::find_entity<world::path>(world, id);
 
                        if (not path) return;
 
@@ -1668,35 +1764,38 @@ void renderer_impl::draw_interaction_targets(
                        }
                     },
                     [&](world::region_id id) {
-                       const world::region* region = find_entity(world.regions, id);
+                       const world::region* region =
+                          world::find_entity<world::region>(world, id);
 
                        if (region) draw_entity(*region, color);
                     },
                     [&](world::sector_id id) {
-                       const world::sector* sector = find_entity(world.sectors, id);
+                       const world::sector* sector =
+                          world::find_entity<world::sector>(world, id);
 
                        if (sector) draw_entity(*sector, color);
                     },
                     [&](world::portal_id id) {
-                       const world::portal* portal = find_entity(world.portals, id);
+                       const world::portal* portal =
+                          world::find_entity<world::portal>(world, id);
 
                        if (portal) draw_entity(*portal, color);
                     },
                     [&](world::hintnode_id id) {
                        const world::hintnode* hintnode =
-                          find_entity(world.hintnodes, id);
+                          world::find_entity<world::hintnode>(world, id);
 
                        if (hintnode) draw_entity(*hintnode, color);
                     },
                     [&](world::barrier_id id) {
                        const world::barrier* barrier =
-                          find_entity(world.barriers, id);
+                          world::find_entity<world::barrier>(world, id);
 
                        if (barrier) draw_entity(*barrier, color);
                     },
                     [&](world::planning_hub_id id) {
                        const world::planning_hub* planning_hub =
-                          find_entity(world.planning_hubs, id);
+                          world::find_entity<world::planning_hub>(world, id);
 
                        if (planning_hub) {
                           draw_entity(*planning_hub, color);
@@ -1704,7 +1803,7 @@ void renderer_impl::draw_interaction_targets(
                     },
                     [&](world::planning_connection_id id) {
                        const world::planning_connection* planning_connection =
-                          find_entity(world.planning_connections, id);
+                          world::find_entity<world::planning_connection>(world, id);
 
                        if (planning_connection) {
                           draw_entity(*planning_connection, color);
@@ -1712,7 +1811,7 @@ void renderer_impl::draw_interaction_targets(
                     },
                     [&](world::boundary_id id) {
                        const world::boundary* boundary =
-                          find_entity(world.boundaries, id);
+                          world::find_entity<world::boundary>(world, id);
 
                        if (boundary) draw_entity(*boundary, color);
                     },
@@ -1741,119 +1840,273 @@ void renderer_impl::build_world_mesh_list(gpu::copy_command_list& command_list,
                                           const world::world& world,
                                           const world::active_layers active_layers,
                                           const world::object_class_library& world_classes,
+                                          const world::object_bbox_cache& world_bboxes,
+                                          const world::object_store& world_objects,
                                           const world::object* const creation_object)
 {
-   _world_mesh_list.clear();
-   _world_mesh_list.reserve(1024 * 16);
+   const std::size_t frame_index = _device.frame_index();
+
+   // Every object has the constants at its index, the creation object uses the ones after
+   // the last object.
+   while (_object_constants_pages.size() * object_constants_page_objects <
+          world.objects.size() + 1) {
+      add_object_constants_page();
+   }
 
-   auto& upload_buffer = _object_constants_upload_buffers[_device.frame_index()];
+   const auto get_constants =
+      [&](const std::size_t index) noexcept -> world_mesh_constants_slot {
+      const std::size_t page_offset = index % object_constants_page_objects;
+      const object_constants_page& page =
+         _object_constants_pages[index / object_constants_page_objects];
 
-   const gpu_virtual_address constants_upload_gpu_address =
-      _device.get_gpu_virtual_address(_object_constants_buffer.get());
-   std::byte* const constants_upload_data =
-      _object_constants_upload_cpu_ptrs[_device.frame_index()];
-   std::size_t constants_data_size = 0;
+      return {.cpu = page.upload_cpu_ptrs[frame_index] + page_offset,
+              .gpu = page.gpu_address + page_offset * sizeof(world_mesh_constants)};
+   };
+
+   const auto copy_constants = [&](const std::size_t first, const std::size_t count) {
+      for (std::size_t index = first; index < first + count;) {
+         const std::size_t page_offset = index % object_constants_page_objects;
+         const std::size_t page_count =
+            std::min(first + count - index, object_constants_page_objects - page_offset);
+         const object_constants_page& page =
+            _object_constants_pages[index / object_constants_page_objects];
+
+         command_list.copy_buffer_region(page.buffer.get(),
+                                         page_offset * sizeof(world_mesh_constants),
+                                         page.upload_buffers[frame_index].get(),
+                                         page_offset * sizeof(world_mesh_constants),
+                                         page_count * sizeof(world_mesh_constants));
+
+         index += page_count;
+      }
+   };
+
+   const auto get_pipeline = [&](const material_pipeline_flags flags) {
+      return _pipelines.mesh_normal[flags].get();
+   };
+
+   if (world_objects.size() == world.objects.size()) {
+      const std::span<const name_handle> class_names = world_objects.class_names();
+      const uint64 object_classes_generation = world_classes.generation();
+      const uint64 models_generation = _model_manager.generation();
 
-   for (std::size_t i = 0; i < std::min(world.objects.size(), max_drawn_objects); ++i) {
-      const auto& object = world.objects[i];
-      auto& model = _model_manager[world_classes[object.class_name].model_name];
+      if (_world_mesh_list_state.object_classes_generation != object_classes_generation or
+          _world_mesh_list_state.models_generation != models_generation) {
+         _class_models.clear();
+      }
 
-      if (not active_layers[object.layer]) continue;
+      // Models are looked up once per class on the render thread so the thread pool only
+      // reads the table. When no objects changed there's nothing new to look up.
+      if (_class_models.empty() or
+          world.changes.objects.current() != _world_mesh_list_state.cursor) {
+         _class_models.resize(name_table_size(), nullptr);
 
-      const auto object_bbox = object.rotation * model.bbox + object.position;
+         for (const name_handle class_name : class_names) {
+            model*& class_model = _class_models[static_cast<std::size_t>(class_name)];
 
-      const std::size_t object_constants_offset = constants_data_size;
-      const gpu_virtual_address object_constants_address =
-         constants_upload_gpu_address + object_constants_offset;
+            if (not class_model) {
+               class_model = &_model_manager[world_classes[class_name].model_name];
+            }
+         }
+      }
 
-      world_mesh_constants constants;
+      const world_mesh_list_update update = update_world_mesh_list(
+         _world_mesh_list, _world_mesh_list_state, world, world_objects, world_bboxes,
+         active_layers, object_classes_generation, models_generation,
+         [&](const std::size_t i) noexcept -> const model& {
+            return *_class_models[static_cast<std::size_t>(class_names[i])];
+         },
+         get_constants, get_pipeline, *_thread_pool);
 
-      constants.object_to_world = to_matrix(object.rotation);
-      constants.object_to_world[3] = float4{object.position, 1.0f};
+      if (update == world_mesh_list_update::modified) {
+         const std::span<const uint32> dirty_objects = _world_mesh_list_state.dirty_objects;
 
-      std::memcpy(constants_upload_data + object_constants_offset,
-                  &constants.object_to_world, sizeof(world_mesh_constants));
+         // Runs of neighbouring objects are copied together.
+         for (std::size_t i = 0; i < dirty_objects.size();) {
+            std::size_t count = 1;
 
-      constants_data_size += sizeof(world_mesh_constants);
+            while (i + count < dirty_objects.size() and
+                   dirty_objects[i + count] == dirty_objects[i] + count) {
+               count += 1;
+            }
+
+            copy_constants(dirty_objects[i], count);
 
-      for (auto& mesh : model.parts) {
-         const gpu::pipeline_handle pipeline =
-            _pipelines.mesh_normal[mesh.material.flags].get();
+            i += count;
+         }
 
-         _world_mesh_list.push_back(
-            object_bbox, object_constants_address, object.position, pipeline,
-            mesh.material.flags, mesh.material.constant_buffer_view,
-            world_mesh{.index_buffer_view = model.gpu_buffer.index_buffer_view,
-                       .vertex_buffer_views = {model.gpu_buffer.position_vertex_buffer_view,
-                                               model.gpu_buffer.attributes_vertex_buffer_view},
-                       .index_count = mesh.index_count,
-                       .start_index = mesh.start_index,
-                       .start_vertex = mesh.start_vertex});
+         _world_mesh_bvh.update(_world_mesh_list);
+         _light_clusters.invalidate_shadow_casters();
+      }
+      else if (update == world_mesh_list_update::rebuilt) {
+         copy_constants(0, world_objects.size());
+
+         _world_mesh_bvh.clear();
+         _world_mesh_bvh.update(_world_mesh_list);
+         _light_clusters.invalidate_shadow_casters();
       }
    }
+   else {
+      // The object store is behind the world so draw straight from world.objects. The
+      // list is rebuilt from the store once it catches up.
+      _world_mesh_list_state.clear();
+      _world_mesh_list.clear();
+
+      const bool use_cached_bboxes = world_bboxes.size() == world.objects.size();
 
-   if (creation_object and world.objects.size() < max_drawn_objects) {
+      for (std::size_t i = 0; i < world.objects.size(); ++i) {
+         const auto& object = world.objects[i];
+         auto& model = _model_manager[world_classes[object.class_name].model_name];
+
+         if (not active_layers[object.layer]) continue;
+
+         add_world_mesh_list_object(_world_mesh_list,
+                                    use_cached_bboxes
+                                       ? world_bboxes[i]
+                                       : object.rotation * model.bbox + object.position,
+                                    object.rotation, object.position, model,
+                                    get_constants(i), get_pipeline);
+      }
+
+      copy_constants(0, world.objects.size());
+
+      _world_mesh_bvh.update(_world_mesh_list);
+      _light_clusters.invalidate_shadow_casters();
+   }
+
+   // The creation object changes from frame to frame so it's kept out of the BVH, it's
+   // pushed onto the end of the list and dropped again by the next update.
+   if (creation_object) {
       auto& model =
          _model_manager[world_classes[creation_object->class_name].model_name];
 
-      const auto object_bbox =
-         creation_object->rotation * model.bbox + creation_object->position;
+      add_world_mesh_list_object(_world_mesh_list,
+                                 creation_object->rotation * model.bbox +
+                                    creation_object->position,
+                                 creation_object->rotation, creation_object->position,
+                                 model, get_constants(world.objects.size()),
+                                 get_pipeline);
+
+      copy_constants(world.objects.size(), 1);
+   }
+}
 
-      const std::size_t object_constants_offset = constants_data_size;
-      const gpu_virtual_address object_constants_address =
-         constants_upload_gpu_address + object_constants_offset;
+void renderer_impl::build_render_lists(
+   const camera& camera, const frustum& view_frustum, const world::world& world,
+   const world::active_entity_types active_entity_types,
+   const world::active_layers active_layers,
+   const world::object_class_library& world_classes,
+   const world::object_bbox_cache& world_bboxes)
+{
+   // The view and every shadow cascade are culled against the same BVH at once, each
+   // writing to its own render list.
+   _thread_pool->for_each_n(
+      async::task_priority::normal, 1 + light_clusters::sun_cascade_count,
+      [&](const std::size_t i) noexcept {
+         if (i == 0) {
+            build_world_mesh_render_lists(view_frustum, _world_mesh_list,
+                                          _world_mesh_bvh, _world_mesh_sort_buffers,
+                                          _opaque_object_render_list,
+                                          _transparent_object_render_list);
+
+            build_occlusion_buffer(camera, view_frustum, world, active_entity_types,
+                                   active_layers, world_classes, world_bboxes);
+
+            cull_occluded(_occlusion_buffer, _world_mesh_list,
+                          _opaque_object_render_list);
+            cull_occluded(_occlusion_buffer, _world_mesh_list,
+                          _transparent_object_render_list);
+         }
+         else {
+            _light_clusters.cull_shadow_cascade(static_cast<uint32>(i - 1),
+                                                _world_mesh_list, _world_mesh_bvh);
+         }
+      });
+}
 
-      world_mesh_constants constants;
+void renderer_impl::build_occlusion_buffer(
+   const camera& camera, const frustum& view_frustum, const world::world& world,
+   const world::active_entity_types active_entity_types,
+   const world::active_layers active_layers,
+   const world::object_class_library& world_classes,
+   const world::object_bbox_cache& world_bboxes) noexcept
+{
+   _occlusion_buffer.clear(camera.view_projection_matrix());
 
-      constants.object_to_world = to_matrix(creation_object->rotation);
-      constants.object_to_world[3] = float4{creation_object->position, 1.0f};
+   if (active_entity_types.terrain) {
+      _occlusion_buffer.add_occluder(float4x4{}, _terrain_occluder.positions,
+                                     _terrain_occluder.triangles);
+   }
 
-      std::memcpy(constants_upload_data + object_constants_offset,
-                  &constants.object_to_world, sizeof(world_mesh_constants));
+   // The cached bounds lag behind the world while the object store catches up, objects
+   // don't occlude anything until it has.
+   if (active_entity_types.objects and world_bboxes.size() == world.objects.size()) {
+      select_occluders(
+         view_frustum, camera.position(), world_bboxes, occluder_min_score,
+         max_occluder_objects,
+         [&](const uint32 i) {
+            const world::object& object = world.objects[i];
+
+            return active_layers[object.layer] and
+                   world_classes[object.class_name].model != nullptr;
+         },
+         _occluder_objects);
+
+      // Meshes that can be seen through in places don't occlude.
+      const assets::msh::material_flags see_through_flags =
+         assets::msh::material_flags::transparent |
+         assets::msh::material_flags::transparent_doublesided |
+         assets::msh::material_flags::hardedged | assets::msh::material_flags::additive;
+
+      std::size_t triangle_budget = max_occluder_object_triangles;
+
+      for (const uint32 i : _occluder_objects) {
+         const world::object& object = world.objects[i];
+         const assets::msh::flat_model& model = *world_classes[object.class_name].model;
+
+         float4x4 world_matrix = to_matrix(object.rotation);
+         world_matrix[3] = {object.position, 1.0f};
+
+         for (const assets::msh::mesh& mesh : model.meshes) {
+            if ((mesh.material.flags & see_through_flags) !=
+                assets::msh::material_flags::none) {
+               continue;
+            }
 
-      constants_data_size += sizeof(world_mesh_constants);
+            if (mesh.triangles.size() > triangle_budget) continue;
 
-      for (auto& mesh : model.parts) {
-         const gpu::pipeline_handle pipeline =
-            _pipelines.mesh_normal[mesh.material.flags].get();
+            triangle_budget -= mesh.triangles.size();
 
-         _world_mesh_list.push_back(
-            object_bbox, object_constants_address, creation_object->position,
-            pipeline, mesh.material.flags, mesh.material.constant_buffer_view,
-            world_mesh{.index_buffer_view = model.gpu_buffer.index_buffer_view,
-                       .vertex_buffer_views = {model.gpu_buffer.position_vertex_buffer_view,
-                                               model.gpu_buffer.attributes_vertex_buffer_view},
-                       .index_count = mesh.index_count,
-                       .start_index = mesh.start_index,
-                       .start_vertex = mesh.start_vertex});
+            _occlusion_buffer.add_occluder(world_matrix, mesh.positions, mesh.triangles);
+         }
       }
    }
 
-   command_list.copy_buffer_region(_object_constants_buffer.get(), 0,
-                                   upload_buffer.get(), 0, constants_data_size);
+   _occlusion_buffer.build_hierarchy();
 }
 
-void renderer_impl::build_object_render_list(const frustum& view_frustum)
+void renderer_impl::add_object_constants_page()
 {
-   auto& meshes = _world_mesh_list;
+   object_constants_page page{
+      .buffer = {_device.create_buffer({.size = object_constants_page_size,
+                                        .debug_name = "Object Constant Buffers"},
+                                       gpu::heap_type::default_),
+                 _device.direct_queue}};
+
+   page.gpu_address = _device.get_gpu_virtual_address(page.buffer.get());
+
+   for (std::size_t i = 0; i < page.upload_buffers.size(); ++i) {
+      page.upload_buffers[i] = {
+         _device.create_buffer({.size = object_constants_page_size,
+                                .debug_name = "Object Constant Upload Buffers"},
+                               gpu::heap_type::upload),
+         _device.direct_queue};
+
+      page.upload_cpu_ptrs[i] = static_cast<world_mesh_constants*>(
+         _device.map(page.upload_buffers[i].get(), 0, {}));
+   }
 
-   cull_objects_avx2(view_frustum, meshes.bbox.min.x, meshes.bbox.min.y,
-                     meshes.bbox.min.z, meshes.bbox.max.x, meshes.bbox.max.y,
-                     meshes.bbox.max.z, meshes.pipeline_flags,
-                     _opaque_object_render_list, _transparent_object_render_list);
-
-   std::sort(_opaque_object_render_list.begin(), _opaque_object_render_list.end(),
-             [&](const uint16 l, const uint16 r) {
-                return meshes.pipeline[l] < meshes.pipeline[r];
-             });
-   std::sort(_transparent_object_render_list.begin(),
-             _transparent_object_render_list.end(),
-             [&](const uint16 l, const uint16 r) {
-                return dot(view_frustum.planes[frustum_planes::near_],
-                           float4{meshes.position[l], 1.0f}) >
-                       dot(view_frustum.planes[frustum_planes::near_],
-                           float4{meshes.position[r], 1.0f});
-             });
+   _object_constants_pages.push_back(std::move(page));
 }
 
 void renderer_impl::clear_depth_minmax(gpu::copy_command_list& command_list)
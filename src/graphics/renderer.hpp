@@ -37,6 +37,8 @@ namespace we::world {
 
 struct world;
 struct object_class_library;
+class object_bbox_cache;
+class object_store;
 
 }
 
@@ -57,6 +59,8 @@ struct renderer {
                            const world::active_layers active_layers,
                            const world::tool_visualizers& tool_visualizers,
                            const world::object_class_library& world_classes,
+                           const world::object_bbox_cache& world_bboxes,
+                           const world::object_store& world_objects,
                            const settings::graphics& settings) = 0;
 
    virtual void window_resized(uint16 width, uint16 height) = 0;
@@ -0,0 +1,287 @@
+#include "shadow_cascades.hpp"
+#include "frustum.hpp"
+#include "math/matrix_funcs.hpp"
+#include "math/quaternion_funcs.hpp"
+#include "math/vector_funcs.hpp"
+#include "utility/enum_bitflags.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace we::graphics {
+
+namespace {
+
+auto make_shadow_cascade_splits(const camera& camera)
+   -> std::array<float, sun_shadow_cascade_count + 1>
+{
+   const float clip_ratio = camera.far_clip() / camera.near_clip();
+   const float clip_range = camera.far_clip() - camera.near_clip();
+
+   std::array<float, 5> cascade_splits{};
+
+   for (int i = 0; i < cascade_splits.size(); ++i) {
+      const float split = (camera.near_clip() * std::pow(clip_ratio, i / 4.0f));
+      const float split_normalized = (split - camera.near_clip()) / clip_range;
+
+      cascade_splits[i] = split_normalized;
+   }
+
+   return cascade_splits;
+}
+
+auto make_cascade_shadow_camera(const float3 light_direction,
+                                const float near_split, const float far_split,
+                                const frustum& view_frustum,
+                                const uint32 shadow_resolution) -> shadow_ortho_camera
+{
+   auto view_frustum_corners = view_frustum.corners;
+
+   for (int i = 0; i < 4; ++i) {
+      float3 corner_ray = view_frustum_corners[i + 4] - view_frustum_corners[i];
+
+      view_frustum_corners[i + 4] = view_frustum_corners[i] + (corner_ray * far_split);
+      view_frustum_corners[i] += (corner_ray * near_split);
+   }
+
+   float3 view_frustum_center{0.0f, 0.0f, 0.0f};
+
+   for (const auto& corner : view_frustum_corners) {
+      view_frustum_center += corner;
+   }
+
+   view_frustum_center /= 8.0f;
+
+   float radius = std::numeric_limits<float>::lowest();
+
+   for (const auto& corner : view_frustum_corners) {
+      radius = std::max(distance(corner, view_frustum_center), radius);
+   }
+
+   float3 bounds_max{radius, radius, radius};
+   float3 bounds_min{-radius, -radius, -radius};
+   float3 casecase_extents{bounds_max - bounds_min};
+
+   float3 shadow_camera_position =
+      view_frustum_center + light_direction * -bounds_min.z;
+
+   shadow_ortho_camera shadow_camera;
+   shadow_camera.set_projection(bounds_min.x, bounds_min.y, bounds_max.x,
+                                bounds_max.y, 0.0f, casecase_extents.z);
+   shadow_camera.look_at(shadow_camera_position, view_frustum_center,
+                         float3{0.0f, 1.0f, 0.0f});
+
+   auto shadow_view_projection = shadow_camera.view_projection_matrix();
+
+   float4 shadow_origin = shadow_view_projection * float4{0.0f, 0.0f, 0.0f, 1.0f};
+   shadow_origin /= shadow_origin.w;
+   shadow_origin *= static_cast<float>(shadow_resolution) / 2.0f;
+
+   float2 shadow_origin_xy = {shadow_origin.x, shadow_origin.y};
+
+   float2 rounded_origin = round(shadow_origin_xy);
+   float2 rounded_offset = rounded_origin - shadow_origin_xy;
+   rounded_offset *= 2.0f / static_cast<float>(shadow_resolution);
+
+   shadow_camera.set_stabilization(rounded_offset);
+
+   return shadow_camera;
+}
+
+auto mesh_bbox(const world_mesh_list& meshes, const std::size_t i) noexcept
+   -> math::bounding_box
+{
+   return {.min = {meshes.bbox.min.x[i], meshes.bbox.min.y[i], meshes.bbox.min.z[i]},
+           .max = {meshes.bbox.max.x[i], meshes.bbox.max.y[i], meshes.bbox.max.z[i]}};
+}
+
+bool is_transparent(const material_pipeline_flags flags) noexcept
+{
+   return are_flags_set(flags, material_pipeline_flags::transparent) or
+          are_flags_set(flags, material_pipeline_flags::additive);
+}
+
+/// @brief Grow the volume of an orthographic view projection matrix. X and Y grow about
+/// the centre, Z grows away from the sun.
+auto pad_view_projection_matrix(const float4x4& view_projection_matrix,
+                                const float padding) noexcept -> float4x4
+{
+   const float scale = 1.0f / (1.0f + padding);
+
+   float4x4 padded = view_projection_matrix;
+
+   for (int i = 0; i < 4; ++i) {
+      padded[i].x *= scale;
+      padded[i].y *= scale;
+      padded[i].z *= scale;
+   }
+
+   return padded;
+}
+
+/// @brief Test if the volume a cascade's casters come from lies inside the padded volume
+/// of an earlier cascade. The volumes reach all the way to the sun, so they must also
+/// face the same way.
+bool contains_cascade(const float4x4& padded_view_projection_matrix,
+                      const float4x4& inv_view_projection_matrix) noexcept
+{
+   const float4x4 to_padded = padded_view_projection_matrix * inv_view_projection_matrix;
+
+   constexpr float direction_tolerance = 1e-4f;
+
+   const float4 towards_sun = to_padded * float4{0.0f, 0.0f, -1.0f, 0.0f};
+
+   if (std::abs(towards_sun.x) > std::abs(towards_sun.z) * direction_tolerance or
+       std::abs(towards_sun.y) > std::abs(towards_sun.z) * direction_tolerance) {
+      return false;
+   }
+
+   for (const float z : {0.0f, 1.0f}) {
+      for (const float y : {-1.0f, 1.0f}) {
+         for (const float x : {-1.0f, 1.0f}) {
+            const float4 corner = to_padded * float4{x, y, z, 1.0f};
+
+            if (std::abs(corner.x) > 1.0f or std::abs(corner.y) > 1.0f or
+                corner.z > 1.0f) {
+               return false;
+            }
+         }
+      }
+   }
+
+   return true;
+}
+
+}
+
+auto make_shadow_cascades(const quaternion light_rotation, const camera& camera,
+                          const std::array<float, 2> scene_depth_min_max,
+                          const uint32 shadow_resolution)
+   -> std::array<shadow_ortho_camera, sun_shadow_cascade_count>
+{
+   const frustum view_frustum{camera.inv_view_projection_matrix(),
+                              scene_depth_min_max[0], scene_depth_min_max[1]};
+
+   const float3 light_direction =
+      normalize(light_rotation * float3{0.0f, 0.0f, -1.0f});
+
+   const std::array cascade_splits = make_shadow_cascade_splits(camera);
+
+   std::array<shadow_ortho_camera, sun_shadow_cascade_count> cameras;
+
+   for (int i = 0; i < sun_shadow_cascade_count; ++i) {
+      cameras[i] = make_cascade_shadow_camera(light_direction, cascade_splits[i],
+                                              cascade_splits[i + 1], view_frustum,
+                                              shadow_resolution);
+   }
+
+   return cameras;
+}
+
+bool intersects_shadow_cascade_light_space(const float4x4& view_projection_matrix,
+                                           const math::bounding_box& bbox) noexcept
+{
+   const float3 centre = (bbox.min + bbox.max) * 0.5f;
+   const float3 extents = (bbox.max - bbox.min) * 0.5f;
+
+   // The matrix is affine so the box's bounds in light space are its transformed centre
+   // plus its extents projected onto each light space axis.
+   const float4 light_centre = view_projection_matrix * float4{centre, 1.0f};
+   const float4 light_extents = abs(view_projection_matrix[0]) * extents.x +
+                                abs(view_projection_matrix[1]) * extents.y +
+                                abs(view_projection_matrix[2]) * extents.z;
+
+   if (light_centre.x - light_extents.x > 1.0f) return false;
+   if (light_centre.x + light_extents.x < -1.0f) return false;
+   if (light_centre.y - light_extents.y > 1.0f) return false;
+   if (light_centre.y + light_extents.y < -1.0f) return false;
+
+   // Only the far side is tested, boxes between the cascade and the sun still cast
+   // shadows into it.
+   if (light_centre.z - light_extents.z > 1.0f) return false;
+
+   return true;
+}
+
+void shadow_caster_cache::next_frame() noexcept
+{
+   _frame += 1;
+}
+
+void shadow_caster_cache::invalidate() noexcept
+{
+   for (cascade_state& cascade : _cascades) cascade.valid = false;
+}
+
+void shadow_caster_cache::cull(const uint32 cascade_index,
+                               const shadow_ortho_camera& cascade,
+                               const world_mesh_list& meshes,
+                               const world_mesh_bvh& meshes_bvh) noexcept
+{
+   assert(cascade_index < sun_shadow_cascade_count);
+
+   cascade_state& state = _cascades[cascade_index];
+
+   // Each distant cascade has its own frame to be culled again on so they're spread out.
+   const bool refresh_frame =
+      _frame % max_reuse_frames ==
+      cascade_index * max_reuse_frames / sun_shadow_cascade_count;
+
+   state.reused = cascade_index != 0 and state.valid and not refresh_frame and
+                  state.bvh_size == meshes_bvh.size() and
+                  contains_cascade(state.padded_view_projection_matrix,
+                                   cascade.inv_view_projection_matrix());
+
+   if (state.reused) {
+      state.casters.resize(state.bvh_casters_count);
+
+      for (std::size_t i = meshes_bvh.size(); i < meshes.size(); ++i) {
+         if (is_transparent(meshes.pipeline_flags[i])) continue;
+
+         if (intersects_shadow_cascade_light_space(cascade.view_projection_matrix(),
+                                                   mesh_bbox(meshes, i))) {
+            state.casters.push_back(static_cast<uint32>(i));
+         }
+      }
+
+      return;
+   }
+
+   const float4x4 view_projection_matrix =
+      cascade_index == 0
+         ? cascade.view_projection_matrix()
+         : pad_view_projection_matrix(cascade.view_projection_matrix(), cascade_padding);
+
+   meshes_bvh.cull_shadow_cascade(frustum{inverse(view_projection_matrix)}, meshes,
+                                  state.casters);
+
+   std::erase_if(state.casters, [&](const uint32 i) {
+      return not intersects_shadow_cascade_light_space(view_projection_matrix,
+                                                       mesh_bbox(meshes, i));
+   });
+
+   // The BVH's meshes come first, the ones pushed on after it follow them.
+   const std::size_t bvh_size = meshes_bvh.size();
+
+   state.bvh_casters_count = static_cast<std::size_t>(
+      std::ranges::find_if(state.casters, [&](const uint32 i) { return i >= bvh_size; }) -
+      state.casters.begin());
+   state.bvh_size = bvh_size;
+   state.padded_view_projection_matrix = view_projection_matrix;
+   state.valid = true;
+}
+
+auto shadow_caster_cache::casters(const uint32 cascade_index) const noexcept
+   -> std::span<const uint32>
+{
+   return _cascades[cascade_index].casters;
+}
+
+bool shadow_caster_cache::reused(const uint32 cascade_index) const noexcept
+{
+   return _cascades[cascade_index].reused;
+}
+
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "camera.hpp"
+#include "math/bounding_box.hpp"
+#include "shadow_camera.hpp"
+#include "types.hpp"
+#include "world_mesh_bvh.hpp"
+#include "world_mesh_list.hpp"
+
+#include <array>
+#include <span>
+#include <vector>
+
+namespace we::graphics {
+
+/// @brief The number of cascades the sun's shadow map is split into.
+constexpr uint32 sun_shadow_cascade_count = 4;
+
+/// @brief Make the cameras for the sun's shadow cascades. Each cascade covers a slice of
+/// the view frustum, the slices growing with distance from the camera. Cascades are
+/// snapped to the shadow map's texels so their shadows don't shimmer as the camera moves.
+/// @param light_rotation The rotation of the sun.
+/// @param camera The view camera.
+/// @param scene_depth_min_max The min and max depth of the scene in the view. The
+/// cascades are fitted to this part of the view frustum.
+/// @param shadow_resolution The width and height of the shadow map.
+auto make_shadow_cascades(const quaternion light_rotation, const camera& camera,
+                          const std::array<float, 2> scene_depth_min_max,
+                          const uint32 shadow_resolution)
+   -> std::array<shadow_ortho_camera, sun_shadow_cascade_count>;
+
+/// @brief Test if a box can cast shadows into a shadow cascade. The bounds of the box in
+/// the cascade's light space are tested against the cascade, this is tighter than testing
+/// the box against the cascade's frustum planes in world space. Boxes between the cascade
+/// and the sun pass.
+/// @param view_projection_matrix The cascade's view projection matrix. Must be
+/// orthographic.
+/// @param bbox The box to test.
+bool intersects_shadow_cascade_light_space(const float4x4& view_projection_matrix,
+                                           const math::bounding_box& bbox) noexcept;
+
+/// @brief Culls shadow casters for the sun's cascades and keeps them between frames.
+///
+/// The near cascade is culled every frame. The distant cascades move little from frame to
+/// frame, they're culled against a padded copy of the cascade and the casters are reused
+/// while the cascade stays inside the padding and the world mesh list doesn't change.
+/// Even when nothing moves the distant cascades are culled again every few frames,
+/// staggered so only one of them is culled on any frame.
+///
+/// Meshes pushed onto the end of the world mesh list after its BVH was updated are tested
+/// every frame, even when the rest of the casters are reused.
+class shadow_caster_cache {
+public:
+   /// @brief The max number of frames a distant cascade's casters are reused for.
+   constexpr static uint32 max_reuse_frames = 8;
+
+   /// @brief How much the distant cascades are padded by, relative to their size.
+   constexpr static float cascade_padding = 0.125f;
+
+   /// @brief Start a new frame. Call once a frame before culling.
+   void next_frame() noexcept;
+
+   /// @brief Throw away the cached casters. Call whenever the world mesh list changed.
+   void invalidate() noexcept;
+
+   /// @brief Cull the casters for a cascade or reuse the ones from an earlier frame.
+   /// Different cascades can be culled at once from different threads.
+   /// @param cascade_index The index of the cascade.
+   /// @param cascade The cascade's camera.
+   /// @param meshes The world mesh list.
+   /// @param meshes_bvh The BVH of the world mesh list.
+   void cull(const uint32 cascade_index, const shadow_ortho_camera& cascade,
+             const world_mesh_list& meshes, const world_mesh_bvh& meshes_bvh) noexcept;
+
+   /// @brief Get the casters for a cascade from its last cull.
+   /// @param cascade_index The index of the cascade.
+   [[nodiscard]] auto casters(const uint32 cascade_index) const noexcept
+      -> std::span<const uint32>;
+
+   /// @brief Get if the last cull of a cascade reused casters from an earlier frame.
+   /// @param cascade_index The index of the cascade.
+   [[nodiscard]] bool reused(const uint32 cascade_index) const noexcept;
+
+private:
+   struct cascade_state {
+      /// @brief Casters from the BVH followed by the casters pushed on after it.
+      std::vector<uint32> casters;
+      std::size_t bvh_casters_count = 0;
+      std::size_t bvh_size = 0;
+      float4x4 padded_view_projection_matrix;
+      bool valid = false;
+      bool reused = false;
+   };
+
+   std::array<cascade_state, sun_shadow_cascade_count> _cascades;
+   uint32 _frame = 0;
+};
+
+}
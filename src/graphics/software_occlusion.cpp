@@ -0,0 +1,521 @@
+#include "software_occlusion.hpp"
+#include "math/matrix_funcs.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+
+#include <immintrin.h>
+
+namespace we::graphics {
+
+namespace {
+
+constexpr int avx_width = 8;
+
+static_assert(occlusion_buffer::width % avx_width == 0);
+static_assert(occlusion_buffer::tile_size == avx_width);
+
+struct screen_vertex {
+   float x;
+   float y;
+   float depth;
+};
+
+auto to_screen(const float4& clip) noexcept -> screen_vertex
+{
+   const float inv_w = 1.0f / clip.w;
+
+   return {.x = (clip.x * inv_w * 0.5f + 0.5f) * occlusion_buffer::width,
+           .y = (0.5f - clip.y * inv_w * 0.5f) * occlusion_buffer::height,
+           .depth = clip.z * inv_w};
+}
+
+/// @brief Edge function for the edge from a to b. Positive for points to the right of the
+/// edge on screen.
+struct edge {
+   float step_x;
+   float step_y;
+   float offset;
+
+   edge(const screen_vertex& a, const screen_vertex& b) noexcept
+   {
+      step_x = a.y - b.y;
+      step_y = b.x - a.x;
+      offset = -(step_x * a.x + step_y * a.y);
+   }
+
+   auto at(const float x, const float y) const noexcept -> float
+   {
+      return step_x * x + step_y * y + offset;
+   }
+};
+
+/// @brief Rasterize a triangle into an occluder's depth. Every pixel the triangle
+/// touches, not just the ones with their centre inside, takes the max of its depth and
+/// the triangle's furthest vertex.
+/// @param occluder_depth The occluder's depth. Untouched pixels are negative.
+/// @param a The first vertex.
+/// @param b The second vertex.
+/// @param c The third vertex. Pixels are inside when they're to the right of a to b, b to c
+/// and c to a.
+void rasterize_touched(std::span<float> occluder_depth, const screen_vertex& a,
+                       const screen_vertex& b, const screen_vertex& c) noexcept
+{
+   const float min_x = std::min({a.x, b.x, c.x});
+   const float max_x = std::max({a.x, b.x, c.x});
+   const float min_y = std::min({a.y, b.y, c.y});
+   const float max_y = std::max({a.y, b.y, c.y});
+
+   if (max_x < 0.0f or max_y < 0.0f or min_x >= occlusion_buffer::width or
+       min_y >= occlusion_buffer::height) {
+      return;
+   }
+
+   const int32 begin_x = static_cast<int32>(std::max(std::floor(min_x), 0.0f));
+   const int32 end_x =
+      static_cast<int32>(std::min(std::ceil(max_x), float{occlusion_buffer::width}));
+   const int32 begin_y = static_cast<int32>(std::max(std::floor(min_y), 0.0f));
+   const int32 end_y =
+      static_cast<int32>(std::min(std::ceil(max_y), float{occlusion_buffer::height}));
+
+   const edge edge_ab{a, b};
+   const edge edge_bc{b, c};
+   const edge edge_ca{c, a};
+
+   // A pixel touches the triangle when it's inside the triangle's bounds and when the
+   // corner of the pixel furthest along each edge's normal is inside that edge. Moving
+   // the sample point from the centre to that corner adds half of each step.
+   const auto touch_offset = [](const edge& edge) {
+      return 0.5f * (std::abs(edge.step_x) + std::abs(edge.step_y));
+   };
+
+   const __m256 depth = _mm256_set1_ps(std::max({a.depth, b.depth, c.depth}));
+   const __m256 lane_offsets =
+      _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+   const __m256 zero = _mm256_setzero_ps();
+   const __m256 bounds_begin_x = _mm256_set1_ps(static_cast<float>(begin_x));
+   const __m256 bounds_end_x = _mm256_set1_ps(static_cast<float>(end_x));
+
+   const __m256 ab_step_x = _mm256_set1_ps(edge_ab.step_x);
+   const __m256 bc_step_x = _mm256_set1_ps(edge_bc.step_x);
+   const __m256 ca_step_x = _mm256_set1_ps(edge_ca.step_x);
+
+   const int32 aligned_begin_x = begin_x & ~(avx_width - 1);
+
+   for (int32 y = begin_y; y < end_y; ++y) {
+      const float pixel_y = static_cast<float>(y) + 0.5f;
+
+      const __m256 ab_row =
+         _mm256_set1_ps(edge_ab.at(0.0f, pixel_y) + touch_offset(edge_ab));
+      const __m256 bc_row =
+         _mm256_set1_ps(edge_bc.at(0.0f, pixel_y) + touch_offset(edge_bc));
+      const __m256 ca_row =
+         _mm256_set1_ps(edge_ca.at(0.0f, pixel_y) + touch_offset(edge_ca));
+
+      float* const row = &occluder_depth[y * occlusion_buffer::width];
+
+      for (int32 x = aligned_begin_x; x < end_x; x += avx_width) {
+         const __m256 pixel_x =
+            _mm256_add_ps(_mm256_set1_ps(static_cast<float>(x)), lane_offsets);
+
+         const __m256 ab = _mm256_fmadd_ps(ab_step_x, pixel_x, ab_row);
+         const __m256 bc = _mm256_fmadd_ps(bc_step_x, pixel_x, bc_row);
+         const __m256 ca = _mm256_fmadd_ps(ca_step_x, pixel_x, ca_row);
+
+         const __m256 in_bounds =
+            _mm256_and_ps(_mm256_cmp_ps(pixel_x, bounds_begin_x, _CMP_GT_OQ),
+                          _mm256_cmp_ps(pixel_x, bounds_end_x, _CMP_LT_OQ));
+         const __m256 touched =
+            _mm256_and_ps(_mm256_and_ps(in_bounds, _mm256_cmp_ps(ab, zero, _CMP_GE_OQ)),
+                          _mm256_and_ps(_mm256_cmp_ps(bc, zero, _CMP_GE_OQ),
+                                        _mm256_cmp_ps(ca, zero, _CMP_GE_OQ)));
+
+         if (_mm256_testz_ps(touched, touched)) continue;
+
+         const __m256 old_depth = _mm256_load_ps(row + x);
+
+         _mm256_store_ps(row + x,
+                         _mm256_blendv_ps(old_depth, _mm256_max_ps(old_depth, depth),
+                                          touched));
+      }
+   }
+}
+
+/// @brief Clear every pixel of an occluder's depth that the segment from a to b passes
+/// through. A little extra is cleared to stay clear of rounding.
+void clear_crossed(std::span<float> occluder_depth, const screen_vertex& a,
+                   const screen_vertex& b) noexcept
+{
+   constexpr float tolerance = 1.0f / 256.0f;
+
+   const float min_x = std::min(a.x, b.x) - tolerance;
+   const float max_x = std::max(a.x, b.x) + tolerance;
+   const float min_y = std::min(a.y, b.y) - tolerance;
+   const float max_y = std::max(a.y, b.y) + tolerance;
+
+   if (max_x < 0.0f or max_y < 0.0f or min_x >= occlusion_buffer::width or
+       min_y >= occlusion_buffer::height) {
+      return;
+   }
+
+   const int32 begin_x = static_cast<int32>(std::max(std::floor(min_x), 0.0f));
+   const int32 last_x = static_cast<int32>(
+      std::min(std::floor(max_x), float{occlusion_buffer::width - 1}));
+   const int32 begin_y = static_cast<int32>(std::max(std::floor(min_y), 0.0f));
+   const int32 last_y = static_cast<int32>(
+      std::min(std::floor(max_y), float{occlusion_buffer::height - 1}));
+
+   const float delta_x = b.x - a.x;
+   const float delta_y = b.y - a.y;
+
+   // Each row clears the pixels overlapping the part of the segment inside the row.
+   for (int32 y = begin_y; y <= last_y; ++y) {
+      float t_begin = 0.0f;
+      float t_end = 1.0f;
+
+      if (delta_y != 0.0f) {
+         const float t_top = (static_cast<float>(y) - tolerance - a.y) / delta_y;
+         const float t_bottom = (static_cast<float>(y + 1) + tolerance - a.y) / delta_y;
+
+         t_begin = std::max(std::min(t_top, t_bottom), 0.0f);
+         t_end = std::min(std::max(t_top, t_bottom), 1.0f);
+
+         if (t_begin > t_end) continue;
+      }
+
+      const float row_x0 = a.x + delta_x * t_begin;
+      const float row_x1 = a.x + delta_x * t_end;
+
+      const int32 row_begin_x = static_cast<int32>(
+         std::max(std::floor(std::min(row_x0, row_x1) - tolerance), float(begin_x)));
+      const int32 row_last_x = static_cast<int32>(
+         std::min(std::floor(std::max(row_x0, row_x1) + tolerance), float(last_x)));
+
+      for (int32 x = row_begin_x; x <= row_last_x; ++x) {
+         occluder_depth[y * occlusion_buffer::width + x] = -1.0f;
+      }
+   }
+}
+
+}
+
+occlusion_buffer::occlusion_buffer()
+{
+   _depth.resize(width * height, 1.0f);
+   _occluder_depth.resize(width * height, -1.0f);
+   _tile_max_depth.resize(tiles_width * tiles_height, 1.0f);
+}
+
+void occlusion_buffer::clear(const float4x4& view_projection_matrix) noexcept
+{
+   _view_projection_matrix = view_projection_matrix;
+
+   std::ranges::fill(_depth, 1.0f);
+   std::ranges::fill(_tile_max_depth, 1.0f);
+}
+
+void occlusion_buffer::add_occluder(const float4x4& world_matrix,
+                                    std::span<const float3> positions,
+                                    std::span<const std::array<uint16, 3>> triangles,
+                                    const occluder_faces faces) noexcept
+{
+   const float4x4 world_view_projection = _view_projection_matrix * world_matrix;
+
+   _clip_positions.resize(positions.size());
+
+   for (std::size_t i = 0; i < positions.size(); ++i) {
+      _clip_positions[i] = world_view_projection * float4{positions[i], 1.0f};
+   }
+
+   _occluder_edges.clear();
+
+   int32 begin_y = height;
+   int32 end_y = 0;
+
+   for (auto [i0, i1, i2] : triangles) {
+      assert(i0 < positions.size() and i1 < positions.size() and i2 < positions.size());
+
+      const float4& v0 = _clip_positions[i0];
+      const float4& v1 = _clip_positions[i1];
+      const float4& v2 = _clip_positions[i2];
+
+      // Clipping would be needed to rasterize triangles crossing the near plane. Leaving
+      // them out instead only means occluding less.
+      if (v0.z < 0.0f or v1.z < 0.0f or v2.z < 0.0f) continue;
+      if (v0.z > v0.w and v1.z > v1.w and v2.z > v2.w) continue;
+
+      const screen_vertex a = to_screen(v0);
+      screen_vertex b = to_screen(v1);
+      screen_vertex c = to_screen(v2);
+
+      // Screen Y points down so counter clockwise triangles have a negative area here.
+      const float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+
+      if (area == 0.0f) continue;
+      if (area > 0.0f and faces == occluder_faces::front) continue;
+
+      // Wind every triangle the same way on screen, so a to b to c keeps the inside on
+      // the right.
+      if (area < 0.0f) {
+         std::swap(b, c);
+         std::swap(i1, i2);
+      }
+
+      rasterize_touched(_occluder_depth, a, b, c);
+
+      _occluder_edges.push_back({i0, i1});
+      _occluder_edges.push_back({i1, i2});
+      _occluder_edges.push_back({i2, i0});
+
+      begin_y = std::min(begin_y, static_cast<int32>(std::floor(
+                                     std::clamp(std::min({a.y, b.y, c.y}), 0.0f,
+                                                float{height}))));
+      end_y = std::max(end_y, static_cast<int32>(std::ceil(
+                                 std::clamp(std::max({a.y, b.y, c.y}), 0.0f,
+                                            float{height}))));
+   }
+
+   if (begin_y >= end_y) return;
+
+   // The occluder covers a pixel completely when a triangle touches it and none of the
+   // occluder's outline crosses it. Edges shared by two triangles on either side of them
+   // are inside the occluder, every other edge is on its outline. Gaps along edges
+   // between triangles are left closed this way, which coverage tested per triangle
+   // would open up.
+   //
+   // Edges are bucketed by their lowest vertex so the ones sharing vertices can be found
+   // without a sort.
+   _occluder_edge_offsets.assign(positions.size() + 1, 0);
+
+   for (const auto [from, to] : _occluder_edges) {
+      _occluder_edge_offsets[std::min(from, to) + 1] += 1;
+   }
+
+   for (std::size_t i = 1; i < _occluder_edge_offsets.size(); ++i) {
+      _occluder_edge_offsets[i] += _occluder_edge_offsets[i - 1];
+   }
+
+   _occluder_edge_cursors.assign(_occluder_edge_offsets.begin(),
+                                 _occluder_edge_offsets.end() - 1);
+   _occluder_edge_buckets.resize(_occluder_edges.size());
+
+   for (const std::array<uint16, 2>& edge : _occluder_edges) {
+      _occluder_edge_buckets[_occluder_edge_cursors[std::min(edge[0], edge[1])]++] = edge;
+   }
+
+   for (const auto [from, to] : _occluder_edges) {
+      const uint16 lowest = std::min(from, to);
+
+      uint32 same_count = 0;
+      uint32 reversed_count = 0;
+
+      for (uint32 i = _occluder_edge_offsets[lowest];
+           i < _occluder_edge_offsets[lowest + 1]; ++i) {
+         const auto [bucket_from, bucket_to] = _occluder_edge_buckets[i];
+
+         if (bucket_from == from and bucket_to == to) same_count += 1;
+         if (bucket_from == to and bucket_to == from) reversed_count += 1;
+      }
+
+      if (same_count == 1 and reversed_count == 1) continue;
+
+      clear_crossed(_occluder_depth, to_screen(_clip_positions[from]),
+                    to_screen(_clip_positions[to]));
+   }
+
+   // Merge the occluder in and reset its depth for the next one.
+   const __m256 untouched = _mm256_set1_ps(-1.0f);
+   const __m256 zero = _mm256_setzero_ps();
+
+   for (int32 y = begin_y; y < end_y; ++y) {
+      float* const row = &_depth[y * width];
+      float* const occluder_row = &_occluder_depth[y * width];
+
+      for (uint32 x = 0; x < width; x += avx_width) {
+         const __m256 occluder_depth = _mm256_load_ps(occluder_row + x);
+         const __m256 covered = _mm256_cmp_ps(occluder_depth, zero, _CMP_GE_OQ);
+
+         if (_mm256_testz_ps(covered, covered)) continue;
+
+         const __m256 old_depth = _mm256_load_ps(row + x);
+
+         _mm256_store_ps(row + x, _mm256_blendv_ps(old_depth,
+                                                   _mm256_min_ps(old_depth,
+                                                                 occluder_depth),
+                                                   covered));
+         _mm256_store_ps(occluder_row + x, untouched);
+      }
+   }
+}
+
+void occlusion_buffer::build_hierarchy() noexcept
+{
+   for (uint32 tile_y = 0; tile_y < tiles_height; ++tile_y) {
+      for (uint32 tile_x = 0; tile_x < tiles_width; ++tile_x) {
+         const float* const tile =
+            &_depth[tile_y * tile_size * width + tile_x * tile_size];
+
+         __m256 max_depth = _mm256_load_ps(tile);
+
+         for (uint32 y = 1; y < tile_size; ++y) {
+            max_depth = _mm256_max_ps(max_depth, _mm256_load_ps(tile + y * width));
+         }
+
+         // Reduce the 8 lanes down to one.
+         __m128 max_4 = _mm_max_ps(_mm256_castps256_ps128(max_depth),
+                                   _mm256_extractf128_ps(max_depth, 1));
+         max_4 = _mm_max_ps(max_4, _mm_movehl_ps(max_4, max_4));
+         max_4 = _mm_max_ss(max_4, _mm_shuffle_ps(max_4, max_4, 0b01));
+
+         _tile_max_depth[tile_y * tiles_width + tile_x] = _mm_cvtss_f32(max_4);
+      }
+   }
+}
+
+bool occlusion_buffer::is_occluded(const math::bounding_box& bbox) const noexcept
+{
+   float min_x = FLT_MAX;
+   float max_x = -FLT_MAX;
+   float min_y = FLT_MAX;
+   float max_y = -FLT_MAX;
+   float min_depth = FLT_MAX;
+
+   for (const float3& corner : math::to_corners(bbox)) {
+      const float4 clip = _view_projection_matrix * float4{corner, 1.0f};
+
+      if (clip.z < 0.0f) return false;
+
+      const screen_vertex vertex = to_screen(clip);
+
+      min_x = std::min(min_x, vertex.x);
+      max_x = std::max(max_x, vertex.x);
+      min_y = std::min(min_y, vertex.y);
+      max_y = std::max(max_y, vertex.y);
+      min_depth = std::min(min_depth, vertex.depth);
+   }
+
+   if (max_x < 0.0f or max_y < 0.0f or min_x >= width or min_y >= height) return false;
+
+   const uint32 begin_x = static_cast<uint32>(std::max(std::floor(min_x), 0.0f));
+   const uint32 last_x =
+      static_cast<uint32>(std::min(std::floor(max_x), float{width - 1}));
+   const uint32 begin_y = static_cast<uint32>(std::max(std::floor(min_y), 0.0f));
+   const uint32 last_y =
+      static_cast<uint32>(std::min(std::floor(max_y), float{height - 1}));
+
+   for (uint32 tile_y = begin_y / tile_size; tile_y <= last_y / tile_size; ++tile_y) {
+      for (uint32 tile_x = begin_x / tile_size; tile_x <= last_x / tile_size; ++tile_x) {
+         // Every pixel in the tile is in front of the box.
+         if (_tile_max_depth[tile_y * tiles_width + tile_x] < min_depth) continue;
+
+         const uint32 tile_begin_x = std::max(tile_x * tile_size, begin_x);
+         const uint32 tile_last_x = std::min(tile_x * tile_size + tile_size - 1, last_x);
+         const uint32 tile_begin_y = std::max(tile_y * tile_size, begin_y);
+         const uint32 tile_last_y = std::min(tile_y * tile_size + tile_size - 1, last_y);
+
+         for (uint32 y = tile_begin_y; y <= tile_last_y; ++y) {
+            for (uint32 x = tile_begin_x; x <= tile_last_x; ++x) {
+               if (_depth[y * width + x] >= min_depth) return false;
+            }
+         }
+      }
+   }
+
+   return true;
+}
+
+auto occlusion_buffer::depth() const noexcept -> std::span<const float>
+{
+   return _depth;
+}
+
+auto make_terrain_occluder(const world::terrain& terrain,
+                           const int32 max_grid_length) noexcept -> occluder_mesh
+{
+   if (not terrain.active_flags.terrain or terrain.length < 2) return {};
+
+   // Keep the vertex count within what uint16 indices can address.
+   const int32 clamped_max_grid_length = std::clamp(max_grid_length, 1, 255);
+   const int32 max_index = terrain.length - 1;
+   const int32 step =
+      (max_index + clamped_max_grid_length - 1) / clamped_max_grid_length;
+   const int32 grid_length = (max_index + step - 1) / step;
+
+   const float grid_scale = terrain.grid_scale;
+   const float half_world_length = terrain.length * grid_scale / 2.0f;
+
+   const auto to_terrain_index = [&](const int32 grid_index) {
+      return std::clamp(grid_index * step, 0, max_index);
+   };
+
+   occluder_mesh occluder;
+
+   occluder.positions.reserve((grid_length + 1) * (grid_length + 1));
+
+   for (int32 grid_z = 0; grid_z <= grid_length; ++grid_z) {
+      for (int32 grid_x = 0; grid_x <= grid_length; ++grid_x) {
+         // Take the lowest height from every cell touching the vertex so no part of the
+         // occluder rises above the terrain.
+         int16 height = std::numeric_limits<int16>::max();
+
+         for (int32 z = to_terrain_index(grid_z - 1); z <= to_terrain_index(grid_z + 1);
+              ++z) {
+            for (int32 x = to_terrain_index(grid_x - 1);
+                 x <= to_terrain_index(grid_x + 1); ++x) {
+               height = std::min(height, terrain.height_map[{x, z}]);
+            }
+         }
+
+         occluder.positions.push_back(
+            {to_terrain_index(grid_x) * grid_scale - half_world_length,
+             height * terrain.height_scale,
+             to_terrain_index(grid_z) * grid_scale - half_world_length + grid_scale});
+      }
+   }
+
+   const auto overlaps_cut = [&](const float3& min, const float3& max) {
+      for (const world::terrain_cut& cut : terrain.cuts) {
+         if (min.x <= cut.bbox_max.x and max.x >= cut.bbox_min.x and
+             min.z <= cut.bbox_max.z and max.z >= cut.bbox_min.z) {
+            return true;
+         }
+      }
+
+      return false;
+   };
+
+   occluder.triangles.reserve(grid_length * grid_length * 2);
+
+   for (int32 grid_z = 0; grid_z < grid_length; ++grid_z) {
+      for (int32 grid_x = 0; grid_x < grid_length; ++grid_x) {
+         const uint16 i0 = static_cast<uint16>(grid_z * (grid_length + 1) + grid_x);
+         const uint16 i1 = static_cast<uint16>(i0 + 1);
+         const uint16 i2 = static_cast<uint16>(i0 + grid_length + 1);
+         const uint16 i3 = static_cast<uint16>(i2 + 1);
+
+         if (overlaps_cut(occluder.positions[i0], occluder.positions[i3])) continue;
+
+         // Wound counter clockwise when seen from above.
+         occluder.triangles.push_back({i0, i2, i1});
+         occluder.triangles.push_back({i1, i2, i3});
+      }
+   }
+
+   return occluder;
+}
+
+void cull_occluded(const occlusion_buffer& buffer, const world_mesh_list& meshes,
+                   std::vector<uint32>& render_list) noexcept
+{
+   std::erase_if(render_list, [&](const uint32 i) {
+      return buffer.is_occluded({.min = {meshes.bbox.min.x[i], meshes.bbox.min.y[i],
+                                         meshes.bbox.min.z[i]},
+                                 .max = {meshes.bbox.max.x[i], meshes.bbox.max.y[i],
+                                         meshes.bbox.max.z[i]}});
+   });
+}
+
+}
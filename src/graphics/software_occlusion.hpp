@@ -0,0 +1,156 @@
+#pragma once
+
+#include "allocators/aligned_allocator.hpp"
+#include "frustum.hpp"
+#include "math/bounding_box.hpp"
+#include "math/vector_funcs.hpp"
+#include "types.hpp"
+#include "world/terrain.hpp"
+#include "world_mesh_list.hpp"
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <vector>
+
+namespace we::graphics {
+
+/// @brief Triangles to rasterize into an occlusion_buffer.
+struct occluder_mesh {
+   std::vector<float3> positions;
+   std::vector<std::array<uint16, 3>> triangles;
+};
+
+/// @brief Which faces of an occluder to rasterize.
+enum class occluder_faces { front, both };
+
+/// @brief A low resolution depth buffer rasterized on the CPU from a handful of large
+/// occluders. Boxes can be tested against it to skip drawing objects hidden behind the
+/// occluders.
+///
+/// Depth is conservative so that nothing in front of an occluder is reported as
+/// occluded. Pixels are only covered when they're completely inside an occluder and take
+/// the depth of the furthest vertex of any triangle touching them. Triangles crossing the
+/// near plane are skipped.
+class occlusion_buffer {
+public:
+   constexpr static uint32 width = 256;
+   constexpr static uint32 height = 128;
+
+   /// @brief The size of the tiles in the hierarchical Z.
+   constexpr static uint32 tile_size = 8;
+   constexpr static uint32 tiles_width = width / tile_size;
+   constexpr static uint32 tiles_height = height / tile_size;
+
+   occlusion_buffer();
+
+   /// @brief Clear the buffer and begin adding occluders for a view.
+   /// @param view_projection_matrix The view projection matrix of the view.
+   void clear(const float4x4& view_projection_matrix) noexcept;
+
+   /// @brief Rasterize an occluder's triangles.
+   /// @param world_matrix Transforms the occluder's positions to world space.
+   /// @param positions The positions of the occluder's vertices.
+   /// @param triangles The occluder's triangles.
+   /// @param faces Which faces to rasterize. Front faces are counter clockwise, matching
+   /// the GPU pipelines.
+   void add_occluder(const float4x4& world_matrix, std::span<const float3> positions,
+                     std::span<const std::array<uint16, 3>> triangles,
+                     const occluder_faces faces = occluder_faces::front) noexcept;
+
+   /// @brief Build the hierarchical Z from the rasterized occluders. Call after adding
+   /// the last occluder and before testing boxes.
+   void build_hierarchy() noexcept;
+
+   /// @brief Test if a box is completely hidden behind the occluders. Boxes off screen or
+   /// crossing the near plane are never occluded, frustum culling handles them.
+   /// @param bbox The box to test.
+   [[nodiscard]] bool is_occluded(const math::bounding_box& bbox) const noexcept;
+
+   /// @brief The depth of each pixel, row by row.
+   [[nodiscard]] auto depth() const noexcept -> std::span<const float>;
+
+private:
+   float4x4 _view_projection_matrix;
+   std::vector<float, aligned_allocator<float, 32>> _depth;
+   std::vector<float, aligned_allocator<float, 32>> _occluder_depth;
+   std::vector<float> _tile_max_depth;
+   std::vector<float4> _clip_positions;
+   std::vector<std::array<uint16, 2>> _occluder_edges;
+   std::vector<std::array<uint16, 2>> _occluder_edge_buckets;
+   std::vector<uint32> _occluder_edge_offsets;
+   std::vector<uint32> _occluder_edge_cursors;
+};
+
+/// @brief Make an occluder from the terrain. The occluder is a coarse grid that never
+/// rises above the terrain so it can only ever occlude less than the terrain does. Cells
+/// overlapping terrain cuts are left out.
+/// @param terrain The terrain.
+/// @param max_grid_length The max number of cells along each side of the grid.
+[[nodiscard]] auto make_terrain_occluder(const world::terrain& terrain,
+                                         const int32 max_grid_length = 64) noexcept
+   -> occluder_mesh;
+
+/// @brief Remove the meshes hidden behind the occluders from a render list. The order of
+/// the remaining meshes is kept.
+/// @param buffer The occlusion buffer to test against. Must have had its hierarchy built.
+/// @param meshes The world mesh list.
+/// @param render_list The render list to remove meshes from.
+void cull_occluded(const occlusion_buffer& buffer, const world_mesh_list& meshes,
+                   std::vector<uint32>& render_list) noexcept;
+
+/// @brief Pick the objects that cover the most of the view to be occluders. Objects are
+/// scored by the radius of their bounds over their distance from the camera.
+/// @param view_frustum The view frustum.
+/// @param camera_position The position of the camera.
+/// @param bboxes The object bounding boxes. A world::object_bbox_cache or any other
+/// container of math::bounding_box indexed like world::objects.
+/// @param min_score The min score for an object to be picked.
+/// @param max_occluders The max number of objects to pick.
+/// @param is_candidate Called with an object's index, returns if the object can be an
+/// occluder (it's drawn and has an opaque model, etc).
+/// @param out_occluders Receives the indices of the picked objects, highest score first.
+template<typename Bboxes, typename Fn>
+void select_occluders(const frustum& view_frustum, const float3& camera_position,
+                      const Bboxes& bboxes, const float min_score,
+                      const std::size_t max_occluders, const Fn& is_candidate,
+                      std::vector<uint32>& out_occluders) noexcept
+{
+   struct scored_object {
+      float score;
+      uint32 index;
+   };
+
+   std::vector<scored_object> candidates;
+
+   for (uint32 i = 0; i < bboxes.size(); ++i) {
+      const math::bounding_box bbox = bboxes[i];
+      const float3 centre = (bbox.min + bbox.max) * 0.5f;
+      const float radius = distance(bbox.min, bbox.max) * 0.5f;
+      const float distance_to_camera =
+         std::max(distance(camera_position, centre), radius);
+      const float score = radius / distance_to_camera;
+
+      if (score < min_score) continue;
+      if (not intersects(view_frustum, bbox)) continue;
+      if (not is_candidate(i)) continue;
+
+      candidates.push_back({.score = score, .index = i});
+   }
+
+   const auto higher_score = [](const scored_object& l, const scored_object& r) {
+      if (l.score != r.score) return l.score > r.score;
+
+      return l.index < r.index;
+   };
+
+   const std::size_t count = std::min(candidates.size(), max_occluders);
+
+   std::ranges::partial_sort(candidates, candidates.begin() + count, higher_score);
+
+   out_occluders.resize(count);
+
+   for (std::size_t i = 0; i < count; ++i) out_occluders[i] = candidates[i].index;
+}
+
+}
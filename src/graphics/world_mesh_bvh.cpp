@@ -0,0 +1,289 @@
+#include "world_mesh_bvh.hpp"
+#include "math/vector_funcs.hpp"
+#include "utility/enum_bitflags.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <numeric>
+#include <span>
+
+namespace we::graphics {
+
+namespace {
+
+constexpr uint32 max_leaf_size = 8;
+
+constexpr uint32 all_planes_mask = (1u << static_cast<uint32>(frustum_planes::count)) - 1u;
+
+enum class plane_test { outside, inside, intersecting };
+
+auto mesh_bbox(const world_mesh_list& meshes, const std::size_t i) noexcept
+   -> math::bounding_box
+{
+   return {.min = {meshes.bbox.min.x[i], meshes.bbox.min.y[i], meshes.bbox.min.z[i]},
+           .max = {meshes.bbox.max.x[i], meshes.bbox.max.y[i], meshes.bbox.max.z[i]}};
+}
+
+auto axis_value(const float3& v, const int axis) noexcept -> float
+{
+   if (axis == 0) return v.x;
+   if (axis == 1) return v.y;
+
+   return v.z;
+}
+
+bool is_transparent(const material_pipeline_flags flags) noexcept
+{
+   return are_flags_set(flags, material_pipeline_flags::transparent) or
+          are_flags_set(flags, material_pipeline_flags::additive);
+}
+
+auto test_plane(const float4& plane, const math::bounding_box& bbox) noexcept -> plane_test
+{
+   // The corner furthest along the plane's normal is the last to leave its positive side,
+   // the corner furthest against it is the first.
+   const float3 positive_corner{plane.x >= 0.0f ? bbox.max.x : bbox.min.x,
+                                plane.y >= 0.0f ? bbox.max.y : bbox.min.y,
+                                plane.z >= 0.0f ? bbox.max.z : bbox.min.z};
+
+   if (dot(plane, float4{positive_corner, 1.0f}) < 0.0f) return plane_test::outside;
+
+   const float3 negative_corner{plane.x >= 0.0f ? bbox.min.x : bbox.max.x,
+                                plane.y >= 0.0f ? bbox.min.y : bbox.max.y,
+                                plane.z >= 0.0f ? bbox.min.z : bbox.max.z};
+
+   if (dot(plane, float4{negative_corner, 1.0f}) >= 0.0f) return plane_test::inside;
+
+   return plane_test::intersecting;
+}
+
+/// @brief Walk the tree. Subtrees inside every plane in root_plane_mask have all their
+/// meshes accepted, meshes in leaves that cross a plane are passed to test_mesh first.
+template<typename Node, typename Accept_mesh, typename Test_mesh>
+void cull_nodes(std::span<const Node> nodes, std::span<const uint32> indices,
+                const frustum& frustum, const uint32 root_plane_mask,
+                const Accept_mesh& accept_mesh, const Test_mesh& test_mesh) noexcept
+{
+   if (nodes.empty()) return;
+
+   struct stack_entry {
+      uint32 node_index;
+      uint32 plane_mask;
+   };
+
+   // The tree is split at the median so its depth is at most log2 of the mesh count.
+   std::array<stack_entry, 64> stack;
+   std::size_t stack_size = 0;
+
+   stack[stack_size++] = {.node_index = 0, .plane_mask = root_plane_mask};
+
+   while (stack_size != 0) {
+      const stack_entry entry = stack[--stack_size];
+      const Node& node = nodes[entry.node_index];
+
+      uint32 plane_mask = entry.plane_mask;
+      bool outside = false;
+
+      for (uint32 plane_index = 0; plane_index < frustum.planes.size(); ++plane_index) {
+         const uint32 plane_bit = 1u << plane_index;
+
+         if (not(plane_mask & plane_bit)) continue;
+
+         const plane_test test = test_plane(frustum.planes[plane_index], node.bbox);
+
+         if (test == plane_test::outside) {
+            outside = true;
+
+            break;
+         }
+
+         // Children are inside every plane their parent is inside.
+         if (test == plane_test::inside) plane_mask &= ~plane_bit;
+      }
+
+      if (outside) continue;
+
+      const std::span<const uint32> node_indices = indices.subspan(node.first, node.count);
+
+      if (plane_mask == 0) {
+         for (const uint32 i : node_indices) accept_mesh(i);
+      }
+      else if (node.right_child == 0) {
+         for (const uint32 i : node_indices) {
+            if (test_mesh(i)) accept_mesh(i);
+         }
+      }
+      else {
+         assert(stack_size + 2 <= stack.size());
+
+         stack[stack_size++] = {.node_index = node.right_child, .plane_mask = plane_mask};
+         stack[stack_size++] = {.node_index = entry.node_index + 1, .plane_mask = plane_mask};
+      }
+   }
+}
+
+}
+
+void world_mesh_bvh::update(const world_mesh_list& meshes) noexcept
+{
+   if (meshes.size() != _indices.size() or _nodes.empty()) {
+      build(meshes);
+   }
+   else {
+      refit(meshes);
+   }
+}
+
+void world_mesh_bvh::clear() noexcept
+{
+   _nodes.clear();
+   _indices.clear();
+}
+
+void world_mesh_bvh::cull(const frustum& frustum, const world_mesh_list& meshes,
+                          std::vector<uint32>& out_opaque_list,
+                          std::vector<uint32>& out_transparent_list) const noexcept
+{
+   assert(meshes.size() >= _indices.size());
+
+   out_opaque_list.clear();
+   out_transparent_list.clear();
+   out_opaque_list.reserve(meshes.size());
+   out_transparent_list.reserve(meshes.size());
+
+   const auto accept_mesh = [&](const uint32 i) {
+      (is_transparent(meshes.pipeline_flags[i]) ? out_transparent_list : out_opaque_list)
+         .push_back(i);
+   };
+   const auto test_mesh = [&](const uint32 i) {
+      return intersects(frustum, mesh_bbox(meshes, i));
+   };
+
+   cull_nodes(std::span{_nodes}, std::span{_indices}, frustum, all_planes_mask,
+              accept_mesh, test_mesh);
+
+   for (uint32 i = static_cast<uint32>(_indices.size()); i < meshes.size(); ++i) {
+      if (test_mesh(i)) accept_mesh(i);
+   }
+}
+
+void world_mesh_bvh::cull_shadow_cascade(const frustum& frustum,
+                                         const world_mesh_list& meshes,
+                                         std::vector<uint32>& out_list) const noexcept
+{
+   assert(meshes.size() >= _indices.size());
+
+   out_list.clear();
+   out_list.reserve(meshes.size());
+
+   const auto accept_mesh = [&](const uint32 i) {
+      if (not is_transparent(meshes.pipeline_flags[i])) out_list.push_back(i);
+   };
+   const auto test_mesh = [&](const uint32 i) {
+      return intersects_shadow_cascade(frustum, mesh_bbox(meshes, i));
+   };
+
+   // Matches intersects_shadow_cascade, which skips the near plane.
+   cull_nodes(std::span{_nodes}, std::span{_indices}, frustum,
+              all_planes_mask & ~(1u << static_cast<uint32>(frustum_planes::near_)),
+              accept_mesh, test_mesh);
+
+   for (uint32 i = static_cast<uint32>(_indices.size()); i < meshes.size(); ++i) {
+      if (test_mesh(i)) accept_mesh(i);
+   }
+}
+
+auto world_mesh_bvh::size() const noexcept -> std::size_t
+{
+   return _indices.size();
+}
+
+void world_mesh_bvh::build(const world_mesh_list& meshes) noexcept
+{
+   _nodes.clear();
+   _indices.resize(meshes.size());
+   _centroids.resize(meshes.size());
+
+   std::iota(_indices.begin(), _indices.end(), uint32{0});
+
+   for (std::size_t i = 0; i < meshes.size(); ++i) {
+      const math::bounding_box bbox = mesh_bbox(meshes, i);
+
+      _centroids[i] = (bbox.min + bbox.max) * 0.5f;
+   }
+
+   if (meshes.size() == 0) return;
+
+   _nodes.reserve((meshes.size() / max_leaf_size + 1) * 2);
+
+   build_node(0, static_cast<uint32>(meshes.size()));
+
+   refit(meshes);
+}
+
+auto world_mesh_bvh::build_node(const uint32 first, const uint32 count) noexcept -> uint32
+{
+   const uint32 node_index = static_cast<uint32>(_nodes.size());
+
+   _nodes.push_back({.first = first, .count = count});
+
+   if (count <= max_leaf_size) return node_index;
+
+   const auto node_indices_begin = _indices.begin() + first;
+   const auto node_indices_end = node_indices_begin + count;
+
+   math::bounding_box centroid_bounds{.min = _centroids[*node_indices_begin],
+                                      .max = _centroids[*node_indices_begin]};
+
+   for (auto it = node_indices_begin; it != node_indices_end; ++it) {
+      centroid_bounds = math::integrate(centroid_bounds, _centroids[*it]);
+   }
+
+   const float3 extents = centroid_bounds.max - centroid_bounds.min;
+   const int split_axis =
+      extents.x >= extents.y and extents.x >= extents.z ? 0 : (extents.y >= extents.z ? 1 : 2);
+
+   const uint32 left_count = count / 2;
+
+   std::nth_element(node_indices_begin, node_indices_begin + left_count,
+                    node_indices_end, [&](const uint32 l, const uint32 r) {
+                       return axis_value(_centroids[l], split_axis) <
+                              axis_value(_centroids[r], split_axis);
+                    });
+
+   build_node(first, left_count);
+
+   const uint32 right_child = build_node(first + left_count, count - left_count);
+
+   _nodes[node_index].right_child = right_child;
+
+   return node_index;
+}
+
+void world_mesh_bvh::refit(const world_mesh_list& meshes) noexcept
+{
+   // Children always come after their parent, so walking backwards visits both children
+   // before the parent.
+   for (std::size_t i = _nodes.size(); i-- > 0;) {
+      node& node = _nodes[i];
+
+      node.bbox = node.right_child == 0
+                     ? leaf_bbox(meshes, node)
+                     : math::combine(_nodes[i + 1].bbox, _nodes[node.right_child].bbox);
+   }
+}
+
+auto world_mesh_bvh::leaf_bbox(const world_mesh_list& meshes, const node& node) const noexcept
+   -> math::bounding_box
+{
+   math::bounding_box bbox = mesh_bbox(meshes, _indices[node.first]);
+
+   for (uint32 i = node.first + 1; i < node.first + node.count; ++i) {
+      bbox = math::combine(bbox, mesh_bbox(meshes, _indices[i]));
+   }
+
+   return bbox;
+}
+
+}
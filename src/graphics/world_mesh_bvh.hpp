@@ -0,0 +1,78 @@
+#pragma once
+
+#include "frustum.hpp"
+#include "math/bounding_box.hpp"
+#include "types.hpp"
+#include "world_mesh_list.hpp"
+
+#include <vector>
+
+namespace we::graphics {
+
+/// @brief Bounding volume hierarchy over the bounding boxes of a world_mesh_list. Culling
+/// walks the tree and accepts or rejects whole subtrees at once. The same tree serves the
+/// view frustum and every shadow cascade.
+///
+/// The tree is kept between frames. Updating it with a mesh list of the same size as
+/// last time refits the node bounds in place. Otherwise the tree is rebuilt.
+///
+/// Meshes pushed onto the end of the list after the tree was updated aren't in the tree,
+/// culling tests them one by one. This is for the handful of meshes that change every
+/// frame (like an object being placed) so they don't cost a rebuild.
+class world_mesh_bvh {
+public:
+   /// @brief Bring the tree up to date with a mesh list.
+   /// @param meshes The mesh list.
+   void update(const world_mesh_list& meshes) noexcept;
+
+   /// @brief Empty the tree. The next update will rebuild it.
+   void clear() noexcept;
+
+   /// @brief Get the meshes that intersect a frustum. Produces the same meshes as
+   /// cull_objects, though not always in the same order.
+   /// @param frustum The frustum.
+   /// @param meshes The mesh list the tree was last updated with, plus any meshes pushed
+   /// onto its end since.
+   /// @param out_opaque_list Receives the indices of the visible opaque meshes.
+   /// @param out_transparent_list Receives the indices of the visible transparent meshes.
+   void cull(const frustum& frustum, const world_mesh_list& meshes,
+             std::vector<uint32>& out_opaque_list,
+             std::vector<uint32>& out_transparent_list) const noexcept;
+
+   /// @brief Get the opaque meshes that intersect a shadow cascade's frustum. Produces the
+   /// same meshes as cull_objects_shadow_cascade, though not always in the same order.
+   /// @param frustum The shadow cascade's frustum.
+   /// @param meshes The mesh list the tree was last updated with, plus any meshes pushed
+   /// onto its end since.
+   /// @param out_list Receives the indices of the meshes.
+   void cull_shadow_cascade(const frustum& frustum, const world_mesh_list& meshes,
+                            std::vector<uint32>& out_list) const noexcept;
+
+   /// @brief The number of meshes in the tree.
+   [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+private:
+   /// @brief A node of the tree. The left child directly follows its parent, so only the
+   /// right child is stored. Every node covers a contiguous range of _indices.
+   struct node {
+      math::bounding_box bbox;
+      uint32 first = 0;
+      uint32 count = 0;
+      uint32 right_child = 0;
+   };
+
+   void build(const world_mesh_list& meshes) noexcept;
+
+   auto build_node(const uint32 first, const uint32 count) noexcept -> uint32;
+
+   void refit(const world_mesh_list& meshes) noexcept;
+
+   auto leaf_bbox(const world_mesh_list& meshes, const node& node) const noexcept
+      -> math::bounding_box;
+
+   std::vector<node> _nodes;
+   std::vector<uint32> _indices;
+   std::vector<float3> _centroids;
+};
+
+}
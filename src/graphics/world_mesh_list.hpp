@@ -73,6 +73,32 @@ struct world_mesh_list {
       mesh.push_back(world_mesh);
    }
 
+   /// @brief Overwrite the mesh at index. Lets several threads fill disjoint ranges of a
+   /// list that has already been resized.
+   void set(std::size_t index, math::bounding_box mesh_bbox,
+            gpu_virtual_address mesh_gpu_constants, float3 mesh_position,
+            gpu::pipeline_handle mesh_pipeline, material_pipeline_flags mesh_pipeline_flags,
+            gpu_virtual_address mesh_material_constant_buffer, world_mesh world_mesh) noexcept
+   {
+      bbox.min.x[index] = mesh_bbox.min.x;
+      bbox.min.y[index] = mesh_bbox.min.y;
+      bbox.min.z[index] = mesh_bbox.min.z;
+      bbox.max.x[index] = mesh_bbox.max.x;
+      bbox.max.y[index] = mesh_bbox.max.y;
+      bbox.max.z[index] = mesh_bbox.max.z;
+      gpu_constants[index] = mesh_gpu_constants;
+      position[index] = mesh_position;
+      pipeline[index] = mesh_pipeline;
+      pipeline_flags[index] = mesh_pipeline_flags;
+      material_constant_buffer[index] = mesh_material_constant_buffer;
+      mesh[index] = world_mesh;
+   }
+
+   void resize(std::size_t size) noexcept
+   {
+      invoke_over_all([size](auto& container) { container.resize(size); });
+   }
+
    void reserve(std::size_t size) noexcept
    {
       invoke_over_all([size](auto& container) { container.reserve(size); });
@@ -0,0 +1,105 @@
+#include "world_mesh_list_builder.hpp"
+#include "cull_objects.hpp"
+#include "math/vector_funcs.hpp"
+#include "utility/radix_sort.hpp"
+
+#include <bit>
+
+namespace we::graphics {
+
+namespace {
+
+constexpr int draw_key_flags_bits = 4;
+constexpr int draw_key_material_bits = 36;
+constexpr int draw_key_depth_bits = 24;
+
+static_assert(draw_key_flags_bits + draw_key_material_bits + draw_key_depth_bits == 64);
+static_assert(static_cast<int>(material_pipeline_flags::count) <= (1 << draw_key_flags_bits));
+
+/// @brief Map a float to a uint32 that sorts in the same order.
+auto sortable_float_bits(const float value) noexcept -> uint32
+{
+   const uint32 bits = std::bit_cast<uint32>(value);
+
+   return (bits & 0x8000'0000u) ? ~bits : bits | 0x8000'0000u;
+}
+
+void sort_render_list(std::span<uint32> render_list, world_mesh_sort_buffers& sort_buffers,
+                      auto make_key) noexcept
+{
+   sort_buffers.keys.resize(render_list.size());
+
+   for (std::size_t i = 0; i < render_list.size(); ++i) {
+      sort_buffers.keys[i] = make_key(render_list[i]);
+   }
+
+   utility::radix_sort(sort_buffers.keys, render_list, sort_buffers.scratch_keys,
+                       sort_buffers.scratch_indices);
+}
+
+void sort_render_lists(const frustum& view_frustum, const world_mesh_list& meshes,
+                       world_mesh_sort_buffers& sort_buffers,
+                       std::vector<uint32>& opaque_list,
+                       std::vector<uint32>& transparent_list) noexcept
+{
+   const float4 near_plane = view_frustum.planes[frustum_planes::near_];
+
+   sort_render_list(opaque_list, sort_buffers, [&](const uint32 i) {
+      return make_opaque_draw_key(meshes.pipeline_flags[i],
+                                  meshes.material_constant_buffer[i],
+                                  dot(near_plane, float4{meshes.position[i], 1.0f}));
+   });
+   sort_render_list(transparent_list, sort_buffers, [&](const uint32 i) {
+      return make_transparent_draw_key(dot(near_plane, float4{meshes.position[i], 1.0f}));
+   });
+}
+
+}
+
+auto make_opaque_draw_key(const material_pipeline_flags flags,
+                          const gpu_virtual_address material_constant_buffer,
+                          const float depth) noexcept -> uint64
+{
+   // Constant buffers are 256 byte aligned so the low bits are dropped. Two materials
+   // sharing the remaining bits only means they might not be grouped together.
+   const uint64 material_bits =
+      (material_constant_buffer >> 8) & ((1ull << draw_key_material_bits) - 1ull);
+   const uint64 depth_bits = sortable_float_bits(depth) >> (32 - draw_key_depth_bits);
+
+   return (static_cast<uint64>(flags) << (draw_key_material_bits + draw_key_depth_bits)) |
+          (material_bits << draw_key_depth_bits) | depth_bits;
+}
+
+auto make_transparent_draw_key(const float depth) noexcept -> uint64
+{
+   return ~sortable_float_bits(depth);
+}
+
+void build_world_mesh_render_lists(const frustum& view_frustum,
+                                   const world_mesh_list& meshes,
+                                   world_mesh_sort_buffers& sort_buffers,
+                                   std::vector<uint32>& out_opaque_list,
+                                   std::vector<uint32>& out_transparent_list) noexcept
+{
+   cull_objects(view_frustum, meshes.bbox.min.x, meshes.bbox.min.y, meshes.bbox.min.z,
+                meshes.bbox.max.x, meshes.bbox.max.y, meshes.bbox.max.z,
+                meshes.pipeline_flags, out_opaque_list, out_transparent_list);
+
+   sort_render_lists(view_frustum, meshes, sort_buffers, out_opaque_list,
+                     out_transparent_list);
+}
+
+void build_world_mesh_render_lists(const frustum& view_frustum,
+                                   const world_mesh_list& meshes,
+                                   const world_mesh_bvh& meshes_bvh,
+                                   world_mesh_sort_buffers& sort_buffers,
+                                   std::vector<uint32>& out_opaque_list,
+                                   std::vector<uint32>& out_transparent_list) noexcept
+{
+   meshes_bvh.cull(view_frustum, meshes, out_opaque_list, out_transparent_list);
+
+   sort_render_lists(view_frustum, meshes, sort_buffers, out_opaque_list,
+                     out_transparent_list);
+}
+
+}
@@ -0,0 +1,388 @@
+#pragma once
+
+#include "async/thread_pool.hpp"
+#include "frustum.hpp"
+#include "math/quaternion_funcs.hpp"
+#include "world/active_elements.hpp"
+#include "world/object_bbox_cache.hpp"
+#include "world/object_store.hpp"
+#include "world/utility/world_utilities.hpp"
+#include "world/world.hpp"
+#include "world_mesh_bvh.hpp"
+#include "world_mesh_list.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace we::graphics {
+
+/// @brief Where an object's constants are written and the GPU address its meshes read them
+/// from.
+struct world_mesh_constants_slot {
+   world_mesh_constants* cpu = nullptr;
+   gpu_virtual_address gpu = 0;
+};
+
+namespace detail {
+
+/// @brief Write an object's constants and its meshes into an already sized list, starting
+/// at first_mesh. Returns the index after the object's last mesh.
+template<typename Model, typename Get_pipeline>
+auto write_world_mesh_list_object(world_mesh_list& list, std::size_t first_mesh,
+                                  const math::bounding_box& object_bbox,
+                                  const quaternion& rotation, const float3& position,
+                                  const Model& model,
+                                  const world_mesh_constants_slot constants,
+                                  const Get_pipeline& get_pipeline) noexcept -> std::size_t
+{
+   float4x4 object_to_world = to_matrix(rotation);
+
+   object_to_world[3] = float4{position, 1.0f};
+
+   // Only the matrix is written, the constants usually live in write-combined memory.
+   std::memcpy(&constants.cpu->object_to_world, &object_to_world, sizeof(float4x4));
+
+   for (const auto& mesh : model.parts) {
+      list.set(first_mesh++, object_bbox, constants.gpu, position,
+               get_pipeline(mesh.material.flags), mesh.material.flags,
+               mesh.material.constant_buffer_view,
+               world_mesh{.index_buffer_view = model.gpu_buffer.index_buffer_view,
+                          .vertex_buffer_views = {model.gpu_buffer.position_vertex_buffer_view,
+                                                  model.gpu_buffer.attributes_vertex_buffer_view},
+                          .index_count = mesh.index_count,
+                          .start_index = mesh.start_index,
+                          .start_vertex = mesh.start_vertex});
+   }
+
+   return first_mesh;
+}
+
+}
+
+/// @brief Add an object's meshes to a world mesh list.
+///
+/// The model is a template parameter so the list can be built without a GPU. It needs the
+/// same bbox, gpu_buffer and parts members as graphics::model.
+///
+/// @param list The list to add the meshes to.
+/// @param object_bbox The object's world space bounding box.
+/// @param rotation The object's rotation.
+/// @param position The object's position.
+/// @param model The object's model.
+/// @param constants Where to write the object's constants.
+/// @param get_pipeline Called with a mesh's material_pipeline_flags, returns the
+/// gpu::pipeline_handle to draw it with.
+template<typename Model, typename Get_pipeline>
+void add_world_mesh_list_object(world_mesh_list& list, const math::bounding_box& object_bbox,
+                                const quaternion& rotation, const float3& position,
+                                const Model& model, const world_mesh_constants_slot constants,
+                                const Get_pipeline& get_pipeline)
+{
+   const std::size_t first_mesh = list.size();
+
+   list.resize(first_mesh + model.parts.size());
+
+   detail::write_world_mesh_list_object(list, first_mesh, object_bbox, rotation, position,
+                                        model, constants, get_pipeline);
+}
+
+/// @brief Number of objects each task handles in add_world_mesh_list_objects.
+constexpr std::size_t world_mesh_list_chunk_objects = 1024;
+
+/// @brief Add the meshes of every object in an active layer to a world mesh list. The
+/// objects are split into chunks that are filled in parallel, the meshes end up in the
+/// same order as the objects.
+///
+/// Objects are first counted so every chunk knows where its meshes go, then each chunk
+/// writes its own range of the constants and the list.
+///
+/// @param list The list to add the meshes to.
+/// @param objects The world's object store.
+/// @param object_bboxes The world's object bounding boxes. If the cache is out of date
+/// bounding boxes are computed from the models instead.
+/// @param active_layers The active layers.
+/// @param get_model Called with an object's index in the store, returns a reference to
+/// the object's model. Called from several threads at once.
+/// @param get_constants Called with an object's index in the store, returns the
+/// world_mesh_constants_slot for the object. Called from several threads at once.
+/// @param get_pipeline Called with a mesh's material_pipeline_flags, returns the
+/// gpu::pipeline_handle to draw it with. Called from several threads at once.
+/// @param thread_pool The thread pool to fill the chunks on.
+/// @param out_object_meshes Receives the index in the list of each object's first mesh
+/// and one more entry for the end of the last object's meshes. Objects in inactive layers
+/// have no meshes.
+template<typename Get_model, typename Get_constants, typename Get_pipeline>
+void add_world_mesh_list_objects(world_mesh_list& list, const world::object_store& objects,
+                                 const world::object_bbox_cache& object_bboxes,
+                                 const world::active_layers active_layers,
+                                 const Get_model& get_model,
+                                 const Get_constants& get_constants,
+                                 const Get_pipeline& get_pipeline,
+                                 async::thread_pool& thread_pool,
+                                 std::vector<uint32>& out_object_meshes)
+{
+   const std::span<const int> layers = objects.layers();
+   const std::span<const quaternion> rotations = objects.rotations();
+   const std::span<const float3> positions = objects.positions();
+
+   const bool use_cached_bboxes = object_bboxes.size() == objects.size();
+
+   std::vector<std::size_t> chunk_meshes(
+      (objects.size() + world_mesh_list_chunk_objects - 1) / world_mesh_list_chunk_objects);
+
+   thread_pool.for_each_n(
+      async::task_priority::normal, chunk_meshes.size(),
+      [&](const std::size_t chunk_index) noexcept {
+         const std::size_t begin = chunk_index * world_mesh_list_chunk_objects;
+         const std::size_t end =
+            std::min(begin + world_mesh_list_chunk_objects, objects.size());
+
+         for (std::size_t i = begin; i < end; ++i) {
+            if (not active_layers[layers[i]]) continue;
+
+            chunk_meshes[chunk_index] += get_model(i).parts.size();
+         }
+      });
+
+   // Turn the counts into the index of each chunk's first mesh.
+   std::size_t mesh_count = list.size();
+
+   for (std::size_t& meshes : chunk_meshes) {
+      mesh_count += std::exchange(meshes, mesh_count);
+   }
+
+   list.resize(mesh_count);
+   out_object_meshes.resize(objects.size() + 1);
+   out_object_meshes.back() = static_cast<uint32>(mesh_count);
+
+   thread_pool.for_each_n(
+      async::task_priority::normal, chunk_meshes.size(),
+      [&](const std::size_t chunk_index) noexcept {
+         const std::size_t begin = chunk_index * world_mesh_list_chunk_objects;
+         const std::size_t end =
+            std::min(begin + world_mesh_list_chunk_objects, objects.size());
+
+         std::size_t mesh_index = chunk_meshes[chunk_index];
+
+         for (std::size_t i = begin; i < end; ++i) {
+            out_object_meshes[i] = static_cast<uint32>(mesh_index);
+
+            if (not active_layers[layers[i]]) continue;
+
+            const auto& model = get_model(i);
+
+            mesh_index = detail::write_world_mesh_list_object(
+               list, mesh_index,
+               use_cached_bboxes ? object_bboxes[i] : rotations[i] * model.bbox + positions[i],
+               rotations[i], positions[i], model, get_constants(i), get_pipeline);
+         }
+      });
+}
+
+/// @brief What update_world_mesh_list had to do to bring a list up to date.
+enum class world_mesh_list_update {
+   /// @brief Nothing changed.
+   none,
+   /// @brief Some objects were rewritten in place, they're in
+   /// world_mesh_list_state::dirty_objects.
+   modified,
+   /// @brief The list was rebuilt and every object's constants written.
+   rebuilt
+};
+
+/// @brief What update_world_mesh_list keeps between frames to update a world mesh list in
+/// place.
+struct world_mesh_list_state {
+   /// @brief Index in the list of each object's first mesh, with one more entry for the
+   /// end of the last object's meshes.
+   std::vector<uint32> object_meshes;
+   /// @brief The objects rewritten by the last update if it returned
+   /// world_mesh_list_update::modified. Sorted and without duplicates.
+   std::vector<uint32> dirty_objects;
+
+   world::change_log<world::object>::cursor cursor;
+   world::active_layers active_layers;
+   uint64 object_classes_generation = 0;
+   uint64 models_generation = 0;
+
+   /// @brief Forget the list so the next update rebuilds it.
+   void clear() noexcept
+   {
+      object_meshes.clear();
+      dirty_objects.clear();
+      cursor = {};
+   }
+};
+
+/// @brief Bring a world mesh list up to date with the world. The list is kept between
+/// frames and driven by the world's object change log, objects changed by edits are
+/// rewritten in place and a frame without changes does no work. Inserting or removing
+/// objects, changing the active layers, classes or models, or an object gaining or losing
+/// meshes rebuilds the list.
+///
+/// An object's constants are always at the index of the object in the store so they stay
+/// put between frames. Meshes pushed onto the end of the list after an update (for an
+/// object being placed for instance) are dropped by the next update.
+///
+/// @param list The list.
+/// @param state The state kept for the list.
+/// @param world The world.
+/// @param objects The world's object store. Must be up to date with the world.
+/// @param object_bboxes The world's object bounding boxes.
+/// @param active_layers The active layers.
+/// @param object_classes_generation The object class library's generation.
+/// @param models_generation The generation of the models get_model returns.
+/// @param get_model See add_world_mesh_list_objects.
+/// @param get_constants See add_world_mesh_list_objects.
+/// @param get_pipeline See add_world_mesh_list_objects.
+/// @param thread_pool The thread pool to rebuild the list on.
+/// @return What was done to the list.
+template<typename Get_model, typename Get_constants, typename Get_pipeline>
+auto update_world_mesh_list(world_mesh_list& list, world_mesh_list_state& state,
+                            const world::world& world, const world::object_store& objects,
+                            const world::object_bbox_cache& object_bboxes,
+                            const world::active_layers active_layers,
+                            const uint64 object_classes_generation,
+                            const uint64 models_generation, const Get_model& get_model,
+                            const Get_constants& get_constants,
+                            const Get_pipeline& get_pipeline,
+                            async::thread_pool& thread_pool) -> world_mesh_list_update
+{
+   state.dirty_objects.clear();
+
+   const std::optional<std::span<const world::change_log<world::object>::change>> changes =
+      world.changes.objects.changes_since(state.cursor);
+
+   bool rebuild = not changes or state.object_meshes.size() != objects.size() + 1 or
+                  state.active_layers != active_layers or
+                  state.object_classes_generation != object_classes_generation or
+                  state.models_generation != models_generation;
+
+   if (not rebuild) {
+      list.resize(state.object_meshes.back());
+
+      const std::span<const int> layers = objects.layers();
+      const std::span<const quaternion> rotations = objects.rotations();
+      const std::span<const float3> positions = objects.positions();
+
+      const bool use_cached_bboxes = object_bboxes.size() == objects.size();
+
+      for (const auto& change : *changes) {
+         // Inserting or removing shifts every object after it, like object_bbox_cache
+         // the list is just rebuilt.
+         if (change.type != world::change_type::modify) {
+            rebuild = true;
+
+            break;
+         }
+
+         const world::object* object =
+            world::find_entity<world::object>(world, change.id);
+
+         if (not object) continue;
+
+         const std::size_t i = object - world.objects.data();
+         const auto& model = get_model(i);
+         const std::size_t mesh_count =
+            active_layers[layers[i]] ? model.parts.size() : std::size_t{0};
+
+         if (mesh_count != state.object_meshes[i + 1] - state.object_meshes[i]) {
+            rebuild = true;
+
+            break;
+         }
+
+         if (mesh_count == 0) continue;
+
+         detail::write_world_mesh_list_object(
+            list, state.object_meshes[i],
+            use_cached_bboxes ? object_bboxes[i] : rotations[i] * model.bbox + positions[i],
+            rotations[i], positions[i], model, get_constants(i), get_pipeline);
+
+         state.dirty_objects.push_back(static_cast<uint32>(i));
+      }
+   }
+
+   state.cursor = world.changes.objects.current();
+
+   if (rebuild) {
+      state.dirty_objects.clear();
+      state.active_layers = active_layers;
+      state.object_classes_generation = object_classes_generation;
+      state.models_generation = models_generation;
+
+      list.clear();
+
+      add_world_mesh_list_objects(list, objects, object_bboxes, active_layers, get_model,
+                                  get_constants, get_pipeline, thread_pool,
+                                  state.object_meshes);
+
+      return world_mesh_list_update::rebuilt;
+   }
+
+   if (state.dirty_objects.empty()) return world_mesh_list_update::none;
+
+   std::ranges::sort(state.dirty_objects);
+
+   const auto duplicates = std::ranges::unique(state.dirty_objects);
+
+   state.dirty_objects.erase(duplicates.begin(), duplicates.end());
+
+   return world_mesh_list_update::modified;
+}
+
+/// @brief Scratch memory for sorting render lists. Kept between frames so sorting doesn't
+/// allocate.
+struct world_mesh_sort_buffers {
+   std::vector<uint64> keys;
+   std::vector<uint64> scratch_keys;
+   std::vector<uint32> scratch_indices;
+};
+
+/// @brief Make the draw key for an opaque mesh. Sorting by it groups meshes by pipeline
+/// flags (and so by pipeline), then by material and then draws them front to back.
+/// @param flags The mesh's pipeline flags.
+/// @param material_constant_buffer The address of the mesh's material constants.
+/// @param depth The distance of the mesh from the near plane.
+[[nodiscard]] auto make_opaque_draw_key(const material_pipeline_flags flags,
+                                        const gpu_virtual_address material_constant_buffer,
+                                        const float depth) noexcept -> uint64;
+
+/// @brief Make the draw key for a transparent mesh. Sorting by it draws meshes back to
+/// front.
+/// @param depth The distance of the mesh from the near plane.
+[[nodiscard]] auto make_transparent_draw_key(const float depth) noexcept -> uint64;
+
+/// @brief Cull a world mesh list against a frustum and sort the visible meshes into draw
+/// order by their draw keys.
+/// @param view_frustum The frustum to cull against.
+/// @param meshes The world mesh list.
+/// @param sort_buffers Scratch memory for sorting.
+/// @param out_opaque_list Receives the indices of the visible opaque meshes.
+/// @param out_transparent_list Receives the indices of the visible transparent meshes.
+void build_world_mesh_render_lists(const frustum& view_frustum,
+                                   const world_mesh_list& meshes,
+                                   world_mesh_sort_buffers& sort_buffers,
+                                   std::vector<uint32>& out_opaque_list,
+                                   std::vector<uint32>& out_transparent_list) noexcept;
+
+/// @brief Cull a world mesh list against a frustum using its BVH and sort the visible
+/// meshes into draw order by their draw keys.
+/// @param view_frustum The frustum to cull against.
+/// @param meshes The world mesh list.
+/// @param meshes_bvh The BVH of the world mesh list. Must be up to date with the list.
+/// @param sort_buffers Scratch memory for sorting.
+/// @param out_opaque_list Receives the indices of the visible opaque meshes.
+/// @param out_transparent_list Receives the indices of the visible transparent meshes.
+void build_world_mesh_render_lists(const frustum& view_frustum,
+                                   const world_mesh_list& meshes,
+                                   const world_mesh_bvh& meshes_bvh,
+                                   world_mesh_sort_buffers& sort_buffers,
+                                   std::vector<uint32>& out_opaque_list,
+                                   std::vector<uint32>& out_transparent_list) noexcept;
+
+}
@@ -43,6 +43,8 @@ struct graphics {
 
    float planning_connection_height = 48.0f;
 
+   float meta_draw_distance = 2048.0f;
+
    float line_width = 2.5f;
 
    bool show_profiler = false;
@@ -91,6 +91,7 @@ auto load(const std::string_view path) -> settings
             setting_entry(boundary_height);
             setting_entry(planning_hub_height);
             setting_entry(planning_connection_height);
+            setting_entry(meta_draw_distance);
             setting_entry(line_width);
          }
 #undef setting_entry
@@ -131,6 +132,7 @@ auto load(const std::string_view path) -> settings
    }
          for (auto& prop : node) {
             setting_entry(text_editor);
+            setting_entry(edit_history_budget_mb);
          }
 #undef setting_entry
       }
@@ -170,6 +172,7 @@ void save(const std::string_view path, const settings& settings) noexcept
       write(file, name_value(boundary_height));
       write(file, name_value(planning_hub_height));
       write(file, name_value(planning_connection_height));
+      write(file, name_value(meta_draw_distance));
       write(file, name_value(line_width));
 
 #undef name_value
@@ -210,6 +213,7 @@ void save(const std::string_view path, const settings& settings) noexcept
 #define name_value(prop) #prop, settings.preferences.prop
 
       write(file, name_value(text_editor));
+      write(file, name_value(edit_history_budget_mb));
 
 #undef name_value
 
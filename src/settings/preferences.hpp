@@ -10,6 +10,8 @@ struct preferences {
    static std::string default_text_editor;
 
    std::string text_editor = default_text_editor;
+
+   float edit_history_budget_mb = 512.0f;
 };
 
 }
\ No newline at end of file
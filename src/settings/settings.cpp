@@ -8,7 +8,8 @@
 
 namespace we::settings {
 
-void show_imgui_editor(settings& settings, bool& open, float display_scale) noexcept
+void show_imgui_editor(settings& settings, bool& open, float display_scale,
+                       std::size_t edit_history_memory_use) noexcept
 {
    ImGui::SetNextWindowPos({ImGui::GetIO().DisplaySize.x / 2.0f,
                             ImGui::GetIO().DisplaySize.y / 2.0f},
@@ -33,6 +34,20 @@ void show_imgui_editor(settings& settings, bool& open, float display_scale) noex
                                  "not contain quotes (\").");
             }
 
+            ImGui::DragFloat("Undo History Budget", &preferences.edit_history_budget_mb,
+                             1.0f, 16.0f, 65536.0f, "%.0f MB", ImGuiSliderFlags_AlwaysClamp);
+
+            if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) {
+               ImGui::SetTooltip("The amount of memory the undo history can use. When "
+                                 "it's full the oldest edits are forgotten to make "
+                                 "room for new ones.");
+            }
+
+            ImGui::SameLine();
+            ImGui::TextDisabled("%.1f MB used",
+                                static_cast<double>(edit_history_memory_use) /
+                                   (1024.0 * 1024.0));
+
             constexpr static std::array extra_scaling_factors{0.5f, 0.75f,
                                                               1.0f, 1.25f,
                                                               1.5f, 1.75f,
@@ -126,6 +141,11 @@ void show_imgui_editor(settings& settings, bool& open, float display_scale) noex
                              &graphics.planning_connection_height, 0.5f, 0.0f,
                              100000.0f, "%.3f", ImGuiSliderFlags_AlwaysClamp);
 
+            ImGui::SeparatorText("Draw Distance");
+
+            ImGui::DragFloat("Meta Draw Distance", &graphics.meta_draw_distance, 8.0f,
+                             64.0f, 100000.0f, "%.0f", ImGuiSliderFlags_AlwaysClamp);
+
             ImGui::SeparatorText("Line Width");
 
             if (ImGui::SliderFloat("Line Width", &graphics.line_width, 0.5f,
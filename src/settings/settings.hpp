@@ -5,6 +5,8 @@
 #include "preferences.hpp"
 #include "ui.hpp"
 
+#include <cstddef>
+
 namespace we::settings {
 
 struct settings {
@@ -14,6 +16,13 @@ struct settings {
    preferences preferences;
 };
 
-void show_imgui_editor(settings& settings, bool& open, float display_scale) noexcept;
+/// @brief Show the settings editor window.
+/// @param settings The settings to edit.
+/// @param open Set to false when the window is closed.
+/// @param display_scale The UI display scale.
+/// @param edit_history_memory_use The memory the undo history is using, in bytes. Shown
+/// next to its budget.
+void show_imgui_editor(settings& settings, bool& open, float display_scale,
+                       std::size_t edit_history_memory_use) noexcept;
 
 }
@@ -0,0 +1,69 @@
+#include "name_table.hpp"
+
+#include <deque>
+#include <shared_mutex>
+
+#include <absl/container/flat_hash_map.h>
+
+namespace we {
+
+namespace {
+
+struct name_table {
+   std::shared_mutex mutex;
+
+   // A deque so references to names stay valid as the table grows.
+   std::deque<lowercase_string> names;
+   absl::flat_hash_map<lowercase_string, name_handle> handles;
+};
+
+auto get_name_table() noexcept -> name_table&
+{
+   static name_table table;
+
+   return table;
+}
+
+}
+
+auto intern_name(const lowercase_string& name) noexcept -> name_handle
+{
+   name_table& table = get_name_table();
+
+   {
+      std::shared_lock lock{table.mutex};
+
+      if (auto it = table.handles.find(name); it != table.handles.end()) {
+         return it->second;
+      }
+   }
+
+   std::scoped_lock lock{table.mutex};
+
+   const auto [it, inserted] =
+      table.handles.try_emplace(name, static_cast<name_handle>(table.names.size()));
+
+   if (inserted) table.names.push_back(name);
+
+   return it->second;
+}
+
+auto get_name(const name_handle handle) noexcept -> const lowercase_string&
+{
+   name_table& table = get_name_table();
+
+   std::shared_lock lock{table.mutex};
+
+   return table.names[static_cast<std::size_t>(handle)];
+}
+
+auto name_table_size() noexcept -> std::size_t
+{
+   name_table& table = get_name_table();
+
+   std::shared_lock lock{table.mutex};
+
+   return table.names.size();
+}
+
+}
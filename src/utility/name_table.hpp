@@ -0,0 +1,28 @@
+#pragma once
+
+#include "lowercase_string.hpp"
+#include "types.hpp"
+
+namespace we {
+
+/// @brief Handle to a name in the global name table. Two handles are equal when their
+/// names are equal, so handles can be compared and used to index arrays instead of
+/// hashing the names.
+enum class name_handle : uint32 {};
+
+/// @brief Intern a name in the global name table. Safe to call from any thread.
+/// @param name The name.
+/// @return The handle for the name.
+[[nodiscard]] auto intern_name(const lowercase_string& name) noexcept -> name_handle;
+
+/// @brief Get the name for a handle. Safe to call from any thread.
+/// @param handle The handle.
+/// @return The name. Names are never removed from the table so the reference stays valid
+/// for the life of the program.
+[[nodiscard]] auto get_name(const name_handle handle) noexcept -> const lowercase_string&;
+
+/// @brief Get the number of names in the table. Every handle is less than this so it can
+/// be used to size arrays indexed by handle.
+[[nodiscard]] auto name_table_size() noexcept -> std::size_t;
+
+}
@@ -0,0 +1,76 @@
+#include "radix_sort.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <utility>
+
+namespace we::utility {
+
+namespace {
+
+constexpr std::size_t digit_bits = 8;
+constexpr std::size_t digit_count = 64 / digit_bits;
+constexpr std::size_t bucket_count = 1 << digit_bits;
+
+auto get_digit(const uint64 key, const std::size_t digit) noexcept -> std::size_t
+{
+   return (key >> (digit * digit_bits)) & (bucket_count - 1);
+}
+
+}
+
+void radix_sort(std::span<uint64> keys, std::span<uint32> values,
+                std::vector<uint64>& scratch_keys,
+                std::vector<uint32>& scratch_values) noexcept
+{
+   assert(keys.size() == values.size());
+
+   if (keys.size() < 2) return;
+
+   scratch_keys.resize(keys.size());
+   scratch_values.resize(values.size());
+
+   // Counting every digit up front costs one pass over the keys instead of one per digit.
+   std::array<std::array<uint32, bucket_count>, digit_count> counts{};
+
+   for (const uint64 key : keys) {
+      for (std::size_t digit = 0; digit < digit_count; ++digit) {
+         counts[digit][get_digit(key, digit)] += 1;
+      }
+   }
+
+   std::span<uint64> source_keys = keys;
+   std::span<uint32> source_values = values;
+   std::span<uint64> destination_keys = scratch_keys;
+   std::span<uint32> destination_values = scratch_values;
+
+   for (std::size_t digit = 0; digit < digit_count; ++digit) {
+      std::array<uint32, bucket_count>& offsets = counts[digit];
+
+      if (offsets[get_digit(source_keys[0], digit)] == keys.size()) continue;
+
+      uint32 offset = 0;
+
+      for (uint32& bucket : offsets) {
+         offset += std::exchange(bucket, offset);
+      }
+
+      for (std::size_t i = 0; i < source_keys.size(); ++i) {
+         const uint32 destination = offsets[get_digit(source_keys[i], digit)]++;
+
+         destination_keys[destination] = source_keys[i];
+         destination_values[destination] = source_values[i];
+      }
+
+      std::swap(source_keys, destination_keys);
+      std::swap(source_values, destination_values);
+   }
+
+   if (source_keys.data() != keys.data()) {
+      std::ranges::copy(source_keys, keys.begin());
+      std::ranges::copy(source_values, values.begin());
+   }
+}
+
+}
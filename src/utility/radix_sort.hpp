@@ -0,0 +1,22 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <span>
+#include <vector>
+
+namespace we::utility {
+
+/// @brief Sort values by their keys with a least significant digit radix sort. The sort
+/// is stable and takes eight passes over the keys at most. Passes for digits that are
+/// the same in every key are skipped.
+/// @param keys The keys. Sorted in place.
+/// @param values The values to reorder along with their keys.
+/// @param scratch_keys Scratch space for the keys. Resized as needed, pass the same vector
+/// between calls to avoid reallocating it.
+/// @param scratch_values Scratch space for the values. Resized as needed.
+void radix_sort(std::span<uint64> keys, std::span<uint32> values,
+                std::vector<uint64>& scratch_keys,
+                std::vector<uint32>& scratch_values) noexcept;
+
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "id.hpp"
+#include "types.hpp"
+
+#include <atomic>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace we::world {
+
+enum class change_type : uint8 { insert, remove, modify };
+
+/// @brief Records the changes edits make to a type of entity. Lets caches derived from
+/// the world (spatial indices, bounds, etc) update only what changed instead of
+/// rescanning every entity each frame.
+///
+/// Readers hold on to a cursor and pass it to changes_since. The log only keeps a
+/// bounded number of changes, if a reader falls too far behind or the log is reset
+/// changes_since returns nullopt and the reader should rebuild from scratch.
+template<typename T>
+class change_log {
+public:
+   struct change {
+      id<T> id;
+      change_type type;
+      /// @brief For inserts and removes the index in the entity vector the entity was
+      /// inserted at or removed from. Entities before it didn't move.
+      uint32 index = 0;
+   };
+
+   struct cursor {
+      uint64 epoch = 0;
+      uint64 position = 0;
+
+      bool operator==(const cursor&) const noexcept = default;
+   };
+
+   /// @brief The max number of changes to keep. When exceeded the oldest half are dropped.
+   constexpr static std::size_t max_changes = 65536;
+
+   change_log() = default;
+
+   change_log(const change_log&) noexcept : _epoch{make_epoch()} {}
+
+   change_log(change_log&&) noexcept = default;
+
+   /// @brief Copies get a new epoch as they can then be changed independently.
+   auto operator=(const change_log& other) noexcept -> change_log&
+   {
+      if (this == &other) return *this;
+
+      reset();
+
+      return *this;
+   }
+
+   auto operator=(change_log&&) noexcept -> change_log& = default;
+
+   ~change_log() = default;
+
+   /// @brief Record a change to an entity.
+   /// @param id The ID of the entity.
+   /// @param type The type of the change.
+   /// @param index For inserts and removes the index the entity was inserted at or
+   /// removed from. Unused for modifications.
+   void record(const id<T> id, const change_type type,
+               const std::size_t index = 0) noexcept
+   {
+      if (_changes.size() == max_changes) {
+         _changes.erase(_changes.begin(), _changes.begin() + max_changes / 2);
+         _base += max_changes / 2;
+      }
+
+      _changes.push_back(
+         {.id = id, .type = type, .index = static_cast<uint32>(index)});
+   }
+
+   /// @brief Discard all changes and invalidate all cursors. For when entities are changed
+   /// wholesale and readers should rebuild.
+   void reset() noexcept
+   {
+      _changes.clear();
+      _base = 0;
+      _epoch = make_epoch();
+   }
+
+   /// @brief Get a cursor to the current end of the log.
+   [[nodiscard]] auto current() const noexcept -> cursor
+   {
+      return {.epoch = _epoch, .position = _base + _changes.size()};
+   }
+
+   /// @brief Get the changes recorded since a cursor was taken.
+   /// @param cursor The cursor.
+   /// @return The changes or nullopt if they're no longer available.
+   [[nodiscard]] auto changes_since(const cursor cursor) const noexcept
+      -> std::optional<std::span<const change>>
+   {
+      if (cursor.epoch != _epoch) return std::nullopt;
+      if (cursor.position < _base) return std::nullopt;
+      if (cursor.position > _base + _changes.size()) return std::nullopt;
+
+      return std::span{_changes}.subspan(cursor.position - _base);
+   }
+
+private:
+   static auto make_epoch() noexcept -> uint64
+   {
+      static std::atomic_uint64_t next_epoch = 1;
+
+      return next_epoch.fetch_add(1, std::memory_order_relaxed);
+   }
+
+   std::vector<change> _changes;
+   uint64 _base = 0;
+   uint64 _epoch = make_epoch();
+};
+
+}
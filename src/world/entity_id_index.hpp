@@ -0,0 +1,112 @@
+#pragma once
+
+#include "id.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace we::world {
+
+/// @brief Maps the IDs of a type of entity to their index in the world's vector of
+/// them. Kept up to date by edits so entities can be found without relying on the
+/// vector being sorted by ID or searching it.
+///
+/// IDs are handed out in sequence by id_generator so the table is just a vector indexed
+/// by ID. Lookups check the entity at the stored index has the ID and fall back to
+/// searching the entities when it doesn't. An ID missing from an index that holds as
+/// many entities as there are is taken to not exist without searching. So the index
+/// must be kept up to date as entities are added, removed or given new IDs, worlds
+/// built by hand should call rebuild_id_indices.
+template<typename T>
+class entity_id_index {
+public:
+   /// @brief IDs at or above this are left out of the index to keep its size bounded.
+   /// Lookups for them search the entities.
+   constexpr static uint32 max_indexed_id = 1u << 24u;
+
+   /// @brief Update the stored indices of entities. Call after inserting or removing
+   /// entities from the vector.
+   /// @param entities The entities.
+   /// @param first The index of the first entity that may have moved. Entities before
+   /// it must still be at their stored indices.
+   void update(std::span<const T> entities, const std::size_t first = 0) noexcept
+   {
+      for (std::size_t i = first; i < entities.size(); ++i) {
+         const uint32 id_value = static_cast<uint32>(entities[i].id);
+
+         if (id_value >= max_indexed_id) continue;
+
+         if (id_value >= _indices.size()) _indices.resize(id_value + 1, invalid_index);
+
+         if (_indices[id_value] == invalid_index) _size += 1;
+
+         _indices[id_value] = static_cast<uint32>(i);
+      }
+   }
+
+   /// @brief Remove an entity from the index. Does nothing if it isn't in the index.
+   /// @param id The ID of the entity.
+   void erase(const id<T> id) noexcept
+   {
+      const uint32 id_value = static_cast<uint32>(id);
+
+      if (id_value >= _indices.size()) return;
+      if (_indices[id_value] == invalid_index) return;
+
+      _indices[id_value] = invalid_index;
+      _size -= 1;
+   }
+
+   /// @brief Find the index of an entity.
+   /// @param entities The entities the index is for.
+   /// @param id The ID of the entity.
+   /// @return The index of the entity in entities or nullopt.
+   [[nodiscard]] auto find(std::span<const T> entities, const id<T> id) const noexcept
+      -> std::optional<std::size_t>
+   {
+      const uint32 id_value = static_cast<uint32>(id);
+
+      if (id_value < _indices.size() and _indices[id_value] != invalid_index) {
+         const uint32 index = _indices[id_value];
+
+         if (index < entities.size() and entities[index].id == id) return index;
+      }
+      else if (id_value < max_indexed_id and _size == entities.size()) {
+         // The index covers every entity, so an ID missing from it isn't in entities.
+         return std::nullopt;
+      }
+
+      if (auto it = std::find_if(entities.begin(), entities.end(),
+                                 [id](const T& entity) { return entity.id == id; });
+          it != entities.end()) {
+         return static_cast<std::size_t>(it - entities.begin());
+      }
+
+      return std::nullopt;
+   }
+
+   /// @brief The number of entities in the index.
+   [[nodiscard]] auto size() const noexcept -> std::size_t
+   {
+      return _size;
+   }
+
+   /// @brief Remove all entities from the index.
+   void clear() noexcept
+   {
+      _indices.clear();
+      _size = 0;
+   }
+
+private:
+   constexpr static uint32 invalid_index = std::numeric_limits<uint32>::max();
+
+   std::vector<uint32> _indices;
+   std::size_t _size = 0;
+};
+
+}
@@ -0,0 +1,201 @@
+#pragma once
+
+#include "id.hpp"
+#include "types.hpp"
+#include "utility/string_ops.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/inlined_vector.h>
+
+namespace we::world {
+
+/// @brief Maps the names of a type of entity to their IDs. Kept up to date by edits so
+/// entities can be looked up by name without scanning every entity.
+///
+/// Also tracks the lowest free numeric suffix for names ending in digits (Object0,
+/// Object1, etc) so unique names can be generated without searching for a free one.
+template<typename T>
+class entity_name_index {
+public:
+   /// @brief Add an entity to the index.
+   /// @param name The name of the entity.
+   /// @param id The ID of the entity.
+   void insert(const std::string_view name, const id<T> id) noexcept
+   {
+      auto& ids = _entities[name];
+
+      if (auto it = std::lower_bound(ids.begin(), ids.end(), id);
+          it == ids.end() or *it != id) {
+         ids.insert(it, id);
+
+         _size += 1;
+      }
+
+      if (ids.size() > 1) return;
+
+      const std::optional<suffixed_name> suffixed = split_suffix(name);
+
+      if (not suffixed) return;
+
+      auto free_suffix = _free_suffixes.find(suffixed->base);
+
+      if (free_suffix == _free_suffixes.end()) {
+         if (suffixed->suffix != 0) return;
+
+         free_suffix = _free_suffixes.emplace(suffixed->base, 0).first;
+      }
+
+      if (free_suffix->second != suffixed->suffix) return;
+
+      std::string candidate_name;
+
+      do {
+         free_suffix->second += 1;
+
+         candidate_name = suffixed->base;
+         candidate_name += std::to_string(free_suffix->second);
+      } while (_entities.contains(candidate_name));
+   }
+
+   /// @brief Remove an entity from the index. Does nothing if it isn't in the index.
+   /// @param name The name of the entity.
+   /// @param id The ID of the entity.
+   void erase(const std::string_view name, const id<T> id) noexcept
+   {
+      auto entry = _entities.find(name);
+
+      if (entry == _entities.end()) return;
+
+      auto& ids = entry->second;
+
+      auto it = std::lower_bound(ids.begin(), ids.end(), id);
+
+      if (it == ids.end() or *it != id) return;
+
+      ids.erase(it);
+
+      _size -= 1;
+
+      if (not ids.empty()) return;
+
+      _entities.erase(entry);
+
+      const std::optional<suffixed_name> suffixed = split_suffix(name);
+
+      if (not suffixed) return;
+
+      if (auto free_suffix = _free_suffixes.find(suffixed->base);
+          free_suffix != _free_suffixes.end() and suffixed->suffix < free_suffix->second) {
+         free_suffix->second = suffixed->suffix;
+      }
+   }
+
+   /// @brief Move an entity in the index to a new name.
+   /// @param old_name The current name of the entity.
+   /// @param new_name The new name of the entity.
+   /// @param id The ID of the entity.
+   void rename(const std::string_view old_name, const std::string_view new_name,
+               const id<T> id) noexcept
+   {
+      if (old_name == new_name) return;
+
+      erase(old_name, id);
+      insert(new_name, id);
+   }
+
+   /// @brief Find the entities with a name.
+   /// @param name The name to find.
+   /// @return The IDs of the entities with the name, sorted by ID. Empty if there are none.
+   [[nodiscard]] auto find(const std::string_view name) const noexcept
+      -> std::span<const id<T>>
+   {
+      auto entry = _entities.find(name);
+
+      if (entry == _entities.end()) return {};
+
+      return {entry->second.data(), entry->second.size()};
+   }
+
+   /// @brief Check if an entity has a name.
+   /// @param name The name to check for.
+   [[nodiscard]] bool contains(const std::string_view name) const noexcept
+   {
+      return _entities.contains(name);
+   }
+
+   /// @brief Check if a specific entity is in the index under a name.
+   /// @param name The name to check for.
+   /// @param id The ID of the entity.
+   [[nodiscard]] bool contains(const std::string_view name, const id<T> id) const noexcept
+   {
+      auto entry = _entities.find(name);
+
+      if (entry == _entities.end()) return false;
+
+      return std::binary_search(entry->second.begin(), entry->second.end(), id);
+   }
+
+   /// @brief Get a suffix that can be appended to a base name to make a name not in the
+   /// index. The returned suffix is the lowest such suffix.
+   /// @param base_name The base name, this should not end in digits.
+   [[nodiscard]] auto free_suffix(const std::string_view base_name) const noexcept
+      -> uint32
+   {
+      auto free_suffix = _free_suffixes.find(base_name);
+
+      if (free_suffix == _free_suffixes.end()) return 0;
+
+      return free_suffix->second;
+   }
+
+   /// @brief The number of entities in the index.
+   [[nodiscard]] auto size() const noexcept -> std::size_t
+   {
+      return _size;
+   }
+
+   /// @brief Remove all entities from the index.
+   void clear() noexcept
+   {
+      _entities.clear();
+      _free_suffixes.clear();
+      _size = 0;
+   }
+
+private:
+   struct suffixed_name {
+      std::string_view base;
+      uint32 suffix = 0;
+   };
+
+   /// @brief Split a name into its base and numeric suffix. Names with suffixes that
+   /// wouldn't be generated for the base (leading zeros, too large, etc) return nullopt.
+   static auto split_suffix(const std::string_view name) noexcept
+      -> std::optional<suffixed_name>
+   {
+      const std::string_view base = string::trim_trailing_digits(name);
+      const std::string_view digits = name.substr(base.size());
+
+      if (digits.empty() or digits.size() > 9) return std::nullopt;
+      if (digits.size() > 1 and digits[0] == '0') return std::nullopt;
+
+      uint32 suffix = 0;
+
+      std::from_chars(digits.data(), digits.data() + digits.size(), suffix);
+
+      return suffixed_name{.base = base, .suffix = suffix};
+   }
+
+   absl::flat_hash_map<std::string, absl::InlinedVector<id<T>, 1>> _entities;
+   absl::flat_hash_map<std::string, uint32> _free_suffixes;
+   std::size_t _size = 0;
+};
+
+}
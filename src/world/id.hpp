@@ -41,6 +41,16 @@ public:
       return id_type{_next_id++};
    }
 
+   /// @brief Make sure IDs aquired from now on are after an ID. For when an entity keeps an
+   /// ID it was given by another generator, such as one replayed from an edit journal.
+   /// @param id The ID to skip past.
+   void skip_past(const id_type id) noexcept
+   {
+      const uint32 id_value = static_cast<uint32>(id);
+
+      if (id_value >= _next_id and id_value != 0xffffffffu) _next_id = id_value + 1;
+   }
+
 private:
    uint32 _next_id = 0;
 };
@@ -0,0 +1,137 @@
+#include "object_bbox_cache.hpp"
+#include "object_class.hpp"
+#include "object_class_library.hpp"
+#include "utility/world_utilities.hpp"
+#include "world.hpp"
+
+namespace we::world {
+
+namespace {
+
+auto get_object_bbox(const object& object, const object_class_library& object_classes) noexcept
+   -> math::bounding_box
+{
+   return object.rotation * object_classes[object.class_name].model->bounding_box +
+          object.position;
+}
+
+}
+
+void object_bbox_cache::update(const world& world,
+                               const object_class_library& object_classes) noexcept
+{
+   const std::optional<std::span<const change_log<object>::change>> changes =
+      world.changes.objects.changes_since(_cursor);
+
+   if (not changes or object_classes.generation() != _object_classes_generation or
+       size() != world.objects.size()) {
+      rebuild(world, object_classes);
+
+      return;
+   }
+
+   for (const auto& change : *changes) {
+      // Inserting or removing shifts the index of every object after it, rebuilding
+      // is simpler than shuffling the arrays and just as quick.
+      if (change.type != change_type::modify) {
+         rebuild(world, object_classes);
+
+         return;
+      }
+   }
+
+   for (const auto& change : *changes) {
+      const std::optional<std::size_t> index = find_entity_index<object>(world, change.id);
+
+      if (not index) continue;
+
+      store(*index, get_object_bbox(world.objects[*index], object_classes));
+   }
+
+   _cursor = world.changes.objects.current();
+}
+
+void object_bbox_cache::clear() noexcept
+{
+   _min_x.clear();
+   _min_y.clear();
+   _min_z.clear();
+   _max_x.clear();
+   _max_y.clear();
+   _max_z.clear();
+   _cursor = {};
+}
+
+auto object_bbox_cache::size() const noexcept -> std::size_t
+{
+   return _min_x.size();
+}
+
+auto object_bbox_cache::operator[](const std::size_t index) const noexcept
+   -> math::bounding_box
+{
+   return {.min = {_min_x[index], _min_y[index], _min_z[index]},
+           .max = {_max_x[index], _max_y[index], _max_z[index]}};
+}
+
+auto object_bbox_cache::min_x() const noexcept -> std::span<const float>
+{
+   return _min_x;
+}
+
+auto object_bbox_cache::min_y() const noexcept -> std::span<const float>
+{
+   return _min_y;
+}
+
+auto object_bbox_cache::min_z() const noexcept -> std::span<const float>
+{
+   return _min_z;
+}
+
+auto object_bbox_cache::max_x() const noexcept -> std::span<const float>
+{
+   return _max_x;
+}
+
+auto object_bbox_cache::max_y() const noexcept -> std::span<const float>
+{
+   return _max_y;
+}
+
+auto object_bbox_cache::max_z() const noexcept -> std::span<const float>
+{
+   return _max_z;
+}
+
+void object_bbox_cache::rebuild(const world& world,
+                                const object_class_library& object_classes) noexcept
+{
+   const std::size_t count = world.objects.size();
+
+   _min_x.resize(count);
+   _min_y.resize(count);
+   _min_z.resize(count);
+   _max_x.resize(count);
+   _max_y.resize(count);
+   _max_z.resize(count);
+
+   for (std::size_t i = 0; i < count; ++i) {
+      store(i, get_object_bbox(world.objects[i], object_classes));
+   }
+
+   _cursor = world.changes.objects.current();
+   _object_classes_generation = object_classes.generation();
+}
+
+void object_bbox_cache::store(const std::size_t index, const math::bounding_box& bbox) noexcept
+{
+   _min_x[index] = bbox.min.x;
+   _min_y[index] = bbox.min.y;
+   _min_z[index] = bbox.min.z;
+   _max_x[index] = bbox.max.x;
+   _max_y[index] = bbox.max.y;
+   _max_z[index] = bbox.max.z;
+}
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "change_log.hpp"
+#include "math/bounding_box.hpp"
+#include "types.hpp"
+
+#include <span>
+#include <vector>
+
+namespace we::world {
+
+struct object;
+struct object_class_library;
+struct world;
+
+/// @brief Cache of the world space bounding boxes of a world's objects. Stored as
+/// structure of arrays in the same order as world::objects so loops over the bounds can
+/// stay in cache and be vectorized.
+///
+/// Kept current from the world's object change log. Objects changed by edits have their
+/// bounds recomputed, objects being inserted or removed or object classes changing
+/// rebuilds the cache.
+class object_bbox_cache {
+public:
+   /// @brief Bring the cache up to date with the world.
+   /// @param world The world.
+   /// @param object_classes The object class library for the world.
+   void update(const world& world, const object_class_library& object_classes) noexcept;
+
+   /// @brief Empty the cache.
+   void clear() noexcept;
+
+   /// @brief Get the number of objects in the cache. After an update this is the same as
+   /// the number of objects in the world.
+   [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+   /// @brief Get the bounding box of an object.
+   /// @param index The index of the object in world::objects.
+   [[nodiscard]] auto operator[](const std::size_t index) const noexcept
+      -> math::bounding_box;
+
+   [[nodiscard]] auto min_x() const noexcept -> std::span<const float>;
+
+   [[nodiscard]] auto min_y() const noexcept -> std::span<const float>;
+
+   [[nodiscard]] auto min_z() const noexcept -> std::span<const float>;
+
+   [[nodiscard]] auto max_x() const noexcept -> std::span<const float>;
+
+   [[nodiscard]] auto max_y() const noexcept -> std::span<const float>;
+
+   [[nodiscard]] auto max_z() const noexcept -> std::span<const float>;
+
+private:
+   void rebuild(const world& world, const object_class_library& object_classes) noexcept;
+
+   void store(const std::size_t index, const math::bounding_box& bbox) noexcept;
+
+   std::vector<float> _min_x;
+   std::vector<float> _min_y;
+   std::vector<float> _min_z;
+   std::vector<float> _max_x;
+   std::vector<float> _max_y;
+   std::vector<float> _max_z;
+
+   change_log<object>::cursor _cursor;
+   uint64 _object_classes_generation = 0;
+};
+
+}
@@ -33,7 +33,9 @@ struct object_class {
 
    std::vector<instance_property> instance_properties;
 
-   int32 world_frame_references = 1;
+   /// @brief The number of objects in the world (and the entity being created) using the
+   /// class. Maintained by object_class_library.
+   int32 world_references = 0;
 
    /// @brief Update the object class from a definition asset.
    /// @param assets_libraries A reference to the assets::libraries_manager to pull model assets from.
@@ -2,10 +2,14 @@
 #include "assets/asset_libraries.hpp"
 #include "object.hpp"
 #include "object_class.hpp"
+#include "utility/world_utilities.hpp"
+#include "world.hpp"
 
+#include <optional>
 #include <shared_mutex>
 
 #include <absl/container/flat_hash_map.h>
+#include <absl/container/node_hash_map.h>
 
 using namespace std::string_literals;
 
@@ -24,27 +28,19 @@ struct object_class_library::impl {
    impl(const impl&) noexcept = delete;
    auto operator=(const impl&) noexcept -> impl& = delete;
 
-   void update(std::span<std::span<const object>> object_spans) noexcept
+   void update(const world& world, const object* creation_object) noexcept
    {
-      for (auto& [name, object_class] : _object_classes) {
-         object_class.world_frame_references = 0;
-      }
+      update_references(world);
 
-      for (const auto& span : object_spans) {
-         for (const auto& object : span) {
-            if (auto class_it = _object_classes.find(object.class_name);
-                class_it != _object_classes.end()) {
-               auto& [name, object_class] = *class_it;
+      const std::optional<name_handle> creation_class =
+         creation_object ? std::optional{intern_name(creation_object->class_name)}
+                         : std::nullopt;
 
-               object_class.world_frame_references += 1;
-            }
-            else {
-               auto definition = _asset_libraries.odfs[object.class_name];
+      if (creation_class != _creation_class) {
+         if (_creation_class) remove_reference(*_creation_class);
+         if (creation_class) add_reference(*creation_class);
 
-               _object_classes.emplace(object.class_name,
-                                       world::object_class{_asset_libraries, definition});
-            }
-         }
+         _creation_class = creation_class;
       }
 
       {
@@ -67,16 +63,31 @@ struct object_class_library::impl {
          _model_load_queue.clear();
       }
 
-      absl::erase_if(_object_classes, [](const auto& name_object_class) {
-         auto& [name, object_class] = name_object_class;
+      // Classes are erased at the end of the update so an object being deleted and
+      // restored (or a class being swapped back and forth) doesn't reload the class.
+      for (const name_handle name : _unreferenced_classes) {
+         auto it = _object_classes.find(get_name(name));
+
+         if (it == _object_classes.end() or it->second.world_references != 0) continue;
 
-         return object_class.world_frame_references == 0;
-      });
+         remove_model_dependent(it->second);
+         set_handle_class(name, nullptr);
+
+         _object_classes.erase(it);
+      }
+
+      _unreferenced_classes.clear();
    }
 
    void clear() noexcept
    {
       _object_classes.clear();
+      _object_classes_by_handle.clear();
+      _model_dependents.clear();
+      _object_class_names.clear();
+      _unreferenced_classes.clear();
+      _creation_class = std::nullopt;
+      _cursor = {};
    }
 
    auto operator[](const lowercase_string& name) const noexcept -> const object_class&
@@ -86,6 +97,22 @@ struct object_class_library::impl {
       return it != _object_classes.end() ? it->second : _default_object_class;
    }
 
+   auto operator[](const name_handle name) const noexcept -> const object_class&
+   {
+      const std::size_t index = static_cast<std::size_t>(name);
+
+      if (index < _object_classes_by_handle.size() and _object_classes_by_handle[index]) {
+         return *_object_classes_by_handle[index];
+      }
+
+      return _default_object_class;
+   }
+
+   auto generation() const noexcept -> uint64
+   {
+      return _generation;
+   }
+
 private:
    struct loaded_definition {
       lowercase_string name;
@@ -99,25 +126,190 @@ private:
       asset_data<assets::msh::flat_model> data;
    };
 
+   /// @brief Adjust reference counts for the objects changed since the last update. Only
+   /// recounts every object when the change log can't say what changed.
+   void update_references(const world& world) noexcept
+   {
+      const std::optional<std::span<const change_log<object>::change>> changes =
+         world.changes.objects.changes_since(_cursor);
+
+      _cursor = world.changes.objects.current();
+
+      if (not changes) {
+         recount_references(world);
+
+         return;
+      }
+
+      for (const auto& change : *changes) {
+         const std::optional<std::size_t> index = find_entity_index<object>(world, change.id);
+         const object* object = index ? &world.objects[*index] : nullptr;
+         auto tracked = _object_class_names.find(change.id);
+
+         if (tracked != _object_class_names.end()) {
+            // The object was removed or its class changed.
+            if (object and intern_name(object->class_name) == tracked->second) continue;
+
+            remove_reference(tracked->second);
+
+            if (object) {
+               tracked->second = intern_name(object->class_name);
+
+               add_reference(tracked->second);
+            }
+            else {
+               _object_class_names.erase(tracked);
+            }
+         }
+         else if (object) {
+            const name_handle class_name = intern_name(object->class_name);
+
+            _object_class_names.emplace(change.id, class_name);
+
+            add_reference(class_name);
+         }
+      }
+
+      // Something changed objects without recording it, the counts can't be trusted.
+      if (_object_class_names.size() != world.objects.size()) recount_references(world);
+   }
+
+   void recount_references(const world& world) noexcept
+   {
+      for (auto& [name, object_class] : _object_classes) {
+         object_class.world_references = 0;
+
+         _unreferenced_classes.push_back(intern_name(name));
+      }
+
+      _object_class_names.clear();
+      _object_class_names.reserve(world.objects.size());
+
+      for (const object& object : world.objects) {
+         const name_handle class_name = intern_name(object.class_name);
+
+         _object_class_names.emplace(object.id, class_name);
+
+         add_reference(class_name);
+      }
+
+      if (_creation_class) add_reference(*_creation_class);
+   }
+
+   void add_reference(const name_handle name) noexcept
+   {
+      const std::size_t index = static_cast<std::size_t>(name);
+
+      if (index < _object_classes_by_handle.size() and _object_classes_by_handle[index]) {
+         _object_classes_by_handle[index]->world_references += 1;
+
+         return;
+      }
+
+      const lowercase_string& class_name = get_name(name);
+
+      object_class& object_class =
+         _object_classes
+            .try_emplace(class_name, _asset_libraries, _asset_libraries.odfs[class_name])
+            .first->second;
+
+      object_class.world_references = 1;
+
+      set_handle_class(name, &object_class);
+      add_model_dependent(object_class);
+
+      _generation += 1;
+   }
+
+   void remove_reference(const name_handle name) noexcept
+   {
+      const std::size_t index = static_cast<std::size_t>(name);
+
+      if (index >= _object_classes_by_handle.size() or not _object_classes_by_handle[index]) {
+         return;
+      }
+
+      object_class& object_class = *_object_classes_by_handle[index];
+
+      object_class.world_references -= 1;
+
+      if (object_class.world_references == 0) _unreferenced_classes.push_back(name);
+   }
+
+   void add_model_dependent(object_class& object_class) noexcept
+   {
+      _model_dependents[object_class.model_name].push_back(&object_class);
+   }
+
+   void remove_model_dependent(const object_class& object_class) noexcept
+   {
+      auto it = _model_dependents.find(object_class.model_name);
+
+      if (it == _model_dependents.end()) return;
+
+      std::erase(it->second, &object_class);
+
+      if (it->second.empty()) _model_dependents.erase(it);
+   }
+
    void object_definition_loaded(const loaded_definition& loaded)
    {
-      _object_classes[loaded.name].update_definition(_asset_libraries, loaded.asset);
+      auto it = _object_classes.find(loaded.name);
+
+      // The class is no longer used by the world.
+      if (it == _object_classes.end()) return;
+
+      object_class& object_class = it->second;
+
+      remove_model_dependent(object_class);
+
+      object_class.update_definition(_asset_libraries, loaded.asset);
+
+      add_model_dependent(object_class);
+
+      _generation += 1;
    }
 
    void model_loaded(const loaded_model& loaded)
    {
-      for (auto& [object_class_name, object_class] : _object_classes) {
-         if (object_class.model_name != loaded.name) continue;
+      auto it = _model_dependents.find(loaded.name);
+
+      if (it == _model_dependents.end()) return;
+
+      for (object_class* object_class : it->second) {
+         object_class->model_asset = loaded.asset;
+         object_class->model = loaded.data;
+      }
+
+      _generation += 1;
+   }
+
+   void set_handle_class(const name_handle name, object_class* object_class) noexcept
+   {
+      const std::size_t index = static_cast<std::size_t>(name);
 
-         object_class.model_asset = loaded.asset;
-         object_class.model = loaded.data;
+      if (index >= _object_classes_by_handle.size()) {
+         _object_classes_by_handle.resize(index + 1, nullptr);
       }
+
+      _object_classes_by_handle[index] = object_class;
    }
 
-   absl::flat_hash_map<lowercase_string, object_class> _object_classes;
+   // A node map so the classes can be pointed to by _object_classes_by_handle and
+   // _model_dependents.
+   absl::node_hash_map<lowercase_string, object_class> _object_classes;
+   std::vector<object_class*> _object_classes_by_handle;
+   absl::flat_hash_map<lowercase_string, std::vector<object_class*>> _model_dependents;
+
+   absl::flat_hash_map<object_id, name_handle> _object_class_names;
+   std::optional<name_handle> _creation_class;
+   std::vector<name_handle> _unreferenced_classes;
+   change_log<object>::cursor _cursor;
 
    const object_class _default_object_class;
 
+   uint64 _generation = 0;
+
    std::shared_mutex _definition_load_queue_mutex;
    std::vector<loaded_definition> _definition_load_queue;
 
@@ -156,9 +348,10 @@ object_class_library::object_class_library(assets::libraries_manager& asset_libr
 
 object_class_library::~object_class_library() = default;
 
-void object_class_library::update(std::span<std::span<const object>> object_spans) noexcept
+void object_class_library::update(const world& world,
+                                  const object* creation_object) noexcept
 {
-   _impl->update(object_spans);
+   _impl->update(world, creation_object);
 }
 
 void object_class_library::clear() noexcept
@@ -166,10 +359,21 @@ void object_class_library::clear() noexcept
    _impl->clear();
 }
 
+auto object_class_library::generation() const noexcept -> uint64
+{
+   return _impl->generation();
+}
+
 auto object_class_library::operator[](const lowercase_string& name) const noexcept
    -> const object_class&
 {
    return _impl.get()[name];
 }
 
+auto object_class_library::operator[](const name_handle name) const noexcept
+   -> const object_class&
+{
+   return _impl.get()[name];
+}
+
 }
\ No newline at end of file
@@ -1,9 +1,9 @@
 #pragma once
 
 #include "lowercase_string.hpp"
+#include "types.hpp"
 #include "utility/implementation_storage.hpp"
-
-#include <span>
+#include "utility/name_table.hpp"
 
 namespace we::assets {
 
@@ -15,6 +15,7 @@ namespace we::world {
 
 struct object;
 struct object_class;
+struct world;
 
 struct object_class_library {
    explicit object_class_library(assets::libraries_manager& asset_libraries) noexcept;
@@ -25,16 +26,33 @@ struct object_class_library {
    auto operator=(const object_class_library&) noexcept
       -> object_class_library& = delete;
 
-   void update(std::span<std::span<const object>> object_spans) noexcept;
+   /// @brief Bring the library up to date with a world. Adds classes newly used by the
+   /// world, drops ones no longer used and applies loaded definitions and models.
+   ///
+   /// Class reference counts are adjusted from the world's object change log, so a frame
+   /// without edits to objects doesn't touch the classes. If the log can't say what
+   /// changed (a world was loaded, a layer was deleted, etc) every object is recounted.
+   /// @param world The world.
+   /// @param creation_object The object being created, if there is one.
+   void update(const world& world, const object* creation_object) noexcept;
 
    void clear() noexcept;
 
    auto operator[](const lowercase_string& name) const noexcept -> const object_class&;
 
+   /// @brief Get an object class by its interned name. An array lookup instead of a hash
+   /// lookup for loops that already have the handle (from object_store for instance).
+   auto operator[](const name_handle name) const noexcept -> const object_class&;
+
+   /// @brief Get a counter that is incremented whenever an object class is added or has
+   /// its definition or model changed. Lets users caching data derived from object
+   /// classes know when to refresh it.
+   auto generation() const noexcept -> uint64;
+
 private:
    struct impl;
 
-   implementation_storage<impl, 320> _impl;
+   implementation_storage<impl, 512> _impl;
 };
 
 }
\ No newline at end of file
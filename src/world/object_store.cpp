@@ -0,0 +1,104 @@
+#include "object_store.hpp"
+#include "utility/world_utilities.hpp"
+#include "world.hpp"
+
+namespace we::world {
+
+void object_store::update(const world& world) noexcept
+{
+   const std::optional<std::span<const change_log<object>::change>> changes =
+      world.changes.objects.changes_since(_cursor);
+
+   if (not changes or size() != world.objects.size()) {
+      rebuild(world);
+
+      return;
+   }
+
+   for (const auto& change : *changes) {
+      // Inserts and removals shift every object after them, rebuild instead of
+      // shuffling the arrays.
+      if (change.type != change_type::modify) {
+         rebuild(world);
+
+         return;
+      }
+   }
+
+   for (const auto& change : *changes) {
+      const std::optional<std::size_t> index =
+         find_entity_index<object>(world, change.id);
+
+      if (not index) continue;
+
+      store(*index, world.objects[*index]);
+   }
+
+   _cursor = world.changes.objects.current();
+}
+
+void object_store::clear() noexcept
+{
+   _layers.clear();
+   _rotations.clear();
+   _positions.clear();
+   _class_names.clear();
+   _ids.clear();
+   _cursor = {};
+}
+
+auto object_store::size() const noexcept -> std::size_t
+{
+   return _ids.size();
+}
+
+auto object_store::layers() const noexcept -> std::span<const int>
+{
+   return _layers;
+}
+
+auto object_store::rotations() const noexcept -> std::span<const quaternion>
+{
+   return _rotations;
+}
+
+auto object_store::positions() const noexcept -> std::span<const float3>
+{
+   return _positions;
+}
+
+auto object_store::class_names() const noexcept -> std::span<const name_handle>
+{
+   return _class_names;
+}
+
+auto object_store::ids() const noexcept -> std::span<const id<object>>
+{
+   return _ids;
+}
+
+void object_store::rebuild(const world& world) noexcept
+{
+   const std::size_t count = world.objects.size();
+
+   _layers.resize(count);
+   _rotations.resize(count);
+   _positions.resize(count);
+   _class_names.resize(count);
+   _ids.resize(count);
+
+   for (std::size_t i = 0; i < count; ++i) store(i, world.objects[i]);
+
+   _cursor = world.changes.objects.current();
+}
+
+void object_store::store(const std::size_t index, const object& object) noexcept
+{
+   _layers[index] = object.layer;
+   _rotations[index] = object.rotation;
+   _positions[index] = object.position;
+   _class_names[index] = intern_name(object.class_name);
+   _ids[index] = object.id;
+}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "change_log.hpp"
+#include "id.hpp"
+#include "types.hpp"
+#include "utility/name_table.hpp"
+
+#include <span>
+#include <vector>
+
+namespace we::world {
+
+struct object;
+struct world;
+
+/// @brief Hot/cold split of a world's objects. The members per-frame loops read (layer,
+/// rotation, position, class and ID) are copied into contiguous arrays in the same order
+/// as world::objects, the cold members (name, team and instance properties) are left in
+/// world::objects. Class names are stored as handles from the global name table so loops
+/// can look classes up by index instead of hashing the name of every object.
+///
+/// world::objects stays the source of truth and is what edits, saving and the UI keep
+/// using. The store is kept current from the world's object change log the same way as
+/// object_bbox_cache.
+class object_store {
+public:
+   /// @brief Bring the store up to date with the world.
+   /// @param world The world.
+   void update(const world& world) noexcept;
+
+   /// @brief Empty the store.
+   void clear() noexcept;
+
+   /// @brief Get the number of objects in the store. After an update this is the same as
+   /// the number of objects in the world.
+   [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+   [[nodiscard]] auto layers() const noexcept -> std::span<const int>;
+
+   [[nodiscard]] auto rotations() const noexcept -> std::span<const quaternion>;
+
+   [[nodiscard]] auto positions() const noexcept -> std::span<const float3>;
+
+   [[nodiscard]] auto class_names() const noexcept -> std::span<const name_handle>;
+
+   [[nodiscard]] auto ids() const noexcept -> std::span<const id<object>>;
+
+private:
+   void rebuild(const world& world) noexcept;
+
+   void store(const std::size_t index, const object& object) noexcept;
+
+   std::vector<int> _layers;
+   std::vector<quaternion> _rotations;
+   std::vector<float3> _positions;
+   std::vector<name_handle> _class_names;
+   std::vector<id<object>> _ids;
+
+   change_log<object>::cursor _cursor;
+};
+
+}
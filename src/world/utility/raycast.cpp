@@ -6,14 +6,69 @@
 #include "math/quaternion_funcs.hpp"
 #include "math/vector_funcs.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <limits>
 
 namespace we::world {
 
-auto raycast(const float3 ray_origin, const float3 ray_direction,
-             const active_layers active_layers, std::span<const object> objects,
-             const object_class_library& object_classes,
-             std::optional<object_id> ignore_object) noexcept
+namespace {
+
+/// @brief Get the distance along a ray to where it enters an axis-aligned box.
+/// @return The distance or a negative value if the ray misses the box. Rays starting
+/// inside the box return 0.
+auto intersect_aabb(const float3 ray_origin, const float3 inv_ray_direction,
+                    const math::bounding_box& bbox) noexcept -> float
+{
+   const std::array<float, 3> origin{ray_origin.x, ray_origin.y, ray_origin.z};
+   const std::array<float, 3> inv_direction{inv_ray_direction.x, inv_ray_direction.y,
+                                            inv_ray_direction.z};
+   const std::array<float, 3> min{bbox.min.x, bbox.min.y, bbox.min.z};
+   const std::array<float, 3> max{bbox.max.x, bbox.max.y, bbox.max.z};
+
+   float near = 0.0f;
+   float far = std::numeric_limits<float>::max();
+
+   for (std::size_t axis = 0; axis < 3; ++axis) {
+      // Rays parallel to the slab are either always in it or never in it.
+      if (std::isinf(inv_direction[axis])) {
+         if (origin[axis] < min[axis] or origin[axis] > max[axis]) return -1.0f;
+
+         continue;
+      }
+
+      const float t0 = (min[axis] - origin[axis]) * inv_direction[axis];
+      const float t1 = (max[axis] - origin[axis]) * inv_direction[axis];
+
+      near = std::max(near, std::min(t0, t1));
+      far = std::min(far, std::max(t0, t1));
+   }
+
+   if (near > far) return -1.0f;
+
+   return near;
+}
+
+/// @brief The members of an object raycasting reads.
+struct raycast_object {
+   int layer = 0;
+   const quaternion& rotation;
+   const float3& position;
+   object_id id;
+};
+
+/// @brief Raycast against objects, skipping any objects skip_object(index, min_distance)
+/// returns true for. get_object(index) returns a raycast_object and
+/// get_object_class(index) the object's class, which is only looked up for objects that
+/// aren't skipped.
+template<typename Get_object, typename Get_object_class, typename Skip_object>
+auto raycast_objects(const float3 ray_origin, const float3 ray_direction,
+                     const active_layers active_layers, const std::size_t object_count,
+                     const Get_object& get_object,
+                     const Get_object_class& get_object_class,
+                     std::optional<object_id> ignore_object,
+                     const Skip_object& skip_object) noexcept
    -> std::optional<raycast_result<object>>
 {
    using namespace assets;
@@ -22,9 +77,12 @@ auto raycast(const float3 ray_origin, const float3 ray_direction,
    float min_distance = std::numeric_limits<float>::max();
    float3 surface_normalWS;
 
-   for (auto& object : objects) {
+   for (std::size_t i = 0; i < object_count; ++i) {
+      const raycast_object object = get_object(i);
+
       if (not active_layers[object.layer]) continue;
       if (object.id == ignore_object) continue;
+      if (skip_object(i, min_distance)) continue;
 
       quaternion inverse_object_rotation = conjugate(object.rotation);
 
@@ -34,7 +92,7 @@ auto raycast(const float3 ray_origin, const float3 ray_direction,
       float3 obj_ray_origin = world_to_obj * ray_origin;
       float3 obj_ray_direction = normalize(float3x3{world_to_obj} * ray_direction);
 
-      const msh::flat_model& model = *object_classes[object.class_name].model;
+      const msh::flat_model& model = *get_object_class(i).model;
 
       float3 box_centre = (model.bounding_box.min + model.bounding_box.max) * 0.5f;
       float3 box_size = model.bounding_box.max - model.bounding_box.min;
@@ -64,6 +122,104 @@ auto raycast(const float3 ray_origin, const float3 ray_direction,
                                  .id = *hit};
 }
 
+auto get_raycast_object(std::span<const object> objects) noexcept
+{
+   return [objects](const std::size_t index) noexcept {
+      const object& object = objects[index];
+
+      return raycast_object{.layer = object.layer,
+                            .rotation = object.rotation,
+                            .position = object.position,
+                            .id = object.id};
+   };
+}
+
+auto get_raycast_object_class(std::span<const object> objects,
+                              const object_class_library& object_classes) noexcept
+{
+   return [objects, &object_classes](const std::size_t index) noexcept -> const object_class& {
+      return object_classes[objects[index].class_name];
+   };
+}
+
+auto skip_missed_bbox(const float3 ray_origin, const float3 ray_direction,
+                      const object_bbox_cache& object_bboxes) noexcept
+{
+   return [ray_origin, inv_ray_direction = 1.0f / normalize(ray_direction),
+           &object_bboxes](const std::size_t index, const float min_distance) {
+      const float distance =
+         intersect_aabb(ray_origin, inv_ray_direction, object_bboxes[index]);
+
+      return distance < 0.0f or distance > min_distance;
+   };
+}
+
+}
+
+auto raycast(const float3 ray_origin, const float3 ray_direction,
+             const active_layers active_layers, std::span<const object> objects,
+             const object_class_library& object_classes,
+             std::optional<object_id> ignore_object) noexcept
+   -> std::optional<raycast_result<object>>
+{
+   return raycast_objects(ray_origin, ray_direction, active_layers, objects.size(),
+                          get_raycast_object(objects),
+                          get_raycast_object_class(objects, object_classes), ignore_object,
+                          [](const std::size_t, const float) { return false; });
+}
+
+auto raycast(const float3 ray_origin, const float3 ray_direction,
+             const active_layers active_layers, std::span<const object> objects,
+             const object_class_library& object_classes,
+             const object_bbox_cache& object_bboxes,
+             std::optional<object_id> ignore_object) noexcept
+   -> std::optional<raycast_result<object>>
+{
+   if (object_bboxes.size() != objects.size()) {
+      return raycast(ray_origin, ray_direction, active_layers, objects,
+                     object_classes, ignore_object);
+   }
+
+   return raycast_objects(ray_origin, ray_direction, active_layers, objects.size(),
+                          get_raycast_object(objects),
+                          get_raycast_object_class(objects, object_classes), ignore_object,
+                          skip_missed_bbox(ray_origin, ray_direction, object_bboxes));
+}
+
+auto raycast(const float3 ray_origin, const float3 ray_direction,
+             const active_layers active_layers, const object_store& objects,
+             const object_class_library& object_classes,
+             const object_bbox_cache& object_bboxes,
+             std::optional<object_id> ignore_object) noexcept
+   -> std::optional<raycast_result<object>>
+{
+   const std::span<const int> layers = objects.layers();
+   const std::span<const quaternion> rotations = objects.rotations();
+   const std::span<const float3> positions = objects.positions();
+   const std::span<const name_handle> class_names = objects.class_names();
+   const std::span<const object_id> ids = objects.ids();
+
+   const auto get_object = [&](const std::size_t index) noexcept {
+      return raycast_object{.layer = layers[index],
+                            .rotation = rotations[index],
+                            .position = positions[index],
+                            .id = ids[index]};
+   };
+   const auto get_object_class = [&](const std::size_t index) noexcept -> const object_class& {
+      return object_classes[class_names[index]];
+   };
+
+   if (object_bboxes.size() != objects.size()) {
+      return raycast_objects(ray_origin, ray_direction, active_layers, objects.size(),
+                             get_object, get_object_class, ignore_object,
+                             [](const std::size_t, const float) { return false; });
+   }
+
+   return raycast_objects(ray_origin, ray_direction, active_layers, objects.size(),
+                          get_object, get_object_class, ignore_object,
+                          skip_missed_bbox(ray_origin, ray_direction, object_bboxes));
+}
+
 auto raycast(const float3 ray_origin, const float3 ray_direction,
              const active_layers active_layers, std::span<const light> lights) noexcept
    -> std::optional<raycast_result<light>>
@@ -471,7 +627,7 @@ auto raycast(const float3 ray_origin, const float3 ray_direction,
 auto raycast(const float3 ray_origin, const float3 ray_direction,
              std::span<const planning_connection> connections,
              std::span<const planning_hub> hubs,
-             const absl::flat_hash_map<planning_hub_id, std::size_t>& planning_hub_index,
+             const entity_id_index<planning_hub>& planning_hub_index,
              const float connection_height) noexcept
    -> std::optional<raycast_result<planning_connection>>
 {
@@ -479,8 +635,8 @@ auto raycast(const float3 ray_origin, const float3 ray_direction,
    float min_distance = std::numeric_limits<float>::max();
 
    for (auto& connection : connections) {
-      const planning_hub& start = hubs[planning_hub_index.at(connection.start)];
-      const planning_hub& end = hubs[planning_hub_index.at(connection.end)];
+      const planning_hub& start = hubs[*planning_hub_index.find(hubs, connection.start)];
+      const planning_hub& end = hubs[*planning_hub_index.find(hubs, connection.end)];
 
       const math::bounding_box start_bbox{
          .min = float3{-start.radius, -connection_height, -start.radius} + start.position,
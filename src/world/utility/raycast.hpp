@@ -1,14 +1,14 @@
 #pragma once
 
 #include "../active_elements.hpp"
+#include "../object_bbox_cache.hpp"
 #include "../object_class_library.hpp"
+#include "../object_store.hpp"
 #include "../world.hpp"
 
 #include <optional>
 #include <span>
 
-#include <absl/container/flat_hash_map.h>
-
 namespace we::world {
 
 template<typename T>
@@ -44,6 +44,24 @@ auto raycast(const float3 ray_origin, const float3 ray_direction,
              std::optional<object_id> ignore_object = std::nullopt) noexcept
    -> std::optional<raycast_result<object>>;
 
+/// @brief Raycast against objects, using their cached world space bounding boxes to skip
+/// objects the ray misses before testing against their models.
+auto raycast(const float3 ray_origin, const float3 ray_direction,
+             const active_layers active_layers, std::span<const object> objects,
+             const object_class_library& object_classes,
+             const object_bbox_cache& object_bboxes,
+             std::optional<object_id> ignore_object = std::nullopt) noexcept
+   -> std::optional<raycast_result<object>>;
+
+/// @brief Raycast against the objects in an object_store. Reads only the store's hot
+/// arrays until an object's bounding box is hit.
+auto raycast(const float3 ray_origin, const float3 ray_direction,
+             const active_layers active_layers, const object_store& objects,
+             const object_class_library& object_classes,
+             const object_bbox_cache& object_bboxes,
+             std::optional<object_id> ignore_object = std::nullopt) noexcept
+   -> std::optional<raycast_result<object>>;
+
 auto raycast(const float3 ray_origin, const float3 ray_direction,
              const active_layers active_layers, std::span<const light> lights) noexcept
    -> std::optional<raycast_result<light>>;
@@ -79,7 +97,7 @@ auto raycast(const float3 ray_origin, const float3 ray_direction,
 auto raycast(const float3 ray_origin, const float3 ray_direction,
              std::span<const planning_connection> connections,
              std::span<const planning_hub> hubs,
-             const absl::flat_hash_map<planning_hub_id, std::size_t>& planning_hub_index,
+             const entity_id_index<planning_hub>& planning_hub_index,
              const float connection_height) noexcept
    -> std::optional<raycast_result<planning_connection>>;
 
@@ -1,8 +1,11 @@
 #include "sector_fill.hpp"
 #include "../object_class.hpp"
 #include "math/quaternion_funcs.hpp"
+#include "async/thread_pool.hpp"
 #include "math/vector_funcs.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 
 namespace we::world {
@@ -81,13 +84,13 @@ bool inside_sector(const std::span<const float2> sector_points,
    return false;
 }
 
-}
+struct sector_bounds {
+   float3 min;
+   float3 max;
+};
 
-auto sector_fill(const sector& sector, const std::span<const object> world_objects,
-                 const object_class_library& object_classes) -> std::vector<std::string>
+auto get_sector_bounds(const sector& sector) noexcept -> sector_bounds
 {
-   if (sector.points.empty() or sector.points.size() < 3) return {};
-
    float3 sector_min{std::numeric_limits<float>::max(), 0.0f,
                      std::numeric_limits<float>::max()};
    float3 sector_max = -sector_min;
@@ -100,31 +103,193 @@ auto sector_fill(const sector& sector, const std::span<const object> world_objec
    sector_min.y = sector.base;
    sector_max.y = sector.base + sector.height;
 
-   std::vector<std::string> sector_objects;
-   sector_objects.reserve(32);
+   return {sector_min, sector_max};
+}
 
-   for (auto& object : world_objects) {
-      if (object.name.empty()) continue;
+auto get_object_bbox(const object& object, const object_class_library& object_classes) noexcept
+   -> math::bounding_box
+{
+   const math::bounding_box model_bbox =
+      object_classes[object.class_name].model->bounding_box;
 
-      const math::bounding_box model_bbox =
-         object_classes[object.class_name].model->bounding_box;
-      const math::bounding_box bbox = object.rotation * model_bbox + object.position;
+   return object.rotation * model_bbox + object.position;
+}
 
-      if (bbox.min.x > sector_max.x or bbox.max.x < sector_min.x or
-          bbox.min.y > sector_max.y or bbox.max.y < sector_min.y or
-          bbox.min.z > sector_max.z or bbox.max.z < sector_min.z) {
-         continue;
-      }
+bool inside_sector(const sector& sector, const sector_bounds& sector_bounds,
+                   const math::bounding_box& bbox) noexcept
+{
+   if (bbox.min.x > sector_bounds.max.x or bbox.max.x < sector_bounds.min.x or
+       bbox.min.y > sector_bounds.max.y or bbox.max.y < sector_bounds.min.y or
+       bbox.min.z > sector_bounds.max.z or bbox.max.z < sector_bounds.min.z) {
+      return false;
+   }
 
-      const float3 object_centre = (bbox.min + bbox.max) / 2.0f;
+   const float3 object_centre = (bbox.min + bbox.max) / 2.0f;
 
-      if (inside_sector(sector.points, {sector_min.x, sector_min.z},
+   return inside_sector(sector.points, {sector_bounds.min.x, sector_bounds.min.z},
                         {object_centre.x, object_centre.z}) or
-          inside_sector(sector.points, bbox)) {
+          inside_sector(sector.points, bbox);
+}
+
+/// @brief Uniform 2D grid over the XZ bounds of objects. Each cell holds the indices of
+/// the objects overlapping it, in ascending order.
+class object_grid {
+public:
+   object_grid(const std::span<const math::bounding_box> bboxes,
+               const std::span<const uint32> object_indices) noexcept
+   {
+      if (object_indices.empty()) return;
+
+      _min = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+      float2 max = -_min;
+
+      for (const uint32 i : object_indices) {
+         _min = {std::min(_min.x, bboxes[i].min.x), std::min(_min.y, bboxes[i].min.z)};
+         max = {std::max(max.x, bboxes[i].max.x), std::max(max.y, bboxes[i].max.z)};
+      }
+
+      // Aim for a handful of objects per cell.
+      _length = std::clamp(static_cast<uint32>(
+                              std::sqrt(static_cast<float>(object_indices.size()) / 4.0f)),
+                           1u, 256u);
+      _cell_size = {std::max((max.x - _min.x) / _length, 1.0f),
+                    std::max((max.y - _min.y) / _length, 1.0f)};
+      _cells.resize(_length * _length);
+
+      for (const uint32 i : object_indices) {
+         const cell_range range = get_cell_range({bboxes[i].min.x, bboxes[i].min.z},
+                                                 {bboxes[i].max.x, bboxes[i].max.z});
+
+         for (uint32 z = range.top; z <= range.bottom; ++z) {
+            for (uint32 x = range.left; x <= range.right; ++x) {
+               _cells[z * _length + x].push_back(i);
+            }
+         }
+      }
+   }
+
+   /// @brief Get the indices of the objects in the cells overlapping a rectangle.
+   /// @param min The min corner of the rectangle.
+   /// @param max The max corner of the rectangle.
+   /// @param out_indices The vector to write the indices to. They will be sorted and unique.
+   void query(const float2 min, const float2 max,
+              std::vector<uint32>& out_indices) const noexcept
+   {
+      out_indices.clear();
+
+      if (_cells.empty()) return;
+
+      const cell_range range = get_cell_range(min, max);
+
+      for (uint32 z = range.top; z <= range.bottom; ++z) {
+         for (uint32 x = range.left; x <= range.right; ++x) {
+            const std::vector<uint32>& cell = _cells[z * _length + x];
+
+            out_indices.insert(out_indices.end(), cell.begin(), cell.end());
+         }
+      }
+
+      std::sort(out_indices.begin(), out_indices.end());
+
+      out_indices.erase(std::unique(out_indices.begin(), out_indices.end()),
+                        out_indices.end());
+   }
+
+private:
+   struct cell_range {
+      uint32 left;
+      uint32 top;
+      uint32 right;
+      uint32 bottom;
+   };
+
+   auto get_cell_range(const float2 min, const float2 max) const noexcept -> cell_range
+   {
+      const auto to_cell = [this](const float v, const float origin, const float size) {
+         return static_cast<uint32>(
+            std::clamp((v - origin) / size, 0.0f, static_cast<float>(_length - 1)));
+      };
+
+      return {.left = to_cell(min.x, _min.x, _cell_size.x),
+              .top = to_cell(min.y, _min.y, _cell_size.y),
+              .right = to_cell(max.x, _min.x, _cell_size.x),
+              .bottom = to_cell(max.y, _min.y, _cell_size.y)};
+   }
+
+   float2 _min;
+   float2 _cell_size;
+   uint32 _length = 0;
+   std::vector<std::vector<uint32>> _cells;
+};
+
+}
+
+auto sector_fill(const sector& sector, const std::span<const object> world_objects,
+                 const object_class_library& object_classes) -> std::vector<std::string>
+{
+   if (sector.points.empty() or sector.points.size() < 3) return {};
+
+   const sector_bounds sector_bounds = get_sector_bounds(sector);
+
+   std::vector<std::string> sector_objects;
+   sector_objects.reserve(32);
+
+   for (auto& object : world_objects) {
+      if (object.name.empty()) continue;
+
+      if (inside_sector(sector, sector_bounds, get_object_bbox(object, object_classes))) {
          sector_objects.push_back(object.name);
       }
    }
 
    return sector_objects;
 }
+
+auto sector_fill_all(const std::span<const sector> sectors,
+                     const std::span<const object> world_objects,
+                     const object_bbox_cache& object_bboxes,
+                     async::thread_pool& thread_pool)
+   -> std::vector<std::vector<std::string>>
+{
+   std::vector<uint32> named_objects;
+   named_objects.reserve(world_objects.size());
+
+   for (uint32 i = 0; i < world_objects.size(); ++i) {
+      if (not world_objects[i].name.empty()) named_objects.push_back(i);
+   }
+
+   std::vector<math::bounding_box> bboxes;
+   bboxes.resize(world_objects.size());
+
+   for (const uint32 i : named_objects) bboxes[i] = object_bboxes[i];
+
+   const object_grid grid{bboxes, named_objects};
+
+   std::vector<std::vector<std::string>> sectors_objects;
+   sectors_objects.resize(sectors.size());
+
+   thread_pool.for_each_n(
+      async::task_priority::normal, sectors.size(), [&](const std::size_t i) noexcept {
+         const sector& sector = sectors[i];
+
+         if (sector.points.empty() or sector.points.size() < 3) return;
+
+         const sector_bounds sector_bounds = get_sector_bounds(sector);
+
+         std::vector<uint32> candidates;
+
+         grid.query({sector_bounds.min.x, sector_bounds.min.z},
+                    {sector_bounds.max.x, sector_bounds.max.z}, candidates);
+
+         std::vector<std::string>& sector_objects = sectors_objects[i];
+
+         for (const uint32 object_index : candidates) {
+            if (inside_sector(sector, sector_bounds, bboxes[object_index])) {
+               sector_objects.push_back(world_objects[object_index].name);
+            }
+         }
+      });
+
+   return sectors_objects;
+}
 }
\ No newline at end of file
@@ -1,9 +1,15 @@
 #pragma once
 
+#include "../object_bbox_cache.hpp"
 #include "../object_class_library.hpp"
 #include "../world.hpp"
 
 #include <span>
+#include <vector>
+
+namespace we::async {
+class thread_pool;
+}
 
 namespace we::world {
 
@@ -11,4 +17,17 @@ auto sector_fill(const sector& sector, const std::span<const object> world_objec
                  const object_class_library& object_classes)
    -> std::vector<std::string>;
 
+/// @brief Fill every sector in the world at once. Object bounding boxes are binned into a
+/// grid so each sector only tests nearby objects. Sectors are filled in parallel.
+/// @param sectors The sectors to fill.
+/// @param world_objects The objects in the world.
+/// @param object_bboxes The bounding boxes of the objects. Must be up to date.
+/// @param thread_pool The thread pool to fill the sectors on.
+/// @return The objects for each sector, in the same order as sectors.
+auto sector_fill_all(const std::span<const sector> sectors,
+                     const std::span<const object> world_objects,
+                     const object_bbox_cache& object_bboxes,
+                     async::thread_pool& thread_pool)
+   -> std::vector<std::vector<std::string>>;
+
 }
@@ -1,8 +1,11 @@
 #include "snapping.hpp"
 #include "../object_class.hpp"
+#include "world_utilities.hpp"
 #include "math/quaternion_funcs.hpp"
 #include "math/vector_funcs.hpp"
 
+#include <cmath>
+
 namespace we::world {
 
 namespace {
@@ -80,6 +83,163 @@ auto get_snapping_points(const object& object, const float3 object_position,
    return points;
 }
 
+constexpr int32 max_cell_coord = (1 << 20) - 1;
+constexpr int32 min_cell_coord = -(1 << 20);
+
+struct cell_coords {
+   int32 x;
+   int32 y;
+   int32 z;
+};
+
+auto get_cell_coords(const float3 position) noexcept -> cell_coords
+{
+   const auto get_coord = [](const float v) {
+      return static_cast<int32>(std::clamp(std::floor(v / snapping_index::cell_size),
+                                           static_cast<float>(min_cell_coord),
+                                           static_cast<float>(max_cell_coord)));
+   };
+
+   return {get_coord(position.x), get_coord(position.y), get_coord(position.z)};
+}
+
+auto get_cell_key(const cell_coords coords) noexcept -> uint64
+{
+   constexpr uint64 mask = (1ull << 21) - 1;
+
+   return (static_cast<uint64>(coords.x - min_cell_coord) & mask) << 42 |
+          (static_cast<uint64>(coords.y - min_cell_coord) & mask) << 21 |
+          (static_cast<uint64>(coords.z - min_cell_coord) & mask);
+}
+
+/// @brief Call a function with every point in the cells overlapping a sphere. Points
+/// outside the sphere but in overlapping cells are included.
+template<typename Cells, typename Callback>
+void for_each_point_near(const Cells& cells, const float3 position, const float radius,
+                         Callback&& callback) noexcept
+{
+   const cell_coords min = get_cell_coords(position - radius);
+   const cell_coords max = get_cell_coords(position + radius);
+
+   const uint64 cell_count = static_cast<uint64>(max.x - min.x + 1) *
+                             static_cast<uint64>(max.y - min.y + 1) *
+                             static_cast<uint64>(max.z - min.z + 1);
+
+   // For large radii it's cheaper to just visit every populated cell.
+   if (cell_count > cells.size()) {
+      for (const auto& [key, cell] : cells) {
+         for (const auto& point : cell) callback(point.position);
+      }
+
+      return;
+   }
+
+   for (int32 z = min.z; z <= max.z; ++z) {
+      for (int32 y = min.y; y <= max.y; ++y) {
+         for (int32 x = min.x; x <= max.x; ++x) {
+            const auto it = cells.find(get_cell_key({x, y, z}));
+
+            if (it == cells.end()) continue;
+
+            for (const auto& point : it->second) callback(point.position);
+         }
+      }
+   }
+}
+
+}
+
+void snapping_index::update(const world& world,
+                            const object_class_library& object_classes) noexcept
+{
+   const std::optional<std::span<const change_log<object>::change>> changes =
+      world.changes.objects.changes_since(_cursor);
+
+   if (not changes or object_classes.generation() != _object_classes_generation) {
+      rebuild(world, object_classes);
+
+      return;
+   }
+
+   for (const auto& change : *changes) {
+      remove(change.id);
+
+      if (change.type == change_type::remove) continue;
+
+      if (const std::optional<std::size_t> index =
+             find_entity_index<object>(world, change.id);
+          index) {
+         insert(world.objects[*index], object_classes);
+      }
+   }
+
+   _cursor = world.changes.objects.current();
+}
+
+void snapping_index::clear() noexcept
+{
+   _snapping_points.clear();
+   _face_midpoints.clear();
+   _objects.clear();
+   _cursor = {};
+}
+
+void snapping_index::rebuild(const world& world,
+                             const object_class_library& object_classes) noexcept
+{
+   clear();
+
+   for (const object& object : world.objects) insert(object, object_classes);
+
+   _cursor = world.changes.objects.current();
+   _object_classes_generation = object_classes.generation();
+}
+
+void snapping_index::insert(const object& object,
+                            const object_class_library& object_classes) noexcept
+{
+   const object_class& object_class = object_classes[object.class_name];
+
+   object_points& points = _objects[object.id];
+
+   points.snapping_points = get_snapping_points(object, object.position, object_class);
+   points.face_midpoints =
+      get_face_midpoints(get_transformed_corners(object, object.position, object_class));
+
+   for (const float3& position : points.snapping_points) {
+      _snapping_points[get_cell_key(get_cell_coords(position))].push_back(
+         {.position = position, .id = object.id});
+   }
+
+   for (const float3& position : points.face_midpoints) {
+      _face_midpoints[get_cell_key(get_cell_coords(position))].push_back(
+         {.position = position, .id = object.id});
+   }
+}
+
+void snapping_index::remove(const object_id id) noexcept
+{
+   auto object_it = _objects.find(id);
+
+   if (object_it == _objects.end()) return;
+
+   const auto remove_points = [id](absl::flat_hash_map<uint64, cell>& cells,
+                                   std::span<const float3> positions) {
+      for (const float3& position : positions) {
+         auto cell_it = cells.find(get_cell_key(get_cell_coords(position)));
+
+         if (cell_it == cells.end()) continue;
+
+         std::erase_if(cell_it->second, [id](const point& point) { return point.id == id; });
+
+         if (cell_it->second.empty()) cells.erase(cell_it);
+      }
+   };
+
+   remove_points(_snapping_points, object_it->second.snapping_points);
+   remove_points(_face_midpoints, object_it->second.face_midpoints);
+
+   _objects.erase(object_it);
 }
 
 auto get_snapped_position(const object& snapping_object, const float3 snapping_position,
@@ -116,9 +276,7 @@ auto get_snapped_position(const object& snapping_object, const float3 snapping_p
 
    if (closest_distance > snap_radius) return std::nullopt;
 
-   float3 direction = normalize(closest_corner - snapping_corners[closest_index]);
-
-   return snapping_position + direction * closest_distance;
+   return snapping_position + (closest_corner - snapping_corners[closest_index]);
 }
 
 auto get_snapped_position(const float3 snapping_position,
@@ -147,9 +305,61 @@ auto get_snapped_position(const float3 snapping_position,
 
    if (closest_distance > snap_radius) return std::nullopt;
 
-   float3 direction = normalize(closest_position - snapping_position);
+   return closest_position;
+}
+
+auto get_snapped_position(const object& snapping_object, const float3 snapping_position,
+                          const snapping_index& index, const float snap_radius,
+                          const object_class_library& object_classes)
+   -> std::optional<float3>
+{
+   const std::array<float3, 18> snapping_corners =
+      get_snapping_points(snapping_object, snapping_position,
+                          object_classes[snapping_object.class_name]);
+
+   float3 closest_corner;
+   float closest_distance = FLT_MAX;
+   uint32 closest_index = 0;
+
+   for (uint32 i = 0; i < snapping_corners.size(); ++i) {
+      for_each_point_near(index._snapping_points, snapping_corners[i], snap_radius,
+                          [&](const float3 corner) {
+                             const float corner_distance =
+                                distance(corner, snapping_corners[i]);
+
+                             if (corner_distance < closest_distance) {
+                                closest_corner = corner;
+                                closest_distance = corner_distance;
+                                closest_index = i;
+                             }
+                          });
+   }
+
+   if (closest_distance > snap_radius) return std::nullopt;
+
+   return snapping_position + (closest_corner - snapping_corners[closest_index]);
+}
+
+auto get_snapped_position(const float3 snapping_position,
+                          const snapping_index& index, const float snap_radius)
+   -> std::optional<float3>
+{
+   float3 closest_position;
+   float closest_distance = FLT_MAX;
+
+   for_each_point_near(index._face_midpoints, snapping_position, snap_radius,
+                       [&](const float3 corner) {
+                          const float corner_distance = distance(corner, snapping_position);
+
+                          if (corner_distance < closest_distance) {
+                             closest_position = corner;
+                             closest_distance = corner_distance;
+                          }
+                       });
 
-   return snapping_position + direction * closest_distance;
+   if (closest_distance > snap_radius) return std::nullopt;
+
+   return closest_position;
 }
 
-}
\ No newline at end of file
+}
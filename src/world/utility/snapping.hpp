@@ -3,11 +3,69 @@
 #include "../object_class_library.hpp"
 #include "../world.hpp"
 
+#include <array>
 #include <optional>
 #include <span>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
 
 namespace we::world {
 
+/// @brief Spatial hash of the snapping points of a world's objects. Lets snapping
+/// queries only visit the points near the snapping position instead of every object.
+class snapping_index {
+public:
+   /// @brief Bring the index up to date with the world. Only objects changed since the
+   /// last update are reindexed unless the world's change log has been reset or the
+   /// object classes have changed, in which case the index is rebuilt.
+   /// @param world The world.
+   /// @param object_classes The object class library for the world.
+   void update(const world& world, const object_class_library& object_classes) noexcept;
+
+   /// @brief Remove all objects from the index.
+   void clear() noexcept;
+
+   /// @brief Size of the cells in the index, in world units.
+   constexpr static float cell_size = 2.0f;
+
+private:
+   friend auto get_snapped_position(const object& snapping_object,
+                                    const float3 snapping_position,
+                                    const snapping_index& index, const float snap_radius,
+                                    const object_class_library& object_classes)
+      -> std::optional<float3>;
+
+   friend auto get_snapped_position(const float3 snapping_position,
+                                    const snapping_index& index, const float snap_radius)
+      -> std::optional<float3>;
+
+   struct point {
+      float3 position;
+      object_id id;
+   };
+
+   using cell = std::vector<point>;
+
+   struct object_points {
+      std::array<float3, 18> snapping_points;
+      std::array<float3, 6> face_midpoints;
+   };
+
+   void rebuild(const world& world, const object_class_library& object_classes) noexcept;
+
+   void insert(const object& object, const object_class_library& object_classes) noexcept;
+
+   void remove(const object_id id) noexcept;
+
+   absl::flat_hash_map<uint64, cell> _snapping_points;
+   absl::flat_hash_map<uint64, cell> _face_midpoints;
+   absl::flat_hash_map<object_id, object_points> _objects;
+
+   change_log<object>::cursor _cursor;
+   uint64 _object_classes_generation = 0;
+};
+
 auto get_snapped_position(const object& snapping_object, const float3 snapping_position,
                           const std::span<const object> world_objects,
                           const float snap_radius,
@@ -20,4 +78,13 @@ auto get_snapped_position(const float3 snapping_position,
                           const object_class_library& object_classes)
    -> std::optional<float3>;
 
+auto get_snapped_position(const object& snapping_object, const float3 snapping_position,
+                          const snapping_index& index, const float snap_radius,
+                          const object_class_library& object_classes)
+   -> std::optional<float3>;
+
+auto get_snapped_position(const float3 snapping_position,
+                          const snapping_index& index, const float snap_radius)
+   -> std::optional<float3>;
+
 }
@@ -3,6 +3,7 @@
 #include "math/vector_funcs.hpp"
 #include "utility/string_ops.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 #include <fmt/core.h>
@@ -81,8 +82,158 @@ auto create_unique_name_impl(const std::span<const T> entities,
    };
 }
 
+template<typename T>
+void rebuild_name_index(world& world) noexcept
+{
+   entity_name_index<T>& index = select_name_index<T>(world);
+
+   index.clear();
+
+   for (const T& entity : select_entities<T>(world)) index.insert(entity.name, entity.id);
+}
+
+template<typename T>
+void rebuild_id_index(world& world) noexcept
+{
+   select_id_index<T>(world).clear();
+
+   update_id_index<T>(world);
+}
+
+}
+
+void rebuild_name_indices(world& world) noexcept
+{
+   rebuild_name_index<object>(world);
+   rebuild_name_index<light>(world);
+   rebuild_name_index<path>(world);
+   rebuild_name_index<region>(world);
+   rebuild_name_index<sector>(world);
+   rebuild_name_index<portal>(world);
+   rebuild_name_index<hintnode>(world);
+   rebuild_name_index<barrier>(world);
+   rebuild_name_index<planning_hub>(world);
+   rebuild_name_index<planning_connection>(world);
+   rebuild_name_index<boundary>(world);
+
+   world.name_index.region_descriptions.clear();
+
+   for (const region& region : world.regions) {
+      world.name_index.region_descriptions.insert(region.description, region.id);
+   }
+
+   world.name_index.light_region_names.clear();
+
+   for (const light& light : world.lights) {
+      if (is_region_light(light)) {
+         world.name_index.light_region_names.insert(light.region_name, light.id);
+      }
+   }
 }
 
+bool is_region_description_index_complete(const world& world) noexcept
+{
+   const entity_name_index<region>& index = world.name_index.region_descriptions;
+
+   if (index.size() != world.regions.size()) return false;
+
+   for (const region& region : world.regions) {
+      if (not index.contains(region.description, region.id)) return false;
+   }
+
+   return true;
+}
+
+bool is_light_region_name_index_complete(const world& world) noexcept
+{
+   const entity_name_index<light>& index = world.name_index.light_region_names;
+
+   std::size_t region_light_count = 0;
+
+   for (const light& light : world.lights) {
+      if (not is_region_light(light)) continue;
+
+      if (not index.contains(light.region_name, light.id)) return false;
+
+      region_light_count += 1;
+   }
+
+   return index.size() == region_light_count;
+}
+
+void rebuild_id_indices(world& world) noexcept
+{
+   rebuild_id_index<object>(world);
+   rebuild_id_index<light>(world);
+   rebuild_id_index<path>(world);
+   rebuild_id_index<region>(world);
+   rebuild_id_index<sector>(world);
+   rebuild_id_index<portal>(world);
+   rebuild_id_index<hintnode>(world);
+   rebuild_id_index<barrier>(world);
+   rebuild_id_index<planning_hub>(world);
+   rebuild_id_index<planning_connection>(world);
+   rebuild_id_index<boundary>(world);
+}
+
+void reset_change_logs(world& world) noexcept
+{
+   world.changes.objects.reset();
+   world.changes.lights.reset();
+   world.changes.paths.reset();
+   world.changes.regions.reset();
+   world.changes.sectors.reset();
+   world.changes.portals.reset();
+   world.changes.hintnodes.reset();
+   world.changes.barriers.reset();
+   world.changes.planning_hubs.reset();
+   world.changes.planning_connections.reset();
+   world.changes.boundaries.reset();
+}
+
+template<typename Type>
+auto create_unique_name(const world& world, const std::string_view reference_name)
+   -> std::string
+{
+   if (not is_name_index_complete<Type>(world)) {
+      return create_unique_name_impl(std::span{select_entities<Type>(world)},
+                                     reference_name);
+   }
+
+   if (reference_name.empty()) return "";
+
+   const entity_name_index<Type>& index = select_name_index<Type>(world);
+
+   if (not index.contains(reference_name)) return std::string{reference_name};
+
+   const std::string_view base_name = create_base_name<Type>(reference_name);
+
+   uint32 index_suffix = index.free_suffix(base_name);
+
+   while (true) {
+      std::string candidate_name = fmt::format("{}{}", base_name, index_suffix++);
+
+      if (not index.contains(candidate_name)) return candidate_name;
+   };
+}
+
+template auto create_unique_name<object>(const world&, const std::string_view) -> std::string;
+template auto create_unique_name<light>(const world&, const std::string_view) -> std::string;
+template auto create_unique_name<path>(const world&, const std::string_view) -> std::string;
+template auto create_unique_name<region>(const world&, const std::string_view) -> std::string;
+template auto create_unique_name<sector>(const world&, const std::string_view) -> std::string;
+template auto create_unique_name<portal>(const world&, const std::string_view) -> std::string;
+template auto create_unique_name<hintnode>(const world&, const std::string_view)
+   -> std::string;
+template auto create_unique_name<barrier>(const world&, const std::string_view)
+   -> std::string;
+template auto create_unique_name<planning_hub>(const world&, const std::string_view)
+   -> std::string;
+template auto create_unique_name<planning_connection>(const world&, const std::string_view)
+   -> std::string;
+template auto create_unique_name<boundary>(const world&, const std::string_view)
+   -> std::string;
+
 auto create_unique_name(const std::span<const object> entities,
                         const std::string_view reference_name) -> std::string
 {
@@ -180,6 +331,43 @@ auto create_unique_light_region_name(const std::span<const light> lights,
    };
 }
 
+auto create_unique_light_region_name(const world& world,
+                                     const std::string_view reference_name) -> std::string
+{
+   const entity_name_index<light>& lights = world.name_index.lights;
+   const entity_name_index<light>& light_regions = world.name_index.light_region_names;
+   const entity_name_index<region>& regions = world.name_index.regions;
+
+   if (not is_name_index_complete<light>(world) or
+       not is_name_index_complete<region>(world) or
+       not is_light_region_name_index_complete(world)) {
+      return create_unique_light_region_name(world.lights, world.regions, reference_name);
+   }
+
+   if (not reference_name.empty() and not lights.contains(reference_name) and
+       not regions.contains(reference_name)) {
+      return std::string{reference_name};
+   }
+
+   const std::string_view base_name =
+      create_base_name<light>(reference_name, "LightRegion");
+
+   // Every suffix below an index's free suffix is used by that index.
+   uint32 index = std::max({lights.free_suffix(base_name),
+                            light_regions.free_suffix(base_name),
+                            regions.free_suffix(base_name)});
+
+   while (true) {
+      std::string candidate_name = fmt::format("{}{}", base_name, index++);
+
+      if (not lights.contains(candidate_name) and
+          not light_regions.contains(candidate_name) and
+          not regions.contains(candidate_name)) {
+         return candidate_name;
+      }
+   };
+}
+
 bool is_directional_light(const light& light) noexcept
 {
    switch (light.light_type) {
@@ -2,6 +2,7 @@
 
 #include "../world.hpp"
 
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
@@ -25,39 +26,281 @@ inline auto select_entities(world& world) -> std::vector<Type>&
    if constexpr (std::is_same_v<Type, boundary>) return world.boundaries;
 }
 
-template<typename Type, typename Type_id>
-inline auto find_entity(std::span<Type> entities, const Type_id id) -> Type*
+template<typename Type>
+inline auto select_entities(const world& world) -> const std::vector<Type>&
 {
-   if (auto it = std::lower_bound(entities.begin(), entities.end(), id,
-                                  [](const Type& entity, const Type_id id) {
-                                     return entity.id < id;
-                                  });
-       it != entities.end()) {
-      if (it->id == id) return &(*it);
+   if constexpr (std::is_same_v<Type, object>) return world.objects;
+   if constexpr (std::is_same_v<Type, light>) return world.lights;
+   if constexpr (std::is_same_v<Type, path>) return world.paths;
+   if constexpr (std::is_same_v<Type, region>) return world.regions;
+   if constexpr (std::is_same_v<Type, sector>) return world.sectors;
+   if constexpr (std::is_same_v<Type, portal>) return world.portals;
+   if constexpr (std::is_same_v<Type, hintnode>) return world.hintnodes;
+   if constexpr (std::is_same_v<Type, barrier>) return world.barriers;
+   if constexpr (std::is_same_v<Type, planning_hub>) return world.planning_hubs;
+   if constexpr (std::is_same_v<Type, planning_connection>)
+      return world.planning_connections;
+   if constexpr (std::is_same_v<Type, boundary>) return world.boundaries;
+}
+
+template<typename Type>
+inline auto select_name_index(world& world) -> entity_name_index<Type>&
+{
+   if constexpr (std::is_same_v<Type, object>) return world.name_index.objects;
+   if constexpr (std::is_same_v<Type, light>) return world.name_index.lights;
+   if constexpr (std::is_same_v<Type, path>) return world.name_index.paths;
+   if constexpr (std::is_same_v<Type, region>) return world.name_index.regions;
+   if constexpr (std::is_same_v<Type, sector>) return world.name_index.sectors;
+   if constexpr (std::is_same_v<Type, portal>) return world.name_index.portals;
+   if constexpr (std::is_same_v<Type, hintnode>) return world.name_index.hintnodes;
+   if constexpr (std::is_same_v<Type, barrier>) return world.name_index.barriers;
+   if constexpr (std::is_same_v<Type, planning_hub>)
+      return world.name_index.planning_hubs;
+   if constexpr (std::is_same_v<Type, planning_connection>)
+      return world.name_index.planning_connections;
+   if constexpr (std::is_same_v<Type, boundary>) return world.name_index.boundaries;
+}
+
+template<typename Type>
+inline auto select_name_index(const world& world) -> const entity_name_index<Type>&
+{
+   return select_name_index<Type>(const_cast<struct world&>(world));
+}
+
+/// @brief Check if a light is directional. (It's type is directional or one of the directional_region_* types)
+/// @param light
+/// @return
+bool is_directional_light(const light& light) noexcept;
+
+/// @brief Check if a light has a region.
+/// @param light
+/// @return
+bool is_region_light(const light& light) noexcept;
+
+/// @brief Check if the name index for a type of entity holds exactly the names and IDs
+/// of the entities. Worlds that weren't loaded or built through edits (such as in tests)
+/// may have stale indices, lookups fall back to searching the entities for those. This
+/// checks every entity so it is linear in their count.
+template<typename Type>
+inline bool is_name_index_complete(const world& world) noexcept
+{
+   const entity_name_index<Type>& index = select_name_index<Type>(world);
+   const std::vector<Type>& entities = select_entities<Type>(world);
+
+   if (index.size() != entities.size()) return false;
+
+   for (const Type& entity : entities) {
+      if (not index.contains(entity.name, entity.id)) return false;
    }
 
-   return nullptr;
+   return true;
+}
+
+/// @brief Check if the index of region descriptions holds exactly the descriptions and
+/// IDs of the world's regions. See is_name_index_complete.
+bool is_region_description_index_complete(const world& world) noexcept;
+
+/// @brief Check if the index of light region names holds exactly the region names and
+/// IDs of the world's region lights. See is_name_index_complete.
+bool is_light_region_name_index_complete(const world& world) noexcept;
+
+/// @brief Add an entity to the world's name indices. Call when adding it to the world.
+/// @param world The world.
+/// @param entity The entity.
+template<typename Type>
+inline void index_entity_name(world& world, const Type& entity) noexcept
+{
+   select_name_index<Type>(world).insert(entity.name, entity.id);
+
+   if constexpr (std::is_same_v<Type, region>) {
+      world.name_index.region_descriptions.insert(entity.description, entity.id);
+   }
+
+   if constexpr (std::is_same_v<Type, light>) {
+      if (is_region_light(entity)) {
+         world.name_index.light_region_names.insert(entity.region_name, entity.id);
+      }
+   }
+}
+
+/// @brief Remove an entity from the world's name indices. Call when removing it from the world.
+/// @param world The world.
+/// @param entity The entity.
+template<typename Type>
+inline void unindex_entity_name(world& world, const Type& entity) noexcept
+{
+   select_name_index<Type>(world).erase(entity.name, entity.id);
+
+   if constexpr (std::is_same_v<Type, region>) {
+      world.name_index.region_descriptions.erase(entity.description, entity.id);
+   }
+
+   if constexpr (std::is_same_v<Type, light>) {
+      if (is_region_light(entity)) {
+         world.name_index.light_region_names.erase(entity.region_name, entity.id);
+      }
+   }
+}
+
+/// @brief Rebuild all of the world's name indices from its entities.
+/// @param world The world.
+void rebuild_name_indices(world& world) noexcept;
+
+template<typename Type>
+inline auto select_id_index(world& world) -> entity_id_index<Type>&
+{
+   if constexpr (std::is_same_v<Type, object>) return world.id_index.objects;
+   if constexpr (std::is_same_v<Type, light>) return world.id_index.lights;
+   if constexpr (std::is_same_v<Type, path>) return world.id_index.paths;
+   if constexpr (std::is_same_v<Type, region>) return world.id_index.regions;
+   if constexpr (std::is_same_v<Type, sector>) return world.id_index.sectors;
+   if constexpr (std::is_same_v<Type, portal>) return world.id_index.portals;
+   if constexpr (std::is_same_v<Type, hintnode>) return world.id_index.hintnodes;
+   if constexpr (std::is_same_v<Type, barrier>) return world.id_index.barriers;
+   if constexpr (std::is_same_v<Type, planning_hub>) return world.id_index.planning_hubs;
+   if constexpr (std::is_same_v<Type, planning_connection>)
+      return world.id_index.planning_connections;
+   if constexpr (std::is_same_v<Type, boundary>) return world.id_index.boundaries;
+}
+
+template<typename Type>
+inline auto select_id_index(const world& world) -> const entity_id_index<Type>&
+{
+   return select_id_index<Type>(const_cast<struct world&>(world));
 }
 
 template<typename Type>
-inline auto find_entity(std::vector<Type>& entities,
-                        const id<std::type_identity_t<Type>> id) -> Type*
+inline auto select_id_generator(world& world) -> id_generator<Type>&
 {
-   return find_entity(std::span<Type>{entities.data(), entities.size()}, id);
+   if constexpr (std::is_same_v<Type, object>) return world.next_id.objects;
+   if constexpr (std::is_same_v<Type, light>) return world.next_id.lights;
+   if constexpr (std::is_same_v<Type, path>) return world.next_id.paths;
+   if constexpr (std::is_same_v<Type, region>) return world.next_id.regions;
+   if constexpr (std::is_same_v<Type, sector>) return world.next_id.sectors;
+   if constexpr (std::is_same_v<Type, portal>) return world.next_id.portals;
+   if constexpr (std::is_same_v<Type, hintnode>) return world.next_id.hintnodes;
+   if constexpr (std::is_same_v<Type, barrier>) return world.next_id.barriers;
+   if constexpr (std::is_same_v<Type, planning_hub>) return world.next_id.planning_hubs;
+   if constexpr (std::is_same_v<Type, planning_connection>)
+      return world.next_id.planning_connections;
+   if constexpr (std::is_same_v<Type, boundary>) return world.next_id.boundaries;
 }
 
+/// @brief Update the world's ID index for a type of entity. Call after inserting or
+/// removing entities.
+/// @param world The world.
+/// @param first The index of the first entity that was inserted or removed.
 template<typename Type>
-inline auto find_entity(const std::vector<Type>& entities,
-                        const id<std::type_identity_t<Type>> id) -> const Type*
+inline void update_id_index(world& world, const std::size_t first = 0) noexcept
 {
-   return find_entity(std::span<const Type>{entities.data(), entities.size()}, id);
+   select_id_index<Type>(world).update(select_entities<Type>(world), first);
 }
 
+/// @brief Remove an entity from the world's ID index for its type and update the
+/// indices of the entities after it. Call after removing the entity.
+///
+/// Like the vector erase this costs about the number of entities after index. An edit
+/// that removes several entities should erase their IDs from select_id_index and call
+/// update_id_index once from the lowest index instead.
+/// @param world The world.
+/// @param id The ID of the removed entity.
+/// @param index The index the entity was removed from.
+template<typename Type>
+inline void unindex_entity_id(world& world, const id<std::type_identity_t<Type>> id,
+                              const std::size_t index) noexcept
+{
+   select_id_index<Type>(world).erase(id);
+
+   update_id_index<Type>(world, index);
+}
+
+/// @brief Rebuild all of the world's ID indices from its entities.
+/// @param world The world.
+void rebuild_id_indices(world& world) noexcept;
+
+/// @brief Find the index of an entity in the world's vector of its type.
+/// @param world The world.
+/// @param id The ID of the entity.
+/// @return The index of the entity or nullopt if it isn't in the world.
+template<typename Type>
+inline auto find_entity_index(const world& world,
+                              const id<std::type_identity_t<Type>> id) noexcept
+   -> std::optional<std::size_t>
+{
+   return select_id_index<Type>(world).find(select_entities<Type>(world), id);
+}
+
+template<typename Type>
+inline auto select_change_log(world& world) -> change_log<Type>&
+{
+   if constexpr (std::is_same_v<Type, object>) return world.changes.objects;
+   if constexpr (std::is_same_v<Type, light>) return world.changes.lights;
+   if constexpr (std::is_same_v<Type, path>) return world.changes.paths;
+   if constexpr (std::is_same_v<Type, region>) return world.changes.regions;
+   if constexpr (std::is_same_v<Type, sector>) return world.changes.sectors;
+   if constexpr (std::is_same_v<Type, portal>) return world.changes.portals;
+   if constexpr (std::is_same_v<Type, hintnode>) return world.changes.hintnodes;
+   if constexpr (std::is_same_v<Type, barrier>) return world.changes.barriers;
+   if constexpr (std::is_same_v<Type, planning_hub>) return world.changes.planning_hubs;
+   if constexpr (std::is_same_v<Type, planning_connection>)
+      return world.changes.planning_connections;
+   if constexpr (std::is_same_v<Type, boundary>) return world.changes.boundaries;
+}
+
+template<typename Type>
+inline auto select_change_log(const world& world) -> const change_log<Type>&
+{
+   return select_change_log<Type>(const_cast<struct world&>(world));
+}
+
+/// @brief Record a change to an entity in the world's change log for its type. Every
+/// edit that changes an entity must record it, readers of the logs rely on it.
+/// @param world The world.
+/// @param id The ID of the entity that changed.
+/// @param type The type of change.
+/// @param index For inserts and removes the index the entity was inserted at or removed
+/// from.
+template<typename Type>
+inline void record_change(world& world, const id<std::type_identity_t<Type>> id,
+                          const change_type type, const std::size_t index = 0) noexcept
+{
+   select_change_log<Type>(world).record(id, type, index);
+}
+
+/// @brief Reset all of the world's change logs. For edits that change entities wholesale.
+/// @param world The world.
+void reset_change_logs(world& world) noexcept;
+
+/// @brief Find an entity by ID using the world's ID index.
+/// @param world The world.
+/// @param id The ID of the entity.
+/// @return The entity or nullptr.
 template<typename Type>
 inline auto find_entity(world& world, const id<std::type_identity_t<Type>> id)
    -> Type*
 {
-   return find_entity(select_entities<Type>(world), id);
+   if (const std::optional<std::size_t> index = find_entity_index<Type>(world, id);
+       index) {
+      return &select_entities<Type>(world)[*index];
+   }
+
+   return nullptr;
+}
+
+/// @brief Find an entity by ID using the world's ID index.
+/// @param world The world.
+/// @param id The ID of the entity.
+/// @return The entity or nullptr.
+template<typename Type>
+inline auto find_entity(const world& world, const id<std::type_identity_t<Type>> id)
+   -> const Type*
+{
+   if (const std::optional<std::size_t> index = find_entity_index<Type>(world, id);
+       index) {
+      return &select_entities<Type>(world)[*index];
+   }
+
+   return nullptr;
 }
 
 template<typename Type>
@@ -71,19 +314,110 @@ inline auto find_entity(const std::vector<Type>& entities, const std::string_vie
    return nullptr;
 }
 
+/// @brief Find the entity out of some that comes first in the world's vector of them.
+/// @param world The world.
+/// @param ids The IDs of the entities.
+/// @return The entity or nullptr if none of the IDs are in the world.
+template<typename Type>
+inline auto find_first_entity(const world& world, const std::span<const id<Type>> ids)
+   -> const Type*
+{
+   std::optional<std::size_t> first;
+
+   for (const id<Type> id : ids) {
+      const std::optional<std::size_t> index = find_entity_index<Type>(world, id);
+
+      if (index and (not first or *index < *first)) first = index;
+   }
+
+   if (not first) return nullptr;
+
+   return &select_entities<Type>(world)[*first];
+}
+
+/// @brief Find an entity by name using the world's name index.
+/// @param world The world.
+/// @param name The name of the entity.
+/// @return The first entity in the world's vector of them with the name or nullptr.
+template<typename Type>
+inline auto find_entity(const world& world, const std::string_view name) -> const Type*
+{
+   if (not is_name_index_complete<Type>(world)) {
+      return find_entity(select_entities<Type>(world), name);
+   }
+
+   return find_first_entity<Type>(world, select_name_index<Type>(world).find(name));
+}
+
 inline auto find_region(const world& world, const std::string_view name) -> const region*
 {
-   return find_entity(world.regions, name);
+   return find_entity<region>(world, name);
 }
 
 inline auto find_region_by_description(const world& world, const std::string_view description)
    -> const region*
 {
-   for (auto& region : world.regions) {
-      if (region.description == description) return &region;
+   if (not is_region_description_index_complete(world)) {
+      for (auto& region : world.regions) {
+         if (region.description == description) return &region;
+      }
+
+      return nullptr;
    }
 
-   return nullptr;
+   return find_first_entity<region>(
+      world, world.name_index.region_descriptions.find(description));
+}
+
+/// @brief Set a member of an entity, keeping the world's name indices up to date if
+/// the member is a name.
+/// @param world The world.
+/// @param id The ID of the entity.
+/// @param value_member_ptr The member to set.
+/// @param value The value to set the member to.
+template<typename Type, typename T>
+inline void set_entity_value(world& world, const id<std::type_identity_t<Type>> id,
+                             T Type::*value_member_ptr, const T& value) noexcept
+{
+   Type* entity = find_entity<Type>(world, id);
+
+   if constexpr (std::is_same_v<T, std::string>) {
+      if (value_member_ptr == &Type::name) {
+         select_name_index<Type>(world).rename(entity->name, value, id);
+      }
+
+      if constexpr (std::is_same_v<Type, region>) {
+         if (value_member_ptr == &region::description) {
+            world.name_index.region_descriptions.rename(entity->description, value, id);
+         }
+      }
+
+      if constexpr (std::is_same_v<Type, light>) {
+         if (value_member_ptr == &light::region_name and is_region_light(*entity)) {
+            world.name_index.light_region_names.rename(entity->region_name, value, id);
+         }
+      }
+   }
+
+   if constexpr (std::is_same_v<Type, light> and std::is_same_v<T, light_type>) {
+      // Only region lights have their region name indexed.
+      if (value_member_ptr == &light::light_type) {
+         const bool was_region_light = is_region_light(*entity);
+
+         entity->light_type = value;
+
+         if (was_region_light and not is_region_light(*entity)) {
+            world.name_index.light_region_names.erase(entity->region_name, id);
+         }
+         else if (not was_region_light and is_region_light(*entity)) {
+            world.name_index.light_region_names.insert(entity->region_name, id);
+         }
+
+         return;
+      }
+   }
+
+   entity->*value_member_ptr = value;
 }
 
 auto create_unique_name(const std::span<const object> entities,
@@ -119,20 +453,35 @@ auto create_unique_name(const std::span<const planning_connection> entities,
 auto create_unique_name(const std::span<const boundary> entities,
                         const std::string_view reference_name) -> std::string;
 
+/// @brief Create a unique name for an entity using the world's name index. The result
+/// is the same as the create_unique_name overloads taking entities but doesn't need to
+/// search the world's entities.
+/// @param world The world.
+/// @param reference_name The name to base the unique name on.
+/// @return The reference name if it's unique or the reference name with the lowest free
+/// numeric suffix.
+template<typename Type>
+auto create_unique_name(const world& world, const std::string_view reference_name)
+   -> std::string;
+
+/// @brief Create a name for a region light's region that isn't used by any light, region
+/// or light region. The region names of lights that aren't region lights are also
+/// treated as used, they come back if the light is made a region light again.
+/// @param lights The lights.
+/// @param regions The regions.
+/// @param reference_name The name to base the unique name on.
 auto create_unique_light_region_name(const std::span<const light> lights,
                                      const std::span<const region> regions,
                                      const std::string_view reference_name)
    -> std::string;
 
-/// @brief Check if a light is directional. (It's type is directional or one of the directional_region_* types)
-/// @param light
-/// @return
-bool is_directional_light(const light& light) noexcept;
-
-/// @brief Check if a light has a region.
-/// @param light
-/// @return
-bool is_region_light(const light& light) noexcept;
+/// @brief Create a name for a region light's region using the world's name indices. The
+/// result is the same as the overload taking lights and regions.
+/// @param world The world.
+/// @param reference_name The name to base the unique name on.
+auto create_unique_light_region_name(const world& world,
+                                     const std::string_view reference_name)
+   -> std::string;
 
 struct clostest_node_result {
    /// @brief The index of the closest node.
@@ -2,6 +2,9 @@
 
 #include "barrier.hpp"
 #include "boundary.hpp"
+#include "change_log.hpp"
+#include "entity_id_index.hpp"
+#include "entity_name_index.hpp"
 #include "game_mode_description.hpp"
 #include "global_lights.hpp"
 #include "hintnode.hpp"
@@ -46,8 +49,55 @@ struct world {
    std::vector<planning_connection> planning_connections;
    std::vector<boundary> boundaries;
 
-   /// @brief Maps planning hub IDs to their index in planning_hubs.
-   absl::flat_hash_map<planning_hub_id, std::size_t> planning_hub_index;
+   /// @brief Logs of changes made to entities by edits, see record_change.
+   struct change_logs {
+      change_log<object> objects;
+      change_log<light> lights;
+      change_log<path> paths;
+      change_log<region> regions;
+      change_log<sector> sectors;
+      change_log<portal> portals;
+      change_log<hintnode> hintnodes;
+      change_log<barrier> barriers;
+      change_log<planning_hub> planning_hubs;
+      change_log<planning_connection> planning_connections;
+      change_log<boundary> boundaries;
+   } changes;
+
+   /// @brief Indices for finding entities by name. Kept up to date by edits, see
+   /// index_entity_name and unindex_entity_name.
+   struct name_indices {
+      entity_name_index<object> objects;
+      entity_name_index<light> lights;
+      entity_name_index<path> paths;
+      entity_name_index<region> regions;
+      entity_name_index<sector> sectors;
+      entity_name_index<portal> portals;
+      entity_name_index<hintnode> hintnodes;
+      entity_name_index<barrier> barriers;
+      entity_name_index<planning_hub> planning_hubs;
+      entity_name_index<planning_connection> planning_connections;
+      entity_name_index<boundary> boundaries;
+
+      entity_name_index<region> region_descriptions;
+      entity_name_index<light> light_region_names;
+   } name_index;
+
+   /// @brief Indices mapping entity IDs to their index in the entity vectors. Kept up
+   /// to date by edits, see find_entity_index and update_id_index.
+   struct id_indices {
+      entity_id_index<object> objects;
+      entity_id_index<light> lights;
+      entity_id_index<path> paths;
+      entity_id_index<region> regions;
+      entity_id_index<sector> sectors;
+      entity_id_index<portal> portals;
+      entity_id_index<hintnode> hintnodes;
+      entity_id_index<barrier> barriers;
+      entity_id_index<planning_hub> planning_hubs;
+      entity_id_index<planning_connection> planning_connections;
+      entity_id_index<boundary> boundaries;
+   } id_index;
 
    /// @brief Vector of layers to garbage collect the files of at save time.
    std::vector<std::string> deleted_layers;
@@ -8,12 +8,14 @@
 #include "utility/stopwatch.hpp"
 #include "utility/string_icompare.hpp"
 #include "utility/string_ops.hpp"
+#include "utility/world_utilities.hpp"
 
 #include <algorithm>
 #include <cmath>
 
 #include <absl/container/flat_hash_map.h>
 #include <absl/container/flat_hash_set.h>
+#include <absl/container/inlined_vector.h>
 
 #include <fmt/core.h>
 
@@ -660,15 +662,12 @@ void load_planning(const std::filesystem::path& filepath, output_stream& output,
       absl::flat_hash_map<std::string_view, planning_hub_id> hub_map;
       hub_map.reserve(world_out.planning_hubs.size());
 
-      world_out.planning_hub_index.reserve(world_out.planning_hubs.size());
-
-      for (std::size_t i = 0; i < world_out.planning_hubs.size(); ++i) {
-         const planning_hub& hub = world_out.planning_hubs[i];
-
-         world_out.planning_hub_index.emplace(hub.id, i);
+      for (const planning_hub& hub : world_out.planning_hubs) {
          hub_map.emplace(hub.name, hub.id);
       }
 
+      update_id_index<planning_hub>(world_out);
+
       for (auto& key_node : planning) {
          if (key_node.key == "Connection") {
             planning_connection& connection =
@@ -738,8 +737,8 @@ void load_planning(const std::filesystem::path& filepath, output_stream& output,
          planning_connection& connection =
             *connection_map.at(branch_weight.connection);
          planning_branch_weights& weights =
-            world_out.planning_hubs[world_out.planning_hub_index.at(connection.start)]
-                     .name == branch_weight.start_hub
+            find_entity<planning_hub>(world_out, connection.start)->name ==
+                  branch_weight.start_hub
                ? connection.forward_weights
                : connection.backward_weights;
 
@@ -1019,13 +1018,26 @@ void convert_light_regions(world& world)
 
 void convert_boundaries(world& world, output_stream& output)
 {
+   if (world.boundaries.empty()) return;
+
+   // Each boundary uses up the first remaining path with its name. The indices are
+   // stored in reverse so the first path is at the back.
+   absl::flat_hash_map<std::string_view, absl::InlinedVector<std::size_t, 1>> path_indices;
+
+   path_indices.reserve(world.paths.size());
+
+   for (std::size_t i = world.paths.size(); i > 0; --i) {
+      path_indices[world.paths[i - 1].name].push_back(i - 1);
+   }
+
+   std::vector<bool> boundary_paths;
+
+   boundary_paths.resize(world.paths.size());
+
    for (auto& boundary : world.boundaries) {
-      auto path = std::find_if(world.paths.begin(), world.paths.end(),
-                               [&](const we::world::path& path) {
-                                  return path.name == boundary.name;
-                               });
+      auto path_index = path_indices.find(boundary.name);
 
-      if (path == world.paths.end()) {
+      if (path_index == path_indices.end() or path_index->second.empty()) {
          output.write("Warning! Boundary '{}' is missing it's path. The "
                       "default size({:f}, {:f}) and position({:f}, {:f}) "
                       "will be used for the boundary.\n",
@@ -1035,12 +1047,18 @@ void convert_boundaries(world& world, output_stream& output)
          continue;
       }
 
+      const std::size_t index = path_index->second.back();
+
+      path_index->second.pop_back();
+
+      const path& path = world.paths[index];
+
       float2 min_node = {std::numeric_limits<float>::max(),
                          std::numeric_limits<float>::max()};
       float2 max_node = {std::numeric_limits<float>::lowest(),
                          std::numeric_limits<float>::lowest()};
 
-      for (auto& node : path->nodes) {
+      for (auto& node : path.nodes) {
          min_node = min(float2{node.position.x, node.position.z}, min_node);
          max_node = max(float2{node.position.x, node.position.z}, max_node);
       }
@@ -1048,8 +1066,22 @@ void convert_boundaries(world& world, output_stream& output)
       boundary.position = (min_node + max_node) / 2.0f;
       boundary.size = abs(max_node - min_node) / 2.0f;
 
-      world.paths.erase(path);
+      boundary_paths[index] = true;
+   }
+
+   path_indices.clear();
+
+   std::size_t kept_paths = 0;
+
+   for (std::size_t i = 0; i < world.paths.size(); ++i) {
+      if (boundary_paths[i]) continue;
+
+      if (kept_paths != i) world.paths[kept_paths] = std::move(world.paths[i]);
+
+      kept_paths += 1;
    }
+
+   world.paths.resize(kept_paths);
 }
 
 void ensure_common_game_mode(world& world) noexcept
@@ -1089,6 +1121,8 @@ auto load_world(const std::filesystem::path& path, output_stream& output) -> wor
       convert_light_regions(world);
       convert_boundaries(world, output);
       ensure_common_game_mode(world);
+      rebuild_name_indices(world);
+      rebuild_id_indices(world);
 
       try {
          utility::stopwatch load_timer;
@@ -4,6 +4,7 @@
 #include "math/vector_funcs.hpp"
 #include "utility/boundary_nodes.hpp"
 #include "utility/string_icompare.hpp"
+#include "utility/world_utilities.hpp"
 
 #include <cctype>
 #include <cstddef>
@@ -130,8 +131,7 @@ auto get_hub_branch_weight_refs(const world& world)
          const auto process_weight = [&](const float weight, const ai_path_flags flag) {
             if (weight != 0.0f) {
                refs[start_hub].push_back(
-                  {.end_hub =
-                      world.planning_hubs[world.planning_hub_index.at(end_hub)].name,
+                  {.end_hub = find_entity<planning_hub>(world, end_hub)->name,
                    .weight = weight,
                    .connection = connection.name,
                    .flag = flag});
@@ -650,12 +650,10 @@ void save_planning(const std::filesystem::path& path, const world& world)
       file.write_ln("Connection(\"{}\")", connection.name);
       file.write_ln("{");
 
-      file.write_ln(
-         "\tStart(\"{}\");",
-         world.planning_hubs[world.planning_hub_index.at(connection.start)].name);
-      file.write_ln(
-         "\tEnd(\"{}\");",
-         world.planning_hubs[world.planning_hub_index.at(connection.end)].name);
+      file.write_ln("\tStart(\"{}\");",
+                    find_entity<planning_hub>(world, connection.start)->name);
+      file.write_ln("\tEnd(\"{}\");",
+                    find_entity<planning_hub>(world, connection.end)->name);
       file.write_ln("\tFlag({});", static_cast<int>(connection.flags));
 
       if (connection.dynamic_group != 0) {
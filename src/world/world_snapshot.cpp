@@ -0,0 +1,131 @@
+#include "world_snapshot.hpp"
+#include "utility/world_utilities.hpp"
+
+namespace we::world {
+
+namespace {
+
+template<typename T>
+auto make_vector(const container::cow_chunked_array<T>& array) -> std::vector<T>
+{
+   std::vector<T> vector;
+
+   vector.reserve(array.size());
+
+   for (std::size_t i = 0; i < array.chunk_count(); ++i) {
+      const std::span<const T> values = array.chunk_values(i);
+
+      vector.insert(vector.end(), values.begin(), values.end());
+   }
+
+   return vector;
+}
+
+}
+
+auto world_snapshotter::snapshot(const world& world) -> world_snapshot
+{
+   _snapshot.name = world.name;
+   _snapshot.requirements = world.requirements;
+   _snapshot.layer_descriptions = world.layer_descriptions;
+   _snapshot.game_modes = world.game_modes;
+   _snapshot.global_lights = world.global_lights;
+
+   update_entities(world, _snapshot.objects, _cursors.objects);
+   update_entities(world, _snapshot.lights, _cursors.lights);
+   update_entities(world, _snapshot.paths, _cursors.paths);
+   update_entities(world, _snapshot.regions, _cursors.regions);
+   update_entities(world, _snapshot.sectors, _cursors.sectors);
+   update_entities(world, _snapshot.portals, _cursors.portals);
+   update_entities(world, _snapshot.hintnodes, _cursors.hintnodes);
+   update_entities(world, _snapshot.barriers, _cursors.barriers);
+   update_entities(world, _snapshot.planning_hubs, _cursors.planning_hubs);
+   update_entities(world, _snapshot.planning_connections, _cursors.planning_connections);
+   update_entities(world, _snapshot.boundaries, _cursors.boundaries);
+
+   _snapshot.deleted_layers = world.deleted_layers;
+   _snapshot.deleted_game_modes = world.deleted_game_modes;
+   _snapshot.next_id = world.next_id;
+
+   return _snapshot;
+}
+
+void world_snapshotter::reset() noexcept
+{
+   _snapshot = {};
+   _cursors = {};
+}
+
+template<typename T>
+void world_snapshotter::update_entities(const world& world,
+                                        world_snapshot::entity_array<T>& entities,
+                                        typename change_log<T>::cursor& cursor)
+{
+   const change_log<T>& log = select_change_log<T>(world);
+   const std::vector<T>& world_entities = select_entities<T>(world);
+
+   const std::optional<std::span<const typename change_log<T>::change>> changes =
+      log.changes_since(cursor);
+
+   cursor = log.current();
+
+   if (not changes) {
+      entities.assign(world_entities);
+
+      return;
+   }
+
+   // Inserting or removing shifts every entity after it, entities before the first one
+   // are where they were.
+   std::size_t first_moved = std::min(entities.size(), world_entities.size());
+
+   for (const auto& change : *changes) {
+      if (change.type != change_type::modify) {
+         first_moved = std::min(first_moved, std::size_t{change.index});
+      }
+   }
+
+   for (const auto& change : *changes) {
+      if (change.type != change_type::modify) continue;
+
+      const std::optional<std::size_t> index = find_entity_index<T>(world, change.id);
+
+      if (not index or *index >= first_moved) continue;
+
+      entities.mutate(*index) = world_entities[*index];
+   }
+
+   if (first_moved < entities.size() or entities.size() != world_entities.size()) {
+      entities.assign(world_entities, first_moved);
+   }
+}
+
+auto make_world(const world_snapshot& snapshot) -> world
+{
+   world world{.name = snapshot.name,
+               .requirements = snapshot.requirements,
+               .layer_descriptions = snapshot.layer_descriptions,
+               .game_modes = snapshot.game_modes,
+               .global_lights = snapshot.global_lights,
+               .objects = make_vector(snapshot.objects),
+               .lights = make_vector(snapshot.lights),
+               .paths = make_vector(snapshot.paths),
+               .regions = make_vector(snapshot.regions),
+               .sectors = make_vector(snapshot.sectors),
+               .portals = make_vector(snapshot.portals),
+               .hintnodes = make_vector(snapshot.hintnodes),
+               .barriers = make_vector(snapshot.barriers),
+               .planning_hubs = make_vector(snapshot.planning_hubs),
+               .planning_connections = make_vector(snapshot.planning_connections),
+               .boundaries = make_vector(snapshot.boundaries),
+               .deleted_layers = snapshot.deleted_layers,
+               .deleted_game_modes = snapshot.deleted_game_modes,
+               .next_id = snapshot.next_id};
+
+   rebuild_id_indices(world);
+   rebuild_name_indices(world);
+
+   return world;
+}
+
+}
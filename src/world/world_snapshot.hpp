@@ -0,0 +1,95 @@
+#pragma once
+
+#include "change_log.hpp"
+#include "container/cow_chunked_array.hpp"
+#include "world.hpp"
+
+#include <string>
+#include <vector>
+
+namespace we::world {
+
+/// @brief An immutable copy of a world's entities that shares storage with other
+/// snapshots of the same world. Cheap enough to take every frame and safe to hand to
+/// another thread for autosaving, validation, diffing and the like.
+///
+/// The terrain is not included.
+struct world_snapshot {
+   template<typename T>
+   using entity_array = container::cow_chunked_array<T>;
+
+   std::string name;
+
+   std::vector<requirement_list> requirements;
+
+   std::vector<layer_description> layer_descriptions;
+   std::vector<game_mode_description> game_modes;
+
+   global_lights global_lights;
+
+   entity_array<object> objects;
+   entity_array<light> lights;
+   entity_array<path> paths;
+   entity_array<region> regions;
+   entity_array<sector> sectors;
+   entity_array<portal> portals;
+   entity_array<hintnode> hintnodes;
+   entity_array<barrier> barriers;
+   entity_array<planning_hub> planning_hubs;
+   entity_array<planning_connection> planning_connections;
+   entity_array<boundary> boundaries;
+
+   std::vector<std::string> deleted_layers;
+   std::vector<std::string> deleted_game_modes;
+
+   world::next_ids next_id;
+};
+
+/// @brief Takes snapshots of a world. Each snapshot shares the chunks of entities that
+/// haven't changed since the previous one, only chunks that changed are copied.
+///
+/// Entities are kept current from the world's change logs. An entity type with no
+/// changes costs nothing, modifying entities costs about the number that changed.
+/// Inserting or removing an entity compares the entities from where it was inserted or
+/// removed to the end, as those all moved. When a change log can't say what changed,
+/// such as after the world is replaced or the log is reset, every entity of that type is
+/// compared.
+class world_snapshotter {
+public:
+   /// @brief Take a snapshot of a world.
+   /// @param world The world.
+   /// @return The snapshot.
+   [[nodiscard]] auto snapshot(const world& world) -> world_snapshot;
+
+   /// @brief Discard the previous snapshot so the next one copies every entity.
+   void reset() noexcept;
+
+private:
+   template<typename T>
+   void update_entities(const world& world, world_snapshot::entity_array<T>& entities,
+                        typename change_log<T>::cursor& cursor);
+
+   world_snapshot _snapshot;
+
+   struct cursors {
+      change_log<object>::cursor objects;
+      change_log<light>::cursor lights;
+      change_log<path>::cursor paths;
+      change_log<region>::cursor regions;
+      change_log<sector>::cursor sectors;
+      change_log<portal>::cursor portals;
+      change_log<hintnode>::cursor hintnodes;
+      change_log<barrier>::cursor barriers;
+      change_log<planning_hub>::cursor planning_hubs;
+      change_log<planning_connection>::cursor planning_connections;
+      change_log<boundary>::cursor boundaries;
+   } _cursors;
+};
+
+/// @brief Make a world from a snapshot. Copies every entity so this is best called on the
+/// thread that will use the world. The world's terrain is left empty.
+/// @param snapshot The snapshot.
+/// @return The world.
+auto make_world(const world_snapshot& snapshot) -> world;
+
+}
@@ -0,0 +1,99 @@
+#include "pch.h"
+
+#include "assets/terrain/terrain.hpp"
+#include "assets/terrain/terrain_collision.hpp"
+
+using namespace Catch::literals;
+
+namespace we::assets::terrain::tests {
+
+namespace {
+
+auto make_test_terrain() -> terrain
+{
+   terrain terrain{.length = 16, .height_scale = 0.5f, .grid_scale = 2.0f};
+
+   for (int16& height : terrain.height_map) height = 4;
+
+   return terrain;
+}
+
+}
+
+TEST_CASE("terrain collision raycast", "[Assets][Terrain]")
+{
+   const terrain terrain = make_test_terrain();
+   const terrain_collision collision{terrain};
+
+   auto hit = collision.raycast({0.0f, 10.0f, 0.0f}, {0.0f, -1.0f, 0.0f});
+
+   REQUIRE(hit);
+   CHECK(hit->distance == 8.0_a);
+
+   CHECK(not collision.raycast({0.0f, 10.0f, 0.0f}, {0.0f, 1.0f, 0.0f}));
+   CHECK(not collision.raycast({100.0f, 10.0f, 0.0f}, {0.0f, -1.0f, 0.0f}));
+}
+
+TEST_CASE("terrain collision raycast closest hit", "[Assets][Terrain]")
+{
+   terrain terrain = make_test_terrain();
+
+   for (int16 x = 10; x < 12; ++x) {
+      for (int16 z = 0; z < 16; ++z) terrain.height_map[{x, z}] = 16;
+   }
+
+   const terrain_collision collision{terrain};
+
+   // Shoot along +X from under the raised strip, it should hit the strip's wall and not the far flat terrain.
+   auto hit = collision.raycast({-15.0f, 4.0f, 1.5f}, {1.0f, 0.0f, 0.0f});
+
+   REQUIRE(hit);
+   CHECK(hit->distance < 20.0f);
+   CHECK(hit->distance > 15.0f);
+}
+
+TEST_CASE("terrain collision update_region", "[Assets][Terrain]")
+{
+   terrain terrain = make_test_terrain();
+   terrain_collision collision{terrain};
+
+   terrain.height_map[{8, 7}] = 12;
+   terrain.height_map[{8, 8}] = 12;
+   terrain.height_map[{9, 7}] = 12;
+   terrain.height_map[{9, 8}] = 12;
+
+   collision.update_region({.left = 8, .top = 7, .right = 10, .bottom = 9});
+
+   auto hit = collision.raycast({1.0f, 20.0f, 1.0f}, {0.0f, -1.0f, 0.0f});
+
+   REQUIRE(hit);
+   CHECK(hit->distance == 14.0_a);
+
+   terrain.height_map[{8, 7}] = 4;
+   terrain.height_map[{8, 8}] = 4;
+   terrain.height_map[{9, 7}] = 4;
+   terrain.height_map[{9, 8}] = 4;
+
+   collision.update_region({.left = 8, .top = 7, .right = 10, .bottom = 9});
+
+   hit = collision.raycast({1.0f, 20.0f, 1.0f}, {0.0f, -1.0f, 0.0f});
+
+   REQUIRE(hit);
+   CHECK(hit->distance == 18.0_a);
+}
+
+TEST_CASE("terrain collision update_region out of range", "[Assets][Terrain]")
+{
+   terrain terrain = make_test_terrain();
+   terrain_collision collision{terrain};
+
+   collision.update_region({.left = 12, .top = 12, .right = 64, .bottom = 64});
+   collision.update_region({.left = 64, .top = 64, .right = 128, .bottom = 128});
+
+   auto hit = collision.raycast({0.0f, 10.0f, 0.0f}, {0.0f, -1.0f, 0.0f});
+
+   REQUIRE(hit);
+   CHECK(hit->distance == 8.0_a);
+}
+
+}
@@ -0,0 +1,140 @@
+#include "pch.h"
+
+#include "container/cow_chunked_array.hpp"
+
+#include <array>
+#include <vector>
+
+namespace we::container::tests {
+
+TEST_CASE("cow_chunked_array default construct", "[Container][CowChunkedArray]")
+{
+   cow_chunked_array<int, 4> array;
+
+   CHECK(array.empty());
+   CHECK(array.size() == 0);
+   CHECK(array.chunk_count() == 0);
+   CHECK(array.begin() == array.end());
+}
+
+TEST_CASE("cow_chunked_array push_back", "[Container][CowChunkedArray]")
+{
+   cow_chunked_array<int, 4> array;
+
+   for (int i = 0; i < 9; ++i) array.push_back(i);
+
+   REQUIRE(array.size() == 9);
+   CHECK(array.chunk_count() == 3);
+
+   for (int i = 0; i < 9; ++i) CHECK(array[i] == i);
+
+   CHECK(std::vector<int>{array.begin(), array.end()} ==
+         std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8});
+}
+
+TEST_CASE("cow_chunked_array copy shares chunks", "[Container][CowChunkedArray]")
+{
+   const std::array values{0, 1, 2, 3, 4, 5, 6, 7, 8};
+
+   cow_chunked_array<int, 4> array{values};
+   const cow_chunked_array<int, 4> copy = array;
+
+   CHECK(array.shares_chunk(copy, 0));
+   CHECK(array.shares_chunk(copy, 1));
+   CHECK(array.shares_chunk(copy, 2));
+
+   array.mutate(5) = 50;
+
+   CHECK(array[5] == 50);
+   CHECK(copy[5] == 5);
+   CHECK(array.shares_chunk(copy, 0));
+   CHECK(not array.shares_chunk(copy, 1));
+   CHECK(array.shares_chunk(copy, 2));
+
+   // The chunk is no longer shared so writing to it again doesn't clone it.
+   const int* const value_address = &array[4];
+
+   array.mutate(4) = 40;
+
+   CHECK(&array[4] == value_address);
+   CHECK(copy[4] == 4);
+}
+
+TEST_CASE("cow_chunked_array push_back after copy", "[Container][CowChunkedArray]")
+{
+   const std::array values{0, 1, 2, 3, 4, 5};
+
+   cow_chunked_array<int, 4> array{values};
+   const cow_chunked_array<int, 4> copy = array;
+
+   array.push_back(6);
+
+   CHECK(array.size() == 7);
+   CHECK(copy.size() == 6);
+   CHECK(array.shares_chunk(copy, 0));
+   CHECK(not array.shares_chunk(copy, 1));
+   CHECK(copy.chunk_values(1).size() == 2);
+}
+
+TEST_CASE("cow_chunked_array assign keeps equal chunks", "[Container][CowChunkedArray]")
+{
+   std::vector<int> values{0, 1, 2, 3, 4, 5, 6, 7, 8};
+
+   cow_chunked_array<int, 4> array{values};
+   const cow_chunked_array<int, 4> copy = array;
+
+   values[1] = 10;
+
+   array.assign(values);
+
+   CHECK(array[1] == 10);
+   CHECK(copy[1] == 1);
+   CHECK(not array.shares_chunk(copy, 0));
+   CHECK(array.shares_chunk(copy, 1));
+   CHECK(array.shares_chunk(copy, 2));
+
+   values.resize(6);
+
+   array.assign(values);
+
+   CHECK(array.size() == 6);
+   CHECK(array.chunk_count() == 2);
+   CHECK(not array.shares_chunk(copy, 1));
+   CHECK(copy.size() == 9);
+   CHECK(std::vector<int>{copy.begin(), copy.end()} ==
+         std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8});
+}
+
+TEST_CASE("cow_chunked_array assign from first", "[Container][CowChunkedArray]")
+{
+   std::vector<int> values{0, 1, 2, 3, 4, 5, 6, 7, 8};
+
+   cow_chunked_array<int, 4> array{values};
+   const cow_chunked_array<int, 4> copy = array;
+
+   values.erase(values.begin() + 5);
+
+   array.assign(values, 5);
+
+   CHECK(array.size() == 8);
+   CHECK(array.chunk_count() == 2);
+   CHECK(array.shares_chunk(copy, 0));
+   CHECK(not array.shares_chunk(copy, 1));
+   CHECK(std::vector<int>{array.begin(), array.end()} == values);
+}
+
+TEST_CASE("cow_chunked_array clear", "[Container][CowChunkedArray]")
+{
+   const std::array values{0, 1, 2, 3, 4};
+
+   cow_chunked_array<int, 4> array{values};
+   const cow_chunked_array<int, 4> copy = array;
+
+   array.clear();
+
+   CHECK(array.empty());
+   CHECK(array.chunk_count() == 0);
+   CHECK(copy.size() == 5);
+}
+
+}
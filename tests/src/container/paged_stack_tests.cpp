@@ -2,6 +2,9 @@
 
 #include "container/paged_stack.hpp"
 
+#include <deque>
+#include <memory>
+
 namespace we::container::tests {
 
 TEST_CASE("paged_stack push/pop test", "[Container][PagedStack]")
@@ -75,4 +78,115 @@ TEST_CASE("paged_stack clear test", "[Container][PagedStack]")
    }
 }
 
+TEST_CASE("paged_stack index test", "[Container][PagedStack]")
+{
+   paged_stack<int, 2> stack;
+
+   for (int i = 0; i < 5; ++i) stack.push(i);
+
+   for (int i = 0; i < 5; ++i) {
+      CHECK(stack[i] == i);
+   }
+
+   stack[3] = 8;
+
+   CHECK(stack[3] == 8);
+   CHECK(std::as_const(stack)[3] == 8);
+}
+
+TEST_CASE("paged_stack erase_bottom test", "[Container][PagedStack]")
+{
+   paged_stack<int, 2> stack;
+
+   for (int i = 0; i < 7; ++i) stack.push(i);
+
+   stack.erase_bottom(3);
+
+   REQUIRE(stack.size() == 4);
+
+   for (int i = 0; i < 4; ++i) {
+      CHECK(stack[i] == i + 3);
+   }
+
+   stack.push(7);
+
+   CHECK(stack.top() == 7);
+
+   stack.erase_bottom(0);
+
+   CHECK(stack.size() == 5);
+
+   stack.erase_bottom(5);
+
+   CHECK(stack.empty());
+}
+
+TEST_CASE("paged_stack erase_bottom mixed test", "[Container][PagedStack]")
+{
+   paged_stack<int, 4> stack;
+   std::deque<int> expected;
+
+   int next = 0;
+
+   // Erase counts that end inside a page, on a page boundary and across several pages.
+   for (const std::size_t erase_count :
+        {std::size_t{1}, std::size_t{2}, std::size_t{3}, std::size_t{5}, std::size_t{4},
+         std::size_t{9}, std::size_t{0}, std::size_t{6}}) {
+      for (int i = 0; i < 7; ++i) {
+         stack.push(next);
+         expected.push_back(next);
+
+         next += 1;
+      }
+
+      CHECK(stack.pop() == expected.back());
+
+      expected.pop_back();
+
+      stack.erase_bottom(erase_count);
+      expected.erase(expected.begin(), expected.begin() + erase_count);
+
+      REQUIRE(stack.size() == expected.size());
+
+      for (std::size_t i = 0; i < expected.size(); ++i) {
+         CHECK(stack[i] == expected[i]);
+      }
+
+      CHECK(stack.top() == expected.back());
+   }
+
+   while (not stack.empty()) {
+      CHECK(stack.pop() == expected.back());
+
+      expected.pop_back();
+   }
+
+   stack.push(next);
+
+   REQUIRE(stack.size() == 1);
+   CHECK(stack[0] == next);
+   CHECK(stack.top() == next);
+}
+
+TEST_CASE("paged_stack erase_bottom releases items test", "[Container][PagedStack]")
+{
+   paged_stack<std::shared_ptr<int>, 4> stack;
+
+   const std::shared_ptr<int> value = std::make_shared<int>(0);
+
+   for (int i = 0; i < 10; ++i) stack.push(value);
+
+   stack.erase_bottom(2);
+
+   CHECK(value.use_count() == 9);
+
+   stack.erase_bottom(3);
+
+   CHECK(value.use_count() == 6);
+
+   stack.erase_bottom(5);
+
+   CHECK(value.use_count() == 1);
+}
+
 }
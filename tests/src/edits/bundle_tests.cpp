@@ -2,6 +2,9 @@
 
 #include "edits/bundle.hpp"
 #include "edits/set_value.hpp"
+#include "edits/stack.hpp"
+#include "math/vector_funcs.hpp"
+#include "world/utility/world_utilities.hpp"
 #include "world/world.hpp"
 #include "world_test_data.hpp"
 
@@ -71,4 +74,44 @@ TEST_CASE("edits bundle coalesce", "[Edits]")
    REQUIRE(world.objects[0].layer == 0);
 }
 
+TEST_CASE("edits bundle drag benchmark", "[Edits][!benchmark]")
+{
+   world::world world;
+
+   for (uint32 i = 0; i < 4096; ++i) {
+      world.objects.push_back({.name = "Object"s + std::to_string(i),
+                               .id = world::object_id{i}});
+   }
+
+   world::rebuild_id_indices(world);
+
+   world::interaction_targets interaction_targets;
+   world::edit_context edit_context{world, interaction_targets.creation_entity};
+
+   // A second of dragging the gizmo at 60 FPS with every object selected. Each frame
+   // pushes a bundle that coalesces with the one from the previous frame.
+
+   BENCHMARK("drag 4096 objects for 60 frames")
+   {
+      stack<world::edit_context> stack;
+
+      for (int frame = 0; frame < 60; ++frame) {
+         bundle_vector bundle;
+         bundle.reserve(world.objects.size());
+
+         for (const world::object& object : world.objects) {
+            bundle.push_back(make_set_value(object.id, &world::object::position,
+                                            object.position + float3{0.1f, 0.0f, 0.0f},
+                                            object.position));
+         }
+
+         stack.apply(make_bundle(std::move(bundle)), edit_context);
+      }
+
+      stack.close_last();
+
+      return stack.applied_size();
+   };
+}
+
 }
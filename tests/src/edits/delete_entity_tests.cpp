@@ -1,6 +1,7 @@
 #include "pch.h"
 
 #include "edits/delete_entity.hpp"
+#include "world/utility/world_utilities.hpp"
 #include "world/world.hpp"
 #include "world_test_data.hpp"
 
@@ -11,6 +12,9 @@ namespace we::edits::tests {
 TEST_CASE("edits delete_entity object", "[Edits]")
 {
    world::world world = test_world;
+
+   world::rebuild_id_indices(world);
+
    world::interaction_targets interaction_targets;
    world::edit_context edit_context{world, interaction_targets.creation_entity};
 
@@ -41,9 +45,53 @@ TEST_CASE("edits delete_entity object", "[Edits]")
    REQUIRE(world.hintnodes[0].command_post == "test_object");
 }
 
+TEST_CASE("edits delete_entity object id index", "[Edits]")
+{
+   world::world world;
+   world::interaction_targets interaction_targets;
+   world::edit_context edit_context{world, interaction_targets.creation_entity};
+
+   for (int i = 0; i < 64; ++i) {
+      world.objects.push_back({.name = "object"s + std::to_string(i),
+                               .id = world.next_id.objects.aquire()});
+   }
+
+   world::rebuild_id_indices(world);
+
+   std::vector<std::unique_ptr<edit<world::edit_context>>> edits;
+
+   for (uint32 i = 0; i < 64; i += 3) {
+      edits.push_back(make_delete_entity(world::object_id{i}, world));
+      edits.back()->apply(edit_context);
+   }
+
+   REQUIRE(world.objects.size() == 42);
+
+   for (std::size_t i = 0; i < world.objects.size(); ++i) {
+      REQUIRE(world::find_entity_index<world::object>(world, world.objects[i].id) == i);
+   }
+
+   REQUIRE(not world::find_entity<world::object>(world, world::object_id{0}));
+   REQUIRE(not world::find_entity<world::object>(world, world::object_id{63}));
+
+   for (auto it = edits.rbegin(); it != edits.rend(); ++it) {
+      (*it)->revert(edit_context);
+   }
+
+   REQUIRE(world.objects.size() == 64);
+
+   for (std::size_t i = 0; i < world.objects.size(); ++i) {
+      REQUIRE(world::find_entity_index<world::object>(
+                 world, world::object_id{static_cast<uint32>(i)}) == i);
+   }
+}
+
 TEST_CASE("edits delete_entity light", "[Edits]")
 {
    world::world world = test_world;
+
+   world::rebuild_id_indices(world);
+
    world::interaction_targets interaction_targets;
    world::edit_context edit_context{world, interaction_targets.creation_entity};
 
@@ -62,6 +110,9 @@ TEST_CASE("edits delete_entity light", "[Edits]")
 TEST_CASE("edits delete_entity path", "[Edits]")
 {
    world::world world = test_world;
+
+   world::rebuild_id_indices(world);
+
    world::interaction_targets interaction_targets;
    world::edit_context edit_context{world, interaction_targets.creation_entity};
 
@@ -112,6 +163,9 @@ TEST_CASE("edits delete_entity path", "[Edits]")
 TEST_CASE("edits delete_entity region", "[Edits]")
 {
    world::world world = test_world;
+
+   world::rebuild_id_indices(world);
+
    world::interaction_targets interaction_targets;
    world::edit_context edit_context{world, interaction_targets.creation_entity};
 
@@ -154,6 +208,9 @@ TEST_CASE("edits delete_entity region", "[Edits]")
 TEST_CASE("edits delete_entity sector", "[Edits]")
 {
    world::world world = test_world;
+
+   world::rebuild_id_indices(world);
+
    world::interaction_targets interaction_targets;
    world::edit_context edit_context{world, interaction_targets.creation_entity};
 
@@ -176,6 +233,9 @@ TEST_CASE("edits delete_entity sector", "[Edits]")
 TEST_CASE("edits delete_entity portal", "[Edits]")
 {
    world::world world = test_world;
+
+   world::rebuild_id_indices(world);
+
    world::interaction_targets interaction_targets;
    world::edit_context edit_context{world, interaction_targets.creation_entity};
 
@@ -194,6 +254,9 @@ TEST_CASE("edits delete_entity portal", "[Edits]")
 TEST_CASE("edits delete_entity hintnode", "[Edits]")
 {
    world::world world = test_world;
+
+   world::rebuild_id_indices(world);
+
    world::interaction_targets interaction_targets;
    world::edit_context edit_context{world, interaction_targets.creation_entity};
 
@@ -212,6 +275,9 @@ TEST_CASE("edits delete_entity hintnode", "[Edits]")
 TEST_CASE("edits delete_entity barrier", "[Edits]")
 {
    world::world world = test_world;
+
+   world::rebuild_id_indices(world);
+
    world::interaction_targets interaction_targets;
    world::edit_context edit_context{world, interaction_targets.creation_entity};
 
@@ -230,6 +296,9 @@ TEST_CASE("edits delete_entity barrier", "[Edits]")
 TEST_CASE("edits delete_entity planning_hub", "[Edits]")
 {
    world::world world = test_world;
+
+   world::rebuild_id_indices(world);
+
    world::interaction_targets interaction_targets;
    world::edit_context edit_context{world, interaction_targets.creation_entity};
 
@@ -242,8 +311,11 @@ TEST_CASE("edits delete_entity planning_hub", "[Edits]")
 
    REQUIRE(world.planning_connections.empty());
 
-   REQUIRE(not world.planning_hub_index.contains(test_world.planning_hubs[0].id));
-   REQUIRE(world.planning_hub_index.at(test_world.planning_hubs[1].id) == 0);
+   REQUIRE(world.id_index.planning_hubs.size() == 1);
+   REQUIRE(not world::find_entity_index<world::planning_hub>(
+      world, test_world.planning_hubs[0].id));
+   REQUIRE(world::find_entity_index<world::planning_hub>(
+              world, test_world.planning_hubs[1].id) == 0);
 
    edit->revert(edit_context);
 
@@ -254,13 +326,79 @@ TEST_CASE("edits delete_entity planning_hub", "[Edits]")
    REQUIRE(world.planning_connections.size() == 1);
    REQUIRE(world.planning_connections[0] == test_world.planning_connections[0]);
 
-   REQUIRE(world.planning_hub_index.at(test_world.planning_hubs[0].id) == 0);
-   REQUIRE(world.planning_hub_index.at(test_world.planning_hubs[1].id) == 1);
+   REQUIRE(world.id_index.planning_hubs.size() == 2);
+   REQUIRE(world::find_entity_index<world::planning_hub>(
+              world, test_world.planning_hubs[0].id) == 0);
+   REQUIRE(world::find_entity_index<world::planning_hub>(
+              world, test_world.planning_hubs[1].id) == 1);
+}
+
+TEST_CASE("edits delete_entity planning_hub multiple connections", "[Edits]")
+{
+   world::world world = test_world;
+
+   world.planning_connections = {
+      world::planning_connection{.name = "Connection0",
+                                 .start = world::planning_hub_id{0},
+                                 .end = world::planning_hub_id{1},
+                                 .id = world::planning_connection_id{0}},
+      world::planning_connection{.name = "Connection1",
+                                 .start = world::planning_hub_id{1},
+                                 .end = world::planning_hub_id{1},
+                                 .id = world::planning_connection_id{1}},
+      world::planning_connection{.name = "Connection2",
+                                 .start = world::planning_hub_id{1},
+                                 .end = world::planning_hub_id{0},
+                                 .id = world::planning_connection_id{2}},
+      world::planning_connection{.name = "Connection3",
+                                 .start = world::planning_hub_id{1},
+                                 .end = world::planning_hub_id{1},
+                                 .id = world::planning_connection_id{3}},
+   };
+
+   const std::vector<world::planning_connection> connections = world.planning_connections;
+
+   world::rebuild_id_indices(world);
+
+   world::interaction_targets interaction_targets;
+   world::edit_context edit_context{world, interaction_targets.creation_entity};
+
+   auto edit = make_delete_entity(world.planning_hubs[0].id, world);
+
+   edit->apply(edit_context);
+
+   REQUIRE(world.planning_connections.size() == 2);
+   REQUIRE(world.planning_connections[0] == connections[1]);
+   REQUIRE(world.planning_connections[1] == connections[3]);
+
+   REQUIRE(world.id_index.planning_connections.size() == 2);
+   REQUIRE(not world::find_entity_index<world::planning_connection>(world,
+                                                                    connections[0].id));
+   REQUIRE(world::find_entity_index<world::planning_connection>(world,
+                                                                connections[1].id) == 0);
+   REQUIRE(not world::find_entity_index<world::planning_connection>(world,
+                                                                    connections[2].id));
+   REQUIRE(world::find_entity_index<world::planning_connection>(world,
+                                                                connections[3].id) == 1);
+
+   edit->revert(edit_context);
+
+   REQUIRE(world.planning_connections == connections);
+
+   REQUIRE(world.id_index.planning_connections.size() == 4);
+
+   for (std::size_t i = 0; i < connections.size(); ++i) {
+      REQUIRE(world::find_entity_index<world::planning_connection>(world,
+                                                                   connections[i].id) == i);
+   }
 }
 
 TEST_CASE("edits delete_entity planning_connection", "[Edits]")
 {
    world::world world = test_world;
+
+   world::rebuild_id_indices(world);
+
    world::interaction_targets interaction_targets;
    world::edit_context edit_context{world, interaction_targets.creation_entity};
 
@@ -279,6 +417,9 @@ TEST_CASE("edits delete_entity planning_connection", "[Edits]")
 TEST_CASE("edits delete_entity boundary", "[Edits]")
 {
    world::world world = test_world;
+
+   world::rebuild_id_indices(world);
+
    world::interaction_targets interaction_targets;
    world::edit_context edit_context{world, interaction_targets.creation_entity};
 
@@ -1,6 +1,7 @@
 #include "pch.h"
 
 #include "edits/insert_entity.hpp"
+#include "world/utility/world_utilities.hpp"
 #include "world/world.hpp"
 #include "world_test_data.hpp"
 
@@ -29,26 +30,55 @@ TEST_CASE("edits insert_entity", "[Edits]")
    REQUIRE(world.boundaries[0].name != "Boundary2");
 }
 
+TEST_CASE("edits insert_entity name index", "[Edits]")
+{
+   world::world world = test_world;
+   world::interaction_targets interaction_targets;
+   world::edit_context edit_context{world, interaction_targets.creation_entity};
+
+   world::rebuild_name_indices(world);
+
+   world::boundary boundary{.name = "Boundary2", .id = world::boundary_id{1}};
+
+   auto action = make_insert_entity(boundary);
+
+   action->apply(edit_context);
+
+   REQUIRE(world::is_name_index_complete<world::boundary>(world));
+   REQUIRE(world::find_entity<world::boundary>(world, "Boundary2"sv) ==
+           &world.boundaries[1]);
+
+   action->revert(edit_context);
+
+   REQUIRE(world::is_name_index_complete<world::boundary>(world));
+   REQUIRE(world::find_entity<world::boundary>(world, "Boundary2"sv) == nullptr);
+}
+
 TEST_CASE("edits insert_entity planning_hub", "[Edits]")
 {
    world::world world = test_world;
+
+   world::rebuild_id_indices(world);
+
    world::interaction_targets interaction_targets;
    world::edit_context edit_context{world, interaction_targets.creation_entity};
 
    world::planning_hub hub{.name = "Hub4", .id = world::planning_hub_id{2}};
 
-   auto action = make_insert_entity(hub, world.planning_hubs.size());
+   auto action = make_insert_entity(hub);
 
    action->apply(edit_context);
 
    REQUIRE(world.planning_hubs.size() == 3);
    REQUIRE(world.planning_hubs[2] == hub);
-   REQUIRE(world.planning_hub_index.at(hub.id) == 2);
+   REQUIRE(world.id_index.planning_hubs.size() == 3);
+   REQUIRE(world::find_entity_index<world::planning_hub>(world, hub.id) == 2);
 
    action->revert(edit_context);
 
    REQUIRE(world.planning_hubs.size() == 2);
-   REQUIRE(not world.planning_hub_index.contains(hub.id));
+   REQUIRE(world.id_index.planning_hubs.size() == 2);
+   REQUIRE(not world::find_entity_index<world::planning_hub>(world, hub.id));
 }
 
 }
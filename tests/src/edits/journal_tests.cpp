@@ -0,0 +1,510 @@
+#include "pch.h"
+
+#include "edits/bundle.hpp"
+#include "edits/creation_entity_set.hpp"
+#include "edits/delete_entity.hpp"
+#include "edits/insert_entity.hpp"
+#include "edits/journal.hpp"
+#include "edits/set_value.hpp"
+#include "edits/stack.hpp"
+#include "edits/ui_action.hpp"
+#include "io/read_file.hpp"
+#include "math/vector_funcs.hpp"
+#include "world/utility/world_utilities.hpp"
+#include "world/world.hpp"
+#include "world_test_data.hpp"
+
+using namespace std::literals;
+
+namespace we::edits::tests {
+
+namespace {
+
+constexpr auto test_journal_path = L"temp/edit_journal.wej"sv;
+
+template<typename T>
+auto round_trip(const T& value) -> T
+{
+   journal_writer writer;
+
+   writer.write(value);
+
+   journal_reader reader{writer.bytes()};
+
+   T result = reader.read<T>();
+
+   REQUIRE(reader.remaining() == 0);
+
+   return result;
+}
+
+struct unjournaled_edit final : edit<world::edit_context> {
+   void apply([[maybe_unused]] world::edit_context& context) const noexcept override {}
+
+   void revert([[maybe_unused]] world::edit_context& context) const noexcept override {}
+
+   bool is_coalescable([[maybe_unused]] const edit& other) const noexcept override
+   {
+      return false;
+   }
+
+   void coalesce([[maybe_unused]] edit& other) noexcept override {}
+};
+
+}
+
+TEST_CASE("edits journal_io entity round trip", "[Edits][Journal]")
+{
+   CHECK(round_trip(test_world.objects) == test_world.objects);
+   CHECK(round_trip(test_world.lights) == test_world.lights);
+   CHECK(round_trip(test_world.paths) == test_world.paths);
+   CHECK(round_trip(test_world.regions) == test_world.regions);
+   CHECK(round_trip(test_world.sectors) == test_world.sectors);
+   CHECK(round_trip(test_world.portals) == test_world.portals);
+   CHECK(round_trip(test_world.hintnodes) == test_world.hintnodes);
+   CHECK(round_trip(test_world.barriers) == test_world.barriers);
+   CHECK(round_trip(test_world.planning_hubs) == test_world.planning_hubs);
+   CHECK(round_trip(test_world.planning_connections) == test_world.planning_connections);
+   CHECK(round_trip(test_world.boundaries) == test_world.boundaries);
+   CHECK(round_trip(test_world.global_lights) == test_world.global_lights);
+
+   const std::optional<world::creation_entity> creation_entity{test_world.sectors[0]};
+
+   CHECK(round_trip(creation_entity) == creation_entity);
+}
+
+TEST_CASE("edits journal_io member round trip", "[Edits][Journal]")
+{
+   journal_writer writer;
+
+   writer.write_member(&world::object::position);
+   writer.write_member(&world::light::range);
+   writer.write_entity_type<world::hintnode>();
+
+   journal_reader reader{writer.bytes()};
+
+   CHECK(reader.read_member<world::object>([]<typename T>(T world::object::*member) {
+      if constexpr (std::is_same_v<T, float3>) {
+         return member == &world::object::position;
+      }
+      else {
+         return false;
+      }
+   }));
+   CHECK(reader.read_member<world::light>([]<typename T>(T world::light::*member) {
+      if constexpr (std::is_same_v<T, float>) {
+         return member == &world::light::range;
+      }
+      else {
+         return false;
+      }
+   }));
+   CHECK(reader.read_entity_type([]<typename Entity>(std::type_identity<Entity>) {
+      return std::is_same_v<Entity, world::hintnode>;
+   }));
+   CHECK(reader.remaining() == 0);
+   CHECK_THROWS(reader.read<uint32>());
+}
+
+TEST_CASE("edits journal replay", "[Edits][Journal]")
+{
+   world::world world = test_world;
+   world::interaction_targets interaction_targets;
+   world::edit_context edit_context{world, interaction_targets.creation_entity};
+
+   stack<world::edit_context> stack;
+
+   {
+      journal journal{test_journal_path};
+
+      stack.set_listener(&journal);
+
+      stack.apply(make_set_value(world.objects[0].id, &world::object::position,
+                                 float3{1.0f, 2.0f, 3.0f}, world.objects[0].position),
+                  edit_context);
+      stack.apply(make_set_value(world.objects[0].id, &world::object::position,
+                                 float3{4.0f, 5.0f, 6.0f}, world.objects[0].position),
+                  edit_context);
+      stack.close_last();
+
+      stack.apply(make_insert_entity(
+                     world::object{.name = "inserted_object"s,
+                                   .class_name = lowercase_string{"com_item_healthrecharge"sv},
+                                   .id = world::object_id{64}}),
+                  edit_context);
+
+      bundle_vector bundle;
+
+      bundle.push_back(make_set_value(world.lights[0].id, &world::light::range, 64.0f,
+                                      world.lights[0].range));
+      bundle.push_back(
+         std::make_unique<ui_edit_indexed<world::object, world::instance_property>>(
+            world.objects[0].id, &world::object::instance_properties, 0,
+            world::instance_property{.key = "MaxHealth"s, .value = "100"s},
+            world.objects[0].instance_properties[0]));
+
+      stack.apply(make_bundle(std::move(bundle)), edit_context);
+      stack.apply(make_delete_entity(world.regions[0].id, world), edit_context);
+      stack.apply(make_creation_entity_set(world::portal{.name = "new_portal"s},
+                                           std::nullopt),
+                  edit_context, {.transparent = true});
+      stack.apply(make_set_creation_value(&world::portal::width, 4.0f, 0.0f),
+                  edit_context);
+
+      stack.revert(edit_context);
+      stack.revert(edit_context);
+      stack.reapply(edit_context);
+
+      stack.set_listener(nullptr);
+
+      CHECK(journal.record_count() == 11);
+      CHECK(not journal.has_unsupported_edit());
+   }
+
+   world::world replay_world = test_world;
+   world::interaction_targets replay_interaction_targets;
+   world::edit_context replay_edit_context{replay_world,
+                                           replay_interaction_targets.creation_entity};
+
+   edits::stack<world::edit_context> replay_stack;
+
+   const journal_replay_result result =
+      replay_journal(io::read_file_to_bytes(test_journal_path), replay_stack,
+                     replay_edit_context);
+
+   CHECK(result.complete);
+   CHECK(result.error.empty());
+   CHECK(result.records == 11);
+
+   CHECK(replay_world.objects == world.objects);
+   CHECK(replay_world.lights == world.lights);
+   CHECK(replay_world.regions == world.regions);
+   CHECK(replay_interaction_targets.creation_entity == interaction_targets.creation_entity);
+   CHECK(replay_stack.applied_size() == stack.applied_size());
+   CHECK(replay_stack.reverted_size() == stack.reverted_size());
+
+   replay_stack.revert_all(replay_edit_context);
+
+   CHECK(replay_world.objects == test_world.objects);
+   CHECK(replay_world.lights == test_world.lights);
+   CHECK(replay_world.regions == test_world.regions);
+}
+
+TEST_CASE("edits journal replay inserts keep new ids unique", "[Edits][Journal]")
+{
+   world::world world;
+   world::interaction_targets interaction_targets;
+   world::edit_context edit_context{world, interaction_targets.creation_entity};
+
+   stack<world::edit_context> stack;
+
+   {
+      journal journal{test_journal_path};
+
+      stack.set_listener(&journal);
+
+      stack.apply(make_insert_entity(world::object{.name = "object"s,
+                                                   .id = world.next_id.objects.aquire()}),
+                  edit_context);
+      stack.apply(make_insert_entity(world::light{.name = "light"s,
+                                                  .id = world.next_id.lights.aquire()}),
+                  edit_context);
+      stack.apply(make_insert_entity(
+                     world::path{.name = "path"s, .id = world.next_id.paths.aquire()}),
+                  edit_context);
+      stack.apply(make_insert_entity(world::region{.name = "region"s,
+                                                   .id = world.next_id.regions.aquire()}),
+                  edit_context);
+      stack.apply(make_insert_entity(world::object{.name = "undone_object"s,
+                                                   .id = world.next_id.objects.aquire()}),
+                  edit_context);
+
+      stack.revert(edit_context);
+
+      stack.set_listener(nullptr);
+   }
+
+   world::world replay_world;
+   world::interaction_targets replay_interaction_targets;
+   world::edit_context replay_edit_context{replay_world,
+                                           replay_interaction_targets.creation_entity};
+
+   edits::stack<world::edit_context> replay_stack;
+
+   const journal_replay_result result =
+      replay_journal(io::read_file_to_bytes(test_journal_path), replay_stack,
+                     replay_edit_context);
+
+   REQUIRE(result.complete);
+   REQUIRE(replay_world.objects == world.objects);
+
+   const world::object_id new_object_id = replay_world.next_id.objects.aquire();
+   const world::light_id new_light_id = replay_world.next_id.lights.aquire();
+   const world::path_id new_path_id = replay_world.next_id.paths.aquire();
+   const world::region_id new_region_id = replay_world.next_id.regions.aquire();
+
+   CHECK(not world::find_entity<world::object>(replay_world, new_object_id));
+   CHECK(not world::find_entity<world::light>(replay_world, new_light_id));
+   CHECK(not world::find_entity<world::path>(replay_world, new_path_id));
+   CHECK(not world::find_entity<world::region>(replay_world, new_region_id));
+
+   // The undone insert can still be redone, so its ID must not be handed out either.
+   replay_stack.reapply(replay_edit_context);
+
+   REQUIRE(replay_world.objects.size() == 2);
+   CHECK(replay_world.objects[0].id != new_object_id);
+   CHECK(replay_world.objects[1].id != new_object_id);
+}
+
+TEST_CASE("edits journal coalesced edits", "[Edits][Journal]")
+{
+   world::world world = test_world;
+   world::interaction_targets interaction_targets;
+   world::edit_context edit_context{world, interaction_targets.creation_entity};
+
+   stack<world::edit_context> stack;
+
+   {
+      journal journal{test_journal_path};
+
+      stack.set_listener(&journal);
+
+      stack.apply(make_set_value(world.objects[0].id, &world::object::team, 1,
+                                 world.objects[0].team),
+                  edit_context, {.closed = true});
+
+      for (int frame = 0; frame < 60; ++frame) {
+         stack.apply(make_set_value(world.objects[0].id, &world::object::position,
+                                    world.objects[0].position + float3{0.5f, 0.0f, 0.0f},
+                                    world.objects[0].position),
+                     edit_context, {.transparent = frame == 30});
+      }
+
+      CHECK(journal.record_count() == 2);
+
+      stack.apply(make_set_value(world.objects[0].id, &world::object::team, 2,
+                                 world.objects[0].team),
+                  edit_context);
+
+      CHECK(journal.record_count() == 4);
+
+      stack.apply(make_set_value(world.objects[0].id, &world::object::team, 3,
+                                 world.objects[0].team),
+                  edit_context);
+
+      CHECK(journal.record_count() == 4);
+
+      stack.revert(edit_context);
+
+      CHECK(journal.record_count() == 6);
+
+      stack.set_listener(nullptr);
+   }
+
+   world::world replay_world = test_world;
+   world::interaction_targets replay_interaction_targets;
+   world::edit_context replay_edit_context{replay_world,
+                                           replay_interaction_targets.creation_entity};
+
+   edits::stack<world::edit_context> replay_stack;
+
+   const journal_replay_result result =
+      replay_journal(io::read_file_to_bytes(test_journal_path), replay_stack,
+                     replay_edit_context);
+
+   CHECK(result.complete);
+   CHECK(result.records == 6);
+
+   CHECK(replay_world.objects == world.objects);
+   CHECK(replay_stack.applied_size() == stack.applied_size());
+   CHECK(replay_stack.reverted_size() == stack.reverted_size());
+
+   // The drag was made transparent partway through so it's undone together with the
+   // edit below it.
+   replay_stack.revert(replay_edit_context);
+   stack.revert(edit_context);
+
+   CHECK(replay_world.objects == world.objects);
+   CHECK(replay_world.objects == test_world.objects);
+}
+
+TEST_CASE("edits journal replay truncated", "[Edits][Journal]")
+{
+   world::world world = test_world;
+   world::interaction_targets interaction_targets;
+   world::edit_context edit_context{world, interaction_targets.creation_entity};
+
+   stack<world::edit_context> stack;
+
+   {
+      journal journal{test_journal_path};
+
+      stack.set_listener(&journal);
+
+      stack.apply(make_set_value(world.objects[0].id, &world::object::name,
+                                 "renamed_object"s, world.objects[0].name),
+                  edit_context, {.closed = true});
+      stack.apply(make_set_value(world.objects[0].id, &world::object::team, 2,
+                                 world.objects[0].team),
+                  edit_context);
+
+      stack.set_listener(nullptr);
+   }
+
+   std::vector<std::byte> bytes = io::read_file_to_bytes(test_journal_path);
+
+   bytes.resize(bytes.size() - 1);
+
+   world::world replay_world = test_world;
+   world::interaction_targets replay_interaction_targets;
+   world::edit_context replay_edit_context{replay_world,
+                                           replay_interaction_targets.creation_entity};
+
+   edits::stack<world::edit_context> replay_stack;
+
+   const journal_replay_result result =
+      replay_journal(bytes, replay_stack, replay_edit_context);
+
+   CHECK(result.complete);
+   CHECK(result.records == 1);
+   CHECK(replay_world.objects[0].name == "renamed_object");
+   CHECK(replay_world.objects[0].team == test_world.objects[0].team);
+}
+
+TEST_CASE("edits journal replay stops", "[Edits][Journal]")
+{
+   world::world world = test_world;
+   world::interaction_targets interaction_targets;
+   world::edit_context edit_context{world, interaction_targets.creation_entity};
+
+   stack<world::edit_context> stack;
+
+   stack.apply(make_set_value(world.objects[0].id, &world::object::team, 2,
+                              world.objects[0].team),
+               edit_context);
+
+   world::world replay_world = world;
+   world::interaction_targets replay_interaction_targets;
+   world::edit_context replay_edit_context{replay_world,
+                                           replay_interaction_targets.creation_entity};
+
+   SECTION("revert before journal")
+   {
+      {
+         journal journal{test_journal_path};
+
+         stack.set_listener(&journal);
+         stack.revert(edit_context);
+         stack.set_listener(nullptr);
+      }
+
+      edits::stack<world::edit_context> replay_stack;
+
+      const journal_replay_result result =
+         replay_journal(io::read_file_to_bytes(test_journal_path), replay_stack,
+                        replay_edit_context);
+
+      CHECK(not result.complete);
+      CHECK(not result.error.empty());
+      CHECK(result.records == 0);
+   }
+
+   SECTION("unsupported edit")
+   {
+      {
+         journal journal{test_journal_path};
+
+         stack.set_listener(&journal);
+         stack.apply(make_set_value(world.objects[0].id, &world::object::team, 3,
+                                    world.objects[0].team),
+                     edit_context, {.closed = true});
+         stack.apply(std::make_unique<unjournaled_edit>(), edit_context);
+         stack.set_listener(nullptr);
+
+         CHECK(journal.has_unsupported_edit());
+      }
+
+      edits::stack<world::edit_context> replay_stack;
+
+      const journal_replay_result result =
+         replay_journal(io::read_file_to_bytes(test_journal_path), replay_stack,
+                        replay_edit_context);
+
+      CHECK(not result.complete);
+      CHECK(not result.error.empty());
+      CHECK(result.records == 1);
+      CHECK(replay_world.objects[0].team == 3);
+   }
+
+   SECTION("not a journal")
+   {
+      edits::stack<world::edit_context> replay_stack;
+
+      const std::array<std::byte, 4> bytes{};
+
+      const journal_replay_result result =
+         replay_journal(bytes, replay_stack, replay_edit_context);
+
+      CHECK(not result.complete);
+      CHECK(not result.error.empty());
+   }
+}
+
+TEST_CASE("edits journal replay benchmark", "[Edits][Journal][!benchmark]")
+{
+   world::world world;
+
+   for (uint32 i = 0; i < 4096; ++i) {
+      world.objects.push_back({.name = "Object"s + std::to_string(i),
+                               .id = world::object_id{i}});
+   }
+
+   world::rebuild_id_indices(world);
+
+   // Record a second of dragging every object at 60 FPS and then replay it.
+   {
+      world::world record_world = world;
+      world::interaction_targets interaction_targets;
+      world::edit_context edit_context{record_world, interaction_targets.creation_entity};
+
+      stack<world::edit_context> stack;
+      journal journal{test_journal_path};
+
+      stack.set_listener(&journal);
+
+      stack.apply(make_set_value(world.objects[0].id, &world::object::team, 1,
+                                 world.objects[0].team),
+                  edit_context, {.closed = true});
+
+      for (int frame = 0; frame < 60; ++frame) {
+         bundle_vector bundle;
+         bundle.reserve(record_world.objects.size());
+
+         for (const world::object& object : record_world.objects) {
+            bundle.push_back(make_set_value(object.id, &world::object::position,
+                                            object.position + float3{0.1f, 0.0f, 0.0f},
+                                            object.position));
+         }
+
+         stack.apply(make_bundle(std::move(bundle)), edit_context);
+      }
+
+      stack.close_last();
+      stack.set_listener(nullptr);
+   }
+
+   const std::vector<std::byte> bytes = io::read_file_to_bytes(test_journal_path);
+
+   BENCHMARK("replay drag of 4096 objects for 60 frames")
+   {
+      world::world replay_world = world;
+      world::interaction_targets interaction_targets;
+      world::edit_context edit_context{replay_world, interaction_targets.creation_entity};
+
+      stack<world::edit_context> stack;
+
+      return replay_journal(bytes, stack, edit_context).records;
+   };
+}
+
+}
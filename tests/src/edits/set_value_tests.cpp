@@ -4,6 +4,9 @@
 #include "world/world.hpp"
 #include "world_test_data.hpp"
 
+#include <algorithm>
+#include <ranges>
+
 using namespace std::literals;
 
 namespace we::edits::tests {
@@ -16,6 +19,8 @@ TEST_CASE("edits set_value", "[Edits]")
 
    set_value edit{world.objects[0].id, &world::object::layer, 1, 0};
 
+   const auto change_cursor = world.changes.objects.current();
+
    edit.apply(edit_context);
 
    REQUIRE(world.objects[0].layer == 1);
@@ -23,6 +28,103 @@ TEST_CASE("edits set_value", "[Edits]")
    edit.revert(edit_context);
 
    REQUIRE(world.objects[0].layer == 0);
+
+   const auto changes = world.changes.objects.changes_since(change_cursor);
+
+   REQUIRE(changes);
+   REQUIRE(changes->size() == 2);
+   CHECK((*changes)[0].id == world.objects[0].id);
+   CHECK((*changes)[0].type == world::change_type::modify);
+}
+
+TEST_CASE("edits set_value name", "[Edits]")
+{
+   world::world world = test_world;
+   world::interaction_targets interaction_targets;
+   world::edit_context edit_context{world, interaction_targets.creation_entity};
+
+   world::rebuild_name_indices(world);
+
+   const std::string original_name = world.objects[0].name;
+
+   set_value edit{world.objects[0].id, &world::object::name, "New Name"s, original_name};
+
+   edit.apply(edit_context);
+
+   REQUIRE(world.objects[0].name == "New Name");
+   REQUIRE(world::find_entity<world::object>(world, "New Name"sv) == &world.objects[0]);
+   REQUIRE(world::find_entity<world::object>(world, original_name) == nullptr);
+
+   edit.revert(edit_context);
+
+   REQUIRE(world.objects[0].name == original_name);
+   REQUIRE(world::find_entity<world::object>(world, original_name) == &world.objects[0]);
+   REQUIRE(world::find_entity<world::object>(world, "New Name"sv) == nullptr);
+}
+
+TEST_CASE("edits set_values", "[Edits]")
+{
+   world::world world = test_world;
+   world::interaction_targets interaction_targets;
+   world::edit_context edit_context{world, interaction_targets.creation_entity};
+
+   world.objects.push_back(world::object{.name = "test_object_1"s,
+                                         .position = {1.0f, 0.0f, 0.0f},
+                                         .id = world::object_id{1}});
+   world.objects.push_back(world::object{.name = "test_object_2"s,
+                                         .position = {2.0f, 0.0f, 0.0f},
+                                         .id = world::object_id{2}});
+
+   set_values edit{std::vector{world.objects[2].id, world.objects[0].id},
+                   &world::object::position,
+                   std::vector{float3{2.0f, 1.0f, 0.0f}, float3{0.0f, 1.0f, 0.0f}},
+                   std::vector{float3{2.0f, 0.0f, 0.0f}, float3{0.0f, 0.0f, 0.0f}}};
+
+   const auto change_cursor = world.changes.objects.current();
+
+   edit.apply(edit_context);
+
+   REQUIRE(world.objects[0].position == float3{0.0f, 1.0f, 0.0f});
+   REQUIRE(world.objects[1].position == float3{1.0f, 0.0f, 0.0f});
+   REQUIRE(world.objects[2].position == float3{2.0f, 1.0f, 0.0f});
+
+   edit.revert(edit_context);
+
+   REQUIRE(world.objects[0].position == float3{0.0f, 0.0f, 0.0f});
+   REQUIRE(world.objects[1].position == float3{1.0f, 0.0f, 0.0f});
+   REQUIRE(world.objects[2].position == float3{2.0f, 0.0f, 0.0f});
+
+   const auto changes = world.changes.objects.changes_since(change_cursor);
+
+   REQUIRE(changes);
+   REQUIRE(changes->size() == 4);
+   CHECK((*changes)[0].id == world.objects[2].id);
+   CHECK((*changes)[1].id == world.objects[0].id);
+   CHECK((*changes)[0].type == world::change_type::modify);
+}
+
+TEST_CASE("edits set_values name", "[Edits]")
+{
+   world::world world = test_world;
+   world::interaction_targets interaction_targets;
+   world::edit_context edit_context{world, interaction_targets.creation_entity};
+
+   world::rebuild_name_indices(world);
+
+   const std::string original_name = world.objects[0].name;
+
+   set_values edit{std::vector{world.objects[0].id}, &world::object::name,
+                   std::vector{"New Name"s}, std::vector{original_name}};
+
+   edit.apply(edit_context);
+
+   REQUIRE(world.objects[0].name == "New Name");
+   REQUIRE(world::find_entity<world::object>(world, "New Name"sv) == &world.objects[0]);
+
+   edit.revert(edit_context);
+
+   REQUIRE(world.objects[0].name == original_name);
+   REQUIRE(world::find_entity<world::object>(world, "New Name"sv) == nullptr);
 }
 
 TEST_CASE("edits set_path_node_value", "[Edits]")
@@ -345,6 +447,44 @@ TEST_CASE("edits set_value coalesce", "[Edits]")
    REQUIRE(world.objects[0].layer == 0);
 }
 
+TEST_CASE("edits set_values coalesce", "[Edits]")
+{
+   world::world world = test_world;
+   world::interaction_targets interaction_targets;
+   world::edit_context edit_context{world, interaction_targets.creation_entity};
+
+   world.objects.push_back(world::object{.name = "test_object_1"s,
+                                         .layer = 0,
+                                         .id = world::object_id{1}});
+
+   const std::vector<world::object_id> ids{world.objects[0].id, world.objects[1].id};
+
+   set_values edit{ids, &world::object::layer, std::vector{1, 1}, std::vector{0, 0}};
+   set_values other_edit{ids, &world::object::layer, std::vector{2, 3},
+                         std::vector{1, 1}};
+   set_values different_ids_edit{std::vector{world.objects[0].id},
+                                 &world::object::layer, std::vector{2},
+                                 std::vector{1}};
+   set_values different_member_edit{ids, &world::object::team, std::vector{2, 3},
+                                    std::vector{0, 0}};
+
+   REQUIRE(edit.is_coalescable(other_edit));
+   REQUIRE(not edit.is_coalescable(different_ids_edit));
+   REQUIRE(not edit.is_coalescable(different_member_edit));
+
+   edit.coalesce(other_edit);
+
+   edit.apply(edit_context);
+
+   REQUIRE(world.objects[0].layer == 2);
+   REQUIRE(world.objects[1].layer == 3);
+
+   edit.revert(edit_context);
+
+   REQUIRE(world.objects[0].layer == 0);
+   REQUIRE(world.objects[1].layer == 0);
+}
+
 TEST_CASE("edits set_path_node_value coalesce", "[Edits]")
 {
    world::world world = test_world;
@@ -738,4 +878,38 @@ TEST_CASE("edits set_creation_barrier_metrics coalesce", "[Edits]")
            float2{0.0f, 0.0f});
 }
 
+TEST_CASE("edits set_value kinds are unique", "[Edits]")
+{
+   // Kinds are compared at runtime so this also catches the linker folding the tags
+   // together in Release builds.
+   const std::vector<std::unique_ptr<edit<world::edit_context>>> edits = [] {
+      std::vector<std::unique_ptr<edit<world::edit_context>>> edits;
+
+      edits.push_back(std::make_unique<set_value<world::object, int>>(
+         world::object_id{0}, &world::object::layer, 1, 0));
+      edits.push_back(std::make_unique<set_value<world::object, int>>(
+         world::object_id{0}, &world::object::team, 1, 0));
+      edits.push_back(std::make_unique<set_value<world::object, float3>>(
+         world::object_id{0}, &world::object::position, float3{}, float3{}));
+      edits.push_back(std::make_unique<set_values<world::object, int>>(
+         std::vector{world::object_id{0}}, &world::object::layer, std::vector{1},
+         std::vector{0}));
+      edits.push_back(std::make_unique<set_values<world::object, float3>>(
+         std::vector{world::object_id{0}}, &world::object::position,
+         std::vector{float3{}}, std::vector{float3{}}));
+
+      return edits;
+   }();
+
+   CHECK(edits[0]->kind() == edits[1]->kind());
+
+   std::vector<edit_kind> kinds;
+
+   for (const auto& edit : edits | std::views::drop(1)) kinds.push_back(edit->kind());
+
+   std::ranges::sort(kinds);
+
+   CHECK(std::ranges::adjacent_find(kinds) == kinds.end());
+}
+
 }
@@ -32,6 +32,66 @@ struct dummy_edit : edit<dummy_edit_state> {
    void coalesce([[maybe_unused]] edit& other) noexcept override {}
 };
 
+struct dummy_sized_edit : edit<dummy_edit_state> {
+   dummy_sized_edit(std::size_t size) : size{size} {}
+
+   void apply(dummy_edit_state& target) const noexcept override
+   {
+      ++target.apply_call_count;
+   }
+
+   void revert(dummy_edit_state& target) const noexcept override
+   {
+      ++target.revert_call_count;
+   }
+
+   bool is_coalescable(const edit& other) const noexcept override
+   {
+      return dynamic_cast<const dummy_sized_edit*>(&other) != nullptr;
+   }
+
+   void coalesce(edit& other) noexcept override
+   {
+      size += dynamic_cast<dummy_sized_edit&>(other).size;
+   }
+
+   auto memory_use() const noexcept -> std::size_t override
+   {
+      return size;
+   }
+
+   std::size_t size = 0;
+};
+
+struct dummy_kind_edit_state {
+   int is_coalescable_call_count = 0;
+};
+
+template<int kind_index>
+struct dummy_kind_edit : edit<dummy_kind_edit_state> {
+   dummy_kind_edit(dummy_kind_edit_state& state)
+      : edit{edit_kind_of<dummy_kind_edit>}, state{&state}
+   {
+   }
+
+   void apply([[maybe_unused]] dummy_kind_edit_state& target) const noexcept override {}
+
+   void revert([[maybe_unused]] dummy_kind_edit_state& target) const noexcept override
+   {
+   }
+
+   bool is_coalescable([[maybe_unused]] const edit& other) const noexcept override
+   {
+      ++state->is_coalescable_call_count;
+
+      return true;
+   }
+
+   void coalesce([[maybe_unused]] edit& other) noexcept override {}
+
+   dummy_kind_edit_state* state = nullptr;
+};
+
 struct dummy_edit_bools_state {
    bool toggles[3] = {false, false, false};
 };
@@ -395,4 +455,162 @@ TEST_CASE("edits stack modified flag tests", "[Edits]")
    CHECK(not stack.modified_flag());
 }
 
-}
\ No newline at end of file
+TEST_CASE("edits stack memory use", "[Edits]")
+{
+   stack<dummy_edit_state> stack;
+   dummy_edit_state state;
+
+   CHECK(stack.memory_use() == 0);
+
+   stack.apply(std::make_unique<dummy_sized_edit>(100), state, {.closed = true});
+   stack.apply(std::make_unique<dummy_sized_edit>(50), state, {.closed = true});
+
+   CHECK(stack.memory_use() == 150);
+
+   stack.revert(state);
+
+   CHECK(stack.memory_use() == 150);
+
+   stack.reapply(state);
+
+   CHECK(stack.memory_use() == 150);
+
+   stack.revert(state);
+   stack.apply(std::make_unique<dummy_sized_edit>(25), state);
+
+   CHECK(stack.memory_use() == 125);
+
+   stack.apply(std::make_unique<dummy_sized_edit>(25), state);
+
+   CHECK(stack.applied_size() == 2);
+   CHECK(stack.memory_use() == 150);
+
+   stack.clear();
+
+   CHECK(stack.memory_use() == 0);
+}
+
+TEST_CASE("edits stack memory budget", "[Edits]")
+{
+   stack<dummy_edit_state> stack;
+   dummy_edit_state state;
+
+   stack.set_memory_budget(300);
+
+   CHECK(stack.memory_budget() == 300);
+
+   for (int i = 0; i < 3; ++i) {
+      stack.apply(std::make_unique<dummy_sized_edit>(100), state, {.closed = true});
+   }
+
+   CHECK(stack.applied_size() == 3);
+   CHECK(stack.memory_use() == 300);
+
+   stack.apply(std::make_unique<dummy_sized_edit>(100), state, {.closed = true});
+
+   CHECK(stack.applied_size() == 3);
+   CHECK(stack.memory_use() == 300);
+
+   stack.apply(std::make_unique<dummy_sized_edit>(250), state, {.closed = true});
+
+   CHECK(stack.applied_size() == 1);
+   CHECK(stack.memory_use() == 250);
+
+   stack.apply(std::make_unique<dummy_sized_edit>(400), state, {.closed = true});
+
+   CHECK(stack.applied_size() == 1);
+   CHECK(stack.memory_use() == 400);
+
+   stack.revert(state);
+
+   CHECK(stack.applied_empty());
+   CHECK(stack.reverted_size() == 1);
+}
+
+TEST_CASE("edits stack memory budget transparent", "[Edits]")
+{
+   stack<dummy_edit_state> stack;
+   dummy_edit_state state;
+
+   stack.set_memory_budget(300);
+
+   stack.apply(std::make_unique<dummy_sized_edit>(100), state, {.closed = true});
+   stack.apply(std::make_unique<dummy_sized_edit>(50), state,
+               {.closed = true, .transparent = true});
+   stack.apply(std::make_unique<dummy_sized_edit>(100), state, {.closed = true});
+   stack.apply(std::make_unique<dummy_sized_edit>(100), state, {.closed = true});
+
+   CHECK(stack.applied_size() == 2);
+   CHECK(stack.memory_use() == 200);
+
+   stack.revert_all(state);
+
+   CHECK(state.revert_call_count == 2);
+}
+
+TEST_CASE("edits stack memory budget keeps transparent edits with their base", "[Edits]")
+{
+   stack<dummy_edit_state> stack;
+   dummy_edit_state state;
+
+   stack.set_memory_budget(300);
+
+   stack.apply(std::make_unique<dummy_sized_edit>(100), state, {.closed = true});
+   stack.apply(std::make_unique<dummy_sized_edit>(250), state, {.closed = true});
+
+   CHECK(stack.applied_size() == 1);
+
+   // Dropping the 250 byte edit would leave the transparent edit with nothing below it.
+   stack.apply(std::make_unique<dummy_sized_edit>(100), state,
+               {.closed = true, .transparent = true});
+
+   CHECK(stack.applied_size() == 2);
+   CHECK(stack.memory_use() == 350);
+
+   stack.apply(std::make_unique<dummy_sized_edit>(50), state, {.closed = true});
+
+   CHECK(stack.applied_size() == 1);
+   CHECK(stack.memory_use() == 50);
+
+   stack.revert_all(state);
+
+   CHECK(state.revert_call_count == 1);
+}
+
+TEST_CASE("edits stack coalesce edit kinds", "[Edits]")
+{
+   stack<dummy_kind_edit_state> stack;
+   dummy_kind_edit_state state;
+
+   stack.apply(std::make_unique<dummy_kind_edit<0>>(state), state);
+   stack.apply(std::make_unique<dummy_kind_edit<1>>(state), state);
+
+   CHECK(state.is_coalescable_call_count == 0);
+   CHECK(stack.applied_size() == 2);
+
+   stack.apply(std::make_unique<dummy_kind_edit<1>>(state), state);
+
+   CHECK(state.is_coalescable_call_count == 1);
+   CHECK(stack.applied_size() == 2);
+}
+
+TEST_CASE("edits edit_cast", "[Edits]")
+{
+   dummy_kind_edit_state state;
+   dummy_kind_edit<0> kind_0{state};
+   dummy_kind_edit<1> kind_1{state};
+   dummy_edit untagged;
+
+   edit<dummy_kind_edit_state>& kind_0_unknown = kind_0;
+
+   CHECK(kind_0.kind() == edit_kind_of<dummy_kind_edit<0>>);
+   CHECK(kind_1.kind() == edit_kind_of<dummy_kind_edit<1>>);
+   CHECK(kind_0.kind() != kind_1.kind());
+   CHECK(untagged.kind() == nullptr);
+
+   CHECK(edit_cast<dummy_kind_edit<0>>(&kind_0_unknown) == &kind_0);
+   CHECK(edit_cast<dummy_kind_edit<1>>(&kind_0_unknown) == nullptr);
+   CHECK(&edit_cast<dummy_kind_edit<0>>(kind_0_unknown) == &kind_0);
+}
+
+}
@@ -168,7 +168,5 @@ const we::world::world test_world = {
                                      ai_path_flags::huge | ai_path_flags::flyer)}},
 
    .boundaries = {boundary{.name = "boundary"s}},
-
-   .planning_hub_index = {{planning_hub_id{0}, 0}, {planning_hub_id{1}, 1}},
 };
 }
\ No newline at end of file
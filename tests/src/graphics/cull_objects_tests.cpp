@@ -0,0 +1,226 @@
+#include "pch.h"
+
+#include "graphics/camera.hpp"
+#include "graphics/cull_objects.hpp"
+#include "math/vector_funcs.hpp"
+
+#include <random>
+
+namespace we::graphics::tests {
+
+namespace {
+
+struct test_objects {
+   std::vector<math::bounding_box> bbox;
+   world_bbox_soa bbox_soa;
+   std::vector<material_pipeline_flags> pipeline_flags;
+};
+
+auto make_test_objects(const std::size_t object_count, const uint32 seed) -> test_objects
+{
+   std::mt19937 random{seed};
+   std::uniform_real_distribution<float> position_distribution{-512.0f, 512.0f};
+   std::uniform_real_distribution<float> size_distribution{0.0f, 32.0f};
+   std::uniform_int_distribution<int> flags_distribution{0, 3};
+
+   test_objects objects;
+
+   for (std::size_t i = 0; i < object_count; ++i) {
+      const float3 position{position_distribution(random),
+                            position_distribution(random) * 0.25f,
+                            position_distribution(random)};
+      const float3 half_size{size_distribution(random), size_distribution(random),
+                             size_distribution(random)};
+      const math::bounding_box bbox{.min = position - half_size,
+                                    .max = position + half_size};
+
+      objects.bbox.push_back(bbox);
+      objects.bbox_soa.min.x.push_back(bbox.min.x);
+      objects.bbox_soa.min.y.push_back(bbox.min.y);
+      objects.bbox_soa.min.z.push_back(bbox.min.z);
+      objects.bbox_soa.max.x.push_back(bbox.max.x);
+      objects.bbox_soa.max.y.push_back(bbox.max.y);
+      objects.bbox_soa.max.z.push_back(bbox.max.z);
+
+      switch (flags_distribution(random)) {
+      case 0:
+         objects.pipeline_flags.push_back(material_pipeline_flags::transparent);
+         break;
+      case 1:
+         objects.pipeline_flags.push_back(material_pipeline_flags::additive);
+         break;
+      default:
+         objects.pipeline_flags.push_back(material_pipeline_flags::none);
+         break;
+      }
+   }
+
+   return objects;
+}
+
+auto make_test_frustums() -> std::vector<frustum>
+{
+   std::vector<frustum> frustums;
+
+   camera camera;
+
+   camera.far_clip(256.0f);
+
+   // Some of the views look away from the origin so frustums that don't contain it are
+   // covered too.
+   for (const float yaw : {0.0f, 1.0f, 2.5f, 4.0f, 5.5f}) {
+      camera.position({yaw * 96.0f, 16.0f, -yaw * 64.0f});
+      camera.yaw(yaw);
+      camera.pitch(yaw * -0.125f);
+
+      frustums.emplace_back(camera.inv_view_projection_matrix());
+   }
+
+   return frustums;
+}
+
+using cull_objects_variant = decltype(&cull_objects);
+using cull_objects_shadow_cascade_variant = decltype(&cull_objects_shadow_cascade);
+
+void check_matches_scalar(const cull_objects_variant cull,
+                          const cull_objects_shadow_cascade_variant cull_shadow_cascade)
+{
+   const std::vector<frustum> frustums = make_test_frustums();
+
+   std::vector<uint32> scalar_opaque;
+   std::vector<uint32> scalar_transparent;
+   std::vector<uint32> scalar_shadow;
+   std::vector<uint32> opaque;
+   std::vector<uint32> transparent;
+   std::vector<uint32> shadow;
+
+   // Counts around the SIMD widths cover the partial last iterations.
+   for (const std::size_t object_count :
+        {std::size_t{0}, std::size_t{1}, std::size_t{7}, std::size_t{8}, std::size_t{15},
+         std::size_t{16}, std::size_t{17}, std::size_t{33}, std::size_t{10007}}) {
+      const test_objects objects =
+         make_test_objects(object_count, static_cast<uint32>(object_count));
+
+      for (const frustum& frustum : frustums) {
+         cull_objects_scalar(frustum, objects.bbox, objects.pipeline_flags,
+                             scalar_opaque, scalar_transparent);
+         cull(frustum, objects.bbox_soa.min.x, objects.bbox_soa.min.y,
+              objects.bbox_soa.min.z, objects.bbox_soa.max.x, objects.bbox_soa.max.y,
+              objects.bbox_soa.max.z, objects.pipeline_flags, opaque, transparent);
+
+         CHECK(opaque == scalar_opaque);
+         CHECK(transparent == scalar_transparent);
+
+         cull_objects_shadow_cascade_scalar(frustum, objects.bbox,
+                                            objects.pipeline_flags, scalar_shadow);
+         cull_shadow_cascade(frustum, objects.bbox_soa.min.x, objects.bbox_soa.min.y,
+                             objects.bbox_soa.min.z, objects.bbox_soa.max.x,
+                             objects.bbox_soa.max.y, objects.bbox_soa.max.z,
+                             objects.pipeline_flags, shadow);
+
+         CHECK(shadow == scalar_shadow);
+      }
+   }
+}
+
+}
+
+TEST_CASE("cull_objects variants match scalar", "[Graphics][CullObjects]")
+{
+   SECTION("avx2")
+   {
+      check_matches_scalar(&cull_objects_avx2, &cull_objects_shadow_cascade_avx2);
+   }
+
+   SECTION("avx512")
+   {
+      if (is_cull_objects_avx512_supported()) {
+         check_matches_scalar(&cull_objects_avx512, &cull_objects_shadow_cascade_avx512);
+      }
+      else {
+         WARN("AVX-512 isn't supported, skipping.");
+      }
+   }
+
+   SECTION("dispatched")
+   {
+      check_matches_scalar(&cull_objects, &cull_objects_shadow_cascade);
+   }
+}
+
+TEST_CASE("cull_objects benchmarks", "[Graphics][CullObjects][!benchmark]")
+{
+   const test_objects objects = make_test_objects(100'000, 1);
+   const frustum frustum = make_test_frustums()[0];
+
+   std::vector<uint32> opaque_list;
+   std::vector<uint32> transparent_list;
+
+   BENCHMARK("scalar cull of 100k objects")
+   {
+      cull_objects_scalar(frustum, objects.bbox, objects.pipeline_flags, opaque_list,
+                          transparent_list);
+
+      return opaque_list.size() + transparent_list.size();
+   };
+
+   BENCHMARK("AVX2 cull of 100k objects")
+   {
+      cull_objects_avx2(frustum, objects.bbox_soa.min.x, objects.bbox_soa.min.y,
+                        objects.bbox_soa.min.z, objects.bbox_soa.max.x,
+                        objects.bbox_soa.max.y, objects.bbox_soa.max.z,
+                        objects.pipeline_flags, opaque_list, transparent_list);
+
+      return opaque_list.size() + transparent_list.size();
+   };
+
+   if (is_cull_objects_avx512_supported()) {
+      BENCHMARK("AVX-512 cull of 100k objects")
+      {
+         cull_objects_avx512(frustum, objects.bbox_soa.min.x, objects.bbox_soa.min.y,
+                             objects.bbox_soa.min.z, objects.bbox_soa.max.x,
+                             objects.bbox_soa.max.y, objects.bbox_soa.max.z,
+                             objects.pipeline_flags, opaque_list, transparent_list);
+
+         return opaque_list.size() + transparent_list.size();
+      };
+   }
+
+   std::vector<uint32> shadow_list;
+
+   BENCHMARK("scalar shadow cascade cull of 100k objects")
+   {
+      cull_objects_shadow_cascade_scalar(frustum, objects.bbox, objects.pipeline_flags,
+                                         shadow_list);
+
+      return shadow_list.size();
+   };
+
+   BENCHMARK("AVX2 shadow cascade cull of 100k objects")
+   {
+      cull_objects_shadow_cascade_avx2(frustum, objects.bbox_soa.min.x,
+                                       objects.bbox_soa.min.y, objects.bbox_soa.min.z,
+                                       objects.bbox_soa.max.x, objects.bbox_soa.max.y,
+                                       objects.bbox_soa.max.z, objects.pipeline_flags,
+                                       shadow_list);
+
+      return shadow_list.size();
+   };
+
+   if (is_cull_objects_avx512_supported()) {
+      BENCHMARK("AVX-512 shadow cascade cull of 100k objects")
+      {
+         cull_objects_shadow_cascade_avx512(frustum, objects.bbox_soa.min.x,
+                                            objects.bbox_soa.min.y,
+                                            objects.bbox_soa.min.z,
+                                            objects.bbox_soa.max.x,
+                                            objects.bbox_soa.max.y,
+                                            objects.bbox_soa.max.z,
+                                            objects.pipeline_flags, shadow_list);
+
+         return shadow_list.size();
+      };
+   }
+}
+
+}
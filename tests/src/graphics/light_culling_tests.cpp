@@ -0,0 +1,182 @@
+#include "pch.h"
+
+#include "graphics/camera.hpp"
+#include "graphics/light_culling.hpp"
+#include "math/quaternion_funcs.hpp"
+#include "math/vector_funcs.hpp"
+
+#include <cmath>
+#include <numbers>
+#include <random>
+
+namespace we::graphics::tests {
+
+namespace {
+
+auto make_test_frustum() -> frustum
+{
+   camera camera;
+
+   camera.far_clip(256.0f);
+
+   return frustum{camera.inv_view_projection_matrix()};
+}
+
+/// @brief Rotation that points a light's -Z axis down +Z. Spot lights with it shine down
+/// -Z, into the view.
+const quaternion facing_back = {0.0f, 0.0f, 1.0f, 0.0f};
+
+}
+
+TEST_CASE("graphics light culling point lights", "[Graphics][LightCulling]")
+{
+   const frustum frustum = make_test_frustum();
+
+   CHECK(is_light_visible(frustum, {.position = {0.0f, 0.0f, -16.0f},
+                                    .light_type = world::light_type::point,
+                                    .range = 4.0f}));
+   CHECK(is_light_visible(frustum, {.position = {0.0f, 0.0f, 2.0f},
+                                    .light_type = world::light_type::point,
+                                    .range = 4.0f}));
+   CHECK(not is_light_visible(frustum, {.position = {0.0f, 0.0f, 8.0f},
+                                        .light_type = world::light_type::point,
+                                        .range = 4.0f}));
+   CHECK(not is_light_visible(frustum, {.position = {0.0f, 0.0f, -300.0f},
+                                        .light_type = world::light_type::point,
+                                        .range = 4.0f}));
+}
+
+TEST_CASE("graphics light culling spot lights", "[Graphics][LightCulling]")
+{
+   const frustum frustum = make_test_frustum();
+
+   // Behind the camera with a range that reaches into the frustum, shining away from it.
+   world::light light{.position = {0.0f, 0.0f, 4.0f},
+                      .light_type = world::light_type::spot,
+                      .range = 16.0f,
+                      .inner_cone_angle = 0.5f,
+                      .outer_cone_angle = 0.6f};
+
+   CHECK(not is_light_visible(frustum, light));
+
+   // Shining into the view.
+   light.rotation = facing_back;
+
+   CHECK(is_light_visible(frustum, light));
+
+   // Wide cones are still visible when facing away.
+   light.rotation = {};
+   light.outer_cone_angle = 3.1f;
+
+   CHECK(is_light_visible(frustum, light));
+}
+
+TEST_CASE("graphics light culling region lights", "[Graphics][LightCulling]")
+{
+   const frustum frustum = make_test_frustum();
+
+   for (const world::light_type type :
+        {world::light_type::directional_region_box, world::light_type::directional_region_sphere,
+         world::light_type::directional_region_cylinder}) {
+      CHECK(is_light_visible(frustum, {.position = {0.0f, 0.0f, -16.0f},
+                                       .light_type = type,
+                                       .region_size = {2.0f, 2.0f, 2.0f}}));
+      CHECK(not is_light_visible(frustum, {.position = {0.0f, 0.0f, 16.0f},
+                                           .light_type = type,
+                                           .region_size = {2.0f, 2.0f, 2.0f}}));
+   }
+
+   // A long thin box behind the camera that only reaches the frustum once it's rotated to
+   // lie along the view direction.
+   world::light light{.position = {0.0f, 0.0f, 8.0f},
+                      .light_type = world::light_type::directional_region_box,
+                      .region_size = {16.0f, 0.5f, 0.5f}};
+
+   CHECK(not is_light_visible(frustum, light));
+
+   light.region_rotation = make_quat_from_euler({0.0f, std::numbers::pi_v<float> / 2.0f, 0.0f});
+
+   CHECK(is_light_visible(frustum, light));
+
+   CHECK(is_light_visible(frustum, {.position = {0.0f, 0.0f, 1000.0f},
+                                    .light_type = world::light_type::directional}));
+}
+
+TEST_CASE("graphics light culling cone matches sampled points",
+          "[Graphics][LightCulling]")
+{
+   const frustum frustum = make_test_frustum();
+
+   std::mt19937 random{0x5107};
+   std::uniform_real_distribution<float> position_distribution{-64.0f, 64.0f};
+   std::uniform_real_distribution<float> direction_distribution{-1.0f, 1.0f};
+   std::uniform_real_distribution<float> angle_distribution{0.05f, 1.4f};
+   std::uniform_real_distribution<float> unit_distribution{0.0f, 1.0f};
+
+   for (int cone = 0; cone < 512; ++cone) {
+      const float3 apex{position_distribution(random), position_distribution(random),
+                        position_distribution(random)};
+      const float3 direction = normalize(float3{direction_distribution(random),
+                                                direction_distribution(random),
+                                                direction_distribution(random)});
+      const float height = 4.0f + unit_distribution(random) * 28.0f;
+      const float half_angle = angle_distribution(random);
+
+      const bool visible = intersects_cone(frustum, apex, direction, height, half_angle);
+
+      // The test is conservative, any point of the cone inside the frustum must make it
+      // visible.
+      if (visible) continue;
+
+      const float3 tangent = normalize(
+         cross(direction, std::abs(direction.y) < 0.9f ? float3{0.0f, 1.0f, 0.0f}
+                                                       : float3{1.0f, 0.0f, 0.0f}));
+      const float3 bitangent = cross(direction, tangent);
+
+      for (int sample = 0; sample < 256; ++sample) {
+         const float distance = unit_distribution(random) * height;
+         const float radius =
+            unit_distribution(random) * distance * std::tan(half_angle);
+         const float angle = unit_distribution(random) * 6.2831853f;
+
+         const float3 point = apex + direction * distance +
+                              tangent * (radius * std::cos(angle)) +
+                              bitangent * (radius * std::sin(angle));
+
+         REQUIRE(not intersects(frustum, point, 0.0f));
+      }
+   }
+}
+
+TEST_CASE("graphics light culling order", "[Graphics][LightCulling]")
+{
+   const frustum frustum = make_test_frustum();
+
+   const std::array<world::light, 6> lights{
+      world::light{.position = {0.0f, 0.0f, -64.0f},
+                   .light_type = world::light_type::point,
+                   .range = 4.0f},
+      world::light{.position = {0.0f, 0.0f, 64.0f},
+                   .light_type = world::light_type::point,
+                   .range = 4.0f},
+      world::light{.position = {0.0f, 0.0f, -8.0f},
+                   .light_type = world::light_type::point,
+                   .range = 4.0f},
+      world::light{.light_type = world::light_type::directional},
+      world::light{.position = {0.0f, 0.0f, -8.0f},
+                   .color = {0.5f, 0.5f, 0.5f},
+                   .light_type = world::light_type::point,
+                   .range = 4.0f},
+      world::light{.position = {0.0f, 0.0f, -64.0f},
+                   .light_type = world::light_type::point,
+                   .range = 4.0f},
+   };
+
+   std::vector<uint32> visible_lights;
+
+   cull_lights(frustum, {0.0f, 0.0f, 0.0f}, lights, visible_lights);
+
+   CHECK(visible_lights == std::vector<uint32>{3, 2, 4, 0, 5});
+}
+
+}
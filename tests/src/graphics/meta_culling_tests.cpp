@@ -0,0 +1,106 @@
+#include "pch.h"
+
+#include "graphics/camera.hpp"
+#include "graphics/meta_culling.hpp"
+#include "math/vector_funcs.hpp"
+
+#include <random>
+
+namespace we::graphics::tests {
+
+namespace {
+
+auto make_test_frustum() -> frustum
+{
+   camera camera;
+
+   camera.far_clip(4096.0f);
+
+   return frustum{camera.inv_view_projection_matrix()};
+}
+
+auto make_test_path(const std::size_t node_count, const uint32 seed)
+   -> std::vector<world::path::node>
+{
+   std::mt19937 random{seed};
+   std::uniform_real_distribution<float> step_distribution{-8.0f, 8.0f};
+
+   std::vector<world::path::node> nodes;
+
+   nodes.reserve(node_count);
+
+   float3 position{0.0f, 0.0f, 0.0f};
+
+   for (std::size_t i = 0; i < node_count; ++i) {
+      position += float3{step_distribution(random), step_distribution(random) * 0.25f,
+                         step_distribution(random)};
+
+      nodes.push_back({.position = position});
+   }
+
+   return nodes;
+}
+
+}
+
+TEST_CASE("graphics meta culling distance", "[Graphics][MetaCulling]")
+{
+   const frustum frustum = make_test_frustum();
+   const meta_culling culling{frustum, {0.0f, 0.0f, 0.0f}, 256.0f};
+
+   CHECK(culling.visible(float3{0.0f, 0.0f, -128.0f}, 1.0f));
+   CHECK(culling.visible(float3{0.0f, 0.0f, -260.0f}, 8.0f));
+   CHECK(not culling.visible(float3{0.0f, 0.0f, -300.0f}, 1.0f));
+   CHECK(not culling.visible(float3{0.0f, 0.0f, 128.0f}, 1.0f));
+
+   CHECK(culling.visible(math::bounding_box{.min = {-1.0f, -1.0f, -1000.0f},
+                                            .max = {1.0f, 1.0f, -250.0f}}));
+   CHECK(not culling.visible(math::bounding_box{.min = {-1.0f, -1.0f, -1000.0f},
+                                                .max = {1.0f, 1.0f, -300.0f}}));
+
+   CHECK(culling.detailed({0.0f, 0.0f, -32.0f}, 0.5f));
+   CHECK(not culling.detailed({0.0f, 0.0f, -128.0f}, 0.5f));
+
+   CHECK(culling.fade({0.0f, 0.0f, -128.0f}, 1.0f) == 1.0f);
+   CHECK(culling.fade({0.0f, 0.0f, -225.0f}, 1.0f) == Approx(0.5f));
+   CHECK(culling.fade({0.0f, 0.0f, -400.0f}, 1.0f) == 0.0f);
+}
+
+TEST_CASE("graphics meta culling paths", "[Graphics][MetaCulling]")
+{
+   const frustum frustum = make_test_frustum();
+
+   for (const float draw_distance : {64.0f, 256.0f, 100000.0f}) {
+      const meta_culling culling{frustum, {0.0f, 0.0f, 0.0f}, draw_distance};
+
+      for (const std::size_t node_count : {0, 1, 2, 31, 32, 33, 1000}) {
+         const std::vector<world::path::node> nodes =
+            make_test_path(node_count, static_cast<uint32>(node_count));
+
+         std::vector<uint32> visible_nodes;
+         std::vector<uint32> visible_connections;
+
+         cull_path(culling, nodes, 0.5f, visible_nodes, visible_connections);
+
+         std::vector<uint32> expected_nodes;
+         std::vector<uint32> expected_connections;
+
+         for (uint32 i = 0; i < nodes.size(); ++i) {
+            if (culling.visible(nodes[i].position, 0.5f)) expected_nodes.push_back(i);
+
+            if (i + 1 < nodes.size() and
+                culling.visible(
+                   math::bounding_box{.min = min(nodes[i].position, nodes[i + 1].position),
+                                      .max = max(nodes[i].position,
+                                                 nodes[i + 1].position)})) {
+               expected_connections.push_back(i);
+            }
+         }
+
+         REQUIRE(visible_nodes == expected_nodes);
+         REQUIRE(visible_connections == expected_connections);
+      }
+   }
+}
+
+}
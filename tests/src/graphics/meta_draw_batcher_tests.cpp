@@ -0,0 +1,123 @@
+#include "pch.h"
+
+#include "graphics/meta_draw_batcher.hpp"
+
+namespace we::graphics::tests {
+
+namespace {
+
+void record_test_item(meta_draw_batcher& batcher, const std::size_t i)
+{
+   const float x = static_cast<float>(i);
+   const float4x4 transform{{1.0f, 0.0f, 0.0f, 0.0f},
+                            {0.0f, 1.0f, 0.0f, 0.0f},
+                            {0.0f, 0.0f, 1.0f, 0.0f},
+                            {x, 0.0f, -x, 1.0f}};
+   const uint32 color = static_cast<uint32>(i);
+
+   switch (i % 5) {
+   case 0:
+      batcher.add_octahedron_outlined(transform, {x, 0.0f, 0.0f, 1.0f},
+                                      {0.0f, x, 0.0f, 1.0f});
+      batcher.add_arrow_outline_solid(transform, 0.5f, color);
+      break;
+   case 1:
+      batcher.add_box(transform, {x, 1.0f, 0.0f, 0.5f});
+      batcher.add_line_solid({x, 0.0f, 0.0f}, {0.0f, x, 0.0f}, color);
+      break;
+   case 2:
+      batcher.add_sphere({x, 0.0f, 0.0f}, x, {1.0f, 1.0f, 1.0f, 0.25f});
+      batcher.add_triangle({x, 0.0f, 0.0f}, {0.0f, x, 0.0f}, {0.0f, 0.0f, x}, color);
+      break;
+   case 3:
+      batcher.add_hint_hexahedron(transform, {0.0f, 0.0f, x, 1.0f});
+      batcher.add_cylinder_wireframe(transform, {x, x, x});
+      break;
+   case 4:
+      batcher.add_cone(transform, {x, x, 0.0f, 0.5f});
+      batcher.add_line_overlay({x, 0.0f, 0.0f}, {0.0f, x, 0.0f}, color);
+      break;
+   }
+}
+
+void record_serial(meta_draw_batcher& batcher, const std::size_t count)
+{
+   for (std::size_t i = 0; i < count; ++i) record_test_item(batcher, i);
+}
+
+void record_threaded(meta_draw_batcher& batcher,
+                     std::vector<meta_draw_batcher>& worker_batchers,
+                     const std::size_t count, async::thread_pool& thread_pool)
+{
+   record_meta_draws(batcher, worker_batchers, count, thread_pool,
+                     [](meta_draw_batcher& batcher, const std::size_t begin,
+                        const std::size_t end) noexcept {
+                        for (std::size_t i = begin; i < end; ++i) {
+                           record_test_item(batcher, i);
+                        }
+                     });
+}
+
+}
+
+TEST_CASE("graphics meta_draw_batcher append", "[Graphics][MetaDrawBatcher]")
+{
+   meta_draw_batcher expected;
+
+   record_serial(expected, 20);
+
+   meta_draw_batcher first;
+   meta_draw_batcher second;
+
+   for (std::size_t i = 0; i < 20; ++i) {
+      record_test_item(i < 7 ? first : second, i);
+   }
+
+   first.append(second);
+
+   CHECK(first == expected);
+
+   first.append(meta_draw_batcher{});
+
+   CHECK(first == expected);
+}
+
+TEST_CASE("graphics meta_draw_batcher threaded recording matches serial",
+          "[Graphics][MetaDrawBatcher]")
+{
+   const auto single_thread_pool =
+      async::thread_pool::make({.thread_count = 1, .low_priority_thread_count = 1});
+   const auto thread_pool =
+      async::thread_pool::make({.thread_count = 3, .low_priority_thread_count = 1});
+
+   std::vector<meta_draw_batcher> worker_batchers;
+
+   for (const std::size_t count : {0, 1, 2, 3, 4, 5, 97, 10'000}) {
+      meta_draw_batcher expected;
+
+      expected.add_line_solid({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}, 0xff'ff'ff'ffu);
+
+      record_serial(expected, count);
+
+      for (async::thread_pool* pool : {single_thread_pool.get(), thread_pool.get()}) {
+         meta_draw_batcher batcher;
+
+         batcher.add_line_solid({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}, 0xff'ff'ff'ffu);
+
+         record_threaded(batcher, worker_batchers, count, *pool);
+
+         REQUIRE(batcher == expected);
+      }
+   }
+
+   // Recording again after the worker batchers have been used must not leave stale draws.
+   meta_draw_batcher expected;
+   meta_draw_batcher batcher;
+
+   record_serial(expected, 50);
+   record_threaded(batcher, worker_batchers, 50, *thread_pool);
+
+   CHECK(batcher == expected);
+}
+
+}
@@ -0,0 +1,437 @@
+#include "pch.h"
+
+#include "graphics/camera.hpp"
+#include "graphics/frustum.hpp"
+#include "graphics/shadow_cascades.hpp"
+#include "math/matrix_funcs.hpp"
+#include "math/quaternion_funcs.hpp"
+#include "math/vector_funcs.hpp"
+
+#include <algorithm>
+#include <random>
+
+namespace we::graphics::tests {
+
+namespace {
+
+constexpr uint32 test_shadow_resolution = 2048;
+
+/// @brief A sun coming in steeply from the side.
+const quaternion test_light_rotation =
+   normalize(quaternion{0.8535534f, -0.3535534f, 0.3535534f, 0.1464466f});
+
+auto make_test_camera(const float3 position) -> camera
+{
+   camera camera;
+
+   camera.far_clip(1024.0f);
+   camera.position(position);
+
+   return camera;
+}
+
+auto make_test_cascades(const camera& camera)
+   -> std::array<shadow_ortho_camera, sun_shadow_cascade_count>
+{
+   return make_shadow_cascades(test_light_rotation, camera, {0.0f, 1.0f},
+                               test_shadow_resolution);
+}
+
+auto make_test_mesh_list(const std::size_t mesh_count, const uint32 seed)
+   -> world_mesh_list
+{
+   std::mt19937 random{seed};
+   std::uniform_real_distribution<float> position_distribution{-1024.0f, 1024.0f};
+   std::uniform_real_distribution<float> size_distribution{0.5f, 16.0f};
+
+   world_mesh_list list;
+
+   list.reserve(mesh_count);
+
+   for (std::size_t i = 0; i < mesh_count; ++i) {
+      const float3 position{position_distribution(random),
+                            position_distribution(random) * 0.0625f,
+                            position_distribution(random)};
+      const float3 half_size{size_distribution(random), size_distribution(random),
+                             size_distribution(random)};
+
+      list.push_back({.min = position - half_size, .max = position + half_size}, 0,
+                     position, gpu::pipeline_handle{},
+                     i % 8 == 0 ? material_pipeline_flags::transparent
+                                : material_pipeline_flags::none,
+                     0, {});
+   }
+
+   return list;
+}
+
+/// @brief Get if a point lies in the volume a cascade takes casters from.
+bool in_caster_volume(const shadow_ortho_camera& cascade, const float3& point)
+{
+   const float4 light_point = cascade.view_projection_matrix() * float4{point, 1.0f};
+
+   return std::abs(light_point.x) <= 1.0f and std::abs(light_point.y) <= 1.0f and
+          light_point.z <= 1.0f;
+}
+
+/// @brief Get the casters for a cascade from a cull of every mesh, sorted.
+auto cull_reference(const shadow_ortho_camera& cascade, const world_mesh_list& meshes)
+   -> std::vector<uint32>
+{
+   const frustum cascade_frustum{cascade.inv_view_projection_matrix()};
+
+   std::vector<uint32> casters;
+
+   for (uint32 i = 0; i < meshes.size(); ++i) {
+      if (are_flags_set(meshes.pipeline_flags[i], material_pipeline_flags::transparent)) {
+         continue;
+      }
+
+      const math::bounding_box bbox{.min = {meshes.bbox.min.x[i], meshes.bbox.min.y[i],
+                                            meshes.bbox.min.z[i]},
+                                    .max = {meshes.bbox.max.x[i], meshes.bbox.max.y[i],
+                                            meshes.bbox.max.z[i]}};
+
+      if (intersects_shadow_cascade(cascade_frustum, bbox) and
+          intersects_shadow_cascade_light_space(cascade.view_projection_matrix(), bbox)) {
+         casters.push_back(i);
+      }
+   }
+
+   return casters;
+}
+
+auto sorted(std::span<const uint32> casters) -> std::vector<uint32>
+{
+   std::vector<uint32> sorted_casters{casters.begin(), casters.end()};
+
+   std::ranges::sort(sorted_casters);
+
+   return sorted_casters;
+}
+
+}
+
+TEST_CASE("graphics make_shadow_cascades deterministic", "[Graphics][ShadowCascades]")
+{
+   const camera camera = make_test_camera({16.0f, 32.0f, -8.0f});
+
+   const auto cascades = make_test_cascades(camera);
+   const auto cascades_again = make_test_cascades(camera);
+
+   for (uint32 i = 0; i < sun_shadow_cascade_count; ++i) {
+      CHECK(cascades[i].view_projection_matrix() ==
+            cascades_again[i].view_projection_matrix());
+      CHECK(cascades[i].texture_matrix() == cascades_again[i].texture_matrix());
+   }
+}
+
+TEST_CASE("graphics make_shadow_cascades coverage", "[Graphics][ShadowCascades]")
+{
+   const camera camera = make_test_camera({16.0f, 32.0f, -8.0f});
+   const auto cascades = make_test_cascades(camera);
+
+   // Each cascade covers more of the world than the one before it.
+   for (uint32 i = 1; i < sun_shadow_cascade_count; ++i) {
+      CHECK(length(cascades[i].view_projection_matrix()[0]) <
+            length(cascades[i - 1].view_projection_matrix()[0]));
+   }
+
+   // Every point in the view frustum is inside a cascade.
+   std::mt19937 random{1337};
+   std::uniform_real_distribution<float> ndc_distribution{-1.0f, 1.0f};
+   std::uniform_real_distribution<float> depth_distribution{0.0f, 1.0f};
+
+   for (int i = 0; i < 1024; ++i) {
+      float4 point = camera.inv_view_projection_matrix() *
+                     float4{ndc_distribution(random), ndc_distribution(random),
+                            depth_distribution(random), 1.0f};
+      point /= point.w;
+
+      const float3 world_point{point.x, point.y, point.z};
+
+      REQUIRE(std::ranges::any_of(cascades, [&](const shadow_ortho_camera& cascade) {
+         const float4 light_point =
+            cascade.view_projection_matrix() * float4{world_point, 1.0f};
+
+         return std::abs(light_point.x) <= 1.001f and
+                std::abs(light_point.y) <= 1.001f and light_point.z >= -0.001f and
+                light_point.z <= 1.001f;
+      }));
+   }
+}
+
+TEST_CASE("graphics shadow cascade light space culling", "[Graphics][ShadowCascades]")
+{
+   const camera camera = make_test_camera({0.0f, 0.0f, 0.0f});
+   const shadow_ortho_camera cascade = make_test_cascades(camera)[1];
+   const float4x4& view_projection_matrix = cascade.view_projection_matrix();
+   const float4x4& inv_view_projection_matrix = cascade.inv_view_projection_matrix();
+
+   const auto light_to_world = [&](const float3& light_point) {
+      const float4 point = inv_view_projection_matrix * float4{light_point, 1.0f};
+
+      return float3{point.x, point.y, point.z} / point.w;
+   };
+   const auto make_box = [](const float3& centre, const float half_size) {
+      return math::bounding_box{.min = centre - half_size, .max = centre + half_size};
+   };
+
+   const float half_size = 0.5f;
+
+   CHECK(intersects_shadow_cascade_light_space(
+      view_projection_matrix, make_box(light_to_world({0.0f, 0.0f, 0.5f}), half_size)));
+
+   // Between the cascade and the sun.
+   CHECK(intersects_shadow_cascade_light_space(
+      view_projection_matrix, make_box(light_to_world({0.0f, 0.0f, -4.0f}), half_size)));
+
+   // Beyond the far side, or off to the sides.
+   CHECK(not intersects_shadow_cascade_light_space(
+      view_projection_matrix, make_box(light_to_world({0.0f, 0.0f, 1.5f}), half_size)));
+   CHECK(not intersects_shadow_cascade_light_space(
+      view_projection_matrix, make_box(light_to_world({1.5f, 0.0f, 0.5f}), half_size)));
+   CHECK(not intersects_shadow_cascade_light_space(
+      view_projection_matrix, make_box(light_to_world({0.0f, -1.5f, -4.0f}), half_size)));
+
+   // A box with any point in the volume must pass.
+   std::mt19937 random{1337};
+   std::uniform_real_distribution<float> light_distribution{-2.0f, 2.0f};
+   std::uniform_real_distribution<float> size_distribution{0.5f, 64.0f};
+   std::uniform_real_distribution<float> unorm_distribution{0.0f, 1.0f};
+
+   for (int i = 0; i < 4096; ++i) {
+      const float3 centre = light_to_world({light_distribution(random),
+                                            light_distribution(random),
+                                            light_distribution(random)});
+      const float3 box_half_size{size_distribution(random), size_distribution(random),
+                                 size_distribution(random)};
+      const math::bounding_box box{.min = centre - box_half_size,
+                                   .max = centre + box_half_size};
+
+      const bool passed =
+         intersects_shadow_cascade_light_space(view_projection_matrix, box);
+
+      for (int sample = 0; sample < 16; ++sample) {
+         const float3 point =
+            box.min + (box.max - box.min) * float3{unorm_distribution(random),
+                                                   unorm_distribution(random),
+                                                   unorm_distribution(random)};
+
+         if (in_caster_volume(cascade, point)) REQUIRE(passed);
+      }
+   }
+}
+
+TEST_CASE("graphics shadow_caster_cache culling", "[Graphics][ShadowCascades]")
+{
+   const world_mesh_list meshes = make_test_mesh_list(8192, 7);
+
+   world_mesh_bvh bvh;
+
+   bvh.update(meshes);
+
+   const camera camera = make_test_camera({16.0f, 32.0f, -8.0f});
+   const auto cascades = make_test_cascades(camera);
+
+   shadow_caster_cache cache;
+
+   cache.next_frame();
+
+   for (uint32 i = 0; i < sun_shadow_cascade_count; ++i) {
+      cache.cull(i, cascades[i], meshes, bvh);
+
+      CHECK(not cache.reused(i));
+
+      const std::vector<uint32> casters = sorted(cache.casters(i));
+      const std::vector<uint32> reference = cull_reference(cascades[i], meshes);
+
+      // The near cascade is culled exactly, the distant ones are padded and have extra
+      // casters.
+      if (i == 0) {
+         CHECK(casters == reference);
+      }
+      else {
+         CHECK(std::ranges::includes(casters, reference));
+      }
+   }
+}
+
+TEST_CASE("graphics shadow_caster_cache reuse", "[Graphics][ShadowCascades]")
+{
+   const world_mesh_list meshes = make_test_mesh_list(8192, 7);
+
+   world_mesh_bvh bvh;
+
+   bvh.update(meshes);
+
+   shadow_caster_cache cache;
+
+   const auto run_frame = [&](const camera& camera) {
+      const auto cascades = make_test_cascades(camera);
+
+      cache.next_frame();
+
+      for (uint32 i = 0; i < sun_shadow_cascade_count; ++i) {
+         cache.cull(i, cascades[i], meshes, bvh);
+
+         // Reused or not, every caster the cascade needs must be there.
+         REQUIRE(std::ranges::includes(sorted(cache.casters(i)),
+                                       cull_reference(cascades[i], meshes)));
+      }
+   };
+
+   run_frame(make_test_camera({16.0f, 32.0f, -8.0f}));
+
+   SECTION("still camera")
+   {
+      std::array<uint32, sun_shadow_cascade_count> refresh_counts{};
+
+      for (uint32 frame = 0; frame < shadow_caster_cache::max_reuse_frames; ++frame) {
+         run_frame(make_test_camera({16.0f, 32.0f, -8.0f}));
+
+         uint32 refreshed_this_frame = 0;
+
+         for (uint32 i = 1; i < sun_shadow_cascade_count; ++i) {
+            if (not cache.reused(i)) {
+               refresh_counts[i] += 1;
+               refreshed_this_frame += 1;
+            }
+         }
+
+         CHECK(not cache.reused(0));
+         CHECK(refreshed_this_frame <= 1);
+      }
+
+      // Every distant cascade is refreshed once in its reuse window.
+      for (uint32 i = 1; i < sun_shadow_cascade_count; ++i) {
+         CHECK(refresh_counts[i] == 1);
+      }
+   }
+
+   SECTION("slow camera")
+   {
+      uint32 reused_count = 0;
+
+      for (uint32 frame = 0; frame < 64; ++frame) {
+         run_frame(make_test_camera({16.0f + frame * 0.25f, 32.0f, -8.0f}));
+
+         if (cache.reused(sun_shadow_cascade_count - 1)) reused_count += 1;
+      }
+
+      CHECK(reused_count > 0);
+   }
+
+   SECTION("fast camera")
+   {
+      for (uint32 frame = 0; frame < 4; ++frame) {
+         run_frame(make_test_camera({16.0f + (frame + 1) * 512.0f, 32.0f, -8.0f}));
+
+         for (uint32 i = 0; i < sun_shadow_cascade_count; ++i) {
+            CHECK(not cache.reused(i));
+         }
+      }
+   }
+
+   SECTION("invalidated")
+   {
+      cache.invalidate();
+
+      run_frame(make_test_camera({16.0f, 32.0f, -8.0f}));
+
+      for (uint32 i = 0; i < sun_shadow_cascade_count; ++i) {
+         CHECK(not cache.reused(i));
+      }
+   }
+}
+
+TEST_CASE("graphics shadow_caster_cache pushed meshes", "[Graphics][ShadowCascades]")
+{
+   world_mesh_list meshes = make_test_mesh_list(1024, 7);
+
+   world_mesh_bvh bvh;
+
+   bvh.update(meshes);
+
+   const camera camera = make_test_camera({16.0f, 32.0f, -8.0f});
+   const auto cascades = make_test_cascades(camera);
+   const uint32 cascade_index = sun_shadow_cascade_count - 1;
+
+   shadow_caster_cache cache;
+
+   cache.next_frame();
+   cache.cull(cascade_index, cascades[cascade_index], meshes, bvh);
+
+   const std::size_t bvh_caster_count = cache.casters(cascade_index).size();
+
+   // A mesh pushed on after the BVH update in the middle of the cascade.
+   const float4 centre = cascades[cascade_index].inv_view_projection_matrix() *
+                         float4{0.0f, 0.0f, 0.5f, 1.0f};
+
+   meshes.push_back({.min = float3{centre.x, centre.y, centre.z} - 1.0f,
+                     .max = float3{centre.x, centre.y, centre.z} + 1.0f},
+                    0, {}, gpu::pipeline_handle{}, material_pipeline_flags::none, 0, {});
+
+   cache.next_frame();
+   cache.cull(cascade_index, cascades[cascade_index], meshes, bvh);
+
+   REQUIRE(cache.reused(cascade_index));
+   REQUIRE(cache.casters(cascade_index).size() == bvh_caster_count + 1);
+   CHECK(cache.casters(cascade_index).back() == 1024);
+
+   // And dropped again the next frame.
+   meshes.resize(1024);
+
+   cache.next_frame();
+   cache.cull(cascade_index, cascades[cascade_index], meshes, bvh);
+
+   REQUIRE(cache.reused(cascade_index));
+   CHECK(cache.casters(cascade_index).size() == bvh_caster_count);
+}
+
+TEST_CASE("graphics shadow_caster_cache benchmark",
+          "[Graphics][ShadowCascades][!benchmark]")
+{
+   const world_mesh_list meshes = make_test_mesh_list(100'000, 1);
+
+   world_mesh_bvh bvh;
+
+   bvh.update(meshes);
+
+   const auto cascades = make_test_cascades(make_test_camera({16.0f, 32.0f, -8.0f}));
+
+   BENCHMARK("cull every cascade")
+   {
+      shadow_caster_cache cache;
+      std::size_t caster_count = 0;
+
+      cache.next_frame();
+
+      for (uint32 i = 0; i < sun_shadow_cascade_count; ++i) {
+         cache.cull(i, cascades[i], meshes, bvh);
+
+         caster_count += cache.casters(i).size();
+      }
+
+      return caster_count;
+   };
+
+   shadow_caster_cache cache;
+
+   BENCHMARK("cull with reuse")
+   {
+      std::size_t caster_count = 0;
+
+      cache.next_frame();
+
+      for (uint32 i = 0; i < sun_shadow_cascade_count; ++i) {
+         cache.cull(i, cascades[i], meshes, bvh);
+
+         caster_count += cache.casters(i).size();
+      }
+
+      return caster_count;
+   };
+}
+
+}
@@ -0,0 +1,549 @@
+#include "pch.h"
+
+#include "graphics/camera.hpp"
+#include "graphics/software_occlusion.hpp"
+#include "math/matrix_funcs.hpp"
+#include "math/vector_funcs.hpp"
+
+#include <random>
+#include <utility>
+
+namespace we::graphics::tests {
+
+namespace {
+
+/// @brief A camera at the origin looking down -Z.
+auto make_test_camera() -> camera
+{
+   camera camera;
+
+   camera.far_clip(1024.0f);
+
+   return camera;
+}
+
+/// @brief A square wall facing the camera centred on (0, 0, z).
+auto make_test_wall(const float z, const float half_size) -> occluder_mesh
+{
+   return {.positions = {{-half_size, -half_size, z},
+                         {half_size, -half_size, z},
+                         {half_size, half_size, z},
+                         {-half_size, half_size, z}},
+           .triangles = {{0, 1, 2}, {0, 2, 3}}};
+}
+
+auto make_test_box(const float3& centre, const float3& half_size) -> math::bounding_box
+{
+   return {.min = centre - half_size, .max = centre + half_size};
+}
+
+void add_occluder(occlusion_buffer& buffer, const occluder_mesh& occluder,
+                  const occluder_faces faces = occluder_faces::front)
+{
+   buffer.add_occluder(float4x4{}, occluder.positions, occluder.triangles, faces);
+}
+
+/// @brief A flat terrain with a ridge running along X through the middle.
+auto make_test_terrain() -> world::terrain
+{
+   world::terrain terrain;
+
+   terrain.length = 64;
+   terrain.grid_scale = 8.0f;
+   terrain.height_scale = 1.0f;
+   terrain.height_map = container::dynamic_array_2d<int16>{64, 64};
+
+   for (int32 z = 0; z < 64; ++z) {
+      for (int32 x = 0; x < 64; ++x) {
+         terrain.height_map[{x, z}] = (z >= 28 and z <= 36) ? 64 : 0;
+      }
+   }
+
+   return terrain;
+}
+
+/// @brief Test if a segment hits a triangle. Either face counts and a small tolerance
+/// is allowed at the triangle's edges.
+bool intersects(const float3& start, const float3& end, const float3& v0,
+                const float3& v1, const float3& v2)
+{
+   const float3 direction = end - start;
+   const float3 edge1 = v1 - v0;
+   const float3 edge2 = v2 - v0;
+   const float3 p = cross(direction, edge2);
+   const float determinant = dot(edge1, p);
+
+   if (std::abs(determinant) < 1e-8f) return false;
+
+   const float inv_determinant = 1.0f / determinant;
+   const float3 s = start - v0;
+   const float u = dot(s, p) * inv_determinant;
+
+   if (u < -1e-4f or u > 1.0f + 1e-4f) return false;
+
+   const float3 q = cross(s, edge1);
+   const float v = dot(direction, q) * inv_determinant;
+
+   if (v < -1e-4f or u + v > 1.0f + 1e-4f) return false;
+
+   const float t = dot(edge2, q) * inv_determinant;
+
+   return t > 0.0f and t < 1.0f;
+}
+
+}
+
+TEST_CASE("graphics software occlusion empty", "[Graphics][SoftwareOcclusion]")
+{
+   const camera camera = make_test_camera();
+
+   occlusion_buffer buffer;
+
+   buffer.clear(camera.view_projection_matrix());
+   buffer.build_hierarchy();
+
+   CHECK(not buffer.is_occluded(
+      make_test_box({0.0f, 0.0f, -100.0f}, {1.0f, 1.0f, 1.0f})));
+   CHECK(std::ranges::all_of(buffer.depth(), [](float depth) { return depth == 1.0f; }));
+}
+
+TEST_CASE("graphics software occlusion wall", "[Graphics][SoftwareOcclusion]")
+{
+   const camera camera = make_test_camera();
+   const float3 half_size{5.0f, 5.0f, 5.0f};
+
+   occlusion_buffer buffer;
+
+   buffer.clear(camera.view_projection_matrix());
+   add_occluder(buffer, make_test_wall(-50.0f, 20.0f));
+   buffer.build_hierarchy();
+
+   // Behind the wall.
+   CHECK(buffer.is_occluded(make_test_box({0.0f, 0.0f, -100.0f}, half_size)));
+   CHECK(buffer.is_occluded(make_test_box({0.0f, 0.0f, -900.0f}, {50.0f, 50.0f, 5.0f})));
+
+   // In front of the wall.
+   CHECK(not buffer.is_occluded(make_test_box({0.0f, 0.0f, -25.0f}, half_size)));
+
+   // Crossing the wall.
+   CHECK(not buffer.is_occluded(make_test_box({0.0f, 0.0f, -50.0f}, half_size)));
+
+   // Beside the wall and poking out from behind it.
+   CHECK(not buffer.is_occluded(make_test_box({60.0f, 0.0f, -100.0f}, half_size)));
+   CHECK(not buffer.is_occluded(make_test_box({40.0f, 0.0f, -100.0f}, half_size)));
+
+   // Behind the camera and off screen.
+   CHECK(not buffer.is_occluded(make_test_box({0.0f, 0.0f, 100.0f}, half_size)));
+   CHECK(not buffer.is_occluded(make_test_box({0.0f, 900.0f, -100.0f}, half_size)));
+}
+
+TEST_CASE("graphics software occlusion wall edge", "[Graphics][SoftwareOcclusion]")
+{
+   const camera camera = make_test_camera();
+
+   // Takes a screen X and a view depth back to a view X.
+   const auto to_view_x = [&](const float screen_x, const float z) {
+      return (screen_x / occlusion_buffer::width * 2.0f - 1.0f) * -z /
+             camera.projection_matrix()[0].x;
+   };
+
+   // The wall's right edge ends three quarters of the way across a pixel. The pixel's
+   // centre is inside the wall but the quarter past the edge isn't.
+   const float edge_screen_x = 192.75f;
+   const float edge_x = to_view_x(edge_screen_x, -50.0f);
+
+   const occluder_mesh wall{.positions = {{-20.0f, -20.0f, -50.0f},
+                                          {edge_x, -20.0f, -50.0f},
+                                          {edge_x, 20.0f, -50.0f},
+                                          {-20.0f, 20.0f, -50.0f}},
+                            .triangles = {{0, 1, 2}, {0, 2, 3}}};
+
+   occlusion_buffer buffer;
+
+   buffer.clear(camera.view_projection_matrix());
+   add_occluder(buffer, wall);
+   buffer.build_hierarchy();
+
+   // A small box behind the wall seen only through the part of that pixel past the edge.
+   const float box_min_x = to_view_x(edge_screen_x + 0.05f, -100.0f);
+   const float box_max_x = to_view_x(edge_screen_x + 0.2f, -100.0f);
+
+   CHECK(not buffer.is_occluded({.min = {box_min_x, -1.0f, -100.01f},
+                                 .max = {box_max_x, 1.0f, -99.99f}}));
+
+   // Moved to just inside the edge it's hidden.
+   const float inside_min_x = to_view_x(edge_screen_x - 1.75f, -100.0f);
+   const float inside_max_x = to_view_x(edge_screen_x - 1.25f, -100.0f);
+
+   CHECK(buffer.is_occluded({.min = {inside_min_x, -1.0f, -100.01f},
+                             .max = {inside_max_x, 1.0f, -99.99f}}));
+}
+
+TEST_CASE("graphics software occlusion back faces", "[Graphics][SoftwareOcclusion]")
+{
+   const camera camera = make_test_camera();
+   const math::bounding_box box =
+      make_test_box({0.0f, 0.0f, -100.0f}, {5.0f, 5.0f, 5.0f});
+
+   occluder_mesh wall = make_test_wall(-50.0f, 20.0f);
+
+   for (auto& [i0, i1, i2] : wall.triangles) std::swap(i1, i2);
+
+   occlusion_buffer buffer;
+
+   buffer.clear(camera.view_projection_matrix());
+   add_occluder(buffer, wall, occluder_faces::front);
+   buffer.build_hierarchy();
+
+   CHECK(not buffer.is_occluded(box));
+
+   buffer.clear(camera.view_projection_matrix());
+   add_occluder(buffer, wall, occluder_faces::both);
+   buffer.build_hierarchy();
+
+   CHECK(buffer.is_occluded(box));
+}
+
+TEST_CASE("graphics software occlusion world matrix", "[Graphics][SoftwareOcclusion]")
+{
+   const camera camera = make_test_camera();
+   const occluder_mesh wall = make_test_wall(0.0f, 20.0f);
+
+   float4x4 world_matrix;
+
+   world_matrix[3] = {0.0f, 0.0f, -50.0f, 1.0f};
+
+   occlusion_buffer buffer;
+
+   buffer.clear(camera.view_projection_matrix());
+   buffer.add_occluder(world_matrix, wall.positions, wall.triangles);
+   buffer.build_hierarchy();
+
+   CHECK(buffer.is_occluded(make_test_box({0.0f, 0.0f, -100.0f}, {5.0f, 5.0f, 5.0f})));
+   CHECK(not buffer.is_occluded(make_test_box({0.0f, 0.0f, -25.0f}, {5.0f, 5.0f, 5.0f})));
+}
+
+TEST_CASE("graphics software occlusion terrain", "[Graphics][SoftwareOcclusion]")
+{
+   camera camera = make_test_camera();
+
+   camera.position({0.0f, 16.0f, 200.0f});
+
+   world::terrain terrain = make_test_terrain();
+
+   const occluder_mesh occluder = make_terrain_occluder(terrain);
+
+   REQUIRE(not occluder.triangles.empty());
+
+   // The occluder must face up to be rasterized from above.
+   for (const auto& [i0, i1, i2] : occluder.triangles) {
+      const float3 normal = cross(occluder.positions[i1] - occluder.positions[i0],
+                                  occluder.positions[i2] - occluder.positions[i0]);
+
+      REQUIRE(normal.y > 0.0f);
+   }
+
+   const math::bounding_box behind_ridge =
+      make_test_box({0.0f, 16.0f, -150.0f}, {8.0f, 8.0f, 8.0f});
+   const math::bounding_box above_ridge =
+      make_test_box({0.0f, 120.0f, -50.0f}, {8.0f, 8.0f, 8.0f});
+   const math::bounding_box before_ridge =
+      make_test_box({0.0f, 16.0f, 100.0f}, {8.0f, 8.0f, 8.0f});
+
+   occlusion_buffer buffer;
+
+   buffer.clear(camera.view_projection_matrix());
+   add_occluder(buffer, occluder);
+   buffer.build_hierarchy();
+
+   CHECK(buffer.is_occluded(behind_ridge));
+   CHECK(not buffer.is_occluded(above_ridge));
+   CHECK(not buffer.is_occluded(before_ridge));
+
+   terrain.cuts.push_back({.bbox_min = {-32.0f, -1.0f, -64.0f},
+                           .bbox_max = {32.0f, 128.0f, 64.0f}});
+
+   buffer.clear(camera.view_projection_matrix());
+   add_occluder(buffer, make_terrain_occluder(terrain));
+   buffer.build_hierarchy();
+
+   CHECK(not buffer.is_occluded(behind_ridge));
+
+   terrain.active_flags.terrain = false;
+
+   CHECK(make_terrain_occluder(terrain).triangles.empty());
+}
+
+TEST_CASE("graphics software occlusion terrain coarse grid",
+          "[Graphics][SoftwareOcclusion]")
+{
+   world::terrain terrain = make_test_terrain();
+
+   const occluder_mesh occluder = make_terrain_occluder(terrain, 32);
+
+   CHECK(occluder.positions.size() == 33 * 33);
+   CHECK(occluder.triangles.size() == 32 * 32 * 2);
+
+   CHECK(occluder.positions.front().x == -256.0f);
+   CHECK(occluder.positions.back().x == (63 * 8.0f - 256.0f));
+   CHECK(occluder.positions.back().z == (63 * 8.0f - 256.0f + 8.0f));
+
+   CHECK(std::ranges::any_of(occluder.positions,
+                             [](const float3& position) { return position.y > 0.0f; }));
+
+   // Coarse vertices take the lowest height around them so the ridge is narrowed, never
+   // widened.
+   for (const float3& position : occluder.positions) {
+      if (position.y > 0.0f) {
+         CHECK(position.z > (28 * 8.0f - 256.0f + 8.0f));
+         CHECK(position.z < (36 * 8.0f - 256.0f + 8.0f));
+      }
+   }
+}
+
+TEST_CASE("graphics software occlusion conservative", "[Graphics][SoftwareOcclusion]")
+{
+   const camera camera = make_test_camera();
+
+   std::mt19937 random{1337};
+   std::uniform_real_distribution<float> centre_distribution{-40.0f, 40.0f};
+   std::uniform_real_distribution<float> occluder_depth_distribution{-80.0f, -20.0f};
+   std::uniform_real_distribution<float> occluder_size_distribution{2.0f, 24.0f};
+   std::uniform_real_distribution<float> box_depth_distribution{-300.0f, -30.0f};
+   std::uniform_real_distribution<float> box_size_distribution{0.5f, 8.0f};
+
+   occluder_mesh occluders;
+
+   for (uint16 i = 0; i < 64; ++i) {
+      const float3 centre{centre_distribution(random), centre_distribution(random),
+                          occluder_depth_distribution(random)};
+      const float3 u{occluder_size_distribution(random),
+                     occluder_size_distribution(random) * 0.5f,
+                     occluder_size_distribution(random) * 0.5f};
+      const float3 v{-occluder_size_distribution(random) * 0.5f,
+                     occluder_size_distribution(random),
+                     occluder_size_distribution(random) * 0.5f};
+
+      occluders.positions.push_back(centre - u - v);
+      occluders.positions.push_back(centre + u - v);
+      occluders.positions.push_back(centre + u + v);
+      occluders.positions.push_back(centre - u + v);
+
+      const uint16 base = i * 4;
+
+      occluders.triangles.push_back({base, static_cast<uint16>(base + 1),
+                                     static_cast<uint16>(base + 2)});
+      occluders.triangles.push_back({base, static_cast<uint16>(base + 2),
+                                     static_cast<uint16>(base + 3)});
+   }
+
+   occlusion_buffer buffer;
+
+   buffer.clear(camera.view_projection_matrix());
+   add_occluder(buffer, occluders, occluder_faces::both);
+   buffer.build_hierarchy();
+
+   // Every written pixel must have an occluder triangle in front of its depth along the
+   // rays through its centre and (just inside) its corners.
+   const std::span<const float> depth = buffer.depth();
+   std::size_t written_count = 0;
+
+   for (uint32 y = 0; y < occlusion_buffer::height; ++y) {
+      for (uint32 x = 0; x < occlusion_buffer::width; ++x) {
+         const float pixel_depth = depth[y * occlusion_buffer::width + x];
+
+         if (pixel_depth == 1.0f) continue;
+
+         written_count += 1;
+
+         for (const auto [offset_x, offset_y] :
+              {std::pair{0.5f, 0.5f}, std::pair{0.01f, 0.01f}, std::pair{0.99f, 0.01f},
+               std::pair{0.01f, 0.99f}, std::pair{0.99f, 0.99f}}) {
+            const float4 point_ndc{(x + offset_x) / occlusion_buffer::width * 2.0f - 1.0f,
+                                   1.0f - (y + offset_y) / occlusion_buffer::height * 2.0f,
+                                   std::min(pixel_depth + 1e-4f, 1.0f), 1.0f};
+            const float4 point_world = camera.inv_view_projection_matrix() * point_ndc;
+            const float3 point = float3{point_world.x, point_world.y, point_world.z} /
+                                 point_world.w;
+
+            const bool hidden =
+               std::ranges::any_of(occluders.triangles, [&](const auto& triangle) {
+                  return intersects(camera.position(), point,
+                                    occluders.positions[triangle[0]],
+                                    occluders.positions[triangle[1]],
+                                    occluders.positions[triangle[2]]);
+               });
+
+            REQUIRE(hidden);
+         }
+      }
+   }
+
+   CHECK(written_count > 0);
+
+   // And boxes reported as occluded must be behind the written pixels.
+   std::size_t occluded_count = 0;
+
+   for (int i = 0; i < 2048; ++i) {
+      const math::bounding_box box =
+         make_test_box({centre_distribution(random), centre_distribution(random),
+                        box_depth_distribution(random)},
+                       {box_size_distribution(random), box_size_distribution(random),
+                        box_size_distribution(random)});
+
+      if (not buffer.is_occluded(box)) continue;
+
+      occluded_count += 1;
+
+      for (const float3& corner : math::to_corners(box)) {
+         const float4 corner_clip =
+            camera.view_projection_matrix() * float4{corner, 1.0f};
+         const float corner_depth = corner_clip.z / corner_clip.w;
+         const uint32 x = static_cast<uint32>(
+            std::clamp((corner_clip.x / corner_clip.w * 0.5f + 0.5f) *
+                          occlusion_buffer::width,
+                       0.0f, occlusion_buffer::width - 1.0f));
+         const uint32 y = static_cast<uint32>(
+            std::clamp((0.5f - corner_clip.y / corner_clip.w * 0.5f) *
+                          occlusion_buffer::height,
+                       0.0f, occlusion_buffer::height - 1.0f));
+
+         REQUIRE(depth[y * occlusion_buffer::width + x] < corner_depth);
+      }
+   }
+
+   CHECK(occluded_count > 0);
+}
+
+TEST_CASE("graphics software occlusion cull_occluded", "[Graphics][SoftwareOcclusion]")
+{
+   const camera camera = make_test_camera();
+
+   world_mesh_list meshes;
+
+   meshes.push_back(make_test_box({0.0f, 0.0f, -100.0f}, {5.0f, 5.0f, 5.0f}), 0, {},
+                    gpu::pipeline_handle{}, material_pipeline_flags::none, 0, {});
+   meshes.push_back(make_test_box({0.0f, 0.0f, -25.0f}, {5.0f, 5.0f, 5.0f}), 0, {},
+                    gpu::pipeline_handle{}, material_pipeline_flags::none, 0, {});
+   meshes.push_back(make_test_box({5.0f, 5.0f, -200.0f}, {5.0f, 5.0f, 5.0f}), 0, {},
+                    gpu::pipeline_handle{}, material_pipeline_flags::none, 0, {});
+   meshes.push_back(make_test_box({60.0f, 0.0f, -100.0f}, {5.0f, 5.0f, 5.0f}), 0, {},
+                    gpu::pipeline_handle{}, material_pipeline_flags::none, 0, {});
+
+   occlusion_buffer buffer;
+
+   buffer.clear(camera.view_projection_matrix());
+   add_occluder(buffer, make_test_wall(-50.0f, 20.0f));
+   buffer.build_hierarchy();
+
+   std::vector<uint32> render_list{3, 2, 1, 0};
+
+   cull_occluded(buffer, meshes, render_list);
+
+   CHECK(render_list == std::vector<uint32>{3, 1});
+}
+
+TEST_CASE("graphics software occlusion select_occluders", "[Graphics][SoftwareOcclusion]")
+{
+   const camera camera = make_test_camera();
+   const frustum frustum{camera.inv_view_projection_matrix()};
+
+   const std::vector<math::bounding_box> bboxes = {
+      // Large but far away.
+      make_test_box({0.0f, 0.0f, -400.0f}, {40.0f, 40.0f, 40.0f}),
+      // Large and close.
+      make_test_box({0.0f, 0.0f, -40.0f}, {20.0f, 20.0f, 20.0f}),
+      // Small and far away, scores too low.
+      make_test_box({0.0f, 0.0f, -400.0f}, {1.0f, 1.0f, 1.0f}),
+      // Large and close but behind the camera.
+      make_test_box({0.0f, 0.0f, 100.0f}, {20.0f, 20.0f, 20.0f}),
+      // Large and close but not a candidate.
+      make_test_box({10.0f, 0.0f, -40.0f}, {20.0f, 20.0f, 20.0f}),
+      // Medium and close.
+      make_test_box({0.0f, 0.0f, -60.0f}, {10.0f, 10.0f, 10.0f}),
+   };
+
+   std::vector<uint32> occluders;
+
+   select_occluders(frustum, camera.position(), bboxes, 0.05f, 8,
+                    [](const uint32 i) { return i != 4; }, occluders);
+
+   CHECK(occluders == std::vector<uint32>{1, 5, 0});
+
+   select_occluders(frustum, camera.position(), bboxes, 0.05f, 2,
+                    [](const uint32 i) { return i != 4; }, occluders);
+
+   CHECK(occluders == std::vector<uint32>{1, 5});
+}
+
+TEST_CASE("graphics software occlusion benchmark",
+          "[Graphics][SoftwareOcclusion][!benchmark]")
+{
+   camera camera = make_test_camera();
+
+   camera.position({0.0f, 16.0f, 200.0f});
+
+   const world::terrain terrain = make_test_terrain();
+   const occluder_mesh terrain_occluder = make_terrain_occluder(terrain);
+
+   std::mt19937 random{1337};
+   std::uniform_real_distribution<float> position_distribution{-256.0f, 256.0f};
+   std::uniform_real_distribution<float> size_distribution{0.5f, 8.0f};
+
+   std::vector<occluder_mesh> walls;
+   std::vector<float4x4> wall_matrices;
+
+   for (int i = 0; i < 32; ++i) {
+      walls.push_back(make_test_wall(0.0f, size_distribution(random) * 4.0f));
+
+      float4x4& world_matrix = wall_matrices.emplace_back();
+
+      world_matrix[3] = {position_distribution(random), 16.0f,
+                         position_distribution(random), 1.0f};
+   }
+
+   world_mesh_list meshes;
+   std::vector<uint32> all_meshes;
+
+   for (uint32 i = 0; i < 100'000; ++i) {
+      const float3 position{position_distribution(random),
+                            position_distribution(random) * 0.125f,
+                            position_distribution(random)};
+      const float3 half_size{size_distribution(random), size_distribution(random),
+                             size_distribution(random)};
+
+      meshes.push_back({.min = position - half_size, .max = position + half_size}, 0,
+                       position, gpu::pipeline_handle{}, material_pipeline_flags::none,
+                       0, {});
+      all_meshes.push_back(i);
+   }
+
+   occlusion_buffer buffer;
+   std::vector<uint32> render_list;
+
+   BENCHMARK("rasterize terrain and 32 walls")
+   {
+      buffer.clear(camera.view_projection_matrix());
+      add_occluder(buffer, terrain_occluder);
+
+      for (std::size_t i = 0; i < walls.size(); ++i) {
+         buffer.add_occluder(wall_matrices[i], walls[i].positions, walls[i].triangles,
+                             occluder_faces::both);
+      }
+
+      buffer.build_hierarchy();
+
+      return buffer.depth()[0];
+   };
+
+   BENCHMARK("test 100k meshes")
+   {
+      render_list = all_meshes;
+
+      cull_occluded(buffer, meshes, render_list);
+
+      return render_list.size();
+   };
+}
+
+}
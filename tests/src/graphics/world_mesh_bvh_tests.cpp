@@ -0,0 +1,261 @@
+#include "pch.h"
+
+#include "graphics/camera.hpp"
+#include "graphics/cull_objects.hpp"
+#include "graphics/world_mesh_bvh.hpp"
+#include "math/vector_funcs.hpp"
+
+#include <algorithm>
+#include <random>
+
+namespace we::graphics::tests {
+
+namespace {
+
+auto make_test_mesh_list(const std::size_t mesh_count, const uint32 seed) -> world_mesh_list
+{
+   std::mt19937 random{seed};
+   std::uniform_real_distribution<float> position_distribution{-512.0f, 512.0f};
+   std::uniform_real_distribution<float> size_distribution{0.5f, 16.0f};
+
+   world_mesh_list list;
+
+   list.reserve(mesh_count);
+
+   for (std::size_t i = 0; i < mesh_count; ++i) {
+      const float3 position{position_distribution(random),
+                            position_distribution(random) * 0.125f,
+                            position_distribution(random)};
+      const float3 half_size{size_distribution(random), size_distribution(random),
+                             size_distribution(random)};
+
+      list.push_back({.min = position - half_size, .max = position + half_size}, 0,
+                     position, gpu::pipeline_handle{},
+                     i % 8 == 0 ? material_pipeline_flags::transparent
+                                : material_pipeline_flags::none,
+                     0, {});
+   }
+
+   return list;
+}
+
+auto make_test_frustums() -> std::vector<frustum>
+{
+   std::vector<frustum> frustums;
+
+   camera camera;
+
+   camera.far_clip(768.0f);
+
+   for (const float yaw : {0.0f, 1.0f, 2.5f, 4.0f}) {
+      camera.position({yaw * 32.0f, 16.0f, -yaw * 16.0f});
+      camera.yaw(yaw);
+
+      frustums.emplace_back(camera.inv_view_projection_matrix());
+   }
+
+   return frustums;
+}
+
+auto sorted(std::vector<uint32> list) -> std::vector<uint32>
+{
+   std::ranges::sort(list);
+
+   return list;
+}
+
+void check_matches_flat_cull(const world_mesh_bvh& bvh, const world_mesh_list& list)
+{
+   std::vector<uint32> flat_opaque;
+   std::vector<uint32> flat_transparent;
+   std::vector<uint32> bvh_opaque;
+   std::vector<uint32> bvh_transparent;
+   std::vector<uint32> flat_shadow;
+   std::vector<uint32> bvh_shadow;
+
+   for (const frustum& frustum : make_test_frustums()) {
+      cull_objects_avx2(frustum, list.bbox.min.x, list.bbox.min.y, list.bbox.min.z,
+                        list.bbox.max.x, list.bbox.max.y, list.bbox.max.z,
+                        list.pipeline_flags, flat_opaque, flat_transparent);
+      bvh.cull(frustum, list, bvh_opaque, bvh_transparent);
+
+      CHECK(sorted(bvh_opaque) == flat_opaque);
+      CHECK(sorted(bvh_transparent) == flat_transparent);
+
+      cull_objects_shadow_cascade_avx2(frustum, list.bbox.min.x, list.bbox.min.y,
+                                       list.bbox.min.z, list.bbox.max.x,
+                                       list.bbox.max.y, list.bbox.max.z,
+                                       list.pipeline_flags, flat_shadow);
+      bvh.cull_shadow_cascade(frustum, list, bvh_shadow);
+
+      CHECK(sorted(bvh_shadow) == flat_shadow);
+   }
+}
+
+}
+
+TEST_CASE("world_mesh_bvh cull", "[Graphics][WorldMeshBVH]")
+{
+   const world_mesh_list list = make_test_mesh_list(10000, 1);
+
+   world_mesh_bvh bvh;
+
+   bvh.update(list);
+
+   REQUIRE(bvh.size() == list.size());
+
+   std::vector<uint32> opaque_list;
+   std::vector<uint32> transparent_list;
+
+   bvh.cull(make_test_frustums()[0], list, opaque_list, transparent_list);
+
+   CHECK(not opaque_list.empty());
+   CHECK(opaque_list.size() < list.size());
+
+   check_matches_flat_cull(bvh, list);
+}
+
+TEST_CASE("world_mesh_bvh refit", "[Graphics][WorldMeshBVH]")
+{
+   const world_mesh_list list = make_test_mesh_list(10000, 1);
+
+   world_mesh_bvh bvh;
+
+   bvh.update(list);
+
+   // Same size, different bounds. The tree is refit instead of rebuilt.
+   const world_mesh_list moved_list = make_test_mesh_list(10000, 2);
+
+   bvh.update(moved_list);
+
+   check_matches_flat_cull(bvh, moved_list);
+}
+
+TEST_CASE("world_mesh_bvh meshes added after update", "[Graphics][WorldMeshBVH]")
+{
+   world_mesh_list list = make_test_mesh_list(10000, 1);
+
+   world_mesh_bvh bvh;
+
+   bvh.update(list);
+
+   // Meshes pushed on after the update aren't in the tree but are still culled.
+   const world_mesh_list added_list = make_test_mesh_list(64, 2);
+
+   for (std::size_t i = 0; i < added_list.size(); ++i) {
+      list.push_back({.min = {added_list.bbox.min.x[i], added_list.bbox.min.y[i],
+                              added_list.bbox.min.z[i]},
+                      .max = {added_list.bbox.max.x[i], added_list.bbox.max.y[i],
+                              added_list.bbox.max.z[i]}},
+                     0, added_list.position[i], gpu::pipeline_handle{},
+                     added_list.pipeline_flags[i], 0, {});
+   }
+
+   CHECK(bvh.size() == 10000);
+
+   check_matches_flat_cull(bvh, list);
+}
+
+TEST_CASE("world_mesh_bvh rebuild", "[Graphics][WorldMeshBVH]")
+{
+   world_mesh_bvh bvh;
+
+   bvh.update(make_test_mesh_list(10000, 1));
+
+   const world_mesh_list list = make_test_mesh_list(3, 2);
+
+   bvh.update(list);
+
+   CHECK(bvh.size() == 3);
+
+   check_matches_flat_cull(bvh, list);
+
+   const world_mesh_list empty_list;
+
+   bvh.update(empty_list);
+
+   std::vector<uint32> opaque_list{1, 2, 3};
+   std::vector<uint32> transparent_list{1, 2, 3};
+
+   bvh.cull(make_test_frustums()[0], empty_list, opaque_list, transparent_list);
+
+   CHECK(bvh.size() == 0);
+   CHECK(opaque_list.empty());
+   CHECK(transparent_list.empty());
+}
+
+TEST_CASE("world_mesh_bvh benchmark", "[Graphics][WorldMeshBVH][!benchmark]")
+{
+   const world_mesh_list list = make_test_mesh_list(100'000, 1);
+   const std::vector<frustum> frustums = make_test_frustums();
+
+   world_mesh_bvh bvh;
+
+   bvh.update(list);
+
+   std::vector<uint32> opaque_list;
+   std::vector<uint32> transparent_list;
+   std::vector<uint32> shadow_list;
+
+   // One view frustum and four shadow cascades, like a frame.
+   BENCHMARK("flat cull of 100k meshes")
+   {
+      cull_objects_avx2(frustums[0], list.bbox.min.x, list.bbox.min.y, list.bbox.min.z,
+                        list.bbox.max.x, list.bbox.max.y, list.bbox.max.z,
+                        list.pipeline_flags, opaque_list, transparent_list);
+
+      std::size_t shadow_count = 0;
+
+      for (const frustum& frustum : frustums) {
+         cull_objects_shadow_cascade_avx2(frustum, list.bbox.min.x, list.bbox.min.y,
+                                          list.bbox.min.z, list.bbox.max.x,
+                                          list.bbox.max.y, list.bbox.max.z,
+                                          list.pipeline_flags, shadow_list);
+
+         shadow_count += shadow_list.size();
+      }
+
+      return opaque_list.size() + transparent_list.size() + shadow_count;
+   };
+
+   BENCHMARK("BVH cull of 100k meshes")
+   {
+      bvh.cull(frustums[0], list, opaque_list, transparent_list);
+
+      std::size_t shadow_count = 0;
+
+      for (const frustum& frustum : frustums) {
+         bvh.cull_shadow_cascade(frustum, list, shadow_list);
+
+         shadow_count += shadow_list.size();
+      }
+
+      return opaque_list.size() + transparent_list.size() + shadow_count;
+   };
+
+   BENCHMARK("BVH refit and cull of 100k meshes")
+   {
+      bvh.update(list);
+      bvh.cull(frustums[0], list, opaque_list, transparent_list);
+
+      std::size_t shadow_count = 0;
+
+      for (const frustum& frustum : frustums) {
+         bvh.cull_shadow_cascade(frustum, list, shadow_list);
+
+         shadow_count += shadow_list.size();
+      }
+
+      return opaque_list.size() + transparent_list.size() + shadow_count;
+   };
+
+   BENCHMARK("BVH build of 100k meshes")
+   {
+      bvh.clear();
+      bvh.update(list);
+
+      return bvh.size();
+   };
+}
+
+}
@@ -0,0 +1,489 @@
+#include "pch.h"
+
+#include "async/thread_pool.hpp"
+#include "graphics/camera.hpp"
+#include "graphics/world_mesh_bvh.hpp"
+#include "graphics/world_mesh_list_builder.hpp"
+#include "math/vector_funcs.hpp"
+#include "world/object_bbox_cache.hpp"
+#include "world/object_store.hpp"
+#include "world/world.hpp"
+
+#include <algorithm>
+
+using namespace std::literals;
+
+namespace we::graphics::tests {
+
+namespace {
+
+// Stand ins for the parts of graphics::model and gpu::device the world mesh list uses,
+// so it can be built without a GPU.
+
+struct stub_material {
+   material_pipeline_flags flags = material_pipeline_flags::none;
+   gpu_virtual_address constant_buffer_view = 0;
+};
+
+struct stub_mesh_part {
+   uint32 index_count = 0;
+   uint32 start_index = 0;
+   uint32 start_vertex = 0;
+   stub_material material;
+};
+
+struct stub_gpu_buffer {
+   gpu::index_buffer_view index_buffer_view;
+   gpu::vertex_buffer_view position_vertex_buffer_view;
+   gpu::vertex_buffer_view attributes_vertex_buffer_view;
+};
+
+struct stub_model {
+   math::bounding_box bbox = {.min = {-1.0f, -1.0f, -1.0f}, .max = {1.0f, 1.0f, 1.0f}};
+   stub_gpu_buffer gpu_buffer;
+   std::vector<stub_mesh_part> parts;
+};
+
+struct stub_device {
+   constexpr static gpu_virtual_address constants_gpu_address = 0x10000;
+
+   explicit stub_device(const std::size_t max_objects) : constants{max_objects} {}
+
+   auto get_constants(const std::size_t index) noexcept -> world_mesh_constants_slot
+   {
+      return {.cpu = &constants[index],
+              .gpu = constants_gpu_address + index * sizeof(world_mesh_constants)};
+   }
+
+   auto get_pipeline(const material_pipeline_flags flags) const noexcept
+      -> gpu::pipeline_handle
+   {
+      return gpu::pipeline_handle{static_cast<std::uintptr_t>(flags) + 1};
+   }
+
+   std::vector<world_mesh_constants> constants;
+};
+
+auto make_test_world(const std::size_t object_count, const float3 centre,
+                     const float spacing) -> world::world
+{
+   world::world world;
+
+   world.objects.reserve(object_count);
+
+   const std::size_t row_length = 256;
+
+   for (std::size_t i = 0; i < object_count; ++i) {
+      world.objects.push_back(
+         world::object{.name = "object"s + std::to_string(i),
+                       .position = centre +
+                                   float3{(static_cast<float>(i % row_length) -
+                                           row_length / 2.0f) *
+                                             spacing,
+                                          0.0f,
+                                          (static_cast<float>(i / row_length) -
+                                           object_count / row_length / 2.0f) *
+                                             spacing},
+                       .class_name = lowercase_string{"stub"sv},
+                       .id = world.next_id.objects.aquire()});
+   }
+
+   return world;
+}
+
+auto make_benchmark_models() -> std::array<stub_model, 4>
+{
+   return {
+      stub_model{.parts = {{.index_count = 36}}},
+      stub_model{.parts = {{.index_count = 36},
+                           {.index_count = 12,
+                            .material = {.flags = material_pipeline_flags::alpha_cutout}}}},
+      stub_model{.parts = {{.index_count = 36,
+                            .material = {.flags = material_pipeline_flags::transparent}}}},
+      stub_model{.parts = {{.index_count = 36},
+                           {.index_count = 24},
+                           {.index_count = 12,
+                            .material = {.flags = material_pipeline_flags::additive}}}},
+   };
+}
+
+/// The CPU side of drawing the world's meshes in a frame, the same steps the renderer takes
+/// but with stub models and constants so it runs without a GPU.
+struct cpu_frame {
+   constexpr static std::size_t shadow_cascade_count = 4;
+
+   explicit cpu_frame(const std::size_t object_count)
+      : world{make_test_world(object_count, {}, 8.0f)}, device{object_count}
+   {
+      objects.update(world);
+   }
+
+   static auto make_view_frustum() -> frustum
+   {
+      camera camera;
+
+      camera.position({0.0f, 8.0f, 0.0f});
+
+      return frustum{camera.inv_view_projection_matrix()};
+   }
+
+   static auto make_shadow_frustum(const float yaw) -> frustum
+   {
+      camera camera;
+
+      camera.far_clip(768.0f);
+      camera.position({yaw * 32.0f, 16.0f, -yaw * 16.0f});
+      camera.yaw(yaw);
+
+      return frustum{camera.inv_view_projection_matrix()};
+   }
+
+   /// Update the mesh list and its BVH and cull the view and shadow cascades. Returns the
+   /// number of meshes drawn.
+   auto run(async::thread_pool& thread_pool) -> std::size_t
+   {
+      last_update = update_world_mesh_list(
+         list, list_state, world, objects, object_bboxes, world::active_layers{true}, 0, 0,
+         [&](const std::size_t i) noexcept -> const stub_model& {
+            return models[i % models.size()];
+         },
+         [&](const std::size_t index) noexcept { return device.get_constants(index); },
+         [&](const material_pipeline_flags flags) { return device.get_pipeline(flags); },
+         thread_pool);
+
+      if (last_update == world_mesh_list_update::rebuilt) bvh.clear();
+      if (last_update != world_mesh_list_update::none) bvh.update(list);
+
+      thread_pool.for_each_n(async::task_priority::normal, 1 + shadow_cascade_count,
+                             [&](const std::size_t i) noexcept {
+                                if (i == 0) {
+                                   build_world_mesh_render_lists(view_frustum, list, bvh,
+                                                                 sort_buffers, opaque_list,
+                                                                 transparent_list);
+                                }
+                                else {
+                                   bvh.cull_shadow_cascade(shadow_frustums[i - 1], list,
+                                                           shadow_lists[i - 1]);
+                                }
+                             });
+
+      std::size_t draw_count = opaque_list.size() + transparent_list.size();
+
+      for (const std::vector<uint32>& shadow_list : shadow_lists) {
+         draw_count += shadow_list.size();
+      }
+
+      return draw_count;
+   }
+
+   world::world world;
+   world::object_store objects;
+   const world::object_bbox_cache object_bboxes;
+   const std::array<stub_model, 4> models = make_benchmark_models();
+   stub_device device;
+
+   const frustum view_frustum = make_view_frustum();
+   const std::array<frustum, shadow_cascade_count> shadow_frustums = {
+      make_shadow_frustum(0.0f), make_shadow_frustum(1.0f), make_shadow_frustum(2.5f),
+      make_shadow_frustum(4.0f)};
+
+   world_mesh_list list;
+   world_mesh_list_state list_state;
+   world_mesh_list_update last_update = world_mesh_list_update::none;
+   world_mesh_bvh bvh;
+   world_mesh_sort_buffers sort_buffers;
+   std::vector<uint32> opaque_list;
+   std::vector<uint32> transparent_list;
+   std::array<std::vector<uint32>, shadow_cascade_count> shadow_lists;
+};
+
+}
+
+TEST_CASE("world_mesh_list_builder more than 65535 meshes", "[Graphics][WorldMeshList]")
+{
+   camera camera;
+
+   camera.position({0.0f, 0.0f, 0.0f});
+
+   const std::size_t object_count = 70000;
+
+   // Every object sits in front of the camera so every mesh is drawn.
+   const world::world world = make_test_world(object_count, camera.forward() * 16.0f, 0.0f);
+
+   world::object_store objects;
+
+   objects.update(world);
+
+   const world::object_bbox_cache object_bboxes;
+   const stub_model model{.parts = {{.index_count = 36}}};
+   stub_device device{object_count};
+   const auto thread_pool = async::thread_pool::make();
+
+   world_mesh_list list;
+   std::vector<uint32> object_meshes;
+
+   add_world_mesh_list_objects(
+      list, objects, object_bboxes, world::active_layers{true},
+      [&](const std::size_t) noexcept -> const stub_model& { return model; },
+      [&](const std::size_t index) noexcept { return device.get_constants(index); },
+      [&](const material_pipeline_flags flags) { return device.get_pipeline(flags); },
+      *thread_pool, object_meshes);
+
+   REQUIRE(list.size() == object_count);
+
+   // Chunks are filled in parallel but the meshes must still be in object order.
+   for (std::size_t i = 0; i < object_count; ++i) {
+      REQUIRE(list.position[i] == world.objects[i].position);
+   }
+
+   CHECK(list.gpu_constants[object_count - 1] ==
+         stub_device::constants_gpu_address +
+            (object_count - 1) * sizeof(world_mesh_constants));
+   CHECK(device.constants[object_count - 1].object_to_world[3] ==
+         float4{world.objects[object_count - 1].position, 1.0f});
+
+   world_mesh_sort_buffers sort_buffers;
+   std::vector<uint32> opaque_list;
+   std::vector<uint32> transparent_list;
+
+   build_world_mesh_render_lists(frustum{camera.inv_view_projection_matrix()}, list,
+                                 sort_buffers, opaque_list, transparent_list);
+
+   REQUIRE(opaque_list.size() == object_count);
+   CHECK(transparent_list.empty());
+   CHECK(std::ranges::max(opaque_list) == object_count - 1);
+}
+
+TEST_CASE("world_mesh_list_builder inactive layers", "[Graphics][WorldMeshList]")
+{
+   world::world world = make_test_world(8, {}, 4.0f);
+
+   for (std::size_t i = 0; i < world.objects.size(); ++i) {
+      world.objects[i].layer = static_cast<int>(i % 2);
+   }
+
+   world::object_store objects;
+
+   objects.update(world);
+
+   world::active_layers active_layers;
+
+   active_layers.set(1);
+
+   const world::object_bbox_cache object_bboxes;
+   const stub_model model{.parts = {{.index_count = 36}, {.index_count = 12}}};
+   stub_device device{world.objects.size()};
+   const auto thread_pool = async::thread_pool::make();
+
+   world_mesh_list list;
+   std::vector<uint32> object_meshes;
+
+   add_world_mesh_list_objects(
+      list, objects, object_bboxes, active_layers,
+      [&](const std::size_t) noexcept -> const stub_model& { return model; },
+      [&](const std::size_t index) noexcept { return device.get_constants(index); },
+      [&](const material_pipeline_flags flags) { return device.get_pipeline(flags); },
+      *thread_pool, object_meshes);
+
+   REQUIRE(list.size() == 8);
+
+   for (std::size_t i = 0; i < list.size(); ++i) {
+      const std::size_t object_index = (i / 2) * 2 + 1;
+
+      CHECK(list.position[i] == world.objects[object_index].position);
+      CHECK(list.gpu_constants[i] ==
+            stub_device::constants_gpu_address +
+               object_index * sizeof(world_mesh_constants));
+   }
+
+   CHECK(object_meshes == std::vector<uint32>{0, 0, 2, 2, 4, 4, 6, 6, 8});
+}
+
+TEST_CASE("world_mesh_list_builder draw order", "[Graphics][WorldMeshList]")
+{
+   camera camera;
+
+   camera.position({0.0f, 0.0f, 0.0f});
+
+   const frustum view_frustum{camera.inv_view_projection_matrix()};
+
+   world_mesh_list list;
+
+   const auto add_mesh = [&](const float distance, const material_pipeline_flags flags,
+                             const gpu_virtual_address material) {
+      const float3 position = camera.forward() * distance;
+
+      list.push_back({.min = position - float3{1.0f, 1.0f, 1.0f},
+                      .max = position + float3{1.0f, 1.0f, 1.0f}},
+                     0, position, gpu::pipeline_handle{}, flags, material, {});
+   };
+
+   add_mesh(32.0f, material_pipeline_flags::alpha_cutout, 0x200);
+   add_mesh(8.0f, material_pipeline_flags::none, 0x300);
+   add_mesh(16.0f, material_pipeline_flags::transparent, 0x100);
+   add_mesh(16.0f, material_pipeline_flags::none, 0x100);
+   add_mesh(4.0f, material_pipeline_flags::alpha_cutout, 0x200);
+   add_mesh(64.0f, material_pipeline_flags::transparent, 0x100);
+   add_mesh(32.0f, material_pipeline_flags::none, 0x100);
+   add_mesh(32.0f, material_pipeline_flags::additive, 0x100);
+
+   world_mesh_sort_buffers sort_buffers;
+   std::vector<uint32> opaque_list;
+   std::vector<uint32> transparent_list;
+
+   build_world_mesh_render_lists(view_frustum, list, sort_buffers, opaque_list,
+                                 transparent_list);
+
+   // Opaque meshes are grouped by pipeline and then material, front to back within each.
+   CHECK(opaque_list == std::vector<uint32>{3, 6, 1, 4, 0});
+   // Transparent meshes are back to front.
+   CHECK(transparent_list == std::vector<uint32>{5, 7, 2});
+}
+
+TEST_CASE("world_mesh_list_builder update in place", "[Graphics][WorldMeshList]")
+{
+   const auto thread_pool = async::thread_pool::make();
+
+   cpu_frame frame{2000};
+
+   frame.run(*thread_pool);
+
+   CHECK(frame.last_update == world_mesh_list_update::rebuilt);
+
+   frame.run(*thread_pool);
+
+   CHECK(frame.last_update == world_mesh_list_update::none);
+
+   // Moving objects rewrites only them.
+   for (const std::size_t i : {std::size_t{1500}, std::size_t{5}}) {
+      frame.world.objects[i].position += float3{0.0f, 4.0f, 0.0f};
+      frame.world.changes.objects.record(frame.world.objects[i].id,
+                                        world::change_type::modify);
+   }
+
+   frame.objects.update(frame.world);
+   frame.run(*thread_pool);
+
+   REQUIRE(frame.last_update == world_mesh_list_update::modified);
+   CHECK(frame.list_state.dirty_objects == std::vector<uint32>{5, 1500});
+   CHECK(frame.list.position[frame.list_state.object_meshes[5]] ==
+         frame.world.objects[5].position);
+   CHECK(frame.device.constants[5].object_to_world[3] ==
+         float4{frame.world.objects[5].position, 1.0f});
+
+   const world_mesh_list modified_list = frame.list;
+
+   frame.list_state.clear();
+   frame.run(*thread_pool);
+
+   CHECK(frame.last_update == world_mesh_list_update::rebuilt);
+   CHECK(frame.list.position == modified_list.position);
+   CHECK(frame.list.bbox.min.y == modified_list.bbox.min.y);
+   CHECK(frame.list.gpu_constants == modified_list.gpu_constants);
+
+   // Meshes pushed on after an update are dropped by the next one.
+   frame.list.push_back({}, 0, {}, gpu::pipeline_handle{}, material_pipeline_flags::none,
+                        0, {});
+   frame.run(*thread_pool);
+
+   CHECK(frame.last_update == world_mesh_list_update::none);
+   CHECK(frame.list.size() == frame.list_state.object_meshes.back());
+
+   // Inserting an object rebuilds the list.
+   frame.world.objects.push_back(
+      world::object{.name = "inserted",
+                    .class_name = lowercase_string{"stub"sv},
+                    .id = frame.world.next_id.objects.aquire()});
+   frame.world.changes.objects.record(frame.world.objects.back().id,
+                                     world::change_type::insert);
+   frame.objects.update(frame.world);
+   frame.device.constants.resize(frame.world.objects.size());
+   frame.run(*thread_pool);
+
+   CHECK(frame.last_update == world_mesh_list_update::rebuilt);
+   CHECK(frame.list_state.object_meshes.size() == frame.world.objects.size() + 1);
+}
+
+TEST_CASE("world_mesh_list_builder threads match serial", "[Graphics][WorldMeshList]")
+{
+   cpu_frame serial_frame{10'000};
+   cpu_frame threaded_frame{10'000};
+
+   const auto serial_thread_pool =
+      async::thread_pool::make({.thread_count = 1, .low_priority_thread_count = 1});
+   const auto thread_pool = async::thread_pool::make();
+
+   CHECK(serial_frame.run(*serial_thread_pool) == threaded_frame.run(*thread_pool));
+
+   CHECK(serial_frame.list.position == threaded_frame.list.position);
+   CHECK(serial_frame.list.gpu_constants == threaded_frame.list.gpu_constants);
+   CHECK(serial_frame.opaque_list == threaded_frame.opaque_list);
+   CHECK(serial_frame.transparent_list == threaded_frame.transparent_list);
+   CHECK(serial_frame.shadow_lists == threaded_frame.shadow_lists);
+}
+
+TEST_CASE("world_mesh_list_builder benchmark", "[Graphics][WorldMeshList][!benchmark]")
+{
+   cpu_frame frame{100'000};
+
+   const auto serial_thread_pool =
+      async::thread_pool::make({.thread_count = 1, .low_priority_thread_count = 1});
+   const auto thread_pool = async::thread_pool::make();
+
+   BENCHMARK("cpu frame of 100k objects, rebuilt, one worker thread")
+   {
+      frame.list_state.clear();
+
+      return frame.run(*serial_thread_pool);
+   };
+
+   BENCHMARK("cpu frame of 100k objects, rebuilt, all threads")
+   {
+      frame.list_state.clear();
+
+      return frame.run(*thread_pool);
+   };
+
+   BENCHMARK("cpu frame of 100k objects, one object moved")
+   {
+      frame.world.objects[0].position.y += 1.0f;
+      frame.world.changes.objects.record(frame.world.objects[0].id,
+                                        world::change_type::modify);
+      frame.objects.update(frame.world);
+
+      return frame.run(*thread_pool);
+   };
+
+   BENCHMARK("cpu frame of 100k objects, static")
+   {
+      return frame.run(*thread_pool);
+   };
+
+   BENCHMARK("build world mesh list of 100k objects")
+   {
+      frame.list.clear();
+
+      add_world_mesh_list_objects(
+         frame.list, frame.objects, frame.object_bboxes, world::active_layers{true},
+         [&](const std::size_t i) noexcept -> const stub_model& {
+            return frame.models[i % frame.models.size()];
+         },
+         [&](const std::size_t index) noexcept { return frame.device.get_constants(index); },
+         [&](const material_pipeline_flags flags) {
+            return frame.device.get_pipeline(flags);
+         },
+         *thread_pool, frame.list_state.object_meshes);
+
+      return frame.list.size();
+   };
+
+   BENCHMARK("build render lists of 100k objects")
+   {
+      build_world_mesh_render_lists(frame.view_frustum, frame.list, frame.sort_buffers,
+                                    frame.opaque_list, frame.transparent_list);
+
+      return frame.opaque_list.size() + frame.transparent_list.size();
+   };
+}
+
+}
@@ -0,0 +1,59 @@
+#include "pch.h"
+
+#include "utility/name_table.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+
+namespace we::tests {
+
+TEST_CASE("name_table intern", "[Utility][NameTable]")
+{
+   const name_handle handle = intern_name(lowercase_string{"com_bldg_controlzone"sv});
+
+   CHECK(intern_name(lowercase_string{"COM_BLDG_CONTROLZONE"sv}) == handle);
+   CHECK(intern_name(lowercase_string{"com_item_healthrecharge"sv}) != handle);
+   CHECK(get_name(handle) == "com_bldg_controlzone"sv);
+   CHECK(static_cast<std::size_t>(handle) < name_table_size());
+}
+
+TEST_CASE("name_table names stay valid", "[Utility][NameTable]")
+{
+   const name_handle handle = intern_name(lowercase_string{"name_table_test_name"sv});
+   const lowercase_string& name = get_name(handle);
+
+   for (int i = 0; i < 1024; ++i) {
+      (void)intern_name(lowercase_string{"name_table_test_name_"s + std::to_string(i)});
+   }
+
+   CHECK(&get_name(handle) == &name);
+   CHECK(name == "name_table_test_name"sv);
+}
+
+TEST_CASE("name_table threaded intern", "[Utility][NameTable]")
+{
+   std::vector<std::vector<name_handle>> thread_handles{4};
+
+   {
+      std::vector<std::jthread> threads;
+
+      for (auto& handles : thread_handles) {
+         threads.emplace_back([&handles] {
+            for (int i = 0; i < 256; ++i) {
+               handles.push_back(intern_name(
+                  lowercase_string{"name_table_thread_name_"s + std::to_string(i)}));
+            }
+         });
+      }
+   }
+
+   for (const auto& handles : thread_handles) CHECK(handles == thread_handles[0]);
+
+   for (int i = 0; i < 256; ++i) {
+      CHECK(get_name(thread_handles[0][i]) == "name_table_thread_name_"s + std::to_string(i));
+   }
+}
+
+}
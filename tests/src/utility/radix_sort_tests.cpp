@@ -0,0 +1,80 @@
+#include "pch.h"
+
+#include "utility/radix_sort.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace we::utility::tests {
+
+TEST_CASE("radix_sort", "[Utility][RadixSort]")
+{
+   std::vector<uint64> keys{0x0300'0000'0000'0002ull, 5, 0xffff'ffff'ffff'ffffull, 5, 0,
+                            0x0300'0000'0000'0001ull, 17};
+   std::vector<uint32> values{0, 1, 2, 3, 4, 5, 6};
+
+   std::vector<uint64> scratch_keys;
+   std::vector<uint32> scratch_values;
+
+   radix_sort(keys, values, scratch_keys, scratch_values);
+
+   CHECK(keys == std::vector<uint64>{0, 5, 5, 17, 0x0300'0000'0000'0001ull,
+                                     0x0300'0000'0000'0002ull, 0xffff'ffff'ffff'ffffull});
+   // The sort is stable, equal keys keep their order.
+   CHECK(values == std::vector<uint32>{4, 1, 3, 6, 5, 0, 2});
+}
+
+TEST_CASE("radix_sort matches stable_sort", "[Utility][RadixSort]")
+{
+   std::mt19937_64 random{1};
+
+   std::vector<std::pair<uint64, uint32>> pairs;
+
+   for (uint32 i = 0; i < 10000; ++i) {
+      // Keep some digits the same across every key so those passes are skipped.
+      pairs.emplace_back(random() & 0x00ff'f000'00ff'ff00ull, i);
+   }
+
+   std::vector<uint64> keys;
+   std::vector<uint32> values;
+
+   for (const auto& [key, value] : pairs) {
+      keys.push_back(key);
+      values.push_back(value);
+   }
+
+   std::vector<uint64> scratch_keys;
+   std::vector<uint32> scratch_values;
+
+   radix_sort(keys, values, scratch_keys, scratch_values);
+
+   std::ranges::stable_sort(pairs, {}, &std::pair<uint64, uint32>::first);
+
+   for (std::size_t i = 0; i < pairs.size(); ++i) {
+      REQUIRE(keys[i] == pairs[i].first);
+      REQUIRE(values[i] == pairs[i].second);
+   }
+}
+
+TEST_CASE("radix_sort small", "[Utility][RadixSort]")
+{
+   std::vector<uint64> scratch_keys;
+   std::vector<uint32> scratch_values;
+
+   std::vector<uint64> keys;
+   std::vector<uint32> values;
+
+   radix_sort(keys, values, scratch_keys, scratch_values);
+
+   CHECK(keys.empty());
+
+   keys = {1, 1, 1};
+   values = {0, 1, 2};
+
+   radix_sort(keys, values, scratch_keys, scratch_values);
+
+   CHECK(values == std::vector<uint32>{0, 1, 2});
+}
+
+}
@@ -0,0 +1,116 @@
+#include "pch.h"
+
+#include "world/change_log.hpp"
+
+namespace we::world::tests {
+
+namespace {
+
+using test_log = change_log<int>;
+
+}
+
+TEST_CASE("world change_log changes_since", "[World][ChangeLog]")
+{
+   test_log log;
+
+   const test_log::cursor start = log.current();
+
+   log.record(id<int>{1}, change_type::insert);
+   log.record(id<int>{2}, change_type::modify);
+
+   const test_log::cursor middle = log.current();
+
+   log.record(id<int>{1}, change_type::remove);
+
+   auto changes = log.changes_since(start);
+
+   REQUIRE(changes);
+   REQUIRE(changes->size() == 3);
+   CHECK((*changes)[0].id == id<int>{1});
+   CHECK((*changes)[0].type == change_type::insert);
+   CHECK((*changes)[1].id == id<int>{2});
+   CHECK((*changes)[1].type == change_type::modify);
+   CHECK((*changes)[2].id == id<int>{1});
+   CHECK((*changes)[2].type == change_type::remove);
+
+   changes = log.changes_since(middle);
+
+   REQUIRE(changes);
+   REQUIRE(changes->size() == 1);
+   CHECK((*changes)[0].type == change_type::remove);
+
+   changes = log.changes_since(log.current());
+
+   REQUIRE(changes);
+   CHECK(changes->empty());
+}
+
+TEST_CASE("world change_log index", "[World][ChangeLog]")
+{
+   test_log log;
+
+   const test_log::cursor start = log.current();
+
+   log.record(id<int>{1}, change_type::insert, 4);
+   log.record(id<int>{2}, change_type::remove, 2);
+
+   const auto changes = log.changes_since(start);
+
+   REQUIRE(changes);
+   REQUIRE(changes->size() == 2);
+   CHECK((*changes)[0].index == 4);
+   CHECK((*changes)[1].index == 2);
+}
+
+TEST_CASE("world change_log reset", "[World][ChangeLog]")
+{
+   test_log log;
+
+   const test_log::cursor start = log.current();
+
+   log.record(id<int>{1}, change_type::insert);
+   log.reset();
+
+   CHECK(not log.changes_since(start));
+   CHECK(log.changes_since(log.current()));
+}
+
+TEST_CASE("world change_log overflow", "[World][ChangeLog]")
+{
+   test_log log;
+
+   const test_log::cursor start = log.current();
+
+   for (std::size_t i = 0; i < test_log::max_changes; ++i) {
+      log.record(id<int>{static_cast<uint32>(i)}, change_type::modify);
+   }
+
+   const test_log::cursor full = log.current();
+
+   log.record(id<int>{0}, change_type::remove);
+
+   CHECK(not log.changes_since(start));
+
+   auto changes = log.changes_since(full);
+
+   REQUIRE(changes);
+   REQUIRE(changes->size() == 1);
+   CHECK((*changes)[0].type == change_type::remove);
+}
+
+TEST_CASE("world change_log copy", "[World][ChangeLog]")
+{
+   test_log log;
+
+   log.record(id<int>{1}, change_type::insert);
+
+   const test_log::cursor cursor = log.current();
+
+   test_log copy = log;
+
+   CHECK(log.changes_since(cursor));
+   CHECK(not copy.changes_since(cursor));
+}
+
+}
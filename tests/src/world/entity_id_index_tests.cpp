@@ -0,0 +1,103 @@
+#include "pch.h"
+
+#include "world/entity_id_index.hpp"
+#include "world/object.hpp"
+
+#include <vector>
+
+namespace we::world::tests {
+
+TEST_CASE("entity_id_index find", "[World][IdIndex]")
+{
+   std::vector<object> objects{{.id = object_id{4}},
+                               {.id = object_id{1}},
+                               {.id = object_id{7}}};
+
+   entity_id_index<object> index;
+
+   index.update(objects);
+
+   REQUIRE(index.size() == 3);
+   CHECK(index.find(objects, object_id{4}) == 0);
+   CHECK(index.find(objects, object_id{1}) == 1);
+   CHECK(index.find(objects, object_id{7}) == 2);
+   CHECK(not index.find(objects, object_id{0}));
+   CHECK(not index.find(objects, object_id{64}));
+}
+
+TEST_CASE("entity_id_index update after erase", "[World][IdIndex]")
+{
+   std::vector<object> objects{{.id = object_id{0}},
+                               {.id = object_id{1}},
+                               {.id = object_id{2}}};
+
+   entity_id_index<object> index;
+
+   index.update(objects);
+
+   objects.erase(objects.begin());
+
+   index.erase(object_id{0});
+   index.update(objects, 0);
+
+   CHECK(index.size() == 2);
+   CHECK(not index.find(objects, object_id{0}));
+   CHECK(index.find(objects, object_id{1}) == 0);
+   CHECK(index.find(objects, object_id{2}) == 1);
+
+   objects.insert(objects.begin(), object{.id = object_id{0}});
+
+   index.update(objects, 0);
+
+   CHECK(index.size() == 3);
+   CHECK(index.find(objects, object_id{0}) == 0);
+   CHECK(index.find(objects, object_id{1}) == 1);
+   CHECK(index.find(objects, object_id{2}) == 2);
+}
+
+TEST_CASE("entity_id_index incomplete", "[World][IdIndex]")
+{
+   std::vector<object> objects{{.id = object_id{2}}, {.id = object_id{0}}};
+
+   entity_id_index<object> index;
+
+   CHECK(index.find(objects, object_id{0}) == 1);
+   CHECK(index.find(objects, object_id{2}) == 0);
+   CHECK(not index.find(objects, object_id{1}));
+
+   objects.push_back({.id = object_id{1}});
+
+   index.update(objects, 2);
+
+   CHECK(index.size() == 1);
+   CHECK(index.find(objects, object_id{0}) == 1);
+   CHECK(index.find(objects, object_id{1}) == 2);
+
+   std::swap(objects[1], objects[2]);
+
+   CHECK(index.find(objects, object_id{0}) == 2);
+   CHECK(index.find(objects, object_id{1}) == 1);
+
+   index.clear();
+
+   CHECK(index.size() == 0);
+   CHECK(index.find(objects, object_id{2}) == 0);
+}
+
+TEST_CASE("entity_id_index large ids", "[World][IdIndex]")
+{
+   const object_id large_id{entity_id_index<object>::max_indexed_id};
+
+   std::vector<object> objects{{.id = object_id{0}}, {.id = large_id}};
+
+   entity_id_index<object> index;
+
+   index.update(objects);
+
+   CHECK(index.size() == 1);
+   CHECK(index.find(objects, object_id{0}) == 0);
+   CHECK(index.find(objects, large_id) == 1);
+   CHECK(not index.find(objects, max_id));
+}
+
+}
@@ -0,0 +1,112 @@
+#include "pch.h"
+
+#include "world/entity_name_index.hpp"
+#include "world/object.hpp"
+
+using namespace std::literals;
+
+namespace we::world::tests {
+
+TEST_CASE("entity_name_index find", "[World][NameIndex]")
+{
+   entity_name_index<object> index;
+
+   index.insert("Object"sv, object_id{2});
+   index.insert("Other"sv, object_id{3});
+
+   REQUIRE(index.size() == 2);
+   REQUIRE(index.find("Object"sv).size() == 1);
+   CHECK(index.find("Object"sv)[0] == object_id{2});
+   REQUIRE(index.find("Other"sv).size() == 1);
+   CHECK(index.find("Other"sv)[0] == object_id{3});
+   CHECK(index.find("Missing"sv).empty());
+   CHECK(index.contains("Object"sv));
+   CHECK(not index.contains("Missing"sv));
+   CHECK(index.contains("Object"sv, object_id{2}));
+   CHECK(not index.contains("Object"sv, object_id{3}));
+   CHECK(not index.contains("Missing"sv, object_id{2}));
+
+   index.insert("Object"sv, object_id{2});
+
+   CHECK(index.size() == 2);
+}
+
+TEST_CASE("entity_name_index duplicate names", "[World][NameIndex]")
+{
+   entity_name_index<object> index;
+
+   index.insert("Object"sv, object_id{5});
+   index.insert("Object"sv, object_id{1});
+
+   REQUIRE(index.size() == 2);
+   REQUIRE(index.find("Object"sv).size() == 2);
+   CHECK(index.find("Object"sv)[0] == object_id{1});
+   CHECK(index.find("Object"sv)[1] == object_id{5});
+
+   index.erase("Object"sv, object_id{1});
+
+   CHECK(index.size() == 1);
+   REQUIRE(index.find("Object"sv).size() == 1);
+   CHECK(index.find("Object"sv)[0] == object_id{5});
+
+   index.erase("Object"sv, object_id{5});
+
+   CHECK(index.size() == 0);
+   CHECK(not index.contains("Object"sv));
+
+   index.erase("Object"sv, object_id{5});
+
+   CHECK(index.size() == 0);
+}
+
+TEST_CASE("entity_name_index rename", "[World][NameIndex]")
+{
+   entity_name_index<object> index;
+
+   index.insert("Object"sv, object_id{0});
+   index.rename("Object"sv, "Renamed"sv, object_id{0});
+
+   CHECK(index.size() == 1);
+   CHECK(not index.contains("Object"sv));
+   REQUIRE(index.find("Renamed"sv).size() == 1);
+   CHECK(index.find("Renamed"sv)[0] == object_id{0});
+}
+
+TEST_CASE("entity_name_index free_suffix", "[World][NameIndex]")
+{
+   entity_name_index<object> index;
+
+   CHECK(index.free_suffix("Object"sv) == 0);
+
+   index.insert("Object1"sv, object_id{0});
+
+   CHECK(index.free_suffix("Object"sv) == 0);
+
+   index.insert("Object0"sv, object_id{1});
+
+   CHECK(index.free_suffix("Object"sv) == 2);
+
+   index.insert("Object02"sv, object_id{2});
+   index.insert("Object3"sv, object_id{3});
+
+   CHECK(index.free_suffix("Object"sv) == 2);
+
+   index.insert("Object2"sv, object_id{4});
+
+   CHECK(index.free_suffix("Object"sv) == 4);
+
+   index.erase("Object1"sv, object_id{0});
+
+   CHECK(index.free_suffix("Object"sv) == 1);
+
+   index.rename("Object3"sv, "Object1"sv, object_id{3});
+
+   CHECK(index.free_suffix("Object"sv) == 3);
+
+   index.clear();
+
+   CHECK(index.free_suffix("Object"sv) == 0);
+   CHECK(index.size() == 0);
+}
+
+}
@@ -39,4 +39,23 @@ TEST_CASE("world id", "[World][ID]")
    REQUIRE(id2 == make_id_for_test(2));
 }
 
+TEST_CASE("world id_generator skip_past", "[World][ID]")
+{
+   id_generator<void> next_id;
+
+   next_id.skip_past(make_id_for_test(4));
+
+   REQUIRE(next_id.aquire() == make_id_for_test(5));
+
+   // Skipping past an ID that was already handed out changes nothing.
+   next_id.skip_past(make_id_for_test(2));
+
+   REQUIRE(next_id.aquire() == make_id_for_test(6));
+
+   // The max ID is a sentinel and never skipped past.
+   next_id.skip_past(max_id);
+
+   REQUIRE(next_id.aquire() == make_id_for_test(7));
+}
+
 }
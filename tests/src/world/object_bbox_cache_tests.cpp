@@ -0,0 +1,114 @@
+#include "pch.h"
+
+#include "approx_test_helpers.hpp"
+#include "edits/delete_entity.hpp"
+#include "edits/set_value.hpp"
+#include "math/quaternion_funcs.hpp"
+#include "world/object_bbox_cache.hpp"
+#include "world/object_class.hpp"
+#include "world/object_class_library.hpp"
+#include "world/world.hpp"
+#include "world/world_test_objects.hpp"
+
+using namespace std::literals;
+
+namespace we::world::tests {
+
+namespace {
+
+auto get_bbox(const object& object, const object_class_library& object_classes)
+   -> math::bounding_box
+{
+   return object.rotation * object_classes[object.class_name].model->bounding_box +
+          object.position;
+}
+
+bool approx_equals(const math::bounding_box& l, const math::bounding_box& r)
+{
+   return we::approx_equals(l.min, r.min) and we::approx_equals(l.max, r.max);
+}
+
+}
+
+TEST_CASE("world object_bbox_cache update", "[World][ObjectBBoxCache]")
+{
+   test_object_classes classes;
+   const object_class_library& object_classes = classes.object_classes;
+
+   world world = make_test_world(16);
+   interaction_targets interaction_targets;
+   edit_context edit_context{world, interaction_targets.creation_entity};
+
+   object_bbox_cache cache;
+
+   cache.update(world, object_classes);
+
+   REQUIRE(cache.size() == world.objects.size());
+
+   for (std::size_t i = 0; i < world.objects.size(); ++i) {
+      CHECK(approx_equals(cache[i], get_bbox(world.objects[i], object_classes)));
+   }
+
+   edits::make_set_value(world.objects[3].id, &object::position,
+                         float3{64.0f, 32.0f, 16.0f}, world.objects[3].position)
+      ->apply(edit_context);
+
+   cache.update(world, object_classes);
+
+   CHECK(approx_equals(cache[3], get_bbox(world.objects[3], object_classes)));
+
+   edits::make_delete_entity(world.objects[0].id, world)->apply(edit_context);
+
+   cache.update(world, object_classes);
+
+   REQUIRE(cache.size() == world.objects.size());
+
+   for (std::size_t i = 0; i < world.objects.size(); ++i) {
+      CHECK(approx_equals(cache[i], get_bbox(world.objects[i], object_classes)));
+   }
+
+   cache.clear();
+
+   CHECK(cache.size() == 0);
+}
+
+TEST_CASE("world object_bbox_cache benchmark", "[World][ObjectBBoxCache][!benchmark]")
+{
+   test_object_classes classes;
+   const object_class_library& object_classes = classes.object_classes;
+
+   const world world = make_test_world(20'000);
+
+   object_bbox_cache cache;
+
+   cache.update(world, object_classes);
+
+   // Both benchmarks count the objects above the ground, standing in for any per-frame
+   // pass over object bounds (culling, picking, etc).
+
+   BENCHMARK("recompute bounds")
+   {
+      std::size_t count = 0;
+
+      for (const object& object : world.objects) {
+         if (get_bbox(object, object_classes).max.y > 0.0f) count += 1;
+      }
+
+      return count;
+   };
+
+   BENCHMARK("cached bounds")
+   {
+      cache.update(world, object_classes);
+
+      std::size_t count = 0;
+
+      for (const float max_y : cache.max_y()) {
+         if (max_y > 0.0f) count += 1;
+      }
+
+      return count;
+   };
+}
+
+}
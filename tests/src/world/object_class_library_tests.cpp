@@ -0,0 +1,156 @@
+#include "pch.h"
+
+#include "edits/delete_entity.hpp"
+#include "edits/set_value.hpp"
+#include "world/object_class.hpp"
+#include "world/object_class_library.hpp"
+#include "world/world.hpp"
+#include "world/world_test_objects.hpp"
+
+using namespace std::literals;
+
+namespace we::world::tests {
+
+namespace {
+
+auto class_a_or_b(const std::size_t i) -> std::string_view
+{
+   return i < 6 ? "class_a"sv : "class_b"sv;
+}
+
+}
+
+TEST_CASE("world object_class_library references", "[World][ObjectClassLibrary]")
+{
+   test_object_classes classes;
+   object_class_library& object_classes = classes.object_classes;
+
+   world world = make_test_world(8, class_a_or_b);
+   interaction_targets interaction_targets;
+   edit_context edit_context{world, interaction_targets.creation_entity};
+
+   object_classes.update(world, nullptr);
+
+   REQUIRE(classes.contains("class_a"sv));
+   REQUIRE(classes.contains("class_b"sv));
+   CHECK(object_classes[lowercase_string{"class_a"sv}].world_references == 6);
+   CHECK(object_classes[lowercase_string{"class_b"sv}].world_references == 2);
+   CHECK(&object_classes[intern_name(lowercase_string{"class_a"sv})] ==
+         &object_classes[lowercase_string{"class_a"sv}]);
+
+   const uint64 generation = object_classes.generation();
+
+   object_classes.update(world, nullptr);
+
+   CHECK(object_classes.generation() == generation);
+
+   edits::make_set_value(world.objects[0].id, &object::class_name,
+                         lowercase_string{"class_b"sv}, world.objects[0].class_name)
+      ->apply(edit_context);
+
+   object_classes.update(world, nullptr);
+
+   CHECK(object_classes[lowercase_string{"class_a"sv}].world_references == 5);
+   CHECK(object_classes[lowercase_string{"class_b"sv}].world_references == 3);
+
+   const object_id object_6_id = world.objects[6].id;
+   const object_id object_7_id = world.objects[7].id;
+
+   edits::make_delete_entity(object_6_id, world)->apply(edit_context);
+   edits::make_delete_entity(object_7_id, world)->apply(edit_context);
+
+   object_classes.update(world, nullptr);
+
+   CHECK(object_classes[lowercase_string{"class_b"sv}].world_references == 1);
+
+   edits::make_delete_entity(world.objects[0].id, world)->apply(edit_context);
+
+   object_classes.update(world, nullptr);
+
+   CHECK(not classes.contains("class_b"sv));
+   CHECK(&object_classes[intern_name(lowercase_string{"class_b"sv})] ==
+         &object_classes[lowercase_string{"object_class_library_missing"sv}]);
+}
+
+TEST_CASE("world object_class_library delete and restore", "[World][ObjectClassLibrary]")
+{
+   test_object_classes classes;
+   object_class_library& object_classes = classes.object_classes;
+
+   world world = make_test_world(8, class_a_or_b);
+   interaction_targets interaction_targets;
+   edit_context edit_context{world, interaction_targets.creation_entity};
+
+   object_classes.update(world, nullptr);
+
+   const object_class* class_b = &object_classes[lowercase_string{"class_b"sv}];
+
+   // Deleting every object using a class and restoring them before the next update
+   // keeps the class.
+   auto delete_object_7 = edits::make_delete_entity(world.objects[7].id, world);
+   delete_object_7->apply(edit_context);
+   auto delete_object_6 = edits::make_delete_entity(world.objects[6].id, world);
+   delete_object_6->apply(edit_context);
+
+   delete_object_6->revert(edit_context);
+   delete_object_7->revert(edit_context);
+
+   object_classes.update(world, nullptr);
+
+   CHECK(&object_classes[lowercase_string{"class_b"sv}] == class_b);
+   CHECK(class_b->world_references == 2);
+}
+
+TEST_CASE("world object_class_library creation object", "[World][ObjectClassLibrary]")
+{
+   test_object_classes classes;
+   object_class_library& object_classes = classes.object_classes;
+
+   const world world = make_test_world(8, class_a_or_b);
+
+   object creation_object{.class_name = lowercase_string{"class_c"sv}};
+
+   object_classes.update(world, &creation_object);
+
+   CHECK(classes.contains("class_c"sv));
+
+   creation_object.class_name = lowercase_string{"class_a"sv};
+
+   object_classes.update(world, &creation_object);
+
+   CHECK(not classes.contains("class_c"sv));
+   CHECK(object_classes[lowercase_string{"class_a"sv}].world_references == 7);
+
+   object_classes.update(world, nullptr);
+
+   CHECK(object_classes[lowercase_string{"class_a"sv}].world_references == 6);
+}
+
+TEST_CASE("world object_class_library reload", "[World][ObjectClassLibrary]")
+{
+   test_object_classes classes;
+   object_class_library& object_classes = classes.object_classes;
+
+   world world = make_test_world(8, class_a_or_b);
+
+   object_classes.update(world, nullptr);
+
+   // A copied world has a new change log, every object is recounted.
+   world = make_test_world(8, class_a_or_b);
+   world.objects.pop_back();
+
+   object_classes.update(world, nullptr);
+
+   CHECK(object_classes[lowercase_string{"class_a"sv}].world_references == 6);
+   CHECK(object_classes[lowercase_string{"class_b"sv}].world_references == 1);
+
+   object_classes.clear();
+
+   CHECK(not classes.contains("class_a"sv));
+
+   object_classes.update(world, nullptr);
+
+   CHECK(object_classes[lowercase_string{"class_a"sv}].world_references == 6);
+}
+
+}
@@ -0,0 +1,192 @@
+#include "pch.h"
+
+#include "edits/delete_entity.hpp"
+#include "edits/set_value.hpp"
+#include "math/quaternion_funcs.hpp"
+#include "math/vector_funcs.hpp"
+#include "world/object_bbox_cache.hpp"
+#include "world/object_class_library.hpp"
+#include "world/object_store.hpp"
+#include "world/utility/raycast.hpp"
+#include "world/world.hpp"
+#include "world/world_test_objects.hpp"
+
+using namespace std::literals;
+
+namespace we::world::tests {
+
+namespace {
+
+auto class_a_or_b(const std::size_t i) -> std::string_view
+{
+   return i % 2 == 0 ? "class_a"sv : "class_b"sv;
+}
+
+void check_store(const object_store& store, const world& world)
+{
+   REQUIRE(store.size() == world.objects.size());
+
+   for (std::size_t i = 0; i < world.objects.size(); ++i) {
+      const object& object = world.objects[i];
+
+      CHECK(store.layers()[i] == object.layer);
+      CHECK(store.rotations()[i] == object.rotation);
+      CHECK(store.positions()[i] == object.position);
+      CHECK(get_name(store.class_names()[i]) == object.class_name);
+      CHECK(store.ids()[i] == object.id);
+   }
+}
+
+}
+
+TEST_CASE("world object_store update", "[World][ObjectStore]")
+{
+   world world = make_test_world(16, class_a_or_b);
+   interaction_targets interaction_targets;
+   edit_context edit_context{world, interaction_targets.creation_entity};
+
+   object_store store;
+
+   store.update(world);
+
+   check_store(store, world);
+
+   edits::make_set_value(world.objects[3].id, &object::position,
+                         float3{64.0f, 32.0f, 16.0f}, world.objects[3].position)
+      ->apply(edit_context);
+   edits::make_set_value(world.objects[5].id, &object::class_name,
+                         lowercase_string{"class_c"sv}, world.objects[5].class_name)
+      ->apply(edit_context);
+
+   store.update(world);
+
+   check_store(store, world);
+
+   edits::make_delete_entity(world.objects[0].id, world)->apply(edit_context);
+
+   store.update(world);
+
+   check_store(store, world);
+
+   store.clear();
+
+   CHECK(store.size() == 0);
+}
+
+TEST_CASE("world object_store class names", "[World][ObjectStore]")
+{
+   const world world = make_test_world(8, class_a_or_b);
+
+   object_store store;
+
+   store.update(world);
+
+   const name_handle class_a = intern_name(lowercase_string{"class_a"sv});
+   const name_handle class_b = intern_name(lowercase_string{"class_b"sv});
+
+   for (std::size_t i = 0; i < world.objects.size(); ++i) {
+      CHECK(store.class_names()[i] == (i % 2 == 0 ? class_a : class_b));
+   }
+}
+
+TEST_CASE("world object_store raycast", "[World][ObjectStore]")
+{
+   test_object_classes classes;
+   const object_class_library& object_classes = classes.object_classes;
+
+   const world world = make_test_world(64, class_a_or_b);
+
+   object_store store;
+   object_bbox_cache bboxes;
+
+   store.update(world);
+   bboxes.update(world, object_classes);
+
+   active_layers active_layers{true};
+
+   active_layers[1] = false;
+   active_layers[3] = false;
+
+   for (const float3 ray_origin : {float3{8.0f, 32.0f, 0.0f}, float3{16.0f, 32.0f, 0.0f},
+                                   float3{24.0f, 32.0f, 0.0f}, float3{1000.0f, 32.0f, 0.0f}}) {
+      const float3 ray_direction{0.0f, -1.0f, 0.0f};
+
+      const std::optional<raycast_result<object>> expected =
+         raycast(ray_origin, ray_direction, active_layers, world.objects, object_classes);
+      const std::optional<raycast_result<object>> hit =
+         raycast(ray_origin, ray_direction, active_layers, store, object_classes, bboxes);
+
+      REQUIRE(hit.has_value() == expected.has_value());
+
+      if (hit) CHECK(hit->id == expected->id);
+   }
+}
+
+TEST_CASE("world object_store benchmark", "[World][ObjectStore][!benchmark]")
+{
+   test_object_classes classes;
+   const object_class_library& object_classes = classes.object_classes;
+
+   const world world = make_test_world(20'000, class_a_or_b);
+
+   object_store store;
+   object_bbox_cache bboxes;
+
+   store.update(world);
+   bboxes.update(world, object_classes);
+
+   active_layers active_layers{true};
+
+   active_layers[2] = false;
+
+   // Stands in for the renderer's per-frame pass that reads each object's transform.
+
+   BENCHMARK("transform scan world::objects")
+   {
+      float3 sum{};
+
+      for (const object& object : world.objects) {
+         if (not active_layers[object.layer]) continue;
+
+         sum += object.rotation * object.position;
+      }
+
+      return sum;
+   };
+
+   BENCHMARK("transform scan object_store")
+   {
+      store.update(world);
+
+      const std::span<const int> layers = store.layers();
+      const std::span<const quaternion> rotations = store.rotations();
+      const std::span<const float3> positions = store.positions();
+
+      float3 sum{};
+
+      for (std::size_t i = 0; i < store.size(); ++i) {
+         if (not active_layers[layers[i]]) continue;
+
+         sum += rotations[i] * positions[i];
+      }
+
+      return sum;
+   };
+
+   const float3 ray_origin{-8.0f, 4.0f, 4.0f};
+   const float3 ray_direction = normalize(float3{1.0f, 0.0f, 0.0001f});
+
+   BENCHMARK("raycast world::objects")
+   {
+      return raycast(ray_origin, ray_direction, active_layers, world.objects,
+                     object_classes, bboxes);
+   };
+
+   BENCHMARK("raycast object_store")
+   {
+      return raycast(ray_origin, ray_direction, active_layers, store, object_classes,
+                     bboxes);
+   };
+}
+
+}
@@ -0,0 +1,86 @@
+#include "pch.h"
+
+#include "async/thread_pool.hpp"
+#include "world/object_bbox_cache.hpp"
+#include "world/utility/sector_fill.hpp"
+#include "world/world_test_objects.hpp"
+
+using namespace std::literals;
+
+namespace we::world::tests {
+
+TEST_CASE("world utilities sector_fill_all matches sector_fill", "[World][Utility]")
+{
+   test_object_classes classes;
+   const object_class_library& object_classes = classes.object_classes;
+
+   // 32 rows of 128 objects, covering X 0 to 1016 and Z 0 to 248.
+   world world = make_test_world(4096);
+
+   // Objects without names are never added to sectors.
+   for (std::size_t i = 0; i < world.objects.size(); i += 7) world.objects[i].name.clear();
+
+   world.sectors = {
+      sector{.name = "square"s,
+             .base = -16.0f,
+             .height = 32.0f,
+             .points = {{20.0f, 20.0f}, {100.0f, 20.0f}, {100.0f, 100.0f}, {20.0f, 100.0f}}},
+      sector{.name = "triangle"s,
+             .base = -16.0f,
+             .height = 32.0f,
+             .points = {{300.0f, 10.0f}, {700.0f, 60.0f}, {420.0f, 230.0f}}},
+      sector{.name = "concave"s,
+             .base = -16.0f,
+             .height = 32.0f,
+             .points = {{800.0f, 0.0f},
+                        {1000.0f, 0.0f},
+                        {1000.0f, 60.0f},
+                        {860.0f, 60.0f},
+                        {860.0f, 200.0f},
+                        {800.0f, 200.0f}}},
+      sector{.name = "everything"s,
+             .base = -16.0f,
+             .height = 32.0f,
+             .points = {{-64.0f, -64.0f}, {1100.0f, -64.0f}, {1100.0f, 320.0f}, {-64.0f, 320.0f}}},
+      sector{.name = "overlaps_edge"s,
+             .base = -16.0f,
+             .height = 32.0f,
+             .points = {{-100.0f, 100.0f}, {3.0f, 100.0f}, {3.0f, 150.0f}, {-100.0f, 150.0f}}},
+      sector{.name = "above"s,
+             .base = 64.0f,
+             .height = 32.0f,
+             .points = {{20.0f, 20.0f}, {100.0f, 20.0f}, {100.0f, 100.0f}, {20.0f, 100.0f}}},
+      sector{.name = "away"s,
+             .base = -16.0f,
+             .height = 32.0f,
+             .points = {{2000.0f, 2000.0f}, {2100.0f, 2000.0f}, {2100.0f, 2100.0f}}},
+      sector{.name = "line"s,
+             .base = -16.0f,
+             .height = 32.0f,
+             .points = {{20.0f, 20.0f}, {100.0f, 20.0f}}},
+   };
+
+   object_bbox_cache object_bboxes;
+
+   object_bboxes.update(world, object_classes);
+
+   std::shared_ptr<async::thread_pool> thread_pool = async::thread_pool::make();
+
+   const std::vector<std::vector<std::string>> sectors_objects =
+      sector_fill_all(world.sectors, world.objects, object_bboxes, *thread_pool);
+
+   REQUIRE(sectors_objects.size() == world.sectors.size());
+
+   for (std::size_t i = 0; i < world.sectors.size(); ++i) {
+      INFO("Sector: " << world.sectors[i].name);
+
+      CHECK(sectors_objects[i] == sector_fill(world.sectors[i], world.objects, object_classes));
+   }
+
+   CHECK(not sectors_objects[0].empty());
+   CHECK(sectors_objects[5].empty());
+   CHECK(sectors_objects[6].empty());
+   CHECK(sectors_objects[7].empty());
+}
+
+}
@@ -0,0 +1,270 @@
+#include "pch.h"
+
+#include "approx_test_helpers.hpp"
+#include "edits/delete_entity.hpp"
+#include "edits/insert_entity.hpp"
+#include "edits/set_value.hpp"
+#include "math/quaternion_funcs.hpp"
+#include "math/vector_funcs.hpp"
+#include "world/utility/snapping.hpp"
+#include "world/world_test_objects.hpp"
+
+#include <random>
+
+using namespace std::literals;
+
+namespace we::world::tests {
+
+namespace {
+
+const object snapping_object{.name = "snapping_object"s,
+                             .rotation = normalize(quaternion{0.9f, 0.0f, 0.3f, 0.1f}),
+                             .class_name = lowercase_string{"test_class"sv}};
+
+/// @brief Check a snapping_index gives the same results as searching every object.
+/// @param exact_position Also check the snapped positions are the same. When several
+/// points are the same distance away the two searches can pick different ones, only the
+/// distance snapped is checked when this is false.
+void check_matches_brute_force(const world& world, const snapping_index& index,
+                               const object_class_library& object_classes,
+                               const float3 position, const float snap_radius,
+                               const bool exact_position = true)
+{
+   INFO("Position: " << position.x << ", " << position.y << ", " << position.z);
+   INFO("Snap Radius: " << snap_radius);
+
+   const auto check_results = [&](const std::optional<float3> indexed,
+                                  const std::optional<float3> brute_force) {
+      REQUIRE(indexed.has_value() == brute_force.has_value());
+
+      if (not indexed) return;
+
+      if (exact_position) {
+         CHECK(approx_equals(*indexed, *brute_force));
+      }
+      else {
+         CHECK(distance(*indexed, position) == Approx(distance(*brute_force, position)));
+      }
+   };
+
+   check_results(get_snapped_position(snapping_object, position, index, snap_radius,
+                                      object_classes),
+                 get_snapped_position(snapping_object, position, world.objects,
+                                      snap_radius, object_classes));
+
+   check_results(get_snapped_position(position, index, snap_radius),
+                 get_snapped_position(position, world.objects, snap_radius,
+                                      object_classes));
+}
+
+}
+
+TEST_CASE("world utilities snapping_index matches brute force", "[World][Utility]")
+{
+   test_object_classes classes;
+   const object_class_library& object_classes = classes.object_classes;
+
+   std::mt19937 random{1};
+   std::uniform_real_distribution<float> position_distribution{-32.0f, 32.0f};
+   std::uniform_real_distribution<float> angle_distribution{0.0f, 6.28f};
+
+   world world = make_test_world(64);
+
+   for (object& object : world.objects) {
+      const float angle = angle_distribution(random);
+
+      object.rotation = normalize(quaternion{std::cos(angle), 0.0f, std::sin(angle), 0.0f});
+      object.position = {position_distribution(random), position_distribution(random),
+                         position_distribution(random)};
+   }
+
+   snapping_index index;
+
+   index.update(world, object_classes);
+
+   // Radii below, at and above the cell size and one large enough to cover every cell.
+   for (const float snap_radius : {0.25f, 1.0f, snapping_index::cell_size, 5.0f, 100.0f}) {
+      for (int i = 0; i < 128; ++i) {
+         check_matches_brute_force(world, index, object_classes,
+                                   {position_distribution(random),
+                                    position_distribution(random),
+                                    position_distribution(random)},
+                                   snap_radius);
+      }
+   }
+}
+
+TEST_CASE("world utilities snapping_index cell boundaries", "[World][Utility]")
+{
+   test_object_classes classes;
+   const object_class_library& object_classes = classes.object_classes;
+
+   constexpr float cell_size = snapping_index::cell_size;
+
+   // Unrotated objects on a lattice of cell corners, on both sides of the origin, so
+   // points land on and next to cell boundaries.
+   world world = make_test_world(27);
+
+   for (std::size_t i = 0; i < world.objects.size(); ++i) {
+      world.objects[i].rotation = {};
+      world.objects[i].position = {(static_cast<float>(i % 3) - 1.0f) * cell_size * 3.0f,
+                                   (static_cast<float>(i / 3 % 3) - 1.0f) * cell_size * 3.0f,
+                                   (static_cast<float>(i / 9) - 1.0f) * cell_size * 3.0f};
+   }
+
+   snapping_index index;
+
+   index.update(world, object_classes);
+
+   const std::array offsets{0.0f, cell_size * 0.5f, cell_size, cell_size * 1.5f,
+                            cell_size - 0.001f, cell_size + 0.001f};
+
+   for (const float snap_radius :
+        {0.0f, cell_size * 0.5f, cell_size - 0.001f, cell_size, cell_size + 0.001f,
+         cell_size * 2.0f}) {
+      for (const float x : offsets) {
+         for (const float z : offsets) {
+            check_matches_brute_force(world, index, object_classes, {x, 0.0f, z},
+                                      snap_radius, false);
+            check_matches_brute_force(world, index, object_classes, {-x, -cell_size, -z},
+                                      snap_radius, false);
+         }
+      }
+   }
+
+   SECTION("far from the origin")
+   {
+      // Far enough away that the cell coordinates are clamped.
+      world.objects[0].position = {1.0e7f, 0.0f, -1.0e7f};
+      world.objects[1].position = {1.0e7f + 64.0f, 0.0f, -1.0e7f - 64.0f};
+
+      world.changes.objects.record(world.objects[0].id, change_type::modify);
+      world.changes.objects.record(world.objects[1].id, change_type::modify);
+
+      index.update(world, object_classes);
+
+      for (const float3 position : {world.objects[0].position, world.objects[1].position}) {
+         CHECK(get_snapped_position(position, index, 4.0f));
+
+         check_matches_brute_force(world, index, object_classes, position, 4.0f, false);
+      }
+   }
+}
+
+TEST_CASE("world utilities snapping_index update", "[World][Utility]")
+{
+   test_object_classes classes;
+   const object_class_library& object_classes = classes.object_classes;
+
+   world world = make_test_world(16);
+   interaction_targets interaction_targets;
+   edit_context edit_context{world, interaction_targets.creation_entity};
+
+   snapping_index index;
+
+   index.update(world, object_classes);
+
+   const float snap_radius = 4.0f;
+   const float3 inserted_position{512.0f, 0.0f, 512.0f};
+   const float3 moved_from_position = world.objects[3].position;
+   const float3 moved_to_position{-512.0f, 0.0f, 512.0f};
+   const float3 deleted_position = world.objects[0].position;
+
+   const auto check_all = [&] {
+      for (const float3 position : {inserted_position, moved_from_position,
+                                    moved_to_position, deleted_position}) {
+         check_matches_brute_force(world, index, object_classes, position, snap_radius,
+                                   false);
+      }
+   };
+
+   check_all();
+
+   CHECK(not get_snapped_position(inserted_position, index, snap_radius));
+
+   SECTION("insert")
+   {
+      auto insert = edits::make_insert_entity(
+         object{.name = "inserted"s,
+                .position = inserted_position,
+                .class_name = lowercase_string{"test_class"sv},
+                .id = world.next_id.objects.aquire()});
+
+      insert->apply(edit_context);
+      index.update(world, object_classes);
+
+      CHECK(get_snapped_position(inserted_position, index, snap_radius));
+      check_all();
+
+      insert->revert(edit_context);
+      index.update(world, object_classes);
+
+      CHECK(not get_snapped_position(inserted_position, index, snap_radius));
+      check_all();
+   }
+
+   SECTION("remove")
+   {
+      auto remove = edits::make_delete_entity(world.objects[0].id, world);
+
+      CHECK(get_snapped_position(deleted_position, index, snap_radius));
+
+      remove->apply(edit_context);
+      index.update(world, object_classes);
+
+      CHECK(not get_snapped_position(deleted_position, index, snap_radius));
+      check_all();
+
+      remove->revert(edit_context);
+      index.update(world, object_classes);
+
+      CHECK(get_snapped_position(deleted_position, index, snap_radius));
+      check_all();
+   }
+
+   SECTION("move")
+   {
+      auto move = edits::make_set_value(world.objects[3].id, &object::position,
+                                        moved_to_position, moved_from_position);
+
+      move->apply(edit_context);
+      index.update(world, object_classes);
+
+      CHECK(not get_snapped_position(moved_from_position, index, snap_radius));
+      CHECK(get_snapped_position(moved_to_position, index, snap_radius));
+      check_all();
+
+      move->revert(edit_context);
+      index.update(world, object_classes);
+
+      CHECK(get_snapped_position(moved_from_position, index, snap_radius));
+      CHECK(not get_snapped_position(moved_to_position, index, snap_radius));
+      check_all();
+   }
+
+   SECTION("change log reset")
+   {
+      // Changes made without going through the log are picked up by the rebuild.
+      world.objects[3].position = moved_to_position;
+      world.changes.objects.reset();
+
+      index.update(world, object_classes);
+
+      CHECK(not get_snapped_position(moved_from_position, index, snap_radius));
+      CHECK(get_snapped_position(moved_to_position, index, snap_radius));
+      check_all();
+   }
+
+   SECTION("clear")
+   {
+      index.clear();
+
+      CHECK(not get_snapped_position(deleted_position, index, snap_radius));
+
+      index.update(world, object_classes);
+
+      CHECK(get_snapped_position(deleted_position, index, snap_radius));
+   }
+}
+
+}
@@ -1,6 +1,7 @@
 #include "pch.h"
 
 #include "approx_test_helpers.hpp"
+#include "world/utility/world_utilities.hpp"
 #include "world/world_io_load.hpp"
 
 #include <span>
@@ -378,25 +379,25 @@ TEST_CASE("world loading", "[World][IO]")
       CHECK(world.planning_hubs[0].position == float3{-63.822487f, 0.0f, -9.202278f});
       CHECK(world.planning_hubs[0].radius == 8.0f);
       CHECK(is_unique_id(0, world.planning_hubs));
-      CHECK(world.planning_hub_index.at(world.planning_hubs[0].id) == 0);
+      CHECK(find_entity_index<planning_hub>(world, world.planning_hubs[0].id) == 0);
 
       CHECK(world.planning_hubs[1].name == "Hub1"sv);
       CHECK(world.planning_hubs[1].position == float3{-121.883095f, 1.0f, -30.046543f});
       CHECK(world.planning_hubs[1].radius == 7.586431f);
       CHECK(is_unique_id(1, world.planning_hubs));
-      CHECK(world.planning_hub_index.at(world.planning_hubs[1].id) == 1);
+      CHECK(find_entity_index<planning_hub>(world, world.planning_hubs[1].id) == 1);
 
       CHECK(world.planning_hubs[2].name == "Hub2"sv);
       CHECK(world.planning_hubs[2].position == float3{-54.011314f, 2.0f, -194.037018f});
       CHECK(world.planning_hubs[2].radius == 13.120973f);
       CHECK(is_unique_id(2, world.planning_hubs));
-      CHECK(world.planning_hub_index.at(world.planning_hubs[2].id) == 2);
+      CHECK(find_entity_index<planning_hub>(world, world.planning_hubs[2].id) == 2);
 
       CHECK(world.planning_hubs[3].name == "Hub3"sv);
       CHECK(world.planning_hubs[3].position == float3{-163.852570f, 3.0f, -169.116760f});
       CHECK(world.planning_hubs[3].radius == 12.046540f);
       CHECK(is_unique_id(3, world.planning_hubs));
-      CHECK(world.planning_hub_index.at(world.planning_hubs[3].id) == 3);
+      CHECK(find_entity_index<planning_hub>(world, world.planning_hubs[3].id) == 3);
    }
 
    // planning connections checks
@@ -435,5 +436,21 @@ TEST_CASE("world loading", "[World][IO]")
       CHECK(world.boundaries[0].position == float2{-0.442565918f, 4.79779053f});
       CHECK(is_unique_id(0, world.boundaries));
    }
+
+   // ID index checks
+   {
+      CHECK(world.id_index.objects.size() == world.objects.size());
+      CHECK(world.id_index.lights.size() == world.lights.size());
+      CHECK(world.id_index.paths.size() == world.paths.size());
+      CHECK(world.id_index.regions.size() == world.regions.size());
+      CHECK(world.id_index.sectors.size() == world.sectors.size());
+      CHECK(world.id_index.portals.size() == world.portals.size());
+      CHECK(world.id_index.hintnodes.size() == world.hintnodes.size());
+      CHECK(world.id_index.barriers.size() == world.barriers.size());
+      CHECK(world.id_index.planning_hubs.size() == world.planning_hubs.size());
+      CHECK(world.id_index.planning_connections.size() ==
+            world.planning_connections.size());
+      CHECK(world.id_index.boundaries.size() == world.boundaries.size());
+   }
 }
 }
\ No newline at end of file
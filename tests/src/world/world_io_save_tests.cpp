@@ -758,12 +758,7 @@ TEST_CASE("world saving", "[World][IO]")
 
       .boundaries = {{.name = "boundary",
                       .position = {-0.442565918f, 4.79779053f},
-                      .size = {384.000000f, 384.000000f}}},
-
-      .planning_hub_index = {{hub_ids[0], 0},
-                             {hub_ids[1], 1},
-                             {hub_ids[2], 2},
-                             {hub_ids[3], 3}}};
+                      .size = {384.000000f, 384.000000f}}}};
 
    save_world(L"temp/world/test.wld", world);
 
@@ -0,0 +1,259 @@
+#include "pch.h"
+
+#include "edits/delete_entity.hpp"
+#include "edits/insert_entity.hpp"
+#include "edits/insert_node.hpp"
+#include "edits/set_value.hpp"
+#include "edits/world_test_data.hpp"
+#include "world/utility/world_utilities.hpp"
+#include "world/world_snapshot.hpp"
+#include "world/world_test_objects.hpp"
+
+using namespace std::literals;
+
+namespace we::world::tests {
+
+namespace {
+
+using edits::tests::test_world;
+
+}
+
+TEST_CASE("world snapshot basic", "[World][Snapshot]")
+{
+   world_snapshotter snapshotter;
+
+   const world_snapshot snapshot = snapshotter.snapshot(test_world);
+
+   CHECK(snapshot.name == test_world.name);
+   CHECK(snapshot.requirements == test_world.requirements);
+   CHECK(snapshot.layer_descriptions == test_world.layer_descriptions);
+   CHECK(snapshot.game_modes == test_world.game_modes);
+   CHECK(snapshot.global_lights == test_world.global_lights);
+   CHECK(std::ranges::equal(snapshot.objects, test_world.objects));
+   CHECK(std::ranges::equal(snapshot.lights, test_world.lights));
+   CHECK(std::ranges::equal(snapshot.paths, test_world.paths));
+   CHECK(std::ranges::equal(snapshot.regions, test_world.regions));
+   CHECK(std::ranges::equal(snapshot.sectors, test_world.sectors));
+   CHECK(std::ranges::equal(snapshot.portals, test_world.portals));
+   CHECK(std::ranges::equal(snapshot.hintnodes, test_world.hintnodes));
+   CHECK(std::ranges::equal(snapshot.barriers, test_world.barriers));
+   CHECK(std::ranges::equal(snapshot.planning_hubs, test_world.planning_hubs));
+   CHECK(std::ranges::equal(snapshot.planning_connections,
+                            test_world.planning_connections));
+   CHECK(std::ranges::equal(snapshot.boundaries, test_world.boundaries));
+}
+
+TEST_CASE("world snapshot shares unchanged chunks", "[World][Snapshot]")
+{
+   world world = make_test_world(1024);
+   interaction_targets interaction_targets;
+   edit_context edit_context{world, interaction_targets.creation_entity};
+
+   world_snapshotter snapshotter;
+
+   const world_snapshot first_snapshot = snapshotter.snapshot(world);
+
+   edits::make_set_value(world.objects[300].id, &object::position,
+                         float3{1.0f, 2.0f, 3.0f}, world.objects[300].position)
+      ->apply(edit_context);
+
+   const world_snapshot second_snapshot = snapshotter.snapshot(world);
+
+   REQUIRE(second_snapshot.objects.chunk_count() == 4);
+
+   CHECK(second_snapshot.objects.shares_chunk(first_snapshot.objects, 0));
+   CHECK(not second_snapshot.objects.shares_chunk(first_snapshot.objects, 1));
+   CHECK(second_snapshot.objects.shares_chunk(first_snapshot.objects, 2));
+   CHECK(second_snapshot.objects.shares_chunk(first_snapshot.objects, 3));
+
+   CHECK(second_snapshot.objects[300].position == float3{1.0f, 2.0f, 3.0f});
+   CHECK(first_snapshot.objects[300].position != float3{1.0f, 2.0f, 3.0f});
+   CHECK(std::ranges::equal(second_snapshot.objects, world.objects));
+}
+
+TEST_CASE("world snapshot insert", "[World][Snapshot]")
+{
+   world world = make_test_world(600);
+   interaction_targets interaction_targets;
+   edit_context edit_context{world, interaction_targets.creation_entity};
+
+   world_snapshotter snapshotter;
+
+   const world_snapshot first_snapshot = snapshotter.snapshot(world);
+
+   edits::make_insert_entity(object{.name = "inserted_object"s,
+                                    .class_name = lowercase_string{"test_class"sv},
+                                    .id = world.next_id.objects.aquire()})
+      ->apply(edit_context);
+
+   const world_snapshot second_snapshot = snapshotter.snapshot(world);
+
+   CHECK(second_snapshot.objects.size() == 601);
+   CHECK(first_snapshot.objects.size() == 600);
+   CHECK(second_snapshot.objects.shares_chunk(first_snapshot.objects, 0));
+   CHECK(second_snapshot.objects.shares_chunk(first_snapshot.objects, 1));
+   CHECK(not second_snapshot.objects.shares_chunk(first_snapshot.objects, 2));
+   CHECK(std::ranges::equal(second_snapshot.objects, world.objects));
+}
+
+TEST_CASE("world snapshot remove", "[World][Snapshot]")
+{
+   world world = make_test_world(1024);
+   interaction_targets interaction_targets;
+   edit_context edit_context{world, interaction_targets.creation_entity};
+
+   world_snapshotter snapshotter;
+
+   const world_snapshot first_snapshot = snapshotter.snapshot(world);
+
+   edits::make_delete_entity(world.objects[600].id, world)->apply(edit_context);
+
+   const world_snapshot second_snapshot = snapshotter.snapshot(world);
+
+   CHECK(second_snapshot.objects.size() == 1023);
+   CHECK(second_snapshot.objects.shares_chunk(first_snapshot.objects, 0));
+   CHECK(second_snapshot.objects.shares_chunk(first_snapshot.objects, 1));
+   CHECK(not second_snapshot.objects.shares_chunk(first_snapshot.objects, 2));
+   CHECK(not second_snapshot.objects.shares_chunk(first_snapshot.objects, 3));
+   CHECK(std::ranges::equal(second_snapshot.objects, world.objects));
+}
+
+TEST_CASE("world snapshot shares unchanged entity types", "[World][Snapshot]")
+{
+   world world = make_test_world(512);
+
+   for (int i = 0; i < 300; ++i) {
+      world.lights.push_back(light{.name = "light"s + std::to_string(i),
+                                   .id = world.next_id.lights.aquire()});
+   }
+
+   rebuild_id_indices(world);
+
+   interaction_targets interaction_targets;
+   edit_context edit_context{world, interaction_targets.creation_entity};
+
+   world_snapshotter snapshotter;
+
+   const world_snapshot first_snapshot = snapshotter.snapshot(world);
+
+   edits::make_set_value(world.lights[280].id, &light::position,
+                         float3{1.0f, 2.0f, 3.0f}, world.lights[280].position)
+      ->apply(edit_context);
+
+   const world_snapshot second_snapshot = snapshotter.snapshot(world);
+
+   CHECK(second_snapshot.lights.shares_chunk(first_snapshot.lights, 0));
+   CHECK(not second_snapshot.lights.shares_chunk(first_snapshot.lights, 1));
+   CHECK(second_snapshot.objects.shares_chunk(first_snapshot.objects, 0));
+   CHECK(second_snapshot.objects.shares_chunk(first_snapshot.objects, 1));
+   CHECK(second_snapshot.lights[280].position == float3{1.0f, 2.0f, 3.0f});
+   CHECK(std::ranges::equal(second_snapshot.lights, world.lights));
+}
+
+TEST_CASE("world snapshot tracks edits to every entity type", "[World][Snapshot]")
+{
+   world world = edits::tests::test_world;
+   interaction_targets interaction_targets;
+   edit_context edit_context{world, interaction_targets.creation_entity};
+
+   world_snapshotter snapshotter;
+
+   (void)snapshotter.snapshot(world);
+
+   edits::make_set_value(world.lights[0].id, &light::position, float3{1.0f, 2.0f, 3.0f},
+                         world.lights[0].position)
+      ->apply(edit_context);
+   edits::make_insert_node(world.paths[0].id, 1,
+                           path::node{.position = {4.0f, 4.0f, 4.0f}})
+      ->apply(edit_context);
+   edits::make_insert_entity(region{.name = "inserted_region"s,
+                                    .id = world.next_id.regions.aquire()})
+      ->apply(edit_context);
+   edits::make_delete_entity(world.sectors[0].id, world)->apply(edit_context);
+   edits::make_delete_entity(world.planning_hubs[0].id, world)->apply(edit_context);
+
+   const world_snapshot snapshot = snapshotter.snapshot(world);
+
+   CHECK(std::ranges::equal(snapshot.objects, world.objects));
+   CHECK(std::ranges::equal(snapshot.lights, world.lights));
+   CHECK(std::ranges::equal(snapshot.paths, world.paths));
+   CHECK(std::ranges::equal(snapshot.regions, world.regions));
+   CHECK(std::ranges::equal(snapshot.sectors, world.sectors));
+   CHECK(std::ranges::equal(snapshot.portals, world.portals));
+   CHECK(std::ranges::equal(snapshot.hintnodes, world.hintnodes));
+   CHECK(std::ranges::equal(snapshot.barriers, world.barriers));
+   CHECK(std::ranges::equal(snapshot.planning_hubs, world.planning_hubs));
+   CHECK(std::ranges::equal(snapshot.planning_connections, world.planning_connections));
+   CHECK(std::ranges::equal(snapshot.boundaries, world.boundaries));
+}
+
+TEST_CASE("world snapshot reset", "[World][Snapshot]")
+{
+   const world world = make_test_world(512);
+
+   world_snapshotter snapshotter;
+
+   const world_snapshot first_snapshot = snapshotter.snapshot(world);
+
+   snapshotter.reset();
+
+   const world_snapshot second_snapshot = snapshotter.snapshot(world);
+
+   CHECK(not second_snapshot.objects.shares_chunk(first_snapshot.objects, 0));
+   CHECK(not second_snapshot.objects.shares_chunk(first_snapshot.objects, 1));
+   CHECK(std::ranges::equal(second_snapshot.objects, world.objects));
+}
+
+TEST_CASE("world snapshot make_world", "[World][Snapshot]")
+{
+   world_snapshotter snapshotter;
+
+   const world world = make_world(snapshotter.snapshot(test_world));
+
+   CHECK(world.name == test_world.name);
+   CHECK(world.requirements == test_world.requirements);
+   CHECK(world.layer_descriptions == test_world.layer_descriptions);
+   CHECK(world.game_modes == test_world.game_modes);
+   CHECK(world.global_lights == test_world.global_lights);
+   CHECK(world.objects == test_world.objects);
+   CHECK(world.lights == test_world.lights);
+   CHECK(world.paths == test_world.paths);
+   CHECK(world.regions == test_world.regions);
+   CHECK(world.sectors == test_world.sectors);
+   CHECK(world.portals == test_world.portals);
+   CHECK(world.hintnodes == test_world.hintnodes);
+   CHECK(world.barriers == test_world.barriers);
+   CHECK(world.planning_hubs == test_world.planning_hubs);
+   CHECK(world.planning_connections == test_world.planning_connections);
+   CHECK(world.boundaries == test_world.boundaries);
+
+   CHECK(find_entity<object>(world, test_world.objects[0].id) == &world.objects[0]);
+}
+
+TEST_CASE("world snapshot benchmark", "[World][Snapshot][!benchmark]")
+{
+   world world = make_test_world(16384);
+   interaction_targets interaction_targets;
+   edit_context edit_context{world, interaction_targets.creation_entity};
+
+   world_snapshotter snapshotter;
+
+   (void)snapshotter.snapshot(world);
+
+   BENCHMARK("deep copy objects")
+   {
+      return std::vector<object>{world.objects};
+   };
+
+   BENCHMARK("snapshot after one edit")
+   {
+      edits::make_set_value(world.objects[0].id, &object::layer,
+                            world.objects[0].layer + 1, world.objects[0].layer)
+         ->apply(edit_context);
+
+      return snapshotter.snapshot(world);
+   };
+}
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "assets/asset_libraries.hpp"
+#include "async/thread_pool.hpp"
+#include "math/quaternion_funcs.hpp"
+#include "output_stream.hpp"
+#include "world/object_class_library.hpp"
+#include "world/utility/world_utilities.hpp"
+#include "world/world.hpp"
+
+#include <cmath>
+#include <string>
+#include <string_view>
+
+namespace we::world::tests {
+
+/// @brief Make a world filled with objects. Objects are laid out in rows of 128 spaced 8
+/// units apart, each is rotated a bit more than the last and they cycle through 4 layers.
+/// @param object_count The number of objects to make.
+/// @param class_name Called with the index of an object, returns its class name.
+template<typename Fn>
+inline auto make_test_world(const std::size_t object_count, const Fn& class_name) -> world
+{
+   using namespace std::literals;
+
+   world world;
+
+   for (std::size_t i = 0; i < object_count; ++i) {
+      const float angle = static_cast<float>(i) * 0.1f;
+
+      world.objects.push_back(
+         object{.name = "object"s + std::to_string(i),
+                .layer = static_cast<int>(i % 4),
+                .rotation = normalize(quaternion{std::cos(angle), 0.0f,
+                                                 std::sin(angle), 0.0f}),
+                .position = {static_cast<float>(i % 128) * 8.0f, 0.0f,
+                             static_cast<float>(i / 128) * 8.0f},
+                .class_name = lowercase_string{std::string_view{class_name(i)}},
+                .id = world.next_id.objects.aquire()});
+   }
+
+   rebuild_id_indices(world);
+
+   return world;
+}
+
+/// @brief Make a world filled with objects of the class "test_class".
+/// @param object_count The number of objects to make.
+inline auto make_test_world(const std::size_t object_count) -> world
+{
+   return make_test_world(object_count,
+                          [](const std::size_t) { return std::string_view{"test_class"}; });
+}
+
+/// @brief An object class library for tests, backed by asset libraries with no assets
+/// loaded.
+struct test_object_classes {
+   null_output_stream output;
+   assets::libraries_manager asset_libraries{output, async::thread_pool::make()};
+   object_class_library object_classes{asset_libraries};
+
+   /// @brief Check if the library has a class, rather than the placeholder for missing
+   /// classes.
+   /// @param name The name of the class.
+   bool contains(const std::string_view name) const noexcept
+   {
+      const lowercase_string missing_name{std::string_view{"object_class_library_missing"}};
+
+      return &object_classes[lowercase_string{name}] != &object_classes[missing_name];
+   }
+};
+
+}
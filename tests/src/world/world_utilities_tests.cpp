@@ -28,12 +28,14 @@ TEST_CASE("world utilities find_entity by id", "[World][Utilities]")
    world.regions.push_back(region{.id = world.next_id.regions.aquire()});
    world.regions.push_back(region{.id = world.next_id.regions.aquire()});
 
-   REQUIRE(find_entity(world.regions, world.regions[0].id) == &world.regions[0]);
-   REQUIRE(find_entity(world.regions, world.regions[1].id) == &world.regions[1]);
-   REQUIRE(find_entity(world.regions, world.regions[2].id) == &world.regions[2]);
-   REQUIRE(find_entity(world.regions, world.regions[3].id) == &world.regions[3]);
-   REQUIRE(find_entity(world.regions, world.regions[4].id) == &world.regions[4]);
-   REQUIRE(find_entity(world.regions, missing_id) == nullptr);
+   rebuild_id_indices(world);
+
+   REQUIRE(find_entity<region>(world, world.regions[0].id) == &world.regions[0]);
+   REQUIRE(find_entity<region>(world, world.regions[1].id) == &world.regions[1]);
+   REQUIRE(find_entity<region>(world, world.regions[2].id) == &world.regions[2]);
+   REQUIRE(find_entity<region>(world, world.regions[3].id) == &world.regions[3]);
+   REQUIRE(find_entity<region>(world, world.regions[4].id) == &world.regions[4]);
+   REQUIRE(find_entity<region>(world, missing_id) == nullptr);
 
    world.regions.clear();
 
@@ -43,12 +45,14 @@ TEST_CASE("world utilities find_entity by id", "[World][Utilities]")
    world.regions.push_back(region{.id = world.next_id.regions.aquire()});
    world.regions.push_back(region{.id = world.next_id.regions.aquire()});
 
-   REQUIRE(find_entity(world.regions, world.regions[0].id) == &world.regions[0]);
-   REQUIRE(find_entity(world.regions, world.regions[1].id) == &world.regions[1]);
-   REQUIRE(find_entity(world.regions, world.regions[2].id) == &world.regions[2]);
-   REQUIRE(find_entity(world.regions, world.regions[3].id) == &world.regions[3]);
-   REQUIRE(find_entity(world.regions, world.regions[4].id) == &world.regions[4]);
-   REQUIRE(find_entity(world.regions, missing_id) == nullptr);
+   rebuild_id_indices(world);
+
+   REQUIRE(find_entity<region>(world, world.regions[0].id) == &world.regions[0]);
+   REQUIRE(find_entity<region>(world, world.regions[1].id) == &world.regions[1]);
+   REQUIRE(find_entity<region>(world, world.regions[2].id) == &world.regions[2]);
+   REQUIRE(find_entity<region>(world, world.regions[3].id) == &world.regions[3]);
+   REQUIRE(find_entity<region>(world, world.regions[4].id) == &world.regions[4]);
+   REQUIRE(find_entity<region>(world, missing_id) == nullptr);
 }
 
 TEST_CASE("world utilities find_region", "[World][Utilities]")
@@ -82,6 +86,92 @@ TEST_CASE("world utilities create_unique_name", "[World][Utilities]")
    REQUIRE(create_unique_name(world.objects, "") == "");
 }
 
+TEST_CASE("world utilities create_unique_name with name index", "[World][Utilities]")
+{
+   world world{.objects = {object{.name = "Amazing Object 32"s, .id = object_id{0}},
+                           object{.name = "62"s, .id = object_id{1}}}};
+
+   rebuild_name_indices(world);
+
+   REQUIRE(create_unique_name<object>(world, "Amazing Object 32") == "Amazing Object 0");
+   REQUIRE(create_unique_name<object>(world, "Amazing Object") == "Amazing Object");
+   REQUIRE(create_unique_name<object>(world, "Amazing Object 31") ==
+           "Amazing Object 31");
+   REQUIRE(create_unique_name<object>(world, "62") == "Object0");
+   REQUIRE(create_unique_name<object>(world, "63") == "63");
+   REQUIRE(create_unique_name<object>(world, "") == "");
+
+   for (uint32 i = 0; i < 256; ++i) {
+      object new_object{.name = create_unique_name<object>(world, "Object"),
+                        .id = object_id{i + 2}};
+
+      index_entity_name(world, new_object);
+      world.objects.push_back(std::move(new_object));
+   }
+
+   REQUIRE(world.objects.size() == 258);
+   CHECK(world.objects[2].name == "Object");
+   CHECK(world.objects[3].name == "Object0");
+   CHECK(world.objects.back().name == "Object254");
+   CHECK(create_unique_name<object>(world, "Object") ==
+         create_unique_name(world.objects, "Object"));
+
+   unindex_entity_name(world, world.objects[100]);
+   world.objects.erase(world.objects.begin() + 100);
+
+   CHECK(create_unique_name<object>(world, "Object") == "Object97");
+   CHECK(create_unique_name<object>(world, "Object") ==
+         create_unique_name(world.objects, "Object"));
+}
+
+TEST_CASE("world utilities find by name with name index", "[World][Utilities]")
+{
+   world world{.regions = {region{.name = "some_region"s,
+                                  .description = "some_desc"s,
+                                  .id = region_id{0}},
+                           region{.name = "other_region"s,
+                                  .description = "other_desc"s,
+                                  .id = region_id{1}}}};
+
+   rebuild_name_indices(world);
+
+   REQUIRE(is_name_index_complete<region>(world));
+   REQUIRE(find_entity<region>(world, "other_region"sv) == &world.regions[1]);
+   REQUIRE(find_region(world, "some_region"sv) == &world.regions[0]);
+   REQUIRE(find_region(world, "no_region"sv) == nullptr);
+   REQUIRE(find_region_by_description(world, "other_desc"sv) == &world.regions[1]);
+   REQUIRE(find_region_by_description(world, "no_desc"sv) == nullptr);
+
+   set_entity_value<region>(world, region_id{1}, &region::description, "new_desc"s);
+
+   REQUIRE(find_region_by_description(world, "other_desc"sv) == nullptr);
+   REQUIRE(find_region_by_description(world, "new_desc"sv) == &world.regions[1]);
+}
+
+TEST_CASE("world utilities find_entity with id index", "[World][Utilities]")
+{
+   world world{.objects = {object{.name = "obj2"s, .id = object_id{2}},
+                           object{.name = "obj0"s, .id = object_id{0}},
+                           object{.name = "obj1"s, .id = object_id{1}}}};
+
+   REQUIRE(find_entity<object>(world, object_id{2}) == &world.objects[0]);
+   REQUIRE(find_entity<object>(world, object_id{0}) == &world.objects[1]);
+
+   rebuild_id_indices(world);
+
+   REQUIRE(find_entity_index<object>(world, object_id{2}) == 0);
+   REQUIRE(find_entity_index<object>(world, object_id{0}) == 1);
+   REQUIRE(find_entity_index<object>(world, object_id{1}) == 2);
+   REQUIRE(not find_entity_index<object>(world, object_id{3}));
+
+   world.objects.erase(world.objects.begin());
+   unindex_entity_id<object>(world, object_id{2}, 0);
+
+   REQUIRE(find_entity<object>(world, object_id{2}) == nullptr);
+   REQUIRE(find_entity<object>(world, object_id{0}) == &world.objects[0]);
+   REQUIRE(find_entity<object>(world, object_id{1}) == &world.objects[1]);
+}
+
 TEST_CASE("world utilities create_unique_light_region_name",
           "[World][Utilities]")
 {
@@ -100,6 +190,96 @@ TEST_CASE("world utilities create_unique_light_region_name",
                                            "Region1") == "Region1");
 }
 
+TEST_CASE("world utilities create_unique_light_region_name with name index",
+          "[World][Utilities]")
+{
+   world world{
+      .lights = {light{.name = "Light0"s,
+                       .light_type = light_type::directional_region_box,
+                       .region_name = "LightRegion0"s,
+                       .id = light_id{0}},
+                 light{.name = "Light1"s, .region_name = "LightRegion2"s, .id = light_id{1}}},
+      .regions = {region{.name = "Region0"s, .id = region_id{0}},
+                  region{.name = "LightRegion1"s, .id = region_id{1}}},
+   };
+
+   rebuild_name_indices(world);
+   rebuild_id_indices(world);
+
+   for (const std::string_view reference_name :
+        {"Light0"sv, "Light1"sv, "Region0"sv, "Region1"sv, "LightRegion0"sv, ""sv}) {
+      CHECK(create_unique_light_region_name(world, reference_name) ==
+            create_unique_light_region_name(world.lights, world.regions, reference_name));
+   }
+
+   // Light1 isn't a region light so its region name is free to use.
+   REQUIRE(create_unique_light_region_name(world, "Light0") == "Light2");
+   REQUIRE(create_unique_light_region_name(world, "") == "LightRegion2");
+
+   set_entity_value<light>(world, light_id{1}, &light::light_type,
+                           light_type::directional_region_sphere);
+
+   REQUIRE(is_light_region_name_index_complete(world));
+   REQUIRE(create_unique_light_region_name(world, "") == "LightRegion3");
+   REQUIRE(create_unique_light_region_name(world, "") ==
+           create_unique_light_region_name(world.lights, world.regions, ""));
+
+   set_entity_value<light>(world, light_id{1}, &light::region_name, "Other"s);
+
+   REQUIRE(is_light_region_name_index_complete(world));
+   REQUIRE(create_unique_light_region_name(world, "") == "LightRegion2");
+   REQUIRE(create_unique_light_region_name(world, "") ==
+           create_unique_light_region_name(world.lights, world.regions, ""));
+
+   set_entity_value<light>(world, light_id{1}, &light::light_type, light_type::point);
+
+   REQUIRE(is_light_region_name_index_complete(world));
+
+   unindex_entity_name(world, world.lights[0]);
+   world.lights.erase(world.lights.begin());
+   rebuild_id_indices(world);
+
+   REQUIRE(create_unique_light_region_name(world, "") == "LightRegion0");
+   REQUIRE(create_unique_light_region_name(world, "") ==
+           create_unique_light_region_name(world.lights, world.regions, ""));
+}
+
+TEST_CASE("world utilities find_entity by name picks the first entity",
+          "[World][Utilities]")
+{
+   world world{.paths = {path{.name = "Path"s, .id = path_id{3}},
+                         path{.name = "Path"s, .id = path_id{1}},
+                         path{.name = "Other"s, .id = path_id{0}}}};
+
+   rebuild_id_indices(world);
+
+   REQUIRE(not is_name_index_complete<path>(world));
+   REQUIRE(find_entity<path>(world, "Path"sv) == &world.paths[0]);
+
+   rebuild_name_indices(world);
+
+   REQUIRE(is_name_index_complete<path>(world));
+   REQUIRE(find_entity<path>(world, "Path"sv) == &world.paths[0]);
+   REQUIRE(find_entity<path>(world, "None"sv) == nullptr);
+}
+
+TEST_CASE("world utilities is_name_index_complete compares names", "[World][Utilities]")
+{
+   world world{.objects = {object{.name = "obj0"s, .id = object_id{0}},
+                           object{.name = "obj1"s, .id = object_id{1}}}};
+
+   rebuild_id_indices(world);
+   rebuild_name_indices(world);
+
+   REQUIRE(is_name_index_complete<object>(world));
+
+   world.objects[1].name = "renamed"s;
+
+   REQUIRE(not is_name_index_complete<object>(world));
+   REQUIRE(find_entity<object>(world, "renamed"sv) == &world.objects[1]);
+   REQUIRE(find_entity<object>(world, "obj1"sv) == nullptr);
+}
+
 TEST_CASE("world utilities find_closest_node", "[World][Utilities]")
 {
    path path{.nodes = {